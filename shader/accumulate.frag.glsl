@@ -0,0 +1,85 @@
+#version 330 core
+
+// Out color
+out vec4 color;
+
+
+// Uniform variables
+uniform sampler2D u_current;
+uniform sampler2D u_history;
+
+uniform mat4 u_ray_mat;
+uniform mat4 u_previous_mat;
+
+uniform float u_weight;
+uniform int u_reproject;
+
+uniform vec3 u_clip_min;
+uniform vec3 u_clip_max;
+
+
+// In variables
+in vec2 tex_coord;
+
+
+// Main function
+void main () {
+    // Volume pass of the current frame
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec4 current = texelFetch(u_current, pixel, 0);
+
+    // Replace the history
+    if (u_weight >= 1.0F) {
+        color = current;
+        return;
+    }
+
+    // Static view, running average
+    if (u_reproject == 0) {
+        color = mix(texelFetch(u_history, pixel, 0), current, u_weight);
+        return;
+    }
+
+    // Ray of the pixel in texture space
+    vec2 ndc = 2.0F * tex_coord - 1.0F;
+    vec4 near_pos = u_ray_mat * vec4(ndc, -1.0F, 1.0F);
+    vec4 far_pos = u_ray_mat * vec4(ndc, 1.0F, 1.0F);
+    vec3 near = near_pos.xyz / near_pos.w;
+    vec3 dir = far_pos.xyz / far_pos.w - near;
+
+    // Entry point into the clipped texture box as the representative depth
+    vec3 inv_dir = 1.0F / (dir + vec3(equal(dir, vec3(0.0F))) * 1e-7F);
+    vec3 t_0 = (u_clip_min - near) * inv_dir;
+    vec3 t_1 = (u_clip_max - near) * inv_dir;
+    vec3 t_min = min(t_0, t_1);
+    vec3 t_max = max(t_0, t_1);
+    float t_near = max(max(t_min.x, t_min.y), max(t_min.z, 0.0F));
+    float t_far = min(min(t_max.x, t_max.y), min(t_max.z, 1.0F));
+    if (t_near >= t_far) {
+        color = current;
+        return;
+    }
+
+    // Position of the entry point in the previous frame
+    vec4 previous_pos = u_previous_mat * vec4(near + t_near * dir, 1.0F);
+    vec2 previous = 0.5F * previous_pos.xy / previous_pos.w + 0.5F;
+    if (any(lessThan(previous, vec2(0.0F))) || any(greaterThan(previous, vec2(1.0F)))) {
+        color = current;
+        return;
+    }
+
+    // Clamp the history to the current neighbourhood to reject disoccluded samples
+    ivec2 size = textureSize(u_current, 0);
+    vec4 minimum = current;
+    vec4 maximum = current;
+    for (int j = -1; j <= 1; j++) {
+        for (int i = -1; i <= 1; i++) {
+            vec4 value = texelFetch(u_current, clamp(pixel + ivec2(i, j), ivec2(0), size - 1), 0);
+            minimum = min(minimum, value);
+            maximum = max(maximum, value);
+        }
+    }
+
+    // Blend with the reprojected history
+    color = mix(clamp(texture(u_history, previous), minimum, maximum), current, u_weight);
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#version 330 core
+
+// Out color
+out vec4 color;
+
+
+// Uniform variables
+uniform sampler1D u_trans_func;
+
+uniform float u_isovalue;
+
+
+// In variables
+in vec3 normal;
+
+
+// Main function
+void main() {
+    // Two sided Blinn-Phong with a head light, the half vector is equal to the light direction
+    float magnitude = length(normal);
+    float diffuse = magnitude > 0.0F ? abs(normal.z) / magnitude : 1.0F;
+    float specular = pow(diffuse, 32.0F);
+
+    // Opaque color of the isovalue in the transfer function
+    vec3 classified = texture(u_trans_func, u_isovalue).rgb;
+    color = vec4(classified * (0.25F + 0.75F * diffuse) + vec3(0.25F * specular), 1.0F);
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#version 330 core
+
+// Location variables
+layout (location = 0) in vec3 l_position;
+layout (location = 1) in vec3 l_normal;
+
+
+// Uniform variables
+uniform mat4 u_view_mat;
+uniform mat4 u_projection_mat;
+
+uniform mat4 u_model_mat;
+uniform mat3 u_normal_mat;
+
+
+// Out variables
+out vec3 normal;
+
+
+// Main function
+void main() {
+    // Normal in view space
+    normal = u_normal_mat * l_normal;
+
+    // Set the vertex position
+    gl_Position = u_projection_mat * u_view_mat * u_model_mat * vec4(l_position, 1.0F);
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#version 330 core
+
+// Out variables
+out vec2 tex_coord;
+
+
+// Main function
+void main() {
+    // Screen covering triangle from the vertex index
+    vec2 vert = vec2(float((gl_VertexID & 1) << 2) - 1.0F, float((gl_VertexID & 2) << 1) - 1.0F);
+
+    // Set the out variables
+    tex_coord = 0.5F * vert + 0.5F;
+
+    // Set the vertex position
+    gl_Position = vec4(vert, 0.0F, 1.0F);
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#version 330 core
+
+// Out color
+out vec4 color;
+
+
+// Uniform variables
+uniform sampler2D u_image;
+uniform float u_sigma;
+
+uniform mat4 u_ray_mat;
+
+uniform vec3 u_clip_min;
+uniform vec3 u_clip_max;
+
+
+// In variables
+in vec2 tex_coord;
+
+
+// Distance from the near plane to the entry point into the clipped texture box of the ray through a normalized device point
+float entry(vec2 ndc) {
+    vec4 near_pos = u_ray_mat * vec4(ndc, -1.0F, 1.0F);
+    vec4 far_pos = u_ray_mat * vec4(ndc, 1.0F, 1.0F);
+    vec3 near = near_pos.xyz / near_pos.w;
+    vec3 dir = far_pos.xyz / far_pos.w - near;
+
+    vec3 inv_dir = 1.0F / (dir + vec3(equal(dir, vec3(0.0F))) * 1e-7F);
+    vec3 t_0 = (u_clip_min - near) * inv_dir;
+    vec3 t_1 = (u_clip_max - near) * inv_dir;
+    vec3 t_min = min(t_0, t_1);
+    vec3 t_max = max(t_0, t_1);
+    float t_near = max(max(t_min.x, t_min.y), max(t_min.z, 0.0F));
+    float t_far = min(min(t_max.x, t_max.y), min(t_max.z, 1.0F));
+
+    // Missed rays are far behind any box point
+    if (t_near >= t_far) {
+        return 4.0F;
+    }
+    return t_near * length(dir);
+}
+
+
+// Main function
+void main () {
+    // Low resolution texel coordinates around the pixel
+    ivec2 size = textureSize(u_image, 0);
+    vec2 texel = tex_coord * vec2(size) - 0.5F;
+    ivec2 base = ivec2(floor(texel));
+    vec2 frac = texel - vec2(base);
+
+    // Entry depth of the full resolution pixel as the guide of the range weight
+    float guide = entry(2.0F * tex_coord - 1.0F);
+
+    // Bilinear weights attenuated across depth edges of the low resolution samples
+    vec4 result = vec4(0.0F);
+    float total = 0.0F;
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < 2; i++) {
+            ivec2 sample_texel = clamp(base + ivec2(i, j), ivec2(0), size - 1);
+            vec4 value = texelFetch(u_image, sample_texel, 0);
+            float spatial = (i == 0 ? 1.0F - frac.x : frac.x) * (j == 0 ? 1.0F - frac.y : frac.y);
+            float difference = (entry(2.0F * (vec2(sample_texel) + 0.5F) / vec2(size) - 1.0F) - guide) / u_sigma;
+            float weight = spatial * exp(-difference * difference) + 1e-5F;
+            result += weight * value;
+            total += weight;
+        }
+    }
+
+    // Premultiplied color
+    color = result / total;
+}
\ No newline at end of file
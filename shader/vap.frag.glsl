@@ -8,13 +8,308 @@ out vec4 color;
 uniform sampler3D u_tex;
 uniform sampler1D u_trans_func;
 
+uniform vec3 u_voxel;
+uniform float u_value_scale;
 
+uniform mat4 u_volume_mat;
+uniform float u_step;
+uniform float u_step_scale;
+uniform float u_jitter;
+
+uniform vec3 u_clip_min;
+uniform vec3 u_clip_max;
+uniform vec3 u_region_scale;
+
+
+// Sample the volume data
+float sampleVolume(vec3 point) {
+#ifdef DATA_16BIT
+    // Stretch the used range of the 16 bits data
+    return texture(u_tex, point).r * u_value_scale;
+#else
+    return texture(u_tex, point).r;
+#endif
+}
+
+
+// Correct the opacity for the sample distance
+vec4 correctOpacity(vec4 classified) {
+    return vec4(classified.rgb, 1.0F - pow(1.0F - classified.a, u_step_scale));
+}
+
+
+#ifdef SHADING
+// Shade the classified sample with a head light
+vec4 shade(vec3 point, vec4 classified, vec3 light) {
+    // Gradient by central differences
+    vec3 gradient = vec3(
+        sampleVolume(point - vec3(u_voxel.x, 0.0F, 0.0F)) - sampleVolume(point + vec3(u_voxel.x, 0.0F, 0.0F)),
+        sampleVolume(point - vec3(0.0F, u_voxel.y, 0.0F)) - sampleVolume(point + vec3(0.0F, u_voxel.y, 0.0F)),
+        sampleVolume(point - vec3(0.0F, 0.0F, u_voxel.z)) - sampleVolume(point + vec3(0.0F, 0.0F, u_voxel.z)));
+
+    // Homogeneous regions are not shaded
+    float magnitude = length(gradient);
+    if (magnitude < 1e-4F) {
+        return classified;
+    }
+
+    // Blinn-Phong with the half vector equal to the light direction
+    vec3 normal = gradient / magnitude;
+    float diffuse = abs(dot(normal, light));
+    float specular = pow(diffuse, 32.0F);
+    return vec4(classified.rgb * (0.25F + 0.75F * diffuse) + vec3(0.25F * specular), classified.a);
+}
+#endif
+
+
+#ifdef RAY_CASTING
+#ifdef JITTER
+// Per pixel ray offset in steps, interleaved gradient noise shifted every frame
+float jitterOffset() {
+    return fract(52.9829189F * fract(dot(gl_FragCoord.xy, vec2(0.06711056F, 0.00583715F))) + u_jitter);
+}
+#endif
+
+
+// In variables
+in vec4 near_pos;
+in vec4 far_pos;
+
+
+#ifdef MULTI_VOLUME
+// Maximum number of volumes, as Volume::MAX_LAYERS
+#define MAX_LAYERS 4
+
+
+// Uniform variables of every volume
+uniform int u_layers;
+uniform sampler3D u_layer_tex[MAX_LAYERS];
+uniform sampler1D u_layer_trans_func[MAX_LAYERS];
+uniform mat4 u_layer_mat[MAX_LAYERS];
+uniform vec3 u_layer_inverse_scale[MAX_LAYERS];
+uniform vec3 u_layer_clip_min[MAX_LAYERS];
+uniform vec3 u_layer_clip_max[MAX_LAYERS];
+uniform float u_layer_value_scale[MAX_LAYERS];
+uniform float u_layer_step[MAX_LAYERS];
+
+
+// Ray of every volume in its texture space, its distances inside the drawn box and its opacity correction exponent
+vec3 layer_origin[MAX_LAYERS];
+vec3 layer_dir[MAX_LAYERS];
+vec2 layer_span[MAX_LAYERS];
+float layer_exponent[MAX_LAYERS];
+
+
+// Add the classified sample of the volume at the distance if the ray is inside it, otherwise bring forward the next entry point
+void mixLayer(int layer, sampler3D tex, sampler1D trans_func, float t, inout vec3 emission, inout float weight, inout float transparency, inout float next, inout bool inside) {
+    if ((layer >= u_layers) || (t >= layer_span[layer].y)) {
+        return;
+    }
+
+    if (t < layer_span[layer].x) {
+        next = min(next, layer_span[layer].x);
+        return;
+    }
+
+    // Opacity weighted emission, the opacities are combined as independent absorptions
+    vec4 classified = texture(trans_func, texture(tex, layer_origin[layer] + t * layer_dir[layer]).r * u_layer_value_scale[layer]);
+    float alpha = 1.0F - pow(1.0F - classified.a, layer_exponent[layer]);
+    emission += classified.rgb * alpha;
+    weight += alpha;
+    transparency *= 1.0F - alpha;
+    inside = true;
+}
+
+
+// Main function
+void main () {
+    // Ray in world space, the model matrix is the identity
+    vec3 near = near_pos.xyz / near_pos.w;
+    vec3 far = far_pos.xyz / far_pos.w;
+    vec3 dir = normalize(far - near);
+    float ray_length = distance(near, far);
+
+    // Intersect the ray with the drawn box of every volume in its texture space with the t axis swapped
+    float t_first = ray_length;
+    float t_last = 0.0F;
+    for (int i = 0; i < u_layers; i++) {
+        layer_origin[i] = (u_layer_mat[i] * vec4(near, 1.0F)).stp;
+        layer_dir[i] = (u_layer_mat[i] * vec4(dir, 0.0F)).stp;
+        layer_origin[i].t = 1.0F - layer_origin[i].t;
+        layer_dir[i].t = -layer_dir[i].t;
+
+        vec3 inv_dir = 1.0F / (layer_dir[i] + vec3(equal(layer_dir[i], vec3(0.0F))) * 1e-7F);
+        vec3 t_0 = (u_layer_clip_min[i] - layer_origin[i]) * inv_dir;
+        vec3 t_1 = (u_layer_clip_max[i] - layer_origin[i]) * inv_dir;
+        vec3 t_min = min(t_0, t_1);
+        vec3 t_max = max(t_0, t_1);
+        layer_span[i] = vec2(max(max(t_min.x, t_min.y), max(t_min.z, 0.0F)), min(min(t_max.x, t_max.y), min(t_max.z, ray_length)));
+
+        // The missed volumes are never entered
+        if (layer_span[i].x < layer_span[i].y) {
+            t_first = min(t_first, layer_span[i].x);
+            t_last = max(t_last, layer_span[i].y);
+        }
+        else {
+            layer_span[i] = vec2(ray_length);
+        }
+
+        // Opacity correction for the model space distance between the shared samples
+        layer_exponent[i] = u_step * length(dir * u_layer_inverse_scale[i]) / u_layer_step[i];
+    }
+    if (t_first >= t_last) {
+        discard;
+    }
+
+    // Samples at whole steps from the near plane
+    float t = ceil(t_first / u_step) * u_step;
+
+#ifdef JITTER
+    // Offset the first sample to turn the banding into noise
+    t += jitterOffset() * u_step;
+#endif
+
+    // Front to back emission absorption, the samples of the overlapping volumes are mixed by their opacities
+    vec4 result = vec4(0.0F);
+    while ((t < t_last) && (result.a < 0.99F)) {
+        vec3 emission = vec3(0.0F);
+        float weight = 0.0F;
+        float transparency = 1.0F;
+        float next = t_last;
+        bool inside = false;
+        mixLayer(0, u_layer_tex[0], u_layer_trans_func[0], t, emission, weight, transparency, next, inside);
+        mixLayer(1, u_layer_tex[1], u_layer_trans_func[1], t, emission, weight, transparency, next, inside);
+        mixLayer(2, u_layer_tex[2], u_layer_trans_func[2], t, emission, weight, transparency, next, inside);
+        mixLayer(3, u_layer_tex[3], u_layer_trans_func[3], t, emission, weight, transparency, next, inside);
+
+        // Between the volumes the ray jumps to the first step inside the next one
+        if (!inside) {
+            t += max(1.0F, ceil((next - t) / u_step)) * u_step;
+            continue;
+        }
+
+        if (weight > 0.0F) {
+            float alpha = 1.0F - transparency;
+            result += (1.0F - result.a) * vec4(emission * (alpha / weight), alpha);
+        }
+        t += u_step;
+    }
+
+    // Non premultiplied color for the blend function
+    if (result.a <= 0.0F) {
+        discard;
+    }
+    color = vec4(result.rgb / result.a, result.a);
+}
+
+#else
+// Main function
+void main () {
+    // Ray in model space
+    vec3 near = near_pos.xyz / near_pos.w;
+    vec3 far = far_pos.xyz / far_pos.w;
+    vec3 dir = normalize(far - near);
+
+    // Ray in texture space with the t axis swapped
+    vec3 origin = (u_volume_mat * vec4(near, 1.0F)).stp;
+    vec3 tex_dir = (u_volume_mat * vec4(dir, 0.0F)).stp;
+    origin.t = 1.0F - origin.t;
+    tex_dir.t = -tex_dir.t;
+
+    // Intersect the ray with the drawn box of the texture
+    vec3 inv_dir = 1.0F / (tex_dir + vec3(equal(tex_dir, vec3(0.0F))) * 1e-7F);
+    vec3 t_0 = (u_clip_min - origin) * inv_dir;
+    vec3 t_1 = (u_clip_max - origin) * inv_dir;
+    vec3 t_min = min(t_0, t_1);
+    vec3 t_max = max(t_0, t_1);
+    float t_near = max(max(t_min.x, t_min.y), max(t_min.z, 0.0F));
+    float t_far = min(min(t_max.x, t_max.y), min(t_max.z, distance(near, far)));
+    if (t_near >= t_far) {
+        discard;
+    }
+
+    // Samples at whole steps from the near plane, adjacent bricks continue the same sequence
+    t_near = ceil(t_near / u_step) * u_step;
+
+#ifdef JITTER
+    // Offset the first sample to turn the banding into noise
+    t_near += jitterOffset() * u_step;
+#endif
+
+#if defined(MIP)
+    // Maximum intensity along the ray
+    float maximum = 0.0F;
+    for (float t = t_near; t < t_far; t += u_step) {
+        maximum = max(maximum, sampleVolume(origin + t * tex_dir));
+    }
+
+    // Map the maximum to the transfer function
+    color = texture(u_trans_func, maximum);
+#elif defined(MINIP)
+    // Minimum intensity along the ray
+    float minimum = 1.0F;
+    for (float t = t_near; t < t_far; t += u_step) {
+        minimum = min(minimum, sampleVolume(origin + t * tex_dir));
+    }
+
+    // Map the minimum to the transfer function
+    color = texture(u_trans_func, minimum);
+#elif defined(AVERAGE)
+    // Average intensity along the ray
+    float sum = 0.0F;
+    float count = 0.0F;
+    for (float t = t_near; t < t_far; t += u_step) {
+        sum += sampleVolume(origin + t * tex_dir);
+        count += 1.0F;
+    }
+
+    // Map the average to the transfer function
+    color = texture(u_trans_func, sum / max(count, 1.0F));
+#else
+    // Front to back emission absorption composition
+    vec3 light = -normalize(tex_dir / u_region_scale);
+    vec4 result = vec4(0.0F);
+    for (float t = t_near; (t < t_far) && (result.a < 0.99F); t += u_step) {
+        vec3 point = origin + t * tex_dir;
+        vec4 classified = correctOpacity(texture(u_trans_func, sampleVolume(point)));
+#ifdef SHADING
+        classified = shade(point, classified, light);
+#endif
+        result += (1.0F - result.a) * vec4(classified.rgb * classified.a, classified.a);
+    }
+
+    // Non premultiplied color for the blend function
+    if (result.a <= 0.0F) {
+        discard;
+    }
+    color = vec4(result.rgb / result.a, result.a);
+#endif
+}
+#endif
+
+#else
 // In variables
 in vec3 tex_coord;
+in vec3 light_dir;
 
 
 // Main function
 void main () {
+    // Only the drawn box of the texture
+    if (any(lessThan(tex_coord, u_clip_min)) || any(greaterThanEqual(tex_coord, u_clip_max))) {
+        discard;
+    }
+
+#if defined(MIP)
+    // The maximum is taken by the blend equation
+    float value = sampleVolume(tex_coord);
+    color = vec4(value);
+#else
     // Get the data from the texture and map to the transfer function
-    color = texture(u_trans_func, texture(u_tex, tex_coord).r);
-}
\ No newline at end of file
+    color = correctOpacity(texture(u_trans_func, sampleVolume(tex_coord)));
+#ifdef SHADING
+    color = shade(tex_coord, color, normalize(light_dir));
+#endif
+#endif
+}
+#endif
\ No newline at end of file
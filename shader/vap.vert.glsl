@@ -5,16 +5,40 @@ layout (location = 0) in vec2 l_quad;
 
 
 // Uniform variables
+uniform vec3 u_view_dir;
 uniform mat4 u_view_mat;
 uniform mat4 u_projection_mat;
 
 uniform mat4 u_model_mat;
 uniform mat4 u_volume_mat;
+uniform vec3 u_region_scale;
 uniform float u_slice;
 
 
+#ifdef RAY_CASTING
+// Out variables
+out vec4 near_pos;
+out vec4 far_pos;
+
+
+// Main function
+void main() {
+    // Screen filling quad
+    vec2 ndc = 2.0F * l_quad;
+
+    // Ray end points in model space, the perspective division is done per fragment
+    mat4 inverse_mat = inverse(u_projection_mat * u_view_mat * u_model_mat);
+    near_pos = inverse_mat * vec4(ndc, -1.0F, 1.0F);
+    far_pos = inverse_mat * vec4(ndc, 1.0F, 1.0F);
+
+    // Set the vertex position
+    gl_Position = vec4(ndc, 0.0F, 1.0F);
+}
+
+#else
 // Out variables
 out vec3 tex_coord;
+out vec3 light_dir;
 
 
 // Main function
@@ -26,6 +50,11 @@ void main() {
     tex_coord = (u_volume_mat * quad).stp;
     tex_coord.t = 1.0F - tex_coord.t;
 
+    // Head light direction in texture space of the whole grid
+    light_dir = (u_volume_mat * vec4(-u_view_dir, 0.0F)).stp / u_region_scale;
+    light_dir.t = -light_dir.t;
+
     // Set the vertex position
     gl_Position = u_projection_mat * u_view_mat * u_model_mat * quad;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,596 @@
+#include "benchmark.hpp"
+
+#include "../task/taskscheduler.hpp"
+
+#include <glm/geometric.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+
+// Private static methods
+
+// Get the steady time in seconds
+double Benchmark::now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Get the nearest rank percentile of the sorted samples
+double Benchmark::percentile(const std::vector<double> &sorted, const double &rank) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+
+    const std::size_t index = static_cast<std::size_t>(std::ceil(rank * static_cast<double>(sorted.size())));
+    return sorted[std::min(std::max(index, static_cast<std::size_t>(1U)), sorted.size()) - 1U];
+}
+
+// Get the peak resident memory of the process in kilobytes
+unsigned long long int Benchmark::getPeakMemory() {
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0U;
+    }
+
+    // Reported in bytes by macOS and in kilobytes elsewhere
+#if defined(__APPLE__)
+    return static_cast<unsigned long long int>(usage.ru_maxrss) / 1024U;
+#else
+    return static_cast<unsigned long long int>(usage.ru_maxrss);
+#endif
+#else
+    return 0U;
+#endif
+}
+
+// Escape a string for JSON
+std::string Benchmark::escape(const std::string &text) {
+    std::string escaped;
+    for (const char &c : text) {
+        if ((c == '"') || (c == '\\')) {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+// Open the hardware counter of the cache misses or references of the process and its new threads
+int Benchmark::openCounter(const bool &misses) {
+#if defined(__linux__)
+    // User space only, which needs the least privileges, the worker threads are inherited
+    struct perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = misses ? PERF_COUNT_HW_CACHE_MISSES : PERF_COUNT_HW_CACHE_REFERENCES;
+    attributes.disabled = 1;
+    attributes.inherit = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    const int counter = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    return counter;
+#else
+    static_cast<void>(misses);
+    return -1;
+#endif
+}
+
+// Read and close the hardware counter
+long long int Benchmark::closeCounter(const int &counter) {
+#if defined(__linux__)
+    if (counter < 0) {
+        return -1;
+    }
+    ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+    long long int count = -1;
+    if (read(counter, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) {
+        count = -1;
+    }
+    close(counter);
+    return count;
+#else
+    static_cast<void>(counter);
+    return -1;
+#endif
+}
+
+
+// Constructors
+
+// Benchmark constructor
+Benchmark::Benchmark() :
+    // Dataset
+    format(VolumeData::RAW8),
+    resolution(256U),
+    crop_offset(0U),
+    crop_size(0U),
+    stride(1U),
+    stride_filter(true),
+    overlay_offset(0.0F),
+
+    // Render settings
+    preset("linear"),
+    mode("raycasting"),
+    technique(Volume::RAY_CASTING),
+    composition(Volume::DVR),
+    shading(false),
+    accumulation(false),
+    filter(Volume::TRILINEAR),
+    isovalue(0.5F),
+    layout(VoxelStore::MORTON),
+
+    // Camera path and frames
+    path(new CameraPath("orbit")),
+    orthogonal(false),
+    frames(256U),
+    warmup(16U),
+    node(nullptr),
+
+    // Results
+    elapsed(0.0),
+    samples(0.0),
+    cache_references(-1),
+    cache_misses(-1) {}
+
+
+// Getters
+
+// Get the valid status of the settings
+bool Benchmark::isValid() const {
+    return !dataset.empty() && path->isValid() && (frames > 0U);
+}
+
+
+// Setters
+
+// Set the dataset
+void Benchmark::setDataset(const std::string &new_dataset, const VolumeData::Format &new_format, const glm::uvec3 &new_resolution) {
+    dataset = new_dataset;
+    format = new_format;
+    resolution = new_resolution;
+}
+
+// Set the transfer function preset
+void Benchmark::setPreset(const std::string &new_preset) {
+    preset = new_preset;
+}
+
+// Set the box of the grid read from the datasets
+void Benchmark::setCrop(const glm::uvec3 &new_offset, const glm::uvec3 &new_size) {
+    crop_offset = new_offset;
+    crop_size = new_size;
+}
+
+// Set the voxels of the grid per read voxel of the datasets
+void Benchmark::setStride(const glm::uvec3 &new_stride, const bool &new_filter) {
+    stride = new_stride;
+    stride_filter = new_filter;
+}
+
+// Add a dataset drawn with the dataset
+void Benchmark::addOverlay(const std::string &overlay) {
+    overlays.push_back(overlay);
+}
+
+// Set the world space offset of every overlay from the previous one
+void Benchmark::setOverlayOffset(const glm::vec3 &new_offset) {
+    overlay_offset = new_offset;
+}
+
+// Set the transfer function preset of the overlays
+void Benchmark::setOverlayPreset(const std::string &new_preset) {
+    overlay_preset = new_preset;
+}
+
+// Set the render mode
+bool Benchmark::setMode(const std::string &new_mode) {
+    // Split the options
+    std::vector<std::string> option;
+    std::istringstream stream(new_mode);
+    for (std::string token; std::getline(stream, token, '-');) {
+        option.push_back(token);
+    }
+
+    // The technique goes first
+    if (option.empty() || ((option[0] != "slicing") && (option[0] != "raycasting") && (option[0] != "isosurface") && (option[0] != "cpu") && (option[0] != "shearwarp") && (option[0] != "fourier"))) {
+        std::cerr << "error: unknown render mode `" << new_mode << "'" << std::endl;
+        return false;
+    }
+
+    // Parse the options without changing the current mode on errors
+    const Volume::Technique new_technique = option[0] == "slicing" ? Volume::SLICING : (option[0] == "raycasting" ? Volume::RAY_CASTING : (option[0] == "cpu" ? Volume::CPU_RAY_CASTING : (option[0] == "shearwarp" ? Volume::SHEAR_WARP : (option[0] == "fourier" ? Volume::FOURIER : Volume::ISOSURFACE))));
+    if ((new_technique == Volume::ISOSURFACE) && (option.size() > 1U)) {
+        std::cerr << "error: the isosurface render mode has no options in `" << new_mode << "'" << std::endl;
+        return false;
+    }
+    if ((new_technique == Volume::FOURIER) && (option.size() > 1U)) {
+        std::cerr << "error: the fourier render mode has no options in `" << new_mode << "'" << std::endl;
+        return false;
+    }
+
+    Volume::Composition new_composition = Volume::DVR;
+    bool new_shading = false;
+    bool new_accumulation = false;
+    Volume::Filter new_filter = Volume::TRILINEAR;
+    for (std::size_t i = 1U; i < option.size(); i++) {
+        if (option[i] == "mip") {
+            new_composition = Volume::MIP;
+        }
+        else if (option[i] == "minip") {
+            new_composition = Volume::MINIP;
+        }
+        else if (option[i] == "average") {
+            new_composition = Volume::AVERAGE;
+        }
+        else if (option[i] == "nearest") {
+            new_filter = Volume::NEAREST;
+        }
+        else if (option[i] == "tricubic") {
+            new_filter = Volume::TRICUBIC;
+        }
+        else if (option[i] == "shaded") {
+            new_shading = true;
+        }
+        else if (option[i] == "accumulate") {
+            new_accumulation = true;
+        }
+        else {
+            std::cerr << "error: unknown render mode option `" << option[i] << "' in `" << new_mode << "'" << std::endl;
+            return false;
+        }
+    }
+
+    if ((new_filter != Volume::TRILINEAR) && (new_technique != Volume::CPU_RAY_CASTING)) {
+        std::cerr << "error: only the cpu render mode has sampling filter options in `" << new_mode << "'" << std::endl;
+        return false;
+    }
+
+    mode = new_mode;
+    technique = new_technique;
+    composition = new_composition;
+    shading = new_shading;
+    accumulation = new_accumulation;
+    filter = new_filter;
+    return true;
+}
+
+// Set the data value of the isosurface mode
+void Benchmark::setIsovalue(const float &new_isovalue) {
+    isovalue = new_isovalue;
+}
+
+// Set the voxel layout of the CPU ray caster
+bool Benchmark::setLayout(const std::string &name) {
+    for (const VoxelStore::Layout candidate : {VoxelStore::LINEAR, VoxelStore::BRICKED, VoxelStore::MORTON}) {
+        if (name == VoxelStore::getLayoutName(candidate)) {
+            layout = candidate;
+            return true;
+        }
+    }
+
+    std::cerr << "error: unknown voxel layout `" << name << "'" << std::endl;
+    return false;
+}
+
+// Set the camera path
+bool Benchmark::setCameraPath(const std::string &name) {
+    delete path;
+    path = new CameraPath(name);
+    return path->isValid();
+}
+
+// Set the orthographic projection status of the camera
+void Benchmark::setOrthogonal(const bool &status) {
+    orthogonal = status;
+}
+
+// Set the number of measured frames
+void Benchmark::setFrames(const unsigned int &count) {
+    frames = count;
+}
+
+// Set the number of warm up frames
+void Benchmark::setWarmup(const unsigned int &count) {
+    warmup = count;
+}
+
+
+// Set the sort-last node
+void Benchmark::setNode(SortLastNode *const new_node) {
+    node = new_node;
+}
+
+
+// Methods
+
+// Load the dataset in the scene and render the measured frames
+bool Benchmark::run(Scene *const scene) {
+    // Check the settings
+    if (!isValid()) {
+        std::cerr << "error: the benchmark needs a dataset, a valid camera path and at least one frame" << std::endl;
+        return false;
+    }
+
+    // The partial images are composited with the over operator
+    if ((node != nullptr) && ((composition != Volume::DVR) || (technique == Volume::ISOSURFACE) || (technique == Volume::CPU_RAY_CASTING) || (technique == Volume::SHEAR_WARP) || (technique == Volume::FOURIER))) {
+        std::cerr << "error: the sort-last nodes only composite the emission absorption modes on the GPU" << std::endl;
+        return false;
+    }
+
+    // The overlays are sampled by the same rays
+    if (!overlays.empty() && ((node != nullptr) || (composition != Volume::DVR) || ((technique != Volume::RAY_CASTING) && (technique != Volume::CPU_RAY_CASTING)))) {
+        std::cerr << "error: the overlays are only drawn by the ray casting modes with the emission absorption model without sort-last nodes" << std::endl;
+        return false;
+    }
+
+    // The nodes read their own brick
+    const bool cropped = (crop_size.x > 0U) && (crop_size.y > 0U) && (crop_size.z > 0U);
+    if (cropped && (node != nullptr)) {
+        std::cerr << "error: the sort-last nodes cannot crop the dataset" << std::endl;
+        return false;
+    }
+
+    const glm::uvec3 crop_end = crop_offset + crop_size;
+    if (cropped && ((crop_end.x > resolution.x) || (crop_end.y > resolution.y) || (crop_end.z > resolution.z))) {
+        std::cerr << "error: the crop box is outside the grid of the dataset" << std::endl;
+        return false;
+    }
+
+    // Load the dataset, only the brick of the node if distributed or the crop box, downsampled by the stride
+    Volume *const volume = scene->getVolume();
+    if ((node != nullptr) && !node->assign(volume, resolution)) {
+        return false;
+    }
+    if (cropped) {
+        volume->setBrick(crop_offset, crop_size);
+    }
+    volume->setStride(stride, stride_filter);
+    volume->setPath(dataset, format, resolution.x, resolution.y, resolution.z);
+    if (!volume->isOpen()) {
+        std::cerr << "error: cannot open the dataset `" << dataset << "'" << std::endl;
+        return false;
+    }
+
+    // Apply the transfer function preset
+    if (!volume->getTransferFunction()->loadPreset(preset)) {
+        std::cerr << "error: unknown transfer function preset `" << preset << "'" << std::endl;
+        return false;
+    }
+
+    // Apply the render mode at full resolution
+    volume->setTechnique(technique);
+    volume->setComposition(composition);
+    volume->setShading(shading);
+    volume->setFilter(filter);
+    volume->setIsovalue(isovalue);
+    scene->setAccumulation(accumulation);
+    scene->setVolumeScale(1.0F);
+    scene->getCPURayCaster()->setLayout(layout);
+
+    // Load the overlays with their own transfer function, every one shifted from the previous one
+    for (std::size_t i = 0U; i < overlays.size(); i++) {
+        Volume *const overlay = scene->addVolume();
+        if (cropped) {
+            overlay->setBrick(crop_offset, crop_size);
+        }
+        overlay->setStride(stride, stride_filter);
+        overlay->setPath(overlays[i], format, resolution.x, resolution.y, resolution.z);
+        if (!overlay->isOpen()) {
+            std::cerr << "error: cannot open the overlay `" << overlays[i] << "'" << std::endl;
+            return false;
+        }
+
+        if (!overlay->getTransferFunction()->loadPreset(overlay_preset.empty() ? preset : overlay_preset)) {
+            std::cerr << "error: unknown transfer function preset `" << overlay_preset << "'" << std::endl;
+            return false;
+        }
+
+        overlay->setFilter(filter);
+        overlay->setPosition(overlay_offset * static_cast<float>(i + 1U));
+    }
+
+    // Warm up the program variants and caches at the first pose
+    Camera *const camera = scene->getCamera();
+    camera->reset();
+    camera->setOrthogonal(orthogonal);
+    path->apply(camera, 0.0);
+    for (unsigned int i = 0U; i < warmup; i++) {
+        if (!renderFrame(scene)) {
+            return false;
+        }
+    }
+
+    // Render the path waiting for every frame to finish, counting the cache misses if the hardware counters are available
+    frame_times.clear();
+    frame_times.reserve(frames);
+    samples = 0.0;
+    const int reference_counter = Benchmark::openCounter(false);
+    const int miss_counter = Benchmark::openCounter(true);
+    const double start = Benchmark::now();
+    for (unsigned int i = 0U; i < frames; i++) {
+        path->apply(camera, frames > 1U ? static_cast<double>(i) / static_cast<double>(frames - 1U) : 0.0);
+
+        const double frame_start = Benchmark::now();
+        if (!renderFrame(scene)) {
+            return false;
+        }
+        frame_times.push_back((Benchmark::now() - frame_start) * 1000.0);
+
+        // Nominal samples, every pixel of the pass along a full diagonal of the grid at the frame step, all the nodes draw the full resolution
+        if (technique == Volume::ISOSURFACE) {
+            continue;
+        }
+        const glm::vec2 pass = scene->getResolution() * (node != nullptr ? 1.0F : scene->getVolumeScale());
+        samples += static_cast<double>(pass.x) * static_cast<double>(pass.y) * static_cast<double>(glm::length(glm::vec3(volume->getGrid())) / volume->getStepScale());
+    }
+    elapsed = Benchmark::now() - start;
+    cache_references = Benchmark::closeCounter(reference_counter);
+    cache_misses = Benchmark::closeCounter(miss_counter);
+    if ((cache_references < 0) || (cache_misses < 0)) {
+        std::cout << "info: the hardware cache counters are not available" << std::endl;
+    }
+
+    // Read the last GPU timings
+    scene->getProfiler()->collect();
+
+    if (node != nullptr) {
+        std::cout << "info: sort-last node " << node->getRank() << " composited in " << node->getCompositeTime() << " ms per frame" << std::endl;
+    }
+    std::cout << "info: benchmark `" << mode << "' along `" << path->getName() << "' rendered " << frames << " frames at " << (static_cast<double>(frames) / elapsed) << " fps" << std::endl;
+    return true;
+}
+
+// Render a frame and wait for it
+bool Benchmark::renderFrame(Scene *const scene) {
+    if (node != nullptr) {
+        return node->renderFrame(scene);
+    }
+
+    scene->renderFrame();
+    glFinish();
+    return true;
+}
+
+// Write the report of the last run as JSON
+bool Benchmark::write(const std::string &report_path, Scene *const scene) const {
+    // Open the report file
+    std::ofstream file(report_path, std::ofstream::out | std::ofstream::trunc);
+    if (!file.is_open()) {
+        std::cerr << "error: cannot open the benchmark report `" << report_path << "'" << std::endl;
+        return false;
+    }
+
+    // Frame time distribution
+    std::vector<double> sorted = frame_times;
+    std::sort(sorted.begin(), sorted.end());
+    const double mean = sorted.empty() ? 0.0 : std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+    const double seconds = elapsed > 0.0 ? elapsed : 1.0;
+
+    // Settings
+    const glm::vec2 size = scene->getResolution();
+    file << std::fixed << std::setprecision(4);
+    file << "{\n";
+    file << "  \"dataset\": \"" << Benchmark::escape(dataset) << "\",\n";
+    file << "  \"volume\": [" << resolution.x << ", " << resolution.y << ", " << resolution.z << "],\n";
+    if ((crop_size.x > 0U) && (crop_size.y > 0U) && (crop_size.z > 0U)) {
+        file << "  \"crop\": [" << crop_offset.x << ", " << crop_offset.y << ", " << crop_offset.z << ", " << crop_size.x << ", " << crop_size.y << ", " << crop_size.z << "],\n";
+    }
+    if (stride != glm::uvec3(1U)) {
+        file << "  \"stride\": [" << stride.x << ", " << stride.y << ", " << stride.z << "],\n";
+        file << "  \"stride_filter\": " << (stride_filter ? "true" : "false") << ",\n";
+    }
+    if (!overlays.empty()) {
+        file << "  \"overlays\": [";
+        for (std::size_t i = 0U; i < overlays.size(); i++) {
+            file << (i > 0U ? ", \"" : "\"") << Benchmark::escape(overlays[i]) << '"';
+        }
+        file << "],\n";
+    }
+    file << "  \"preset\": \"" << Benchmark::escape(preset) << "\",\n";
+    file << "  \"mode\": \"" << Benchmark::escape(mode) << "\",\n";
+    file << "  \"path\": \"" << Benchmark::escape(path->getName()) << "\",\n";
+    file << "  \"orthogonal\": " << (orthogonal ? "true" : "false") << ",\n";
+    file << "  \"resolution\": [" << static_cast<int>(size.x) << ", " << static_cast<int>(size.y) << "],\n";
+    file << "  \"renderer\": \"" << Benchmark::escape(reinterpret_cast<const char *>(Scene::getOpenGLRenderer())) << "\",\n";
+    file << "  \"frames\": " << frame_times.size() << ",\n";
+    file << "  \"warmup\": " << warmup << ",\n";
+    if (node != nullptr) {
+        file << "  \"nodes\": " << node->getCount() << ",\n";
+    }
+
+    // Results
+    file << "  \"seconds\": " << elapsed << ",\n";
+    file << "  \"fps\": " << (static_cast<double>(frame_times.size()) / seconds) << ",\n";
+    file << "  \"frame_ms\": {\"mean\": " << mean << ", \"min\": " << (sorted.empty() ? 0.0 : sorted.front()) << ", \"p50\": " << Benchmark::percentile(sorted, 0.50) << ", \"p95\": " << Benchmark::percentile(sorted, 0.95) << ", \"p99\": " << Benchmark::percentile(sorted, 0.99) << ", \"max\": " << (sorted.empty() ? 0.0 : sorted.back()) << "},\n";
+    file << "  \"samples_per_second\": " << std::setprecision(0) << (samples / seconds) << ",\n";
+    file << "  \"peak_memory_kb\": " << Benchmark::getPeakMemory() << ",\n";
+    if ((cache_references >= 0) && (cache_misses >= 0)) {
+        file << "  \"cache\": {\"references\": " << cache_references << ", \"misses\": " << cache_misses << ", \"miss_rate\": " << std::setprecision(4) << (cache_references > 0 ? static_cast<double>(cache_misses) / static_cast<double>(cache_references) : 0.0) << "},\n";
+    }
+    else {
+        file << "  \"cache\": null,\n";
+    }
+    if (technique == Volume::ISOSURFACE) {
+        const Isosurface *const isosurface = scene->getIsosurface();
+        file << std::setprecision(4) << "  \"isosurface\": {\"isovalue\": " << isovalue << ", \"triangles\": " << isosurface->getTriangles() << ", \"vertices\": " << isosurface->getVertices() << ", \"extract_ms\": " << isosurface->getExtractionTime() << "},\n";
+    }
+    if (technique == Volume::CPU_RAY_CASTING) {
+        const RayCaster *const ray_caster = scene->getCPURayCaster();
+        file << "  \"cpu\": {\"threads\": " << ray_caster->getThreads() << ", \"volumes\": " << ray_caster->getDrawnLayers() << ", \"axis_aligned\": " << (ray_caster->isAxisAligned() ? "true" : "false") << ", \"layout\": \"" << VoxelStore::getLayoutName(ray_caster->getLayout()) << "\", \"filter\": \"" << (filter == Volume::NEAREST ? "nearest" : (filter == Volume::TRILINEAR ? "trilinear" : "tricubic")) << "\"},\n";
+    }
+    if ((technique == Volume::SHEAR_WARP) && (composition == Volume::DVR)) {
+        const ShearWarp *const shear_warp = scene->getShearWarp();
+        const glm::uvec2 intermediate = shear_warp->getIntermediateResolution();
+        file << std::setprecision(4) << "  \"shear_warp\": {\"threads\": " << shear_warp->getThreads() << ", \"principal_axis\": " << shear_warp->getPrincipalAxis() << ", \"intermediate\": [" << intermediate.x << ", " << intermediate.y << "], \"encoded_voxels\": " << shear_warp->getEncodedVoxels() << ", \"classify_ms\": " << shear_warp->getClassificationTime() << "},\n";
+    }
+    if (technique == Volume::FOURIER) {
+        const FourierRenderer *const fourier_renderer = scene->getFourierRenderer();
+        file << std::setprecision(4) << "  \"fourier\": {\"threads\": " << fourier_renderer->getThreads() << ", \"side\": " << fourier_renderer->getSide() << ", \"transform_ms\": " << fourier_renderer->getTransformTime() << "},\n";
+    }
+    if (node != nullptr) {
+        file << std::setprecision(4) << "  \"composite_ms\": " << node->getCompositeTime() << ",\n";
+        file << "  \"sent_bytes\": " << node->getSentBytes() << ",\n";
+    }
+
+    // Statistics of the scheduler tasks since the start
+    file << std::setprecision(4) << "  \"tasks\": {";
+    bool first = true;
+    for (const std::pair<const std::string, TaskScheduler::Statistics> &entry : TaskScheduler::getActive()->getStatistics()) {
+        const TaskScheduler::Statistics &task = entry.second;
+        file << (first ? "\n" : ",\n") << "    \"" << Benchmark::escape(entry.first) << "\": {\"tasks\": " << task.tasks << ", \"cancelled\": " << task.cancelled << ", \"run_ms\": " << task.run_ms << ", \"mean_wait_ms\": " << (task.tasks > 0U ? task.wait_ms / static_cast<double>(task.tasks) : 0.0) << ", \"max_wait_ms\": " << task.max_wait_ms << '}';
+        first = false;
+    }
+    file << (first ? "},\n" : "\n  },\n");
+
+    // Rolling phase percentiles of the last frames
+    const Profiler *const profiler = scene->getProfiler();
+    file << std::setprecision(4) << "  \"phases\": {";
+    first = true;
+    for (const std::string &phase : profiler->getPhases()) {
+        const Profiler::Statistics cpu = profiler->getCPUStatistics(phase);
+        const Profiler::Statistics gpu = profiler->getGPUStatistics(phase);
+        file << (first ? "\n" : ",\n") << "    \"" << phase << "\": {\"cpu_p50\": " << cpu.p50 << ", \"cpu_p95\": " << cpu.p95 << ", \"cpu_p99\": " << cpu.p99;
+        if (gpu.p50 >= 0.0) {
+            file << ", \"gpu_p50\": " << gpu.p50 << ", \"gpu_p95\": " << gpu.p95 << ", \"gpu_p99\": " << gpu.p99;
+        }
+        file << '}';
+        first = false;
+    }
+    file << (first ? "}\n" : "\n  }\n") << "}\n";
+
+    std::cout << "info: benchmark report written to `" << report_path << "'" << std::endl;
+    return true;
+}
+
+
+// Destructor
+
+// Benchmark destructor
+Benchmark::~Benchmark() {
+    delete path;
+}
\ No newline at end of file
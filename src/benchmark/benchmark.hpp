@@ -0,0 +1,222 @@
+#ifndef __BENCHMARK_HPP_
+#define __BENCHMARK_HPP_
+
+#include "camerapath.hpp"
+#include "../scene/scene.hpp"
+#include "../volume/volume.hpp"
+#include "../distributed/sortlastnode.hpp"
+#include "../cpu/voxelstore.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <string>
+
+#include <vector>
+
+
+/** Headless benchmark rendering a dataset along a camera path and reporting the timing as JSON */
+class Benchmark {
+    private:
+        // Attributes
+
+        /** Dataset path */
+        std::string dataset;
+
+        /** Dataset format */
+        VolumeData::Format format;
+
+        /** Dataset resolution, needed by the RAW formats */
+        glm::uvec3 resolution;
+
+        /** Offset of the read box of the datasets in their grid */
+        glm::uvec3 crop_offset;
+
+        /** Size of the read box of the datasets, zero for the whole grid */
+        glm::uvec3 crop_size;
+
+        /** Voxels of the grid per read voxel along every axis */
+        glm::uvec3 stride;
+
+        /** Average the voxels of every stride box instead of taking the middle one */
+        bool stride_filter;
+
+        /** Datasets drawn with the dataset by the multi-volume ray casting, of its format and resolution */
+        std::vector<std::string> overlays;
+
+        /** World space offset of every overlay from the previous one */
+        glm::vec3 overlay_offset;
+
+        /** Transfer function preset of the overlays, the dataset preset if empty */
+        std::string overlay_preset;
+
+
+        /** Transfer function preset */
+        std::string preset;
+
+        /** Render mode name */
+        std::string mode;
+
+        /** Rendering technique of the mode */
+        Volume::Technique technique;
+
+        /** Composition of the mode */
+        Volume::Composition composition;
+
+        /** Shading status of the mode */
+        bool shading;
+
+        /** Accumulation status of the mode */
+        bool accumulation;
+
+        /** Sampling filter of the mode */
+        Volume::Filter filter;
+
+        /** Data value of the isosurface mode */
+        float isovalue;
+
+        /** Voxel layout of the CPU ray caster */
+        VoxelStore::Layout layout;
+
+
+        /** Camera path */
+        CameraPath *path;
+
+        /** Orthographic projection status of the camera */
+        bool orthogonal;
+
+        /** Measured frames */
+        unsigned int frames;
+
+        /** Frames rendered before measuring at the first pose */
+        unsigned int warmup;
+
+        /** Sort-last node drawing a brick of the dataset, null to draw the whole dataset */
+        SortLastNode *node;
+
+
+        /** Measured frame times in milliseconds */
+        std::vector<double> frame_times;
+
+        /** Measured time in seconds */
+        double elapsed;
+
+        /** Estimated volume samples of the measured frames */
+        double samples;
+
+        /** Hardware cache references of the measured frames, negative if they were not counted */
+        long long int cache_references;
+
+        /** Hardware cache misses of the measured frames, negative if they were not counted */
+        long long int cache_misses;
+
+
+        // Constructors
+
+        /** Disable the default copy constructor */
+        Benchmark(const Benchmark &) = delete;
+
+        /** Disable the assignation operator */
+        Benchmark &operator=(const Benchmark &) = delete;
+
+
+        // Static methods
+
+        /** Get the steady time in seconds */
+        static double now();
+
+        /** Get the nearest rank percentile of the sorted samples */
+        static double percentile(const std::vector<double> &sorted, const double &rank);
+
+        /** Get the peak resident memory of the process in kilobytes, zero if it is unknown */
+        static unsigned long long int getPeakMemory();
+
+        /** Escape a string for JSON */
+        static std::string escape(const std::string &text);
+
+        /** Open the hardware counter of the cache misses or references of the process and its new threads, negative if it is not available */
+        static int openCounter(const bool &misses);
+
+        /** Read and close the hardware counter, negative if it is not available */
+        static long long int closeCounter(const int &counter);
+
+
+    public:
+        // Constructors
+
+        /** Benchmark constructor with the orbit path and the linear preset */
+        Benchmark();
+
+
+        // Getters
+
+        /** Get the valid status of the settings */
+        bool isValid() const;
+
+
+        // Setters
+
+        /** Set the dataset */
+        void setDataset(const std::string &new_dataset, const VolumeData::Format &new_format, const glm::uvec3 &new_resolution);
+
+        /** Set the transfer function preset */
+        void setPreset(const std::string &new_preset);
+
+        /** Set the box of the grid read from the datasets, the whole grid if the size is zero */
+        void setCrop(const glm::uvec3 &new_offset, const glm::uvec3 &new_size);
+
+        /** Set the voxels of the grid per read voxel of the datasets, averaged by a box filter or the middle one of every box */
+        void setStride(const glm::uvec3 &new_stride, const bool &new_filter);
+
+        /** Add a dataset drawn with the dataset by the ray casting modes with the emission absorption model, of the same format and resolution */
+        void addOverlay(const std::string &overlay);
+
+        /** Set the world space offset of every overlay from the previous one */
+        void setOverlayOffset(const glm::vec3 &new_offset);
+
+        /** Set the transfer function preset of the overlays */
+        void setOverlayPreset(const std::string &new_preset);
+
+        /** Set the render mode, `slicing', `raycasting', `cpu' or `shearwarp' optionally followed by `-mip', `-minip', `-average', `-nearest', `-tricubic', `-shaded' and `-accumulate', or `isosurface' or `fourier', returns false if it is unknown */
+        bool setMode(const std::string &new_mode);
+
+        /** Set the data value of the isosurface mode */
+        void setIsovalue(const float &new_isovalue);
+
+        /** Set the voxel layout of the CPU ray caster, `linear', `bricked' or `morton', returns false if it is unknown */
+        bool setLayout(const std::string &name);
+
+        /** Set the camera path, `orbit', `zoom', `fly', `axis-x', `axis-y', `axis-z' or a keyframes file, returns false if it is not valid */
+        bool setCameraPath(const std::string &name);
+
+        /** Set the orthographic projection status of the camera */
+        void setOrthogonal(const bool &status);
+
+        /** Set the number of measured frames */
+        void setFrames(const unsigned int &count);
+
+        /** Set the number of warm up frames */
+        void setWarmup(const unsigned int &count);
+
+        /** Set the sort-last node drawing a brick of the dataset, null to draw the whole dataset, it is not owned */
+        void setNode(SortLastNode *const new_node);
+
+
+        // Methods
+
+        /** Load the dataset, or the brick of the node, in the scene and render the measured frames */
+        bool run(Scene *const scene);
+
+        /** Render a frame and wait for it, composited with the other nodes if there is a node */
+        bool renderFrame(Scene *const scene);
+
+        /** Write the report of the last run as JSON */
+        bool write(const std::string &report_path, Scene *const scene) const;
+
+
+        // Destructor
+
+        /** Benchmark destructor */
+        virtual ~Benchmark();
+};
+
+#endif // __BENCHMARK_HPP_
\ No newline at end of file
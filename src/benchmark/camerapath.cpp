@@ -0,0 +1,185 @@
+#include "camerapath.hpp"
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+#include <algorithm>
+#include <cmath>
+
+
+// Private methods
+
+// Read the keyframes file
+bool CameraPath::read(const std::string &path) {
+    // Open the file
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "error: cannot open the camera path `" << path << "'" << std::endl;
+        return false;
+    }
+
+    // Read a pose per line
+    std::string line;
+    for (unsigned int number = 1U; std::getline(file, line); number++) {
+        // Skip comments and empty lines
+        const std::size_t start = line.find_first_not_of(" \t\r");
+        if ((start == std::string::npos) || (line[start] == '#')) {
+            continue;
+        }
+
+        // Parse the pose
+        CameraPath::Keyframe keyframe;
+        std::istringstream stream(line);
+        if (!(stream >> keyframe.position.x >> keyframe.position.y >> keyframe.position.z >> keyframe.direction.x >> keyframe.direction.y >> keyframe.direction.z >> keyframe.fov)) {
+            std::cerr << "error: invalid camera pose at `" << path << "' line " << number << std::endl;
+            return false;
+        }
+
+        keyframes.push_back(keyframe);
+    }
+
+    // A path needs at least a pose
+    if (keyframes.empty()) {
+        std::cerr << "error: the camera path `" << path << "' has no poses" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Get the pose at the normalized time
+CameraPath::Keyframe CameraPath::getKeyframe(const double &time) const {
+    const float t = glm::clamp(static_cast<float>(time), 0.0F, 1.0F);
+    const float angle = glm::two_pi<float>() * t;
+    CameraPath::Keyframe keyframe;
+
+    switch (type) {
+        // Full turn around the vertical axis with a gentle elevation wave
+        case CameraPath::ORBIT:
+            keyframe.position = glm::vec3(2.0F * std::sin(angle), 0.5F * std::sin(2.0F * angle), 2.0F * std::cos(angle));
+            keyframe.direction = -keyframe.position;
+            keyframe.fov = 30.0F;
+            break;
+
+        // From wide to narrow and back from the default position
+        case CameraPath::ZOOM:
+            keyframe.position = glm::vec3(0.0F, 0.0F, 2.0F);
+            keyframe.direction = glm::vec3(0.0F, 0.0F, -1.0F);
+            keyframe.fov = 35.0F + 25.0F * std::cos(angle);
+            break;
+
+        // From the front to the back crossing the volume slightly off center
+        case CameraPath::FLY_THROUGH:
+            keyframe.position = glm::vec3(0.1F, 0.05F, 2.0F - 4.0F * t);
+            keyframe.direction = glm::vec3(0.0F, 0.0F, -1.0F);
+            keyframe.fov = 45.0F;
+            break;
+
+        // From the positive side of the axis toward the volume center, slightly tilted to keep the up vector defined
+        case CameraPath::AXIS_X:
+        case CameraPath::AXIS_Y:
+        case CameraPath::AXIS_Z: {
+            const int axis = static_cast<int>(type - CameraPath::AXIS_X);
+            keyframe.position = glm::vec3(0.0F);
+            keyframe.position[axis] = 2.0F;
+            keyframe.position[(axis + 1) % 3] = 0.02F;
+            keyframe.direction = -keyframe.position;
+            keyframe.fov = 30.0F;
+            break;
+        }
+
+        // Linear interpolation of the neighbour keyframes
+        case CameraPath::RECORDED: {
+            const float position = t * static_cast<float>(keyframes.size() - 1U);
+            const std::size_t index = std::min(static_cast<std::size_t>(position), keyframes.size() - 1U);
+            const std::size_t next = std::min(index + 1U, keyframes.size() - 1U);
+            const float factor = position - static_cast<float>(index);
+            keyframe.position = glm::mix(keyframes[index].position, keyframes[next].position, factor);
+            keyframe.direction = glm::mix(keyframes[index].direction, keyframes[next].direction, factor);
+            keyframe.fov = glm::mix(keyframes[index].fov, keyframes[next].fov, factor);
+            break;
+        }
+    }
+
+    return keyframe;
+}
+
+
+// Constructors
+
+// Camera path constructor
+CameraPath::CameraPath(const std::string &path_name) :
+    name(path_name),
+    type(CameraPath::RECORDED),
+    valid(true) {
+    // Procedural paths
+    if (name == "orbit") {
+        type = CameraPath::ORBIT;
+    }
+    else if (name == "zoom") {
+        type = CameraPath::ZOOM;
+    }
+    else if (name == "fly") {
+        type = CameraPath::FLY_THROUGH;
+    }
+    else if (name == "axis-x") {
+        type = CameraPath::AXIS_X;
+    }
+    else if (name == "axis-y") {
+        type = CameraPath::AXIS_Y;
+    }
+    else if (name == "axis-z") {
+        type = CameraPath::AXIS_Z;
+    }
+
+    // Recorded path
+    else {
+        valid = read(name);
+    }
+}
+
+
+// Getters
+
+// Get the valid status
+bool CameraPath::isValid() const {
+    return valid;
+}
+
+// Get the path name
+std::string CameraPath::getName() const {
+    return name;
+}
+
+// Get the path type
+CameraPath::Type CameraPath::getType() const {
+    return type;
+}
+
+
+// Methods
+
+// Move the camera to the pose at the normalized time
+void CameraPath::apply(Camera *const camera, const double &time) const {
+    // Check the path
+    if (!valid) {
+        return;
+    }
+
+    // Set the pose
+    const CameraPath::Keyframe keyframe = getKeyframe(time);
+    camera->setPosition(keyframe.position);
+    camera->setDirection(keyframe.direction);
+    camera->setFOV(keyframe.fov);
+}
+
+
+// Destructor
+
+// Camera path destructor
+CameraPath::~CameraPath() {}
\ No newline at end of file
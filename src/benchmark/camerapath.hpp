@@ -0,0 +1,126 @@
+#ifndef __CAMERA_PATH_HPP_
+#define __CAMERA_PATH_HPP_
+
+#include "../scene/camera.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <string>
+
+#include <vector>
+
+
+/** Reproducible camera path, procedural or recorded as keyframes, sampled by the normalized time */
+class CameraPath {
+    public:
+        // Enumerations
+
+        /** Path types */
+        enum Type {
+            /** Orbit around the volume center */
+            ORBIT,
+
+            /** Field of view sweep from a fixed position */
+            ZOOM,
+
+            /** Straight flight through the volume */
+            FLY_THROUGH,
+
+            /** Fixed view along the x axis */
+            AXIS_X,
+
+            /** Fixed view along the y axis */
+            AXIS_Y,
+
+            /** Fixed view along the z axis */
+            AXIS_Z,
+
+            /** Keyframes read from a file */
+            RECORDED
+        };
+
+
+    private:
+        // Structures
+
+        /** Camera pose */
+        struct Keyframe {
+            /** Position */
+            glm::vec3 position;
+
+            /** Look direction */
+            glm::vec3 direction;
+
+            /** Field of view in degrees */
+            float fov;
+        };
+
+
+        // Attributes
+
+        /** Path name, the procedural type or the keyframes file path */
+        std::string name;
+
+        /** Path type */
+        CameraPath::Type type;
+
+        /** Recorded keyframes */
+        std::vector<CameraPath::Keyframe> keyframes;
+
+        /** Valid status */
+        bool valid;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        CameraPath() = delete;
+
+        /** Disable the default copy constructor */
+        CameraPath(const CameraPath &) = delete;
+
+        /** Disable the assignation operator */
+        CameraPath &operator=(const CameraPath &) = delete;
+
+
+        // Methods
+
+        /** Read the keyframes file, one `px py pz dx dy dz fov' pose per line and `#' comments */
+        bool read(const std::string &path);
+
+        /** Get the pose at the normalized time */
+        CameraPath::Keyframe getKeyframe(const double &time) const;
+
+
+    public:
+        // Constructors
+
+        /** Camera path constructor, `orbit', `zoom', `fly', `axis-x', `axis-y', `axis-z' or the path of a keyframes file */
+        CameraPath(const std::string &path_name);
+
+
+        // Getters
+
+        /** Get the valid status */
+        bool isValid() const;
+
+        /** Get the path name */
+        std::string getName() const;
+
+        /** Get the path type */
+        CameraPath::Type getType() const;
+
+
+        // Methods
+
+        /** Move the camera to the pose at the normalized time, from zero to one */
+        void apply(Camera *const camera, const double &time) const;
+
+
+        // Destructor
+
+        /** Camera path destructor */
+        virtual ~CameraPath();
+};
+
+#endif // __CAMERA_PATH_HPP_
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "cpurenderer.hpp"
+
+#include "../task/taskscheduler.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+
+
+// Protected constructors
+
+// CPU renderer constructor
+CPURenderer::CPURenderer(const unsigned int &threads) :
+    threads(threads) {}
+
+
+// Protected methods
+
+// Run the task over the range in chunks of the grain size as interactive tasks of the scheduler
+void CPURenderer::parallel(const std::size_t &count, const std::size_t &grain, const std::function<void(const std::size_t &, const std::size_t &)> &task) const {
+    TaskScheduler::getActive()->parallel(count, grain, task, TaskScheduler::INTERACTIVE, "cpu render", threads);
+}
+
+
+// Protected static methods
+
+// Get the ray through the pixel center in texture space with the t axis swapped
+float CPURenderer::getRay(const glm::mat4 &inverse_mat, const glm::mat4 &volume_mat, const GLsizei &x, const GLsizei &y, const GLsizei &width, const GLsizei &height, glm::vec3 &origin, glm::vec3 &direction) {
+    // Ray end points in model space
+    const float ndc_x = 2.0F * (static_cast<float>(x) + 0.5F) / static_cast<float>(width) - 1.0F;
+    const float ndc_y = 2.0F * (static_cast<float>(y) + 0.5F) / static_cast<float>(height) - 1.0F;
+    const glm::vec4 near_pos = inverse_mat * glm::vec4(ndc_x, ndc_y, -1.0F, 1.0F);
+    const glm::vec4 far_pos = inverse_mat * glm::vec4(ndc_x, ndc_y, 1.0F, 1.0F);
+    const glm::vec3 near = glm::vec3(near_pos) / near_pos.w;
+    const glm::vec3 far = glm::vec3(far_pos) / far_pos.w;
+
+    // Ray in texture space
+    origin = glm::vec3(volume_mat * glm::vec4(near, 1.0F));
+    direction = glm::vec3(volume_mat * glm::vec4(glm::normalize(far - near), 0.0F));
+    origin.y = 1.0F - origin.y;
+    direction.y = -direction.y;
+    return glm::distance(near, far);
+}
+
+
+// Get the transfer function color of the data value with linear interpolation
+glm::vec4 CPURenderer::classify(const std::vector<glm::vec4> &table, const float &value) {
+    const float position = std::min(std::max(value * 256.0F - 0.5F, 0.0F), 255.0F);
+    const std::size_t index = static_cast<std::size_t>(position);
+    const std::size_t next = std::min(index + 1U, static_cast<std::size_t>(255U));
+    return table[index] + (table[next] - table[index]) * (position - static_cast<float>(index));
+}
+
+// Store the premultiplied color as bytes
+void CPURenderer::store(const glm::vec4 &color, GLubyte *pixel) {
+    for (int i = 0; i < 4; i++) {
+        pixel[i] = static_cast<GLubyte>(std::min(std::max(color[i], 0.0F), 1.0F) * 255.0F + 0.5F);
+    }
+}
+
+// Getters
+
+// Get the number of threads of the parallel loops
+unsigned int CPURenderer::getThreads() const {
+    const unsigned int available = TaskScheduler::getActive()->getThreads();
+    return threads > 0U ? std::min(threads, available) : available;
+}
+
+
+// Destructor
+
+// CPU renderer destructor
+CPURenderer::~CPURenderer() {}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef __CPU_RENDERER_HPP_
+#define __CPU_RENDERER_HPP_
+
+#include "../volume/volume.hpp"
+#include "../scene/camera.hpp"
+
+#include "../glad/glad.h"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <functional>
+#include <vector>
+
+
+/** Volume renderer running on the CPU threads, the image is uploaded to the volume pass of the scene */
+class CPURenderer {
+    private:
+        // Attributes
+
+        /** Maximum number of threads, zero for all the threads of the task scheduler */
+        unsigned int threads;
+
+
+        // Constructors
+
+        /** Disable the default copy constructor */
+        CPURenderer(const CPURenderer &) = delete;
+
+        /** Disable the assignation operator */
+        CPURenderer &operator=(const CPURenderer &) = delete;
+
+
+    protected:
+        // Constructors
+
+        /** CPU renderer constructor, the threads default to all the threads of the task scheduler */
+        CPURenderer(const unsigned int &threads = 0U);
+
+
+        // Methods
+
+        /** Run the task over the range in chunks of the grain size as interactive tasks of the scheduler, the threads take the next chunk until all of them are done and this thread takes chunks too */
+        void parallel(const std::size_t &count, const std::size_t &grain, const std::function<void(const std::size_t &, const std::size_t &)> &task) const;
+
+
+        // Static methods
+
+        /** Get the ray through the pixel center in texture space with the t axis swapped, as the ray casting shaders do, returns the distance between the clipping planes */
+        static float getRay(const glm::mat4 &inverse_mat, const glm::mat4 &volume_mat, const GLsizei &x, const GLsizei &y, const GLsizei &width, const GLsizei &height, glm::vec3 &origin, glm::vec3 &direction);
+
+        /** Get the transfer function color of the data value with linear interpolation */
+        static glm::vec4 classify(const std::vector<glm::vec4> &table, const float &value);
+
+        /** Store the premultiplied color as bytes */
+        static void store(const glm::vec4 &color, GLubyte *pixel);
+
+
+    public:
+        // Getters
+
+        /** Get the number of threads of the parallel loops */
+        unsigned int getThreads() const;
+
+
+        // Methods
+
+        /** Render the volume seen by the camera into the premultiplied RGBA image, the rows from bottom to top */
+        virtual void render(const Volume *const volume, const Camera *const camera, const GLsizei &width, const GLsizei &height, std::vector<GLubyte> &image) = 0;
+
+
+        // Destructor
+
+        /** CPU renderer destructor */
+        virtual ~CPURenderer();
+};
+
+#endif // __CPU_RENDERER_HPP_
\ No newline at end of file
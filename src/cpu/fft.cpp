@@ -0,0 +1,86 @@
+#include "fft.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <cmath>
+#include <utility>
+
+
+// Constructors
+
+// FFT constructor
+FFT::FFT(const std::size_t &new_size) :
+    size(new_size),
+    reversed(new_size),
+    twiddle(new_size / 2U) {
+    // Bit reversed indices
+    std::size_t bits = 0U;
+    while ((static_cast<std::size_t>(1U) << bits) < size) {
+        bits++;
+    }
+    for (std::size_t i = 0U; i < size; i++) {
+        std::size_t reverse = 0U;
+        for (std::size_t b = 0U; b < bits; b++) {
+            reverse |= ((i >> b) & 1U) << (bits - 1U - b);
+        }
+        reversed[i] = reverse;
+    }
+
+    // Roots of unity in double precision
+    for (std::size_t i = 0U; i < twiddle.size(); i++) {
+        const double angle = -glm::two_pi<double>() * static_cast<double>(i) / static_cast<double>(size);
+        twiddle[i] = std::complex<float>(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+}
+
+
+// Getters
+
+// Get the number of samples
+std::size_t FFT::getSize() const {
+    return size;
+}
+
+
+// Methods
+
+// Transform the contiguous samples in place
+void FFT::transform(std::complex<float> *data, const bool &inverse) const {
+    // Bit reversal permutation
+    for (std::size_t i = 0U; i < size; i++) {
+        if (i < reversed[i]) {
+            std::swap(data[i], data[reversed[i]]);
+        }
+    }
+
+    // Butterflies of every stage, the inverse takes the conjugate twiddles
+    for (std::size_t half = 1U; half < size; half <<= 1U) {
+        const std::size_t step = size / (2U * half);
+        for (std::size_t start = 0U; start < size; start += 2U * half) {
+            for (std::size_t i = 0U; i < half; i++) {
+                const std::complex<float> factor = inverse ? std::conj(twiddle[i * step]) : twiddle[i * step];
+                const std::complex<float> odd = factor * data[start + i + half];
+                data[start + i + half] = data[start + i] - odd;
+                data[start + i] += odd;
+            }
+        }
+    }
+}
+
+
+// Destructor
+
+// FFT destructor
+FFT::~FFT() {}
+
+
+// Static methods
+
+// Get the smallest power of two not less than the value
+std::size_t FFT::getPowerOfTwo(const std::size_t &value) {
+    std::size_t power = 1U;
+    while (power < value) {
+        power <<= 1U;
+    }
+    return power;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef __FFT_HPP_
+#define __FFT_HPP_
+
+#include <complex>
+#include <vector>
+
+
+/** Radix-2 fast Fourier transform of a power of two size, with the bit reversal and twiddle tables precomputed */
+class FFT {
+    private:
+        // Attributes
+
+        /** Number of samples */
+        std::size_t size;
+
+        /** Bit reversed index of every sample */
+        std::vector<std::size_t> reversed;
+
+        /** Twiddle factors of the forward transform for the first half of the samples */
+        std::vector<std::complex<float> > twiddle;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        FFT() = delete;
+
+        /** Disable the default copy constructor */
+        FFT(const FFT &) = delete;
+
+        /** Disable the assignation operator */
+        FFT &operator=(const FFT &) = delete;
+
+
+    public:
+        // Constructors
+
+        /** FFT constructor, the size must be a power of two */
+        FFT(const std::size_t &new_size);
+
+
+        // Getters
+
+        /** Get the number of samples */
+        std::size_t getSize() const;
+
+
+        // Methods
+
+        /** Transform the contiguous samples in place, the inverse is not normalized */
+        void transform(std::complex<float> *data, const bool &inverse) const;
+
+
+        // Destructor
+
+        /** FFT destructor */
+        virtual ~FFT();
+
+
+        // Static methods
+
+        /** Get the smallest power of two not less than the value */
+        static std::size_t getPowerOfTwo(const std::size_t &value);
+};
+
+#endif // __FFT_HPP_
\ No newline at end of file
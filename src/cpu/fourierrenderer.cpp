@@ -0,0 +1,369 @@
+#include "fourierrenderer.hpp"
+
+#include "../profiler/profilerscope.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+
+// Static const attributes
+
+// Largest number of voxels of the spectrum with twice the frequency samples
+const std::size_t FourierRenderer::MAX_OVERSAMPLED;
+
+// Number of adjacent lines gathered together along the strided axes
+const std::size_t FourierRenderer::BLOCK;
+
+
+// Spectrum
+
+// Get the size of the samples in bytes
+std::size_t FourierRenderer::Spectrum::getBytes() const {
+    return sizeof(std::complex<float>) * samples.size();
+}
+
+
+// Private methods
+
+// Compute the centered spectrum of the brick of the target with its side
+template <typename T>
+void FourierRenderer::transform(const T *voxel, const glm::ivec3 &resolution, const float &norm, FourierRenderer::Spectrum &target) {
+    // The brick is centered in the zero padded cube
+    const glm::ivec3 lower = target.lower;
+    const glm::ivec3 extent = target.upper - lower;
+    const std::size_t n = target.side;
+    const std::size_t plane = n * n;
+    const glm::ivec3 offset = (glm::ivec3(static_cast<int>(n)) - extent) / 2;
+    if ((fft == nullptr) || (fft->getSize() != n)) {
+        delete fft;
+        fft = new FFT(n);
+    }
+    target.samples.assign(plane * n, std::complex<float>(0.0F, 0.0F));
+
+    // Copy the voxels with alternating signs, which moves the zero frequency to the middle sample, and transform the rows while they are in cache
+    const FFT *const transform_x = fft;
+    std::complex<float> *const data = target.samples.data();
+    parallel(static_cast<std::size_t>(extent.z), 1U, [&lower, voxel, &resolution, norm, &extent, &offset, n, plane, transform_x, data](const std::size_t &first, const std::size_t &last) {
+        for (std::size_t k = first; k < last; k++) {
+            const int z = lower.z + static_cast<int>(k);
+            for (int j = 0; j < extent.y; j++) {
+                const int y = lower.y + j;
+                const std::size_t position_y = static_cast<std::size_t>(offset.y + j);
+                const std::size_t position_z = static_cast<std::size_t>(offset.z) + k;
+                std::complex<float> *const row = data + position_z * plane + position_y * n;
+                const T *const source = voxel + (static_cast<std::size_t>(z) * static_cast<std::size_t>(resolution.y) + static_cast<std::size_t>(y)) * static_cast<std::size_t>(resolution.x);
+                for (int i = 0; i < extent.x; i++) {
+                    const std::size_t position_x = static_cast<std::size_t>(offset.x + i);
+                    const float value = static_cast<float>(source[lower.x + i]) * norm;
+                    row[position_x] = std::complex<float>(((position_x + position_y + position_z) & 1U) != 0U ? -value : value, 0.0F);
+                }
+                transform_x->transform(row, false);
+            }
+        }
+    });
+
+    // Only the planes of the brick are not empty along y, all of them along z
+    transformAxis(data + static_cast<std::size_t>(offset.z) * plane, static_cast<std::size_t>(extent.z), n, false);
+    transformAxis(data, 1U, plane, false);
+
+    // Alternating signs again move the spatial origin to the middle sample, the spectrum of the centered brick is smooth enough to be interpolated
+    parallel(n, 1U, [n, plane, data](const std::size_t &first, const std::size_t &last) {
+        for (std::size_t z = first; z < last; z++) {
+            for (std::size_t y = 0U; y < n; y++) {
+                std::complex<float> *const row = data + z * plane + y * n;
+                for (std::size_t x = (y + z + 1U) & 1U; x < n; x += 2U) {
+                    row[x] = -row[x];
+                }
+            }
+        }
+    });
+}
+
+// Transform the lines along the middle axis of the data laid out as outer, line and inner samples
+void FourierRenderer::transformAxis(std::complex<float> *data, const std::size_t &outer, const std::size_t &inner, const bool &inverse) const {
+    const FFT *const transform = fft;
+    const std::size_t n = transform->getSize();
+
+    // Contiguous lines are transformed in place
+    if (inner == 1U) {
+        parallel(outer, 16U, [transform, data, n, inverse](const std::size_t &first, const std::size_t &last) {
+            for (std::size_t line = first; line < last; line++) {
+                transform->transform(data + line * n, inverse);
+            }
+        });
+        return;
+    }
+
+    // Strided lines are gathered by blocks of adjacent ones, every sample reads a contiguous run of the block
+    const std::size_t blocks = (inner + FourierRenderer::BLOCK - 1U) / FourierRenderer::BLOCK;
+    parallel(outer * blocks, 4U, [transform, data, n, inner, blocks, inverse](const std::size_t &first, const std::size_t &last) {
+        std::vector<std::complex<float> > buffer(FourierRenderer::BLOCK * n);
+        for (std::size_t task = first; task < last; task++) {
+            const std::size_t start = (task % blocks) * FourierRenderer::BLOCK;
+            const std::size_t count = std::min(static_cast<std::size_t>(FourierRenderer::BLOCK), inner - start);
+            std::complex<float> *const base = data + (task / blocks) * n * inner + start;
+            for (std::size_t i = 0U; i < n; i++) {
+                const std::complex<float> *const source = base + i * inner;
+                for (std::size_t b = 0U; b < count; b++) {
+                    buffer[b * n + i] = source[b];
+                }
+            }
+            for (std::size_t b = 0U; b < count; b++) {
+                transform->transform(&buffer[b * n], inverse);
+            }
+            for (std::size_t i = 0U; i < n; i++) {
+                std::complex<float> *const target = base + i * inner;
+                for (std::size_t b = 0U; b < count; b++) {
+                    target[b] = buffer[b * n + i];
+                }
+            }
+        }
+    });
+}
+
+// Interpolate the central slice spanned by the axes into the slice rows in the range
+void FourierRenderer::extractSlice(const glm::vec3 &axis_u, const glm::vec3 &axis_v, const std::size_t &first, const std::size_t &last) {
+    const std::size_t n = side;
+    const float half = static_cast<float>(n / 2U);
+    const int limit = static_cast<int>(n) - 1;
+    for (std::size_t b = first; b < last; b++) {
+        for (std::size_t a = 0U; a < n; a++) {
+            // Frequency of the slice sample in the spectrum, the ones outside of it are zero
+            std::complex<float> &target = slice[b * n + a];
+            target = std::complex<float>(0.0F, 0.0F);
+            const glm::vec3 position = (static_cast<float>(a) - half) * axis_u + (static_cast<float>(b) - half) * axis_v + half;
+            const glm::vec3 lowest = glm::floor(position);
+            const glm::ivec3 sample(lowest);
+            if ((sample.x < 0) || (sample.y < 0) || (sample.z < 0) || (sample.x >= limit) || (sample.y >= limit) || (sample.z >= limit)) {
+                continue;
+            }
+
+            // Trilinear interpolation of the complex values
+            const glm::vec3 weight = position - lowest;
+            const std::complex<float> *const corner = &spectrum->samples[(static_cast<std::size_t>(sample.z) * n + static_cast<std::size_t>(sample.y)) * n + static_cast<std::size_t>(sample.x)];
+            for (int c = 0; c < 8; c++) {
+                const float factor = ((c & 1) != 0 ? weight.x : 1.0F - weight.x) * ((c & 2) != 0 ? weight.y : 1.0F - weight.y) * ((c & 4) != 0 ? weight.z : 1.0F - weight.z);
+                target += factor * corner[((c & 4) != 0 ? n * n : 0U) + ((c & 2) != 0 ? n : 0U) + static_cast<std::size_t>(c & 1)];
+            }
+
+            // Alternating signs move the projection of the brick center to the middle pixel
+            if (((a + b) & 1U) != 0U) {
+                target = -target;
+            }
+        }
+    }
+}
+
+// Sample the projection into the final image rows in the range
+void FourierRenderer::resample(const glm::mat4 &inverse_mat, const glm::mat4 &volume_mat, const glm::ivec3 &resolution, const glm::vec3 &axis_u, const glm::vec3 &axis_v, const glm::vec3 &axis_w, const float &scale, const GLsizei &width, const GLsizei &height, const std::size_t &first, const std::size_t &last, GLubyte *image) const {
+    // Brick box and center of the spectrum in voxels
+    const std::size_t n = side;
+    const float half = static_cast<float>(n / 2U);
+    const glm::vec3 size(resolution);
+    const glm::vec3 box_min = glm::vec3(lower) - 0.5F;
+    const glm::vec3 box_max = glm::vec3(upper) - 0.5F;
+    const glm::vec3 center = glm::vec3(lower) + half - glm::vec3((glm::ivec3(static_cast<int>(n)) - (upper - lower)) / 2);
+
+    for (std::size_t y = first; y < last; y++) {
+        for (GLsizei x = 0; x < width; x++) {
+            // Ray of the pixel in voxels, the pixels missing the brick stay transparent
+            glm::vec3 origin;
+            glm::vec3 direction;
+            const float length = CPURenderer::getRay(inverse_mat, volume_mat, x, static_cast<GLsizei>(y), width, height, origin, direction);
+            origin = origin * size - 0.5F;
+            direction *= size;
+            float t_near = 0.0F;
+            float t_far = length;
+            for (int i = 0; i < 3; i++) {
+                const float inverse = 1.0F / (direction[i] == 0.0F ? 1e-7F : direction[i]);
+                const float t_0 = (box_min[i] - origin[i]) * inverse;
+                const float t_1 = (box_max[i] - origin[i]) * inverse;
+                t_near = std::max(t_near, std::min(t_0, t_1));
+                t_far = std::min(t_far, std::max(t_0, t_1));
+            }
+            const float depth = glm::dot(direction, axis_w);
+            if (!(t_near < t_far) || (depth == 0.0F)) {
+                continue;
+            }
+
+            // Point of the ray on the plane through the center perpendicular to the projection
+            const glm::vec3 point = origin + direction * (glm::dot(center - origin, axis_w) / depth) - center;
+            const float u = glm::dot(point, axis_u) + half;
+            const float v = glm::dot(point, axis_v) + half;
+            if ((u < 0.0F) || (v < 0.0F) || (u >= static_cast<float>(n - 1U)) || (v >= static_cast<float>(n - 1U))) {
+                continue;
+            }
+
+            // Bilinear sample of the line integrals
+            const std::size_t u_0 = static_cast<std::size_t>(u);
+            const std::size_t v_0 = static_cast<std::size_t>(v);
+            const float weight_u = u - static_cast<float>(u_0);
+            const float weight_v = v - static_cast<float>(v_0);
+            const float *const row_0 = &projection[v_0 * n + u_0];
+            const float *const row_1 = row_0 + n;
+            const float lower_value = row_0[0] + (row_0[1] - row_0[0]) * weight_u;
+            const float upper_value = row_1[0] + (row_1[1] - row_1[0]) * weight_u;
+            const glm::vec4 color = CPURenderer::classify(table, (lower_value + (upper_value - lower_value) * weight_v) * scale);
+
+            // Store the premultiplied color
+            CPURenderer::store(glm::vec4(glm::vec3(color) * color.a, color.a), &image[4U * (y * static_cast<std::size_t>(width) + static_cast<std::size_t>(x))]);
+        }
+    }
+}
+
+
+// Constructors
+
+// Fourier renderer constructor
+FourierRenderer::FourierRenderer(const unsigned int &threads) :
+    CPURenderer(threads),
+    lower(0),
+    upper(0),
+    side(0U),
+    transform_time(0.0),
+    fft(nullptr),
+    spectrum(nullptr),
+    table(256U, glm::vec4(0.0F)) {}
+
+
+// Getters
+
+// Get the side of the spectrum cube
+std::size_t FourierRenderer::getSide() const {
+    return side;
+}
+
+// Get the time of the last transform in milliseconds
+double FourierRenderer::getTransformTime() const {
+    return transform_time;
+}
+
+
+// Methods
+
+// Render the line integrals of the volume seen by the camera into the premultiplied RGBA image through the transfer function
+void FourierRenderer::render(const Volume *const volume, const Camera *const camera, const GLsizei &width, const GLsizei &height, std::vector<GLubyte> &image) {
+    // Clear to transparent
+    image.assign(4U * static_cast<std::size_t>(std::max(width, 0)) * static_cast<std::size_t>(std::max(height, 0)), 0U);
+    if (!volume->isEnabled() || !volume->isOpen() || (volume->getVoxels() == nullptr) || (width <= 0) || (height <= 0)) {
+        return;
+    }
+
+    // Voxels of the drawn brick
+    const glm::ivec3 resolution(volume->getResolution());
+    glm::ivec3 brick_lower;
+    glm::ivec3 brick_upper;
+    for (int i = 0; i < 3; i++) {
+        brick_lower[i] = std::min(std::max(0, static_cast<int>(std::round(volume->getClipMin()[i] * static_cast<float>(resolution[i])))), resolution[i] - 1);
+        brick_upper[i] = std::max(brick_lower[i] + 1, std::min(resolution[i], static_cast<int>(std::round(volume->getClipMax()[i] * static_cast<float>(resolution[i])))));
+    }
+
+    // Transform again if the voxels have no spectrum of the brick
+    spectrum = static_cast<const FourierRenderer::Spectrum *>(volume->getDerived("fourier spectrum"));
+    if ((spectrum == nullptr) || (spectrum->lower != brick_lower) || (spectrum->upper != brick_upper)) {
+        const ProfilerScope scope("transform");
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        FourierRenderer::Spectrum *const transformed = new FourierRenderer::Spectrum();
+        transformed->lower = brick_lower;
+        transformed->upper = brick_upper;
+        const glm::ivec3 extent = brick_upper - brick_lower;
+        transformed->side = std::max(static_cast<std::size_t>(4U), FFT::getPowerOfTwo(static_cast<std::size_t>(std::max(extent.x, std::max(extent.y, extent.z)))));
+        if (8U * transformed->side * transformed->side * transformed->side <= FourierRenderer::MAX_OVERSAMPLED) {
+            transformed->side *= 2U;
+        }
+        const float norm = volume->getFormat() == VolumeData::RAW8 ? 1.0F / 255.0F : volume->getValueScale() / 65535.0F;
+        if (volume->getFormat() == VolumeData::RAW8) {
+            transform(reinterpret_cast<const GLubyte *>(volume->getVoxels()), resolution, norm, *transformed);
+        }
+        else {
+            transform(volume->getVoxels(), resolution, norm, *transformed);
+        }
+        volume->setDerived("fourier spectrum", transformed);
+        spectrum = transformed;
+        transform_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "info: fourier transformed the " << spectrum->side << "^3 spectrum in " << transform_time << " ms" << std::endl;
+    }
+    lower = spectrum->lower;
+    upper = spectrum->upper;
+    side = spectrum->side;
+
+    // The slices are transformed with the side of the spectrum
+    if ((fft == nullptr) || (fft->getSize() != side)) {
+        delete fft;
+        fft = new FFT(side);
+    }
+
+    // Projection direction in voxels, toward the brick center for the perspective
+    const glm::mat4 inverse_mat = glm::inverse(camera->getProjectionMatrix() * camera->getViewMatrix() * volume->getModelMatrix());
+    const glm::mat4 volume_mat = volume->getVolumeMatrix();
+    const glm::vec3 size(resolution);
+    glm::vec3 direction;
+    if (!camera->isOrthogonal()) {
+        glm::vec3 eye = glm::vec3(volume_mat * glm::inverse(camera->getViewMatrix() * volume->getModelMatrix()) * glm::vec4(0.0F, 0.0F, 0.0F, 1.0F));
+        eye.y = 1.0F - eye.y;
+        direction = (glm::vec3(lower) + glm::vec3(upper) - 1.0F) * 0.5F - (eye * size - 0.5F);
+    }
+    else {
+        glm::vec3 origin;
+        CPURenderer::getRay(inverse_mat, volume_mat, width / 2, height / 2, width, height, origin, direction);
+        direction *= size;
+    }
+    if (glm::dot(direction, direction) == 0.0F) {
+        return;
+    }
+
+    // Orthonormal basis of the central slice perpendicular to the projection
+    const glm::vec3 axis_w = glm::normalize(direction);
+    const glm::vec3 axis_u = glm::normalize(glm::cross(std::abs(axis_w.x) < 0.9F ? glm::vec3(1.0F, 0.0F, 0.0F) : glm::vec3(0.0F, 1.0F, 0.0F), axis_w));
+    const glm::vec3 axis_v = glm::cross(axis_w, axis_u);
+
+    // The inverse transform of the central slice is the projection by the Fourier slice theorem
+    const std::size_t n = side;
+    slice.resize(n * n);
+    parallel(n, 4U, [this, &axis_u, &axis_v](const std::size_t &first, const std::size_t &last) {
+        extractSlice(axis_u, axis_v, first, last);
+    });
+    transformAxis(slice.data(), n, 1U, true);
+    transformAxis(slice.data(), 1U, n, true);
+
+    // Alternating signs move the spatial origin back, the inverse transform is normalized
+    projection.resize(n * n);
+    const float normalization = 1.0F / static_cast<float>(n * n);
+    parallel(n, 16U, [this, n, normalization](const std::size_t &first, const std::size_t &last) {
+        for (std::size_t v = first; v < last; v++) {
+            for (std::size_t u = 0U; u < n; u++) {
+                const float value = slice[v * n + u].real() * normalization;
+                projection[v * n + u] = ((u + v) & 1U) != 0U ? -value : value;
+            }
+        }
+    });
+
+    // Colors of the transfer function, the integrals are scaled by the largest side of the grid
+    const GLubyte *const data = volume->getTransferFunction()->getData();
+    for (std::size_t i = 0U; i < 256U; i++) {
+        table[i] = glm::vec4(data[4U * i], data[4U * i + 1U], data[4U * i + 2U], data[4U * i + 3U]) / 255.0F;
+    }
+    const float scale = 1.0F / static_cast<float>(std::max(resolution.x, std::max(resolution.y, resolution.z)));
+
+    // Sample the projection into the final image
+    GLubyte *const target = image.data();
+    parallel(static_cast<std::size_t>(height), 4U, [this, &inverse_mat, &volume_mat, &resolution, &axis_u, &axis_v, &axis_w, scale, width, height, target](const std::size_t &first, const std::size_t &last) {
+        resample(inverse_mat, volume_mat, resolution, axis_u, axis_v, axis_w, scale, width, height, first, last, target);
+    });
+}
+
+
+// Destructor
+
+// Fourier renderer destructor
+FourierRenderer::~FourierRenderer() {
+    if (fft != nullptr) {
+        delete fft;
+    }
+}
\ No newline at end of file
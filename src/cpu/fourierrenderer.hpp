@@ -0,0 +1,143 @@
+#ifndef __FOURIER_RENDERER_HPP_
+#define __FOURIER_RENDERER_HPP_
+
+#include "cpurenderer.hpp"
+#include "fft.hpp"
+
+#include "../volume/volume.hpp"
+#include "../scene/camera.hpp"
+
+#include "../glad/glad.h"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include <glm/vec3.hpp>
+
+#include <complex>
+#include <vector>
+
+
+/** Fourier volume renderer on the CPU threads, the spectrum of the drawn brick is computed once and every view is the inverse transform of its central slice perpendicular to the view direction, which gives the line integrals of the voxels as an X-ray */
+class FourierRenderer : public CPURenderer {
+    private:
+        // Structures
+
+        /** Centered spectrum of the drawn brick, the volume keeps it with its voxels */
+        class Spectrum : public VolumeData::Derived {
+            public:
+                // Attributes
+
+                /** Lower voxel of the transformed brick */
+                glm::ivec3 lower;
+
+                /** Upper voxel of the transformed brick, excluded */
+                glm::ivec3 upper;
+
+                /** Side of the spectrum cube, a power of two */
+                std::size_t side;
+
+                /** Samples of the spectrum, the zero frequency is at the middle sample of every axis */
+                std::vector<std::complex<float> > samples;
+
+
+                // Getters
+
+                /** Get the size of the samples in bytes */
+                std::size_t getBytes() const;
+        };
+
+
+        // Static const attributes
+
+        /** Largest number of voxels of the spectrum with twice the frequency samples, the zero padding reduces the aliasing of the slice interpolation */
+        static const std::size_t MAX_OVERSAMPLED = 1U << 24U;
+
+        /** Number of adjacent lines gathered together along the strided axes */
+        static const std::size_t BLOCK = 16U;
+
+
+        // Attributes
+
+        /** Lower voxel of the drawn brick */
+        glm::ivec3 lower;
+
+        /** Upper voxel of the drawn brick, excluded */
+        glm::ivec3 upper;
+
+        /** Side of the spectrum cube of the last frame, a power of two */
+        std::size_t side;
+
+        /** Time of the last transform in milliseconds */
+        double transform_time;
+
+
+        /** Transform of the spectrum side */
+        FFT *fft;
+
+        /** Centered spectrum of the frame, kept by the volume */
+        const FourierRenderer::Spectrum *spectrum;
+
+        /** Central slice of the spectrum, then its inverse transform */
+        std::vector<std::complex<float> > slice;
+
+        /** Line integrals in voxels of the view, the brick center projects at the middle pixel */
+        std::vector<float> projection;
+
+        /** Colors of the transfer function */
+        std::vector<glm::vec4> table;
+
+
+        // Constructors
+
+        /** Disable the default copy constructor */
+        FourierRenderer(const FourierRenderer &) = delete;
+
+        /** Disable the assignation operator */
+        FourierRenderer &operator=(const FourierRenderer &) = delete;
+
+
+        // Methods
+
+        /** Compute the centered spectrum of the brick of the target with its side */
+        template <typename T>
+        void transform(const T *voxel, const glm::ivec3 &resolution, const float &norm, FourierRenderer::Spectrum &target);
+
+        /** Transform the lines along the middle axis of the data laid out as outer, line and inner samples, the inner ones are gathered by blocks */
+        void transformAxis(std::complex<float> *data, const std::size_t &outer, const std::size_t &inner, const bool &inverse) const;
+
+        /** Interpolate the central slice spanned by the axes into the slice rows in the range */
+        void extractSlice(const glm::vec3 &axis_u, const glm::vec3 &axis_v, const std::size_t &first, const std::size_t &last);
+
+        /** Sample the projection into the final image rows in the range */
+        void resample(const glm::mat4 &inverse_mat, const glm::mat4 &volume_mat, const glm::ivec3 &resolution, const glm::vec3 &axis_u, const glm::vec3 &axis_v, const glm::vec3 &axis_w, const float &scale, const GLsizei &width, const GLsizei &height, const std::size_t &first, const std::size_t &last, GLubyte *image) const;
+
+
+    public:
+        // Constructors
+
+        /** Fourier renderer constructor, the threads default to all the threads of the task scheduler */
+        FourierRenderer(const unsigned int &threads = 0U);
+
+
+        // Getters
+
+        /** Get the side of the spectrum cube, zero if it was not computed */
+        std::size_t getSide() const;
+
+        /** Get the time of the last transform in milliseconds */
+        double getTransformTime() const;
+
+
+        // Methods
+
+        /** Render the line integrals of the volume seen by the camera into the premultiplied RGBA image through the transfer function, the rows from bottom to top, the perspective is approximated by the parallel projection along the view of the brick center */
+        void render(const Volume *const volume, const Camera *const camera, const GLsizei &width, const GLsizei &height, std::vector<GLubyte> &image);
+
+
+        // Destructor
+
+        /** Fourier renderer destructor */
+        virtual ~FourierRenderer();
+};
+
+#endif // __FOURIER_RENDERER_HPP_
\ No newline at end of file
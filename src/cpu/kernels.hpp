@@ -0,0 +1,243 @@
+#ifndef __KERNELS_HPP_
+#define __KERNELS_HPP_
+
+#include "lanes.hpp"
+#include "voxelaccessor.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <algorithm>
+
+
+// Compile time policies of the CPU sampling kernels, a kernel is instantiated for every voxel type, filter and composition so its inner loop has no branches on them
+
+/** Sample every lane of the packet with the scalar filter */
+template <typename Filter, typename T>
+Lanes sampleLanes(const VoxelAccessor<T> &voxels, const Lanes &x, const Lanes &y, const Lanes &z) {
+    float point[3][Lanes::SIZE];
+    x.store(point[0]);
+    y.store(point[1]);
+    z.store(point[2]);
+    float value[Lanes::SIZE];
+    for (unsigned int lane = 0U; lane < Lanes::SIZE; lane++) {
+        value[lane] = Filter::sample(voxels, glm::vec3(point[0][lane], point[1][lane], point[2][lane]));
+    }
+    return Lanes::load(value);
+}
+
+
+/** Nearest voxel filter */
+class NearestFilter {
+    public:
+        // Static methods
+
+        /** Sample the raw voxels at the texture coordinates, zero outside */
+        template <typename T>
+        static float sample(const VoxelAccessor<T> &voxels, const glm::vec3 &point) {
+            const glm::ivec3 &resolution = voxels.getResolution();
+            int voxel[3];
+            for (int i = 0; i < 3; i++) {
+                const float position = std::min(std::max(point[i] * static_cast<float>(resolution[i]), -1.0F), static_cast<float>(resolution[i]));
+                voxel[i] = static_cast<int>(position + 1.0F) - 1;
+            }
+            return voxels.fetch(voxel[0], voxel[1], voxel[2]);
+        }
+
+        /** Sample the raw voxels of a packet of points, zero outside */
+        template <typename T>
+        static Lanes sample(const VoxelAccessor<T> &voxels, const Lanes &x, const Lanes &y, const Lanes &z) {
+            return sampleLanes<NearestFilter>(voxels, x, y, z);
+        }
+};
+
+
+/** Trilinear interpolation filter */
+class TrilinearFilter {
+    public:
+        // Static methods
+
+        /** Sample the raw voxels with trilinear interpolation at the texture coordinates, zero outside */
+        template <typename T>
+        static float sample(const VoxelAccessor<T> &voxels, const glm::vec3 &point) {
+            // Voxel centers are at the half texels, the lower corner may be one voxel outside
+            const glm::ivec3 &resolution = voxels.getResolution();
+            int corner[3];
+            float weight[3];
+            for (int i = 0; i < 3; i++) {
+                const float position = std::min(std::max(point[i] * static_cast<float>(resolution[i]) - 0.5F, -1.0F), static_cast<float>(resolution[i]));
+                corner[i] = static_cast<int>(position + 1.0F) - 1;
+                weight[i] = position - static_cast<float>(corner[i]);
+            }
+
+            // Fetch the corners with a zero border
+            float value[8];
+            for (int c = 0; c < 8; c++) {
+                value[c] = voxels.fetch(corner[0] + (c & 1), corner[1] + ((c >> 1) & 1), corner[2] + ((c >> 2) & 1));
+            }
+
+            // Interpolate along x, y and z
+            for (int c = 0; c < 4; c++) {
+                value[c] = value[2 * c] + (value[2 * c + 1] - value[2 * c]) * weight[0];
+            }
+            for (int c = 0; c < 2; c++) {
+                value[c] = value[2 * c] + (value[2 * c + 1] - value[2 * c]) * weight[1];
+            }
+            return value[0] + (value[1] - value[0]) * weight[2];
+        }
+
+        /** Sample the raw voxels of a packet of points with trilinear interpolation, zero outside */
+        template <typename T>
+        static Lanes sample(const VoxelAccessor<T> &voxels, const Lanes &x, const Lanes &y, const Lanes &z) {
+            // Voxel positions clamped around the grid, the idle lanes may be anywhere
+            const glm::ivec3 &resolution = voxels.getResolution();
+            const Lanes half(0.5F);
+            const Lanes lowest(-1.0F);
+            const Lanes *const point[3] = {&x, &y, &z};
+            float position[3][Lanes::SIZE];
+            for (int i = 0; i < 3; i++) {
+                const float size = static_cast<float>(resolution[i]);
+                Lanes::min(Lanes::max(*point[i] * Lanes(size) - half, lowest), Lanes(size)).store(position[i]);
+            }
+
+            // Gather the corners of every lane with a zero border
+            float corner[8][Lanes::SIZE];
+            float weight[3][Lanes::SIZE];
+            for (unsigned int lane = 0U; lane < Lanes::SIZE; lane++) {
+                int lower[3];
+                for (int i = 0; i < 3; i++) {
+                    lower[i] = static_cast<int>(position[i][lane] + 1.0F) - 1;
+                    weight[i][lane] = position[i][lane] - static_cast<float>(lower[i]);
+                }
+                for (int c = 0; c < 8; c++) {
+                    corner[c][lane] = voxels.fetch(lower[0] + (c & 1), lower[1] + ((c >> 1) & 1), lower[2] + ((c >> 2) & 1));
+                }
+            }
+
+            // Interpolate all the lanes along x, y and z
+            const Lanes weight_x = Lanes::load(weight[0]);
+            const Lanes weight_y = Lanes::load(weight[1]);
+            const Lanes weight_z = Lanes::load(weight[2]);
+            const Lanes x_00 = Lanes::mix(Lanes::load(corner[0]), Lanes::load(corner[1]), weight_x);
+            const Lanes x_10 = Lanes::mix(Lanes::load(corner[2]), Lanes::load(corner[3]), weight_x);
+            const Lanes x_01 = Lanes::mix(Lanes::load(corner[4]), Lanes::load(corner[5]), weight_x);
+            const Lanes x_11 = Lanes::mix(Lanes::load(corner[6]), Lanes::load(corner[7]), weight_x);
+            return Lanes::mix(Lanes::mix(x_00, x_10, weight_y), Lanes::mix(x_01, x_11, weight_y), weight_z);
+        }
+};
+
+
+/** Tricubic Catmull-Rom interpolation filter, it goes through the voxel values and may overshoot between them */
+class TricubicFilter {
+    public:
+        // Static methods
+
+        /** Sample the raw voxels with tricubic interpolation at the texture coordinates, zero outside */
+        template <typename T>
+        static float sample(const VoxelAccessor<T> &voxels, const glm::vec3 &point) {
+            // Four taps per axis around the voxel centers at the half texels
+            const glm::ivec3 &resolution = voxels.getResolution();
+            int first[3];
+            float weight[3][4];
+            for (int i = 0; i < 3; i++) {
+                const float position = std::min(std::max(point[i] * static_cast<float>(resolution[i]) - 0.5F, -1.0F), static_cast<float>(resolution[i]));
+                const int lower = static_cast<int>(position + 1.0F) - 1;
+                const float t = position - static_cast<float>(lower);
+                const float t_2 = t * t;
+                const float t_3 = t_2 * t;
+                first[i] = lower - 1;
+                weight[i][0] = 0.5F * (-t_3 + 2.0F * t_2 - t);
+                weight[i][1] = 0.5F * (3.0F * t_3 - 5.0F * t_2 + 2.0F);
+                weight[i][2] = 0.5F * (-3.0F * t_3 + 4.0F * t_2 + t);
+                weight[i][3] = 0.5F * (t_3 - t_2);
+            }
+
+            // Separable sum of the taps with a zero border
+            float value = 0.0F;
+            for (int k = 0; k < 4; k++) {
+                float plane = 0.0F;
+                for (int j = 0; j < 4; j++) {
+                    float row = 0.0F;
+                    for (int i = 0; i < 4; i++) {
+                        row += weight[0][i] * voxels.fetch(first[0] + i, first[1] + j, first[2] + k);
+                    }
+                    plane += weight[1][j] * row;
+                }
+                value += weight[2][k] * plane;
+            }
+            return value;
+        }
+
+        /** Sample the raw voxels of a packet of points with tricubic interpolation, zero outside */
+        template <typename T>
+        static Lanes sample(const VoxelAccessor<T> &voxels, const Lanes &x, const Lanes &y, const Lanes &z) {
+            return sampleLanes<TricubicFilter>(voxels, x, y, z);
+        }
+};
+
+
+/** Maximum intensity projection */
+class MaximumComposition {
+    public:
+        // Static methods
+
+        /** Get the result before the first sample */
+        static Lanes initial() {
+            return Lanes(0.0F);
+        }
+
+        /** Combine the samples into the results */
+        static Lanes combine(const Lanes &result, const Lanes &value) {
+            return Lanes::max(result, value);
+        }
+
+        /** Get the data value of the result of the samples */
+        static float resolve(const float &result, const float &) {
+            return result;
+        }
+};
+
+
+/** Minimum intensity projection */
+class MinimumComposition {
+    public:
+        // Static methods
+
+        /** Get the result before the first sample */
+        static Lanes initial() {
+            return Lanes(1.0F);
+        }
+
+        /** Combine the samples into the results */
+        static Lanes combine(const Lanes &result, const Lanes &value) {
+            return Lanes::min(result, value);
+        }
+
+        /** Get the data value of the result of the samples */
+        static float resolve(const float &result, const float &) {
+            return result;
+        }
+};
+
+
+/** Average intensity projection */
+class AverageComposition {
+    public:
+        // Static methods
+
+        /** Get the result before the first sample */
+        static Lanes initial() {
+            return Lanes(0.0F);
+        }
+
+        /** Combine the samples into the results */
+        static Lanes combine(const Lanes &result, const Lanes &value) {
+            return result + value;
+        }
+
+        /** Get the data value of the result of the samples */
+        static float resolve(const float &result, const float &samples) {
+            return result / std::max(samples, 1.0F);
+        }
+};
+
+#endif // __KERNELS_HPP_
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "lanes.hpp"
+
+
+// Static const attributes
+
+// Number of lanes
+const unsigned int Lanes::SIZE;
\ No newline at end of file
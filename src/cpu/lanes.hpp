@@ -0,0 +1,185 @@
+#ifndef __LANES_HPP_
+#define __LANES_HPP_
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#else
+#include <algorithm>
+#endif
+
+
+/** Packet of four floats processed together, SSE2 registers if available and plain arrays otherwise */
+class Lanes {
+    private:
+        // Attributes
+
+#if defined(__SSE2__)
+        /** Register of the lanes */
+        __m128 value;
+#else
+        /** Values of the lanes */
+        float value[4];
+#endif
+
+
+    public:
+        // Static const attributes
+
+        /** Number of lanes */
+        static const unsigned int SIZE = 4U;
+
+
+        // Constructors
+
+        /** Lanes with undefined values */
+        Lanes() {}
+
+        /** Lanes with the same value */
+        explicit Lanes(const float &scalar) {
+#if defined(__SSE2__)
+            value = _mm_set1_ps(scalar);
+#else
+            std::fill(value, value + Lanes::SIZE, scalar);
+#endif
+        }
+
+
+        // Methods
+
+        /** Store the lanes to four floats */
+        void store(float *const target) const {
+#if defined(__SSE2__)
+            _mm_storeu_ps(target, value);
+#else
+            std::copy(value, value + Lanes::SIZE, target);
+#endif
+        }
+
+        /** Get the mask of the lanes with a non zero sign bit, the first lane in the lowest bit */
+        int mask() const {
+#if defined(__SSE2__)
+            return _mm_movemask_ps(value);
+#else
+            int bits = 0;
+            for (unsigned int i = 0U; i < Lanes::SIZE; i++) {
+                bits |= (value[i] != 0.0F ? 1 : 0) << i;
+            }
+            return bits;
+#endif
+        }
+
+
+        // Operators
+
+        /** Lanes sum */
+        Lanes operator+(const Lanes &other) const {
+            Lanes result;
+#if defined(__SSE2__)
+            result.value = _mm_add_ps(value, other.value);
+#else
+            for (unsigned int i = 0U; i < Lanes::SIZE; i++) {
+                result.value[i] = value[i] + other.value[i];
+            }
+#endif
+            return result;
+        }
+
+        /** Lanes difference */
+        Lanes operator-(const Lanes &other) const {
+            Lanes result;
+#if defined(__SSE2__)
+            result.value = _mm_sub_ps(value, other.value);
+#else
+            for (unsigned int i = 0U; i < Lanes::SIZE; i++) {
+                result.value[i] = value[i] - other.value[i];
+            }
+#endif
+            return result;
+        }
+
+        /** Lanes product */
+        Lanes operator*(const Lanes &other) const {
+            Lanes result;
+#if defined(__SSE2__)
+            result.value = _mm_mul_ps(value, other.value);
+#else
+            for (unsigned int i = 0U; i < Lanes::SIZE; i++) {
+                result.value[i] = value[i] * other.value[i];
+            }
+#endif
+            return result;
+        }
+
+
+        // Static methods
+
+        /** Load the lanes from four floats */
+        static Lanes load(const float *const source) {
+            Lanes result;
+#if defined(__SSE2__)
+            result.value = _mm_loadu_ps(source);
+#else
+            std::copy(source, source + Lanes::SIZE, result.value);
+#endif
+            return result;
+        }
+
+        /** Lanes minimum */
+        static Lanes min(const Lanes &a, const Lanes &b) {
+            Lanes result;
+#if defined(__SSE2__)
+            result.value = _mm_min_ps(a.value, b.value);
+#else
+            for (unsigned int i = 0U; i < Lanes::SIZE; i++) {
+                result.value[i] = std::min(a.value[i], b.value[i]);
+            }
+#endif
+            return result;
+        }
+
+        /** Lanes maximum */
+        static Lanes max(const Lanes &a, const Lanes &b) {
+            Lanes result;
+#if defined(__SSE2__)
+            result.value = _mm_max_ps(a.value, b.value);
+#else
+            for (unsigned int i = 0U; i < Lanes::SIZE; i++) {
+                result.value[i] = std::max(a.value[i], b.value[i]);
+            }
+#endif
+            return result;
+        }
+
+        /** Mask of the lanes where a is less than b, all the bits set or cleared */
+        static Lanes less(const Lanes &a, const Lanes &b) {
+            Lanes result;
+#if defined(__SSE2__)
+            result.value = _mm_cmplt_ps(a.value, b.value);
+#else
+            for (unsigned int i = 0U; i < Lanes::SIZE; i++) {
+                result.value[i] = a.value[i] < b.value[i] ? 1.0F : 0.0F;
+            }
+#endif
+            return result;
+        }
+
+        /** Linear interpolation from a to b by the weight */
+        static Lanes mix(const Lanes &a, const Lanes &b, const Lanes &weight) {
+            return a + (b - a) * weight;
+        }
+
+        /** Take the lanes of a where the mask is set and the lanes of b otherwise */
+        static Lanes select(const Lanes &mask, const Lanes &a, const Lanes &b) {
+            Lanes result;
+#if defined(__SSE2__)
+            result.value = _mm_or_ps(_mm_and_ps(mask.value, a.value), _mm_andnot_ps(mask.value, b.value));
+#else
+            for (unsigned int i = 0U; i < Lanes::SIZE; i++) {
+                result.value[i] = mask.value[i] != 0.0F ? a.value[i] : b.value[i];
+            }
+#endif
+            return result;
+        }
+};
+
+#endif // __LANES_HPP_
\ No newline at end of file
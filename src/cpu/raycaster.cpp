@@ -0,0 +1,802 @@
+#include "raycaster.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+// Static const attributes
+
+// Number of voxel types of the kernels, the bytes and the unsigned shorts
+const std::size_t RayCaster::VOXEL_TYPES;
+
+// Number of filters of the kernels
+const std::size_t RayCaster::FILTERS;
+
+// Number of compositions of the kernels
+const std::size_t RayCaster::COMPOSITIONS;
+
+
+// Axis reduction kernels, sixteen bytes at a time with SSE2 and the tail one by one
+
+/** Keep the maximum of the row and the accumulated row */
+static void combineMaximum(const GLubyte *row, GLubyte *accumulated, const std::size_t &size) {
+    std::size_t i = 0U;
+#if defined(__SSE2__)
+    for (; i + 16U <= size; i += 16U) {
+        __m128i *const target = reinterpret_cast<__m128i *>(accumulated + i);
+        _mm_storeu_si128(target, _mm_max_epu8(_mm_loadu_si128(target), _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i))));
+    }
+#endif
+    for (; i < size; i++) {
+        accumulated[i] = std::max(accumulated[i], row[i]);
+    }
+}
+
+/** Keep the maximum of the row and the accumulated row, the unsigned shorts are compared as signed with the sign bit flipped */
+static void combineMaximum(const GLushort *row, GLushort *accumulated, const std::size_t &size) {
+    std::size_t i = 0U;
+#if defined(__SSE2__)
+    const __m128i flip = _mm_set1_epi16(static_cast<short>(0x8000));
+    for (; i + 8U <= size; i += 8U) {
+        __m128i *const target = reinterpret_cast<__m128i *>(accumulated + i);
+        const __m128i value = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i)), flip);
+        _mm_storeu_si128(target, _mm_xor_si128(_mm_max_epi16(_mm_xor_si128(_mm_loadu_si128(target), flip), value), flip));
+    }
+#endif
+    for (; i < size; i++) {
+        accumulated[i] = std::max(accumulated[i], row[i]);
+    }
+}
+
+/** Keep the minimum of the row and the accumulated row */
+static void combineMinimum(const GLubyte *row, GLubyte *accumulated, const std::size_t &size) {
+    std::size_t i = 0U;
+#if defined(__SSE2__)
+    for (; i + 16U <= size; i += 16U) {
+        __m128i *const target = reinterpret_cast<__m128i *>(accumulated + i);
+        _mm_storeu_si128(target, _mm_min_epu8(_mm_loadu_si128(target), _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i))));
+    }
+#endif
+    for (; i < size; i++) {
+        accumulated[i] = std::min(accumulated[i], row[i]);
+    }
+}
+
+/** Keep the minimum of the row and the accumulated row, the unsigned shorts are compared as signed with the sign bit flipped */
+static void combineMinimum(const GLushort *row, GLushort *accumulated, const std::size_t &size) {
+    std::size_t i = 0U;
+#if defined(__SSE2__)
+    const __m128i flip = _mm_set1_epi16(static_cast<short>(0x8000));
+    for (; i + 8U <= size; i += 8U) {
+        __m128i *const target = reinterpret_cast<__m128i *>(accumulated + i);
+        const __m128i value = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i)), flip);
+        _mm_storeu_si128(target, _mm_xor_si128(_mm_min_epi16(_mm_xor_si128(_mm_loadu_si128(target), flip), value), flip));
+    }
+#endif
+    for (; i < size; i++) {
+        accumulated[i] = std::min(accumulated[i], row[i]);
+    }
+}
+
+/** Add the row to the accumulated sums */
+static void combineSum(const GLubyte *row, std::uint32_t *accumulated, const std::size_t &size) {
+    std::size_t i = 0U;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16U <= size; i += 16U) {
+        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+        const __m128i half[2] = {_mm_unpacklo_epi8(value, zero), _mm_unpackhi_epi8(value, zero)};
+        for (unsigned int h = 0U; h < 2U; h++) {
+            __m128i *const low = reinterpret_cast<__m128i *>(accumulated + i + 8U * h);
+            __m128i *const high = reinterpret_cast<__m128i *>(accumulated + i + 8U * h + 4U);
+            _mm_storeu_si128(low, _mm_add_epi32(_mm_loadu_si128(low), _mm_unpacklo_epi16(half[h], zero)));
+            _mm_storeu_si128(high, _mm_add_epi32(_mm_loadu_si128(high), _mm_unpackhi_epi16(half[h], zero)));
+        }
+    }
+#endif
+    for (; i < size; i++) {
+        accumulated[i] += row[i];
+    }
+}
+
+/** Add the row to the accumulated sums */
+static void combineSum(const GLushort *row, std::uint32_t *accumulated, const std::size_t &size) {
+    std::size_t i = 0U;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8U <= size; i += 8U) {
+        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+        __m128i *const low = reinterpret_cast<__m128i *>(accumulated + i);
+        __m128i *const high = reinterpret_cast<__m128i *>(accumulated + i + 4U);
+        _mm_storeu_si128(low, _mm_add_epi32(_mm_loadu_si128(low), _mm_unpacklo_epi16(value, zero)));
+        _mm_storeu_si128(high, _mm_add_epi32(_mm_loadu_si128(high), _mm_unpackhi_epi16(value, zero)));
+    }
+#endif
+    for (; i < size; i++) {
+        accumulated[i] += row[i];
+    }
+}
+
+/** Get the maximum of the row */
+static std::uint32_t reduceMaximum(const GLubyte *row, const std::size_t &size) {
+    std::size_t i = 0U;
+    GLubyte maximum = 0U;
+#if defined(__SSE2__)
+    if (size >= 16U) {
+        __m128i accumulated = _mm_setzero_si128();
+        for (; i + 16U <= size; i += 16U) {
+            accumulated = _mm_max_epu8(accumulated, _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i)));
+        }
+        GLubyte lanes[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), accumulated);
+        maximum = *std::max_element(lanes, lanes + 16);
+    }
+#endif
+    for (; i < size; i++) {
+        maximum = std::max(maximum, row[i]);
+    }
+    return maximum;
+}
+
+/** Get the maximum of the row */
+static std::uint32_t reduceMaximum(const GLushort *row, const std::size_t &size) {
+    std::size_t i = 0U;
+    GLushort maximum = 0U;
+#if defined(__SSE2__)
+    if (size >= 8U) {
+        const __m128i flip = _mm_set1_epi16(static_cast<short>(0x8000));
+        __m128i accumulated = flip;
+        for (; i + 8U <= size; i += 8U) {
+            accumulated = _mm_max_epi16(accumulated, _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i)), flip));
+        }
+        GLushort lanes[8];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), _mm_xor_si128(accumulated, flip));
+        maximum = *std::max_element(lanes, lanes + 8);
+    }
+#endif
+    for (; i < size; i++) {
+        maximum = std::max(maximum, row[i]);
+    }
+    return maximum;
+}
+
+/** Get the minimum of the row */
+static std::uint32_t reduceMinimum(const GLubyte *row, const std::size_t &size) {
+    std::size_t i = 0U;
+    GLubyte minimum = 0xFFU;
+#if defined(__SSE2__)
+    if (size >= 16U) {
+        __m128i accumulated = _mm_set1_epi8(static_cast<char>(0xFF));
+        for (; i + 16U <= size; i += 16U) {
+            accumulated = _mm_min_epu8(accumulated, _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i)));
+        }
+        GLubyte lanes[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), accumulated);
+        minimum = *std::min_element(lanes, lanes + 16);
+    }
+#endif
+    for (; i < size; i++) {
+        minimum = std::min(minimum, row[i]);
+    }
+    return minimum;
+}
+
+/** Get the minimum of the row */
+static std::uint32_t reduceMinimum(const GLushort *row, const std::size_t &size) {
+    std::size_t i = 0U;
+    GLushort minimum = 0xFFFFU;
+#if defined(__SSE2__)
+    if (size >= 8U) {
+        const __m128i flip = _mm_set1_epi16(static_cast<short>(0x8000));
+        __m128i accumulated = _mm_set1_epi16(0x7FFF);
+        for (; i + 8U <= size; i += 8U) {
+            accumulated = _mm_min_epi16(accumulated, _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i)), flip));
+        }
+        GLushort lanes[8];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), _mm_xor_si128(accumulated, flip));
+        minimum = *std::min_element(lanes, lanes + 8);
+    }
+#endif
+    for (; i < size; i++) {
+        minimum = std::min(minimum, row[i]);
+    }
+    return minimum;
+}
+
+/** Get the sum of the row, the bytes are added by the sums of absolute differences to zero */
+static std::uint32_t reduceSum(const GLubyte *row, const std::size_t &size) {
+    std::size_t i = 0U;
+    std::uint32_t sum = 0U;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i accumulated = zero;
+    for (; i + 16U <= size; i += 16U) {
+        accumulated = _mm_add_epi64(accumulated, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i)), zero));
+    }
+    std::uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), accumulated);
+    sum = static_cast<std::uint32_t>(lanes[0] + lanes[1]);
+#endif
+    for (; i < size; i++) {
+        sum += row[i];
+    }
+    return sum;
+}
+
+/** Get the sum of the row */
+static std::uint32_t reduceSum(const GLushort *row, const std::size_t &size) {
+    std::size_t i = 0U;
+    std::uint32_t sum = 0U;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i accumulated = zero;
+    for (; i + 8U <= size; i += 8U) {
+        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+        accumulated = _mm_add_epi32(accumulated, _mm_add_epi32(_mm_unpacklo_epi16(value, zero), _mm_unpackhi_epi16(value, zero)));
+    }
+    std::uint32_t lanes[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), accumulated);
+    sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < size; i++) {
+        sum += row[i];
+    }
+    return sum;
+}
+
+
+// Private methods
+
+// Get the voxels of the volume in the layout, copying them to a store the volume keeps with its voxels if it has none
+const VoxelStore *RayCaster::getStore(const Volume *const volume) const {
+    const glm::ivec3 resolution(volume->getResolution());
+    const VoxelStore *const kept = static_cast<const VoxelStore *>(volume->getDerived("voxel store"));
+    if ((kept != nullptr) && (kept->getLayout() == layout) && (kept->getResolution() == resolution)) {
+        return kept;
+    }
+
+    // Every task copies its own slices
+    const GLushort *const voxel = volume->getVoxels();
+    VoxelStore *const store = new VoxelStore();
+    store->allocate(resolution, volume->getFormat() == VolumeData::RAW8 ? 1U : 2U, layout);
+    parallel(static_cast<std::size_t>(resolution.z), 4U, [store, voxel](const std::size_t &first, const std::size_t &last) {
+        store->copy(voxel, first, last);
+    });
+    volume->setDerived("voxel store", store);
+    return store;
+}
+
+// Cast the rays of the image rows in the range with the intensity projection
+template <typename T, typename Filter, typename Composition>
+void RayCaster::castRows(const RayCaster::Frame &frame, const std::size_t &first, const std::size_t &last, GLubyte *image) const {
+    const VoxelAccessor<T> voxels = voxel_store->getAccessor<T>();
+    const Lanes norm(frame.norm);
+    const Lanes step(frame.step);
+    const Lanes one(1.0F);
+    const Lanes zero(0.0F);
+    for (std::size_t y = first; y < last; y++) {
+        for (GLsizei x = 0; x < frame.width; x += static_cast<GLsizei>(Lanes::SIZE)) {
+            // Set up a packet of rays, the missing ones and the ones past the row end have no samples
+            float origin[3][Lanes::SIZE];
+            float direction[3][Lanes::SIZE];
+            float t_near[Lanes::SIZE];
+            float t_far[Lanes::SIZE];
+            bool hit[Lanes::SIZE];
+            for (unsigned int lane = 0U; lane < Lanes::SIZE; lane++) {
+                RayCaster::Ray ray;
+                const GLsizei pixel = x + static_cast<GLsizei>(lane);
+                hit[lane] = (pixel < frame.width) && RayCaster::setupRay(frame, pixel, static_cast<GLsizei>(y), ray);
+                for (int i = 0; i < 3; i++) {
+                    origin[i][lane] = hit[lane] ? ray.origin[i] : 0.0F;
+                    direction[i][lane] = hit[lane] ? ray.direction[i] : 0.0F;
+                }
+                t_near[lane] = hit[lane] ? ray.t_near : 0.0F;
+                t_far[lane] = hit[lane] ? ray.t_far : 0.0F;
+            }
+
+            // March the packet while any of its rays is inside, the finished lanes keep their result
+            const Lanes origin_x = Lanes::load(origin[0]);
+            const Lanes origin_y = Lanes::load(origin[1]);
+            const Lanes origin_z = Lanes::load(origin[2]);
+            const Lanes direction_x = Lanes::load(direction[0]);
+            const Lanes direction_y = Lanes::load(direction[1]);
+            const Lanes direction_z = Lanes::load(direction[2]);
+            const Lanes far = Lanes::load(t_far);
+            Lanes t = Lanes::load(t_near);
+            Lanes result = Composition::initial();
+            Lanes count(0.0F);
+            for (Lanes active = Lanes::less(t, far); active.mask() != 0; t = t + step, active = Lanes::less(t, far)) {
+                const Lanes value = Filter::sample(voxels, origin_x + t * direction_x, origin_y + t * direction_y, origin_z + t * direction_z) * norm;
+                result = Lanes::select(active, Composition::combine(result, value), result);
+                count = count + Lanes::select(active, one, zero);
+            }
+
+            // Map the results to the transfer function
+            float value[Lanes::SIZE];
+            float samples[Lanes::SIZE];
+            result.store(value);
+            count.store(samples);
+            for (unsigned int lane = 0U; lane < Lanes::SIZE; lane++) {
+                if (hit[lane]) {
+                    const glm::vec4 color = CPURenderer::classify(classification, Composition::resolve(value[lane], samples[lane]));
+                    CPURenderer::store(glm::vec4(glm::vec3(color) * color.a, color.a), &image[4U * (y * static_cast<std::size_t>(frame.width) + static_cast<std::size_t>(x) + lane)]);
+                }
+            }
+        }
+    }
+}
+
+// Composite the rays of the image rows in the range front to back
+template <typename T, typename Filter>
+void RayCaster::compositeRows(const RayCaster::Frame &frame, const std::size_t &first, const std::size_t &last, GLubyte *image) const {
+    const VoxelAccessor<T> voxels = voxel_store->getAccessor<T>();
+    for (std::size_t y = first; y < last; y++) {
+        for (GLsizei x = 0; x < frame.width; x++) {
+            RayCaster::Ray ray;
+            if (!RayCaster::setupRay(frame, x, static_cast<GLsizei>(y), ray)) {
+                continue;
+            }
+
+            // Emission absorption with early ray termination
+            glm::vec4 result(0.0F);
+            for (float t = ray.t_near; (t < ray.t_far) && (result.a < 0.99F); t += frame.step) {
+                const float value = Filter::sample(voxels, ray.origin + t * ray.direction) * frame.norm;
+                result += (1.0F - result.a) * CPURenderer::classify(corrected, value);
+            }
+            CPURenderer::store(result, &image[4U * (y * static_cast<std::size_t>(frame.width) + static_cast<std::size_t>(x))]);
+        }
+    }
+}
+
+// Reduce the voxels along the axis into the projection
+template <typename T>
+void RayCaster::project(const T *voxel, const RayCaster::Frame &frame, const int &axis) {
+    // Remaining axes and the voxels of the drawn brick along the axis
+    const glm::ivec3 &resolution = frame.resolution;
+    const int axis_u = axis == 0 ? 1 : 0;
+    const int axis_v = axis == 2 ? 1 : 2;
+    const std::size_t size_u = static_cast<std::size_t>(resolution[axis_u]);
+    const std::size_t size_v = static_cast<std::size_t>(resolution[axis_v]);
+    const int lower = std::min(std::max(0, static_cast<int>(std::round(frame.clip_min[axis] * static_cast<float>(resolution[axis])))), resolution[axis] - 1);
+    const int upper = std::max(lower + 1, std::min(resolution[axis], static_cast<int>(std::round(frame.clip_max[axis] * static_cast<float>(resolution[axis])))));
+    const std::size_t depth = static_cast<std::size_t>(upper - lower);
+    const std::size_t row = static_cast<std::size_t>(resolution.x);
+    const std::size_t plane = row * static_cast<std::size_t>(resolution.y);
+    const Volume::Composition composition = frame.composition;
+    const float norm = composition == Volume::AVERAGE ? frame.norm / static_cast<float>(depth) : frame.norm;
+    projection.assign(size_u * size_v, 0.0F);
+
+    // Every output row is reduced on its own
+    parallel(size_v, 1U, [this, voxel, axis, composition, norm, size_u, lower, upper, depth, row, plane](const std::size_t &first, const std::size_t &last) {
+        std::vector<T> extreme(size_u);
+        std::vector<std::uint32_t> sum(size_u);
+        for (std::size_t v = first; v < last; v++) {
+            float *const target = &projection[v * size_u];
+
+            // Along x every voxel row is reduced horizontally to a single value
+            if (axis == 0) {
+                for (std::size_t u = 0U; u < size_u; u++) {
+                    const T *const source = &voxel[v * plane + u * row + static_cast<std::size_t>(lower)];
+                    const std::uint32_t value = composition == Volume::MIP ? reduceMaximum(source, depth) : composition == Volume::MINIP ? reduceMinimum(source, depth) : reduceSum(source, depth);
+                    target[u] = static_cast<float>(value) * norm;
+                }
+                continue;
+            }
+
+            // Along y or z the voxel rows are combined vertically
+            std::fill(extreme.begin(), extreme.end(), composition == Volume::MINIP ? static_cast<T>(~static_cast<T>(0U)) : static_cast<T>(0U));
+            std::fill(sum.begin(), sum.end(), 0U);
+            for (int k = lower; k < upper; k++) {
+                const std::size_t index = axis == 1 ? v * plane + static_cast<std::size_t>(k) * row : static_cast<std::size_t>(k) * plane + v * row;
+                if (composition == Volume::MIP) {
+                    combineMaximum(&voxel[index], extreme.data(), size_u);
+                }
+                else if (composition == Volume::MINIP) {
+                    combineMinimum(&voxel[index], extreme.data(), size_u);
+                }
+                else {
+                    combineSum(&voxel[index], sum.data(), size_u);
+                }
+            }
+            for (std::size_t u = 0U; u < size_u; u++) {
+                target[u] = static_cast<float>(composition == Volume::AVERAGE ? sum[u] : static_cast<std::uint32_t>(extreme[u])) * norm;
+            }
+        }
+    });
+}
+
+// Composite the rays of the image rows in the range through all the volumes of the multi-volume frame
+void RayCaster::compositeLayers(const RayCaster::Frame &frame, const std::size_t &first, const std::size_t &last, GLubyte *image) const {
+    std::vector<RayCaster::Span> spans;
+    spans.reserve(drawn_layers);
+    for (std::size_t y = first; y < last; y++) {
+        for (GLsizei x = 0; x < frame.width; x++) {
+            // Ray through the pixel center in world space
+            const float ndc_x = 2.0F * (static_cast<float>(x) + 0.5F) / static_cast<float>(frame.width) - 1.0F;
+            const float ndc_y = 2.0F * (static_cast<float>(y) + 0.5F) / static_cast<float>(frame.height) - 1.0F;
+            const glm::vec4 near_pos = frame.inverse_mat * glm::vec4(ndc_x, ndc_y, -1.0F, 1.0F);
+            const glm::vec4 far_pos = frame.inverse_mat * glm::vec4(ndc_x, ndc_y, 1.0F, 1.0F);
+            const glm::vec4 near = near_pos / near_pos.w;
+            const glm::vec3 far = glm::vec3(far_pos) / far_pos.w;
+            const glm::vec4 direction(glm::normalize(far - glm::vec3(near)), 0.0F);
+            const float length = glm::distance(glm::vec3(near), far);
+
+            // Intersect the ray with the drawn box of every volume in its texture space with the t axis swapped, the missed ones are not visited again
+            spans.clear();
+            float t_first = std::numeric_limits<float>::max();
+            float t_last = 0.0F;
+            for (std::size_t i = 0U; i < drawn_layers; i++) {
+                const RayCaster::Layer *const layer = layers[i];
+                RayCaster::Span span;
+                span.layer = layer;
+                span.ray.origin = glm::vec3(layer->texture_mat * near);
+                span.ray.direction = glm::vec3(layer->texture_mat * direction);
+                span.ray.origin.y = 1.0F - span.ray.origin.y;
+                span.ray.direction.y = -span.ray.direction.y;
+                span.ray.t_near = 0.0F;
+                span.ray.t_far = length;
+                for (int axis = 0; axis < 3; axis++) {
+                    const float inverse = 1.0F / (span.ray.direction[axis] == 0.0F ? 1e-7F : span.ray.direction[axis]);
+                    const float t_0 = (layer->clip_min[axis] - span.ray.origin[axis]) * inverse;
+                    const float t_1 = (layer->clip_max[axis] - span.ray.origin[axis]) * inverse;
+                    span.ray.t_near = std::max(span.ray.t_near, std::min(t_0, t_1));
+                    span.ray.t_far = std::min(span.ray.t_far, std::max(t_0, t_1));
+                }
+                if (span.ray.t_near < span.ray.t_far) {
+                    t_first = std::min(t_first, span.ray.t_near);
+                    t_last = std::max(t_last, span.ray.t_far);
+                    spans.push_back(span);
+                }
+            }
+            if (spans.empty()) {
+                continue;
+            }
+
+            // Emission absorption with early ray termination at whole steps from the near plane, the samples at the same distance are mixed by their opacities and the gaps between the volumes are skipped
+            glm::vec4 result(0.0F);
+            float t = std::ceil(t_first / frame.step) * frame.step;
+            while ((t < t_last) && (result.a < 0.99F)) {
+                glm::vec3 emission(0.0F);
+                float weight = 0.0F;
+                float transparency = 1.0F;
+                float next = t_last;
+                bool inside = false;
+                for (const RayCaster::Span &span : spans) {
+                    if (t < span.ray.t_near) {
+                        next = std::min(next, span.ray.t_near);
+                    }
+                    else if (t < span.ray.t_far) {
+                        const RayCaster::Layer *const layer = span.layer;
+                        const glm::vec4 sample = CPURenderer::classify(layer->corrected, layer->sample(*layer->store, span.ray.origin + t * span.ray.direction) * layer->norm);
+                        emission += glm::vec3(sample);
+                        weight += sample.a;
+                        transparency *= 1.0F - sample.a;
+                        inside = true;
+                    }
+                }
+
+                // Between the volumes the ray jumps to the first step inside the next one
+                if (!inside) {
+                    t += std::max(1.0F, std::ceil((next - t) / frame.step)) * frame.step;
+                    continue;
+                }
+
+                if (weight > 0.0F) {
+                    const float alpha = 1.0F - transparency;
+                    result += (1.0F - result.a) * glm::vec4(emission * (alpha / weight), alpha);
+                }
+                t += frame.step;
+            }
+            CPURenderer::store(result, &image[4U * (y * static_cast<std::size_t>(frame.width) + static_cast<std::size_t>(x))]);
+        }
+    }
+}
+
+// Draw the image rows in the range from the projection along the axis
+void RayCaster::drawProjection(const RayCaster::Frame &frame, const int &axis, const std::size_t &first, const std::size_t &last, GLubyte *image) const {
+    const int axis_u = axis == 0 ? 1 : 0;
+    const int axis_v = axis == 2 ? 1 : 2;
+    const int size_u = frame.resolution[axis_u];
+    const int size_v = frame.resolution[axis_v];
+    for (std::size_t y = first; y < last; y++) {
+        for (GLsizei x = 0; x < frame.width; x++) {
+            RayCaster::Ray ray;
+            if (!RayCaster::setupRay(frame, x, static_cast<GLsizei>(y), ray)) {
+                continue;
+            }
+
+            // Bilinear sample of the projection at the entry point, clamped to the edges
+            const glm::vec3 entry = ray.origin + ray.t_near * ray.direction;
+            const float u = std::min(std::max(entry[axis_u] * static_cast<float>(size_u) - 0.5F, 0.0F), static_cast<float>(size_u - 1));
+            const float v = std::min(std::max(entry[axis_v] * static_cast<float>(size_v) - 0.5F, 0.0F), static_cast<float>(size_v - 1));
+            const int u_0 = static_cast<int>(u);
+            const int v_0 = static_cast<int>(v);
+            const int u_1 = std::min(u_0 + 1, size_u - 1);
+            const int v_1 = std::min(v_0 + 1, size_v - 1);
+            const float weight_u = u - static_cast<float>(u_0);
+            const float weight_v = v - static_cast<float>(v_0);
+            const float lower = projection[v_0 * size_u + u_0] + (projection[v_0 * size_u + u_1] - projection[v_0 * size_u + u_0]) * weight_u;
+            const float upper = projection[v_1 * size_u + u_0] + (projection[v_1 * size_u + u_1] - projection[v_1 * size_u + u_0]) * weight_u;
+            const glm::vec4 color = CPURenderer::classify(classification, lower + (upper - lower) * weight_v);
+            CPURenderer::store(glm::vec4(glm::vec3(color) * color.a, color.a), &image[4U * (y * static_cast<std::size_t>(frame.width) + static_cast<std::size_t>(x))]);
+        }
+    }
+}
+
+
+// Private static methods
+
+// Set up the ray of the pixel, as the ray casting fragment shader does
+bool RayCaster::setupRay(const RayCaster::Frame &frame, const GLsizei &x, const GLsizei &y, RayCaster::Ray &ray) {
+    // Ray in texture space through the pixel center
+    const float length = CPURenderer::getRay(frame.inverse_mat, frame.volume_mat, x, y, frame.width, frame.height, ray.origin, ray.direction);
+
+    // Intersect the ray with the drawn box of the texture
+    float t_near = 0.0F;
+    float t_far = length;
+    for (int i = 0; i < 3; i++) {
+        const float inverse = 1.0F / (ray.direction[i] == 0.0F ? 1e-7F : ray.direction[i]);
+        const float t_0 = (frame.clip_min[i] - ray.origin[i]) * inverse;
+        const float t_1 = (frame.clip_max[i] - ray.origin[i]) * inverse;
+        t_near = std::max(t_near, std::min(t_0, t_1));
+        t_far = std::min(t_far, std::max(t_0, t_1));
+    }
+    if (!(t_near < t_far)) {
+        return false;
+    }
+
+    // Samples at whole steps from the near plane
+    ray.t_near = std::ceil(t_near / frame.step) * frame.step;
+    ray.t_far = t_far;
+    return true;
+}
+
+// Get the kernel instantiated for the voxel type, the filter and the composition
+RayCaster::Kernel RayCaster::getKernel(const std::size_t &voxel_type, const Volume::Filter &filter, const Volume::Composition &composition) {
+    // The table is filled once, a new voxel type only needs its line
+    static const std::vector<RayCaster::Kernel> table = [] {
+        std::vector<RayCaster::Kernel> kernels;
+        kernels.reserve(RayCaster::VOXEL_TYPES * RayCaster::FILTERS * RayCaster::COMPOSITIONS);
+        RayCaster::addKernels<GLubyte>(kernels);
+        RayCaster::addKernels<GLushort>(kernels);
+        return kernels;
+    }();
+    return table[(voxel_type * RayCaster::FILTERS + static_cast<std::size_t>(filter)) * RayCaster::COMPOSITIONS + static_cast<std::size_t>(composition)];
+}
+
+// Sample the store of the voxel type with the filter
+template <typename T, typename Filter>
+float RayCaster::sampleStore(const VoxelStore &store, const glm::vec3 &point) {
+    return Filter::sample(store.getAccessor<T>(), point);
+}
+
+// Get the sampler of the voxel type and the filter
+RayCaster::Sampler RayCaster::getSampler(const std::size_t &voxel_type, const Volume::Filter &filter) {
+    static const RayCaster::Sampler table[RayCaster::VOXEL_TYPES][RayCaster::FILTERS] = {
+        {&RayCaster::sampleStore<GLubyte, NearestFilter>, &RayCaster::sampleStore<GLubyte, TrilinearFilter>, &RayCaster::sampleStore<GLubyte, TricubicFilter>},
+        {&RayCaster::sampleStore<GLushort, NearestFilter>, &RayCaster::sampleStore<GLushort, TrilinearFilter>, &RayCaster::sampleStore<GLushort, TricubicFilter>}
+    };
+    return table[voxel_type][static_cast<std::size_t>(filter)];
+}
+
+// Add the kernels of the voxel type and the filter to the table, in the order of the compositions
+template <typename T, typename Filter>
+void RayCaster::addKernels(std::vector<RayCaster::Kernel> &table) {
+    table.push_back(&RayCaster::compositeRows<T, Filter>);
+    table.push_back(&RayCaster::castRows<T, Filter, MaximumComposition>);
+    table.push_back(&RayCaster::castRows<T, Filter, MinimumComposition>);
+    table.push_back(&RayCaster::castRows<T, Filter, AverageComposition>);
+}
+
+// Add the kernels of the voxel type to the table, in the order of the filters and the compositions
+template <typename T>
+void RayCaster::addKernels(std::vector<RayCaster::Kernel> &table) {
+    RayCaster::addKernels<T, NearestFilter>(table);
+    RayCaster::addKernels<T, TrilinearFilter>(table);
+    RayCaster::addKernels<T, TricubicFilter>(table);
+}
+
+
+// Constructors
+
+// Ray caster constructor
+RayCaster::RayCaster(const unsigned int &threads) :
+    CPURenderer(threads),
+    voxel_store(nullptr),
+    layout(VoxelStore::MORTON),
+    classification(256U),
+    corrected(256U),
+    projection_revision(0U),
+    projection_axis(-1),
+    projection_composition(Volume::DVR),
+    axis_aligned(false),
+    drawn_layers(0U) {}
+
+
+// Getters
+
+// Get the axis aligned status of the last frame
+bool RayCaster::isAxisAligned() const {
+    return axis_aligned;
+}
+
+// Get the layout of the sampled voxels
+VoxelStore::Layout RayCaster::getLayout() const {
+    return layout;
+}
+
+// Get the number of volumes drawn in the last frame
+std::size_t RayCaster::getDrawnLayers() const {
+    return drawn_layers;
+}
+
+
+// Setters
+
+// Set the layout of the sampled voxels
+void RayCaster::setLayout(const VoxelStore::Layout &new_layout) {
+    layout = new_layout;
+}
+
+
+// Methods
+
+// Render the volume seen by the camera into the premultiplied RGBA image
+void RayCaster::render(const Volume *const volume, const Camera *const camera, const GLsizei &width, const GLsizei &height, std::vector<GLubyte> &image) {
+    // Clear to transparent
+    image.assign(4U * static_cast<std::size_t>(std::max(width, 0)) * static_cast<std::size_t>(std::max(height, 0)), 0U);
+    axis_aligned = false;
+    drawn_layers = 0U;
+    if (!volume->isEnabled() || !volume->isOpen() || (volume->getVoxels() == nullptr) || (width <= 0) || (height <= 0)) {
+        return;
+    }
+    drawn_layers = 1U;
+
+    // Constants of the frame
+    RayCaster::Frame frame;
+    frame.inverse_mat = glm::inverse(camera->getProjectionMatrix() * camera->getViewMatrix() * volume->getModelMatrix());
+    frame.volume_mat = volume->getVolumeMatrix();
+    frame.clip_min = volume->getClipMin();
+    frame.clip_max = volume->getClipMax();
+    frame.resolution = glm::ivec3(volume->getResolution());
+    frame.step = volume->getSampleDistance();
+    frame.norm = volume->getFormat() == VolumeData::RAW8 ? 1.0F / 255.0F : volume->getValueScale() / 65535.0F;
+    frame.width = width;
+    frame.height = height;
+    frame.composition = volume->getComposition();
+
+    // Transfer function as colors and as opacity corrected premultiplied samples
+    const GLubyte *const data = volume->getTransferFunction()->getData();
+    const float step_scale = volume->getStepScale();
+    for (std::size_t i = 0U; i < 256U; i++) {
+        const glm::vec4 color = glm::vec4(data[4U * i], data[4U * i + 1U], data[4U * i + 2U], data[4U * i + 3U]) / 255.0F;
+        const float alpha = 1.0F - std::pow(1.0F - color.a, step_scale);
+        classification[i] = color;
+        corrected[i] = glm::vec4(glm::vec3(color) * alpha, alpha);
+    }
+
+    // Orthographic views along an axis are drawn from a projection of the voxels, every ray of them crosses the same voxels, which the trilinear filter interpolates
+    int axis = -1;
+    if ((frame.composition != Volume::DVR) && (volume->getFilter() == Volume::TRILINEAR) && camera->isOrthogonal()) {
+        RayCaster::Ray ray;
+        RayCaster::setupRay(frame, width / 2, height / 2, ray);
+        const glm::vec3 direction = glm::abs(glm::normalize(ray.direction));
+        for (int i = 0; i < 3; i++) {
+            if (direction[i] > 1.0F - 1e-4F) {
+                axis = i;
+            }
+        }
+    }
+
+    const bool bytes = volume->getFormat() == VolumeData::RAW8;
+    const GLushort *const voxel = volume->getVoxels();
+    GLubyte *const target = image.data();
+    const std::size_t rows = static_cast<std::size_t>(height);
+    if (axis >= 0) {
+        axis_aligned = true;
+        if ((axis != projection_axis) || (frame.composition != projection_composition) || (volume->getDataRevision() != projection_revision)) {
+            if (bytes) {
+                project(reinterpret_cast<const GLubyte *>(voxel), frame, axis);
+            }
+            else {
+                project(voxel, frame, axis);
+            }
+            projection_axis = axis;
+            projection_composition = frame.composition;
+            projection_revision = volume->getDataRevision();
+        }
+        parallel(rows, 4U, [this, &frame, axis, target](const std::size_t &first, const std::size_t &last) {
+            drawProjection(frame, axis, first, last, target);
+        });
+    }
+
+    // The rays sample the store with the kernel of the voxel type, the filter and the composition, chosen once per frame
+    else {
+        voxel_store = getStore(volume);
+        const RayCaster::Kernel kernel = RayCaster::getKernel(bytes ? 0U : 1U, volume->getFilter(), frame.composition);
+        parallel(rows, 4U, [this, &frame, kernel, target](const std::size_t &first, const std::size_t &last) {
+            (this->*kernel)(frame, first, last, target);
+        });
+    }
+}
+
+// Render the volumes seen by the camera in one pass with the emission absorption model
+void RayCaster::render(const std::vector<const Volume *> &volumes, const Camera *const camera, const GLsizei &width, const GLsizei &height, std::vector<GLubyte> &image) {
+    // Clear to transparent
+    image.assign(4U * static_cast<std::size_t>(std::max(width, 0)) * static_cast<std::size_t>(std::max(height, 0)), 0U);
+    axis_aligned = false;
+    drawn_layers = 0U;
+    if ((width <= 0) || (height <= 0)) {
+        return;
+    }
+
+    // Constants of the frame, the rays are cast in world space at the distance shared by the volumes
+    RayCaster::Frame frame;
+    frame.inverse_mat = glm::inverse(camera->getProjectionMatrix() * camera->getViewMatrix());
+    frame.step = Volume::getSampleDistance(volumes);
+    frame.width = width;
+    frame.height = height;
+    frame.composition = Volume::DVR;
+
+    // Direction of the central ray, the opacity correction of every volume assumes its scale along it
+    glm::vec3 origin;
+    glm::vec3 direction;
+    CPURenderer::getRay(frame.inverse_mat, glm::mat4(1.0F), width / 2, height / 2, width, height, origin, direction);
+
+    // Layer of every drawn volume, the volume keeps its voxel store with its voxels
+    for (const Volume *const volume : volumes) {
+        if (!volume->isEnabled() || !volume->isOpen() || (volume->getVoxels() == nullptr)) {
+            continue;
+        }
+
+        if (drawn_layers == layers.size()) {
+            layers.push_back(new RayCaster::Layer());
+            layers.back()->corrected.resize(256U);
+        }
+        RayCaster::Layer *const layer = layers[drawn_layers++];
+        const bool bytes = volume->getFormat() == VolumeData::RAW8;
+
+        // Frame constants of the volume
+        layer->store = getStore(volume);
+        layer->sample = RayCaster::getSampler(bytes ? 0U : 1U, volume->getFilter());
+        layer->texture_mat = volume->getVolumeMatrix() * glm::inverse(volume->getModelMatrix());
+        layer->clip_min = volume->getClipMin();
+        layer->clip_max = volume->getClipMax();
+        layer->norm = bytes ? 1.0F / 255.0F : volume->getValueScale() / 65535.0F;
+
+        // Transfer function with the opacity corrected for the model space distance between the shared samples
+        const float exponent = frame.step * glm::length(direction / volume->getScale()) * volume->getStepScale() / volume->getSampleDistance();
+        const GLubyte *const data = volume->getTransferFunction()->getData();
+        for (std::size_t i = 0U; i < 256U; i++) {
+            const glm::vec4 color = glm::vec4(data[4U * i], data[4U * i + 1U], data[4U * i + 2U], data[4U * i + 3U]) / 255.0F;
+            const float alpha = 1.0F - std::pow(1.0F - color.a, exponent);
+            layer->corrected[i] = glm::vec4(glm::vec3(color) * alpha, alpha);
+        }
+    }
+
+    // Every row is composited through all the volumes
+    if (drawn_layers > 0U) {
+        GLubyte *const target = image.data();
+        parallel(static_cast<std::size_t>(height), 4U, [this, &frame, target](const std::size_t &first, const std::size_t &last) {
+            compositeLayers(frame, first, last, target);
+        });
+    }
+}
+
+// Destructor
+
+// Ray caster destructor
+RayCaster::~RayCaster() {
+    for (RayCaster::Layer *const layer : layers) {
+        delete layer;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,268 @@
+#ifndef __RAY_CASTER_HPP_
+#define __RAY_CASTER_HPP_
+
+#include "cpurenderer.hpp"
+#include "lanes.hpp"
+#include "kernels.hpp"
+#include "voxelstore.hpp"
+
+#include "../volume/volume.hpp"
+#include "../scene/camera.hpp"
+
+#include "../glad/glad.h"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include <glm/vec3.hpp>
+
+#include <vector>
+
+
+/** Ray caster on the CPU threads over a bricked copy of the voxels, the projections march packets of rays with SIMD lanes and the orthographic views along an axis reduce the linear voxels directly */
+class RayCaster : public CPURenderer {
+    private:
+        // Structures
+
+        /** Constants of the frame being rendered */
+        struct Frame {
+            /** Matrix from the normalized device coordinates to the model space */
+            glm::mat4 inverse_mat;
+
+            /** Matrix from the model space to the texture space */
+            glm::mat4 volume_mat;
+
+            /** Lower corner of the drawn brick in texture coordinates */
+            glm::vec3 clip_min;
+
+            /** Upper corner of the drawn brick in texture coordinates */
+            glm::vec3 clip_max;
+
+            /** Resolution of the read region */
+            glm::ivec3 resolution;
+
+            /** Distance between samples in model space */
+            float step;
+
+            /** Factor from the raw values to the normalized data values */
+            float norm;
+
+            /** Image width */
+            GLsizei width;
+
+            /** Image height */
+            GLsizei height;
+
+            /** Composition mode */
+            Volume::Composition composition;
+        };
+
+        /** Ray in texture space */
+        struct Ray {
+            /** Origin at the near plane */
+            glm::vec3 origin;
+
+            /** Direction, unit length in model space */
+            glm::vec3 direction;
+
+            /** Distance of the first sample */
+            float t_near;
+
+            /** Distance of the exit point */
+            float t_far;
+        };
+
+
+        // Types
+
+        /** Kernel drawing the image rows in the range */
+        typedef void (RayCaster::*Kernel)(const RayCaster::Frame &frame, const std::size_t &first, const std::size_t &last, GLubyte *image) const;
+
+        /** Filter sampling the raw voxels of a store at the texture coordinates */
+        typedef float (*Sampler)(const VoxelStore &store, const glm::vec3 &point);
+
+
+        // Structures
+
+        /** Volume of a multi-volume frame */
+        struct Layer {
+            /** Voxels sampled by the rays, kept by the volume */
+            const VoxelStore *store;
+
+            /** Filter of the voxel type and the sampling filter of the volume */
+            RayCaster::Sampler sample;
+
+            /** Matrix from the world space to the texture space */
+            glm::mat4 texture_mat;
+
+            /** Lower corner of the drawn brick in texture coordinates */
+            glm::vec3 clip_min;
+
+            /** Upper corner of the drawn brick in texture coordinates */
+            glm::vec3 clip_max;
+
+            /** Factor from the raw values to the normalized data values */
+            float norm;
+
+            /** Transfer function with the opacity corrected for the shared sample distance and premultiplied colors */
+            std::vector<glm::vec4> corrected;
+        };
+
+        /** Ray of a multi-volume frame inside a volume, in its texture space */
+        struct Span {
+            /** Volume crossed by the ray */
+            const RayCaster::Layer *layer;
+
+            /** Ray in the texture space of the volume */
+            RayCaster::Ray ray;
+        };
+
+
+        // Static const attributes
+
+        /** Number of voxel types of the kernels, the bytes and the unsigned shorts */
+        static const std::size_t VOXEL_TYPES = 2U;
+
+        /** Number of filters of the kernels */
+        static const std::size_t FILTERS = Volume::TRICUBIC + 1U;
+
+        /** Number of compositions of the kernels */
+        static const std::size_t COMPOSITIONS = Volume::AVERAGE + 1U;
+
+
+        // Attributes
+
+        /** Voxels sampled by the rays of the frame, kept by the volume */
+        const VoxelStore *voxel_store;
+
+        /** Layout of the sampled voxels */
+        VoxelStore::Layout layout;
+
+
+        /** Transfer function of the frame, non premultiplied colors */
+        std::vector<glm::vec4> classification;
+
+        /** Transfer function of the frame with the opacity corrected for the sample distance and premultiplied colors */
+        std::vector<glm::vec4> corrected;
+
+
+        /** Projection of the voxels along an axis, normalized data values with the first remaining axis fastest */
+        std::vector<float> projection;
+
+        /** Data revision of the volume the projection was reduced from */
+        unsigned long long int projection_revision;
+
+        /** Axis of the projection, negative if there is none */
+        int projection_axis;
+
+        /** Composition mode of the projection */
+        Volume::Composition projection_composition;
+
+        /** Axis aligned status of the last frame */
+        bool axis_aligned;
+
+
+        /** Volumes of the multi-volume frames, in the order they were given */
+        std::vector<RayCaster::Layer *> layers;
+
+        /** Volumes drawn in the last frame */
+        std::size_t drawn_layers;
+
+
+        // Constructors
+
+        /** Disable the default copy constructor */
+        RayCaster(const RayCaster &) = delete;
+
+        /** Disable the assignation operator */
+        RayCaster &operator=(const RayCaster &) = delete;
+
+
+        // Methods
+
+        /** Get the voxels of the volume in the layout, copying them to a store the volume keeps with its voxels if it has none */
+        const VoxelStore *getStore(const Volume *const volume) const;
+
+        /** Cast the rays of the image rows in the range with the intensity projection */
+        template <typename T, typename Filter, typename Composition>
+        void castRows(const RayCaster::Frame &frame, const std::size_t &first, const std::size_t &last, GLubyte *image) const;
+
+        /** Composite the rays of the image rows in the range front to back with the emission absorption model */
+        template <typename T, typename Filter>
+        void compositeRows(const RayCaster::Frame &frame, const std::size_t &first, const std::size_t &last, GLubyte *image) const;
+
+        /** Reduce the voxels along the axis into the projection */
+        template <typename T>
+        void project(const T *voxel, const RayCaster::Frame &frame, const int &axis);
+
+        /** Composite the rays of the image rows in the range through all the volumes of the multi-volume frame, the samples of the overlapping volumes are mixed by their opacities */
+        void compositeLayers(const RayCaster::Frame &frame, const std::size_t &first, const std::size_t &last, GLubyte *image) const;
+
+        /** Draw the image rows in the range from the projection along the axis */
+        void drawProjection(const RayCaster::Frame &frame, const int &axis, const std::size_t &first, const std::size_t &last, GLubyte *image) const;
+
+
+        // Static methods
+
+        /** Set up the ray of the pixel, returns false if it misses the drawn brick */
+        static bool setupRay(const RayCaster::Frame &frame, const GLsizei &x, const GLsizei &y, RayCaster::Ray &ray);
+
+        /** Get the kernel instantiated for the voxel type, the filter and the composition */
+        static RayCaster::Kernel getKernel(const std::size_t &voxel_type, const Volume::Filter &filter, const Volume::Composition &composition);
+
+        /** Sample the store of the voxel type with the filter */
+        template <typename T, typename Filter>
+        static float sampleStore(const VoxelStore &store, const glm::vec3 &point);
+
+        /** Get the sampler of the voxel type and the filter */
+        static RayCaster::Sampler getSampler(const std::size_t &voxel_type, const Volume::Filter &filter);
+
+        /** Add the kernels of the voxel type and the filter to the table, in the order of the compositions */
+        template <typename T, typename Filter>
+        static void addKernels(std::vector<RayCaster::Kernel> &table);
+
+        /** Add the kernels of the voxel type to the table, in the order of the filters and the compositions */
+        template <typename T>
+        static void addKernels(std::vector<RayCaster::Kernel> &table);
+
+
+    public:
+        // Constructors
+
+        /** Ray caster constructor, the threads default to all the threads of the task scheduler */
+        RayCaster(const unsigned int &threads = 0U);
+
+
+        // Getters
+
+        /** Get the axis aligned status of the last frame, true if it was drawn from a projection of the voxels */
+        bool isAxisAligned() const;
+
+        /** Get the layout of the sampled voxels */
+        VoxelStore::Layout getLayout() const;
+
+        /** Get the number of volumes drawn in the last frame */
+        std::size_t getDrawnLayers() const;
+
+
+        // Setters
+
+        /** Set the layout of the sampled voxels, they are copied again on the next frame */
+        void setLayout(const VoxelStore::Layout &new_layout);
+
+
+        // Methods
+
+        /** Render the volume seen by the camera into the premultiplied RGBA image, the rows from bottom to top */
+        void render(const Volume *const volume, const Camera *const camera, const GLsizei &width, const GLsizei &height, std::vector<GLubyte> &image);
+
+        /** Render the volumes seen by the camera in one pass with the emission absorption model, every ray only samples the volumes it crosses and skips the gaps between them */
+        void render(const std::vector<const Volume *> &volumes, const Camera *const camera, const GLsizei &width, const GLsizei &height, std::vector<GLubyte> &image);
+
+
+        // Destructor
+
+        /** Ray caster destructor */
+        virtual ~RayCaster();
+};
+
+#endif // __RAY_CASTER_HPP_
\ No newline at end of file
@@ -0,0 +1,507 @@
+#include "shearwarp.hpp"
+
+#include "../profiler/profilerscope.hpp"
+
+#include <glm/matrix.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+
+// Static const attributes
+
+// Index of the transparent entry of the table
+const GLushort ShearWarp::TRANSPARENT;
+
+// Largest intermediate image side in voxels of the largest grid side
+const int ShearWarp::MAX_INTERMEDIATE;
+
+
+/** Get the next pixel that is not opaque, compressing the path of skip links */
+static int findPixel(std::vector<int> &next, int pixel) {
+    int root = pixel;
+    while (next[root] != root) {
+        root = next[root];
+    }
+    while (next[pixel] != root) {
+        const int following = next[pixel];
+        next[pixel] = root;
+        pixel = following;
+    }
+    return root;
+}
+
+
+// Classification
+
+// Get the size of the encodings in bytes
+std::size_t ShearWarp::Classification::getBytes() const {
+    std::size_t bytes = 0U;
+    for (const ShearWarp::Encoding &axis : encoding) {
+        bytes += sizeof(std::size_t) * (axis.run_offset.size() + axis.voxel_offset.size()) + sizeof(std::uint32_t) * axis.runs.size() + axis.voxels.size();
+    }
+    return bytes;
+}
+
+
+// Private methods
+
+// Classify the voxels inside the brick of the classification and encode them along the three axes
+template <typename T>
+void ShearWarp::classify(const T *voxel, const glm::ivec3 &resolution, const float &norm, ShearWarp::Classification &target) const {
+    // Transfer function index of every voxel, the transparent ones and the ones outside the brick are marked
+    const glm::ivec3 lower = target.lower;
+    const glm::ivec3 upper = target.upper;
+    const std::vector<bool> &visible = target.visible;
+    const std::size_t row = static_cast<std::size_t>(resolution.x);
+    const std::size_t plane = row * static_cast<std::size_t>(resolution.y);
+    std::vector<GLushort> index(plane * static_cast<std::size_t>(resolution.z));
+    parallel(static_cast<std::size_t>(resolution.z), 1U, [voxel, &resolution, &lower, &upper, norm, &visible, row, plane, &index](const std::size_t &first, const std::size_t &last) {
+        for (std::size_t z = first; z < last; z++) {
+            for (int y = 0; y < resolution.y; y++) {
+                for (int x = 0; x < resolution.x; x++) {
+                    const std::size_t i = z * plane + static_cast<std::size_t>(y) * row + static_cast<std::size_t>(x);
+                    const bool inside = (x >= lower.x) && (y >= lower.y) && (static_cast<int>(z) >= lower.z) && (x < upper.x) && (y < upper.y) && (static_cast<int>(z) < upper.z);
+                    const GLushort entry = static_cast<GLushort>(std::min(255, static_cast<int>(static_cast<float>(voxel[i]) * norm * 256.0F)));
+                    index[i] = inside && visible[entry] ? entry : ShearWarp::TRANSPARENT;
+                }
+            }
+        }
+    });
+
+    // Encode along every axis
+    for (int axis = 0; axis < 3; axis++) {
+        encode(index, resolution, axis, target.encoding[axis]);
+    }
+}
+
+// Encode the classified voxels along the axis
+void ShearWarp::encode(const std::vector<GLushort> &index, const glm::ivec3 &resolution, const int &axis, ShearWarp::Encoding &target) const {
+    // Scanlines along the next axis, across the one after it and then through the slices
+    const int axis_u = (axis + 1) % 3;
+    const int axis_v = (axis + 2) % 3;
+    const glm::ivec3 stride(1, resolution.x, resolution.x * resolution.y);
+    const std::size_t length = static_cast<std::size_t>(resolution[axis_u]);
+    const std::size_t lines = static_cast<std::size_t>(resolution[axis_v]) * static_cast<std::size_t>(resolution[axis]);
+    const std::size_t step = static_cast<std::size_t>(stride[axis_u]);
+    const auto start = [&resolution, &stride, axis, axis_v](const std::size_t &line) {
+        const std::size_t v = line % static_cast<std::size_t>(resolution[axis_v]);
+        const std::size_t k = line / static_cast<std::size_t>(resolution[axis_v]);
+        return v * static_cast<std::size_t>(stride[axis_v]) + k * static_cast<std::size_t>(stride[axis]);
+    };
+
+    // Count the runs and the non transparent voxels of every scanline
+    target.run_offset.assign(lines + 1U, 0U);
+    target.voxel_offset.assign(lines + 1U, 0U);
+    parallel(lines, 64U, [&index, &target, &start, length, step](const std::size_t &first, const std::size_t &last) {
+        for (std::size_t line = first; line < last; line++) {
+            const GLushort *const source = &index[start(line)];
+            std::size_t runs = 1U;
+            std::size_t voxels = 0U;
+            bool transparent = true;
+            for (std::size_t i = 0U; i < length; i++) {
+                const bool empty = source[i * step] == ShearWarp::TRANSPARENT;
+                if (empty != transparent) {
+                    transparent = empty;
+                    runs++;
+                }
+                voxels += empty ? 0U : 1U;
+            }
+            target.run_offset[line + 1U] = runs;
+            target.voxel_offset[line + 1U] = voxels;
+        }
+    });
+    std::partial_sum(target.run_offset.begin(), target.run_offset.end(), target.run_offset.begin());
+    std::partial_sum(target.voxel_offset.begin(), target.voxel_offset.end(), target.voxel_offset.begin());
+
+    // Write the runs and the voxels
+    target.runs.assign(target.run_offset.back(), 0U);
+    target.voxels.assign(target.voxel_offset.back(), 0U);
+    parallel(lines, 64U, [&index, &target, &start, length, step](const std::size_t &first, const std::size_t &last) {
+        for (std::size_t line = first; line < last; line++) {
+            const GLushort *const source = &index[start(line)];
+            std::uint32_t *run = &target.runs[target.run_offset[line]];
+            GLubyte *voxel = &target.voxels[target.voxel_offset[line]];
+            bool transparent = true;
+            for (std::size_t i = 0U; i < length; i++) {
+                const GLushort entry = source[i * step];
+                const bool empty = entry == ShearWarp::TRANSPARENT;
+                if (empty != transparent) {
+                    transparent = empty;
+                    run++;
+                }
+                (*run)++;
+                if (!empty) {
+                    *(voxel++) = static_cast<GLubyte>(entry);
+                }
+            }
+        }
+    });
+}
+
+// Get the linear map from the intermediate pixels to the voxels of the slice
+void ShearWarp::getSliceMap(const int &slice, float &scale, glm::vec2 &translation) const {
+    const glm::vec2 origin = factorization.origin;
+
+    // The perspective scales the base plane toward the eye
+    if (factorization.perspective) {
+        const glm::vec2 eye(factorization.eye[factorization.axis_u], factorization.eye[factorization.axis_v]);
+        const float depth = factorization.eye[factorization.axis];
+        scale = (static_cast<float>(slice) - depth) / (static_cast<float>(factorization.first) - depth);
+        translation = scale * origin + eye * (1.0F - scale);
+    }
+
+    // The parallel projection shears it
+    else {
+        scale = 1.0F;
+        translation = origin + factorization.shear * static_cast<float>(slice - factorization.first);
+    }
+}
+
+// Composite all the slices into the intermediate image scanlines in the range
+void ShearWarp::compositeScanlines(const glm::ivec3 &resolution, const std::size_t &first, const std::size_t &last) {
+    const int axis = factorization.axis;
+    const int size_u = resolution[factorization.axis_u];
+    const int size_v = resolution[factorization.axis_v];
+    const int width = factorization.width;
+    const ShearWarp::Encoding &source = classification->encoding[axis];
+
+    // Decoded voxel rows shifted by one for the left neighbors, their non transparent intervals and the skip links of the opaque pixels
+    std::vector<GLushort> buffer[2] = {std::vector<GLushort>(static_cast<std::size_t>(size_u) + 2U, ShearWarp::TRANSPARENT), std::vector<GLushort>(static_cast<std::size_t>(size_u) + 2U, ShearWarp::TRANSPARENT)};
+    std::vector<std::pair<int, int> > intervals[2];
+    std::vector<std::pair<int, int> > merged;
+    std::vector<int> next(static_cast<std::size_t>(width) + 1U);
+
+    for (std::size_t v = first; v < last; v++) {
+        float *const pixels = &intermediate[4U * v * static_cast<std::size_t>(width)];
+        std::iota(next.begin(), next.end(), 0);
+
+        // Front to back through the slices
+        for (int n = 0; n < factorization.slices; n++) {
+            const int slice = factorization.first + n * factorization.step;
+            float scale;
+            glm::vec2 translation;
+            getSliceMap(slice, scale, translation);
+
+            // The scanline crosses two voxel rows of the slice
+            const float position_v = scale * static_cast<float>(v) + translation.y;
+            const int row = static_cast<int>(std::floor(position_v));
+            const float weight_v = position_v - static_cast<float>(row);
+            if ((row < -1) || (row >= size_v)) {
+                continue;
+            }
+
+            // Decode the non transparent runs of both rows
+            bool empty = true;
+            for (int r = 0; r < 2; r++) {
+                intervals[r].clear();
+                const int j = row + r;
+                if ((j < 0) || (j >= size_v)) {
+                    continue;
+                }
+                const std::size_t line = static_cast<std::size_t>(slice) * static_cast<std::size_t>(size_v) + static_cast<std::size_t>(j);
+                const GLubyte *voxel = &source.voxels[source.voxel_offset[line]];
+                int i = 0;
+                bool transparent = true;
+                for (std::size_t run = source.run_offset[line]; run < source.run_offset[line + 1U]; run++, transparent = !transparent) {
+                    const int length = static_cast<int>(source.runs[run]);
+                    if (!transparent && (length > 0)) {
+                        std::copy(voxel, voxel + length, &buffer[r][static_cast<std::size_t>(i) + 1U]);
+                        intervals[r].push_back(std::make_pair(i, i + length));
+                        voxel += length;
+                        empty = false;
+                    }
+                    i += length;
+                }
+            }
+            if (empty) {
+                continue;
+            }
+
+            // Union of the voxel intervals widened by the left neighbors
+            merged.clear();
+            std::size_t a = 0U;
+            std::size_t b = 0U;
+            while ((a < intervals[0].size()) || (b < intervals[1].size())) {
+                const bool take_a = (b >= intervals[1].size()) || ((a < intervals[0].size()) && (intervals[0][a].first <= intervals[1][b].first));
+                const std::pair<int, int> interval = take_a ? intervals[0][a++] : intervals[1][b++];
+                if (!merged.empty() && (interval.first - 1 <= merged.back().second)) {
+                    merged.back().second = std::max(merged.back().second, interval.second);
+                }
+                else {
+                    merged.push_back(std::make_pair(interval.first - 1, interval.second));
+                }
+            }
+
+            // Composite the pixels over the intervals, skipping the opaque ones
+            for (const std::pair<int, int> &interval : merged) {
+                const int u_first = std::max(0, static_cast<int>(std::floor((static_cast<float>(interval.first) - translation.x) / scale)) + 1);
+                const int u_last = std::min(width, static_cast<int>(std::ceil((static_cast<float>(interval.second) - translation.x) / scale)));
+                for (int u = u_first < u_last ? findPixel(next, u_first) : u_last; u < u_last; u = findPixel(next, u + 1)) {
+                    const float position_u = scale * static_cast<float>(u) + translation.x;
+                    const int column = std::min(std::max(static_cast<int>(std::floor(position_u)), -1), size_u - 1);
+                    const float weight_u = position_u - static_cast<float>(column);
+                    const std::size_t left = static_cast<std::size_t>(column + 1);
+                    const glm::vec4 lower = table[buffer[0][left]] + (table[buffer[0][left + 1U]] - table[buffer[0][left]]) * weight_u;
+                    const glm::vec4 upper = table[buffer[1][left]] + (table[buffer[1][left + 1U]] - table[buffer[1][left]]) * weight_u;
+                    const glm::vec4 color = lower + (upper - lower) * weight_v;
+                    if (color.a <= 0.0F) {
+                        continue;
+                    }
+
+                    // Front to back over operator, the opaque pixels are linked to the next one
+                    float *const pixel = &pixels[4U * static_cast<std::size_t>(u)];
+                    const float transparency = 1.0F - pixel[3];
+                    for (int c = 0; c < 4; c++) {
+                        pixel[c] += transparency * color[c];
+                    }
+                    if (pixel[3] >= 0.99F) {
+                        next[static_cast<std::size_t>(u)] = u + 1;
+                    }
+                }
+            }
+
+            // Clear the decoded runs
+            for (int r = 0; r < 2; r++) {
+                for (const std::pair<int, int> &interval : intervals[r]) {
+                    std::fill(&buffer[r][static_cast<std::size_t>(interval.first) + 1U], &buffer[r][static_cast<std::size_t>(interval.second) + 1U], ShearWarp::TRANSPARENT);
+                }
+            }
+        }
+    }
+}
+
+// Warp the intermediate image into the final image rows in the range
+void ShearWarp::warp(const glm::mat4 &inverse_mat, const glm::mat4 &volume_mat, const glm::ivec3 &resolution, const GLsizei &width, const GLsizei &height, const std::size_t &first, const std::size_t &last, GLubyte *image) const {
+    const int axis = factorization.axis;
+    const int axis_u = factorization.axis_u;
+    const int axis_v = factorization.axis_v;
+    const glm::vec3 size(resolution);
+    for (std::size_t y = first; y < last; y++) {
+        for (GLsizei x = 0; x < width; x++) {
+            // Intersect the ray of the pixel in voxels with the base plane, the slices behind the near plane are not seen
+            glm::vec3 origin;
+            glm::vec3 direction;
+            CPURenderer::getRay(inverse_mat, volume_mat, x, static_cast<GLsizei>(y), width, height, origin, direction);
+            origin = origin * size - 0.5F;
+            direction *= size;
+            const float t = direction[axis] != 0.0F ? (static_cast<float>(factorization.first) - origin[axis]) / direction[axis] : -1.0F;
+            if (t < 0.0F) {
+                continue;
+            }
+            const glm::vec3 base = origin + direction * t;
+
+            // Bilinear sample of the intermediate image with a transparent border
+            const float u = base[axis_u] - factorization.origin.x;
+            const float v = base[axis_v] - factorization.origin.y;
+            if ((u <= -1.0F) || (v <= -1.0F) || (u >= static_cast<float>(factorization.width)) || (v >= static_cast<float>(factorization.height))) {
+                continue;
+            }
+            const int u_0 = static_cast<int>(std::floor(u));
+            const int v_0 = static_cast<int>(std::floor(v));
+            const float weight_u = u - static_cast<float>(u_0);
+            const float weight_v = v - static_cast<float>(v_0);
+            glm::vec4 color(0.0F);
+            for (int c = 0; c < 4; c++) {
+                const int pixel_u = u_0 + (c & 1);
+                const int pixel_v = v_0 + (c >> 1);
+                if ((pixel_u < 0) || (pixel_v < 0) || (pixel_u >= factorization.width) || (pixel_v >= factorization.height)) {
+                    continue;
+                }
+                const float weight = ((c & 1) != 0 ? weight_u : 1.0F - weight_u) * ((c >> 1) != 0 ? weight_v : 1.0F - weight_v);
+                const float *const pixel = &intermediate[4U * (static_cast<std::size_t>(pixel_v) * static_cast<std::size_t>(factorization.width) + static_cast<std::size_t>(pixel_u))];
+                color += weight * glm::vec4(pixel[0], pixel[1], pixel[2], pixel[3]);
+            }
+
+            // Store the premultiplied color
+            CPURenderer::store(color, &image[4U * (y * static_cast<std::size_t>(width) + static_cast<std::size_t>(x))]);
+        }
+    }
+}
+
+
+// Constructors
+
+// Shear-warp constructor
+ShearWarp::ShearWarp(const unsigned int &threads) :
+    CPURenderer(threads),
+    classification(nullptr),
+    encoded_voxels(0U),
+    classification_time(0.0),
+    table(257U, glm::vec4(0.0F)) {
+    factorization.axis = 2;
+    factorization.axis_u = 0;
+    factorization.axis_v = 1;
+    factorization.width = 0;
+    factorization.height = 0;
+}
+
+
+// Getters
+
+// Get the principal axis of the last frame
+int ShearWarp::getPrincipalAxis() const {
+    return factorization.axis;
+}
+
+// Get the intermediate image resolution of the last frame
+glm::uvec2 ShearWarp::getIntermediateResolution() const {
+    return glm::uvec2(static_cast<unsigned int>(factorization.width), static_cast<unsigned int>(factorization.height));
+}
+
+// Get the number of non transparent voxels
+std::size_t ShearWarp::getEncodedVoxels() const {
+    return encoded_voxels;
+}
+
+// Get the time of the last classification in milliseconds
+double ShearWarp::getClassificationTime() const {
+    return classification_time;
+}
+
+
+// Methods
+
+// Render the volume seen by the camera into the premultiplied RGBA image with the emission absorption model
+void ShearWarp::render(const Volume *const volume, const Camera *const camera, const GLsizei &width, const GLsizei &height, std::vector<GLubyte> &image) {
+    // Clear to transparent
+    image.assign(4U * static_cast<std::size_t>(std::max(width, 0)) * static_cast<std::size_t>(std::max(height, 0)), 0U);
+    if (!volume->isEnabled() || !volume->isOpen() || (volume->getVoxels() == nullptr) || (width <= 0) || (height <= 0)) {
+        return;
+    }
+
+    // Voxels of the drawn brick
+    const glm::ivec3 resolution(volume->getResolution());
+    glm::ivec3 lower;
+    glm::ivec3 upper;
+    for (int i = 0; i < 3; i++) {
+        lower[i] = std::min(std::max(0, static_cast<int>(std::round(volume->getClipMin()[i] * static_cast<float>(resolution[i])))), resolution[i] - 1);
+        upper[i] = std::max(lower[i] + 1, std::min(resolution[i], static_cast<int>(std::round(volume->getClipMax()[i] * static_cast<float>(resolution[i])))));
+    }
+
+    // Classify again if the voxels have no classification of the brick with the non transparent entries of the transfer function
+    const TransferFunction *const transfer_function = volume->getTransferFunction();
+    const GLubyte *const entries = transfer_function->getData();
+    std::vector<bool> visible(256U);
+    for (std::size_t i = 0U; i < 256U; i++) {
+        visible[i] = entries[4U * i + 3U] != 0U;
+    }
+    classification = static_cast<const ShearWarp::Classification *>(volume->getDerived("shear-warp classification"));
+    if ((classification == nullptr) || (classification->visible != visible) || (classification->lower != lower) || (classification->upper != upper)) {
+        const ProfilerScope scope("classify");
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        ShearWarp::Classification *const classified = new ShearWarp::Classification();
+        classified->visible = visible;
+        classified->lower = lower;
+        classified->upper = upper;
+        const float norm = volume->getFormat() == VolumeData::RAW8 ? 1.0F / 255.0F : volume->getValueScale() / 65535.0F;
+        if (volume->getFormat() == VolumeData::RAW8) {
+            classify(reinterpret_cast<const GLubyte *>(volume->getVoxels()), resolution, norm, *classified);
+        }
+        else {
+            classify(volume->getVoxels(), resolution, norm, *classified);
+        }
+        volume->setDerived("shear-warp classification", classified);
+        classification = classified;
+        classification_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "info: shear-warp classified " << classified->encoding[0].voxels.size() << " non transparent voxels in " << classification_time << " ms" << std::endl;
+    }
+    encoded_voxels = classification->encoding[0].voxels.size();
+
+    // View direction in voxels, toward the volume center for the perspective
+    const glm::mat4 inverse_mat = glm::inverse(camera->getProjectionMatrix() * camera->getViewMatrix() * volume->getModelMatrix());
+    const glm::mat4 volume_mat = volume->getVolumeMatrix();
+    const glm::vec3 size(resolution);
+    const glm::vec3 center = (glm::vec3(lower) + glm::vec3(upper) - 1.0F) * 0.5F;
+    factorization.perspective = !camera->isOrthogonal();
+    glm::vec3 direction;
+    if (factorization.perspective) {
+        glm::vec3 eye = glm::vec3(volume_mat * glm::inverse(camera->getViewMatrix() * volume->getModelMatrix()) * glm::vec4(0.0F, 0.0F, 0.0F, 1.0F));
+        eye.y = 1.0F - eye.y;
+        factorization.eye = eye * size - 0.5F;
+        direction = center - factorization.eye;
+    }
+    else {
+        glm::vec3 origin;
+        CPURenderer::getRay(inverse_mat, volume_mat, width / 2, height / 2, width, height, origin, direction);
+        direction *= size;
+    }
+
+    // The principal axis is the one most parallel to the view, the scanlines run along the next one
+    const glm::vec3 magnitude = glm::abs(direction);
+    factorization.axis = magnitude.x >= std::max(magnitude.y, magnitude.z) ? 0 : (magnitude.y >= magnitude.z ? 1 : 2);
+    const int axis = factorization.axis;
+    const int axis_u = (axis + 1) % 3;
+    const int axis_v = (axis + 2) % 3;
+    factorization.axis_u = axis_u;
+    factorization.axis_v = axis_v;
+    factorization.shear = glm::vec2(direction[axis_u], direction[axis_v]) / direction[axis];
+
+    // Slices from front to back in front of the eye, the sample distance scale skips slices
+    const int stride = std::max(1, static_cast<int>(std::round(volume->getStepScale())));
+    factorization.step = direction[axis] > 0.0F ? stride : -stride;
+    factorization.first = direction[axis] > 0.0F ? lower[axis] : upper[axis] - 1;
+    if (factorization.perspective) {
+        const float depth = factorization.eye[axis];
+        factorization.first = direction[axis] > 0.0F ? std::max(factorization.first, static_cast<int>(std::floor(depth)) + 1) : std::min(factorization.first, static_cast<int>(std::ceil(depth)) - 1);
+    }
+    const int remaining = direction[axis] > 0.0F ? upper[axis] - 1 - factorization.first : factorization.first - lower[axis];
+    factorization.slices = remaining >= 0 ? remaining / stride + 1 : 0;
+    if (factorization.slices == 0) {
+        factorization.width = 0;
+        factorization.height = 0;
+        return;
+    }
+
+    // Footprint of the front and back slices on the base plane
+    factorization.origin = glm::vec2(0.0F);
+    glm::vec2 minimum(std::numeric_limits<float>::max());
+    glm::vec2 maximum(-std::numeric_limits<float>::max());
+    for (const int slice : {factorization.first, factorization.first + (factorization.slices - 1) * factorization.step}) {
+        float scale;
+        glm::vec2 translation;
+        getSliceMap(slice, scale, translation);
+        for (int c = 0; c < 4; c++) {
+            const glm::vec2 corner((c & 1) != 0 ? upper[axis_u] - 1 : lower[axis_u], (c >> 1) != 0 ? upper[axis_v] - 1 : lower[axis_v]);
+            const glm::vec2 pixel = (corner - translation) / scale;
+            minimum = glm::min(minimum, pixel);
+            maximum = glm::max(maximum, pixel);
+        }
+    }
+    const int limit = ShearWarp::MAX_INTERMEDIATE * std::max(resolution.x, std::max(resolution.y, resolution.z));
+    factorization.origin = glm::floor(minimum) - 1.0F;
+    factorization.width = std::min(limit, static_cast<int>(std::ceil(maximum.x - factorization.origin.x)) + 2);
+    factorization.height = std::min(limit, static_cast<int>(std::ceil(maximum.y - factorization.origin.y)) + 2);
+
+    // Transfer function with the opacity corrected for the distance between slices along the view
+    const float distance = static_cast<float>(stride) * std::sqrt(1.0F + glm::dot(factorization.shear, factorization.shear));
+    const GLubyte *const data = transfer_function->getData();
+    for (std::size_t i = 0U; i < 256U; i++) {
+        const glm::vec4 color = glm::vec4(data[4U * i], data[4U * i + 1U], data[4U * i + 2U], data[4U * i + 3U]) / 255.0F;
+        const float alpha = 1.0F - std::pow(1.0F - color.a, distance);
+        table[i] = glm::vec4(glm::vec3(color) * alpha, alpha);
+    }
+
+    // Composite the intermediate image scanlines in parallel, every scanline only depends on itself
+    intermediate.assign(4U * static_cast<std::size_t>(factorization.width) * static_cast<std::size_t>(factorization.height), 0.0F);
+    parallel(static_cast<std::size_t>(factorization.height), 4U, [this, &resolution](const std::size_t &first, const std::size_t &last) {
+        compositeScanlines(resolution, first, last);
+    });
+
+    // Warp to the final image
+    GLubyte *const target = image.data();
+    parallel(static_cast<std::size_t>(height), 4U, [this, &inverse_mat, &volume_mat, &resolution, width, height, target](const std::size_t &first, const std::size_t &last) {
+        warp(inverse_mat, volume_mat, resolution, width, height, first, last, target);
+    });
+}
+
+
+// Destructor
+
+// Shear-warp destructor
+ShearWarp::~ShearWarp() {}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#ifndef __SHEAR_WARP_HPP_
+#define __SHEAR_WARP_HPP_
+
+#include "cpurenderer.hpp"
+
+#include "../volume/volume.hpp"
+#include "../scene/camera.hpp"
+
+#include "../glad/glad.h"
+
+#include <glm/vec4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+#include <vector>
+
+
+/** Shear-warp renderer on the CPU threads, the classified volume is run-length encoded along the three axes, the slices are composited front to back into the sheared intermediate image skipping the transparent voxels and the opaque pixels, and the intermediate image is warped to the final image */
+class ShearWarp : public CPURenderer {
+    private:
+        // Structures
+
+        /** Run-length encoding of the classified voxels along an axis */
+        struct Encoding {
+            /** First run of every scanline, followed by the total */
+            std::vector<std::size_t> run_offset;
+
+            /** Run lengths alternating transparent and non transparent voxels, starting with transparent */
+            std::vector<std::uint32_t> runs;
+
+            /** First non transparent voxel of every scanline, followed by the total */
+            std::vector<std::size_t> voxel_offset;
+
+            /** Transfer function indices of the non transparent voxels */
+            std::vector<GLubyte> voxels;
+        };
+
+        /** Classified voxels of the drawn brick encoded along the three axes, the volume keeps them with its voxels */
+        class Classification : public VolumeData::Derived {
+            public:
+                // Attributes
+
+                /** Encodings along the x, y and z axes, the scanlines of every axis follow the next one cyclically */
+                ShearWarp::Encoding encoding[3];
+
+                /** Non transparent status of every transfer function entry, the voxels of the other entries were skipped */
+                std::vector<bool> visible;
+
+                /** Lower voxel of the classified brick */
+                glm::ivec3 lower;
+
+                /** Upper voxel of the classified brick, excluded */
+                glm::ivec3 upper;
+
+
+                // Getters
+
+                /** Get the size of the encodings in bytes */
+                std::size_t getBytes() const;
+        };
+
+        /** Factorization of the view into a shear of the slices and a warp of the intermediate image */
+        struct Factorization {
+            /** Principal axis, the slices are perpendicular to it */
+            int axis;
+
+            /** Axis of the intermediate image scanlines */
+            int axis_u;
+
+            /** Axis across the intermediate image scanlines */
+            int axis_v;
+
+            /** Front slice, the base plane of the intermediate image */
+            int first;
+
+            /** Slice increment from front to back */
+            int step;
+
+            /** Number of composited slices */
+            int slices;
+
+            /** Perspective status, the slices are scaled toward the eye */
+            bool perspective;
+
+            /** Eye position in voxels for the perspective */
+            glm::vec3 eye;
+
+            /** Shear of the slices per slice for the parallel projection */
+            glm::vec2 shear;
+
+            /** Position in voxels of the base plane of the first intermediate pixel */
+            glm::vec2 origin;
+
+            /** Intermediate image width */
+            int width;
+
+            /** Intermediate image height */
+            int height;
+        };
+
+
+        // Static const attributes
+
+        /** Index of the transparent entry of the table */
+        static const GLushort TRANSPARENT = 256U;
+
+        /** Largest intermediate image side in voxels of the largest grid side */
+        static const int MAX_INTERMEDIATE = 4;
+
+
+        // Attributes
+
+        /** Classified voxels of the frame, kept by the volume */
+        const ShearWarp::Classification *classification;
+
+        /** Number of non transparent voxels */
+        std::size_t encoded_voxels;
+
+        /** Time of the last classification in milliseconds */
+        double classification_time;
+
+
+        /** Opacity corrected premultiplied colors of the transfer function, followed by a transparent entry */
+        std::vector<glm::vec4> table;
+
+        /** Premultiplied RGBA intermediate image */
+        std::vector<float> intermediate;
+
+        /** Factorization of the last frame */
+        ShearWarp::Factorization factorization;
+
+
+        // Constructors
+
+        /** Disable the default copy constructor */
+        ShearWarp(const ShearWarp &) = delete;
+
+        /** Disable the assignation operator */
+        ShearWarp &operator=(const ShearWarp &) = delete;
+
+
+        // Methods
+
+        /** Classify the voxels inside the brick of the classification and encode them along the three axes */
+        template <typename T>
+        void classify(const T *voxel, const glm::ivec3 &resolution, const float &norm, ShearWarp::Classification &target) const;
+
+        /** Encode the classified voxels along the axis */
+        void encode(const std::vector<GLushort> &index, const glm::ivec3 &resolution, const int &axis, ShearWarp::Encoding &target) const;
+
+        /** Get the linear map from the intermediate pixels to the voxels of the slice */
+        void getSliceMap(const int &slice, float &scale, glm::vec2 &translation) const;
+
+        /** Composite all the slices into the intermediate image scanlines in the range */
+        void compositeScanlines(const glm::ivec3 &resolution, const std::size_t &first, const std::size_t &last);
+
+        /** Warp the intermediate image into the final image rows in the range */
+        void warp(const glm::mat4 &inverse_mat, const glm::mat4 &volume_mat, const glm::ivec3 &resolution, const GLsizei &width, const GLsizei &height, const std::size_t &first, const std::size_t &last, GLubyte *image) const;
+
+
+    public:
+        // Constructors
+
+        /** Shear-warp constructor, the threads default to all the threads of the task scheduler */
+        ShearWarp(const unsigned int &threads = 0U);
+
+
+        // Getters
+
+        /** Get the principal axis of the last frame */
+        int getPrincipalAxis() const;
+
+        /** Get the intermediate image resolution of the last frame */
+        glm::uvec2 getIntermediateResolution() const;
+
+        /** Get the number of non transparent voxels */
+        std::size_t getEncodedVoxels() const;
+
+        /** Get the time of the last classification in milliseconds */
+        double getClassificationTime() const;
+
+
+        // Methods
+
+        /** Render the volume seen by the camera into the premultiplied RGBA image with the emission absorption model, the rows from bottom to top */
+        void render(const Volume *const volume, const Camera *const camera, const GLsizei &width, const GLsizei &height, std::vector<GLubyte> &image);
+
+
+        // Destructor
+
+        /** Shear-warp destructor */
+        virtual ~ShearWarp();
+};
+
+#endif // __SHEAR_WARP_HPP_
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef __VOXEL_ACCESSOR_HPP_
+#define __VOXEL_ACCESSOR_HPP_
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+
+
+/** Read access to the voxels of a store in any layout, the index of a voxel is the sum of the offsets of its coordinates along every axis */
+template <typename T>
+class VoxelAccessor {
+    private:
+        // Attributes
+
+        /** Voxels */
+        const T *voxel;
+
+        /** Offsets of the x coordinates */
+        const std::size_t *offset_x;
+
+        /** Offsets of the y coordinates */
+        const std::size_t *offset_y;
+
+        /** Offsets of the z coordinates */
+        const std::size_t *offset_z;
+
+        /** Resolution */
+        glm::ivec3 resolution;
+
+
+    public:
+        // Constructors
+
+        /** Voxel accessor constructor */
+        VoxelAccessor(const T *new_voxel, const std::size_t *new_offset_x, const std::size_t *new_offset_y, const std::size_t *new_offset_z, const glm::ivec3 &new_resolution) :
+            voxel(new_voxel),
+            offset_x(new_offset_x),
+            offset_y(new_offset_y),
+            offset_z(new_offset_z),
+            resolution(new_resolution) {}
+
+
+        // Getters
+
+        /** Get the resolution */
+        const glm::ivec3 &getResolution() const {
+            return resolution;
+        }
+
+
+        // Methods
+
+        /** Get the raw value of the voxel, it must be inside */
+        T get(const int &x, const int &y, const int &z) const {
+            return voxel[offset_x[x] + offset_y[y] + offset_z[z]];
+        }
+
+        /** Get the raw value of the voxel as a float, zero outside */
+        float fetch(const int &x, const int &y, const int &z) const {
+            const bool inside = (x >= 0) && (y >= 0) && (z >= 0) && (x < resolution.x) && (y < resolution.y) && (z < resolution.z);
+            return inside ? static_cast<float>(get(x, y, z)) : 0.0F;
+        }
+};
+
+#endif // __VOXEL_ACCESSOR_HPP_
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include "voxelstore.hpp"
+
+#include <cstring>
+
+
+// Static const attributes
+
+// Bits of the brick side
+const int VoxelStore::BRICK_BITS;
+
+
+// Constructors
+
+// Empty voxel store constructor
+VoxelStore::VoxelStore() :
+    layout(VoxelStore::LINEAR),
+    resolution(0),
+    voxel_size(1U) {}
+
+
+// Getters
+
+// Get the layout
+VoxelStore::Layout VoxelStore::getLayout() const {
+    return layout;
+}
+
+// Get the resolution
+glm::ivec3 VoxelStore::getResolution() const {
+    return resolution;
+}
+
+// Get the size of the stored voxels in bytes
+std::size_t VoxelStore::getSize() const {
+    return data.size();
+}
+
+// Get the size of the stored voxels and the offsets in bytes
+std::size_t VoxelStore::getBytes() const {
+    return data.size() + sizeof(std::size_t) * (offset[0].size() + offset[1].size() + offset[2].size());
+}
+
+
+// Methods
+
+// Allocate the store and compute the offsets of the layout
+void VoxelStore::allocate(const glm::ivec3 &new_resolution, const std::size_t &new_voxel_size, const VoxelStore::Layout &new_layout) {
+    layout = new_layout;
+    resolution = new_resolution;
+    voxel_size = new_voxel_size;
+
+    // Linear rows, the offsets are the strides
+    if (layout == VoxelStore::LINEAR) {
+        const std::size_t stride[3] = {1U, static_cast<std::size_t>(resolution.x), static_cast<std::size_t>(resolution.x) * static_cast<std::size_t>(resolution.y)};
+        for (int axis = 0; axis < 3; axis++) {
+            offset[axis].resize(static_cast<std::size_t>(resolution[axis]));
+            for (int i = 0; i < resolution[axis]; i++) {
+                offset[axis][static_cast<std::size_t>(i)] = static_cast<std::size_t>(i) * stride[axis];
+            }
+        }
+        data.resize(stride[2] * static_cast<std::size_t>(resolution.z) * voxel_size);
+        return;
+    }
+
+    // Bricks in linear order, the offset of a coordinate is the one of its brick plus the one inside the brick
+    const int side = 1 << VoxelStore::BRICK_BITS;
+    const std::size_t brick = static_cast<std::size_t>(side * side * side);
+    const glm::ivec3 bricks = (resolution + side - 1) / side;
+    const std::size_t brick_stride[3] = {brick, brick * static_cast<std::size_t>(bricks.x), brick * static_cast<std::size_t>(bricks.x) * static_cast<std::size_t>(bricks.y)};
+    for (int axis = 0; axis < 3; axis++) {
+        offset[axis].resize(static_cast<std::size_t>(resolution[axis]));
+        for (int i = 0; i < resolution[axis]; i++) {
+            const int local = i & (side - 1);
+            std::size_t inner = 0U;
+
+            // The Z-order curve interleaves the bits of the three coordinates
+            if (layout == VoxelStore::MORTON) {
+                for (int bit = 0; bit < VoxelStore::BRICK_BITS; bit++) {
+                    inner |= static_cast<std::size_t>((local >> bit) & 1) << (3 * bit + axis);
+                }
+            }
+            else {
+                inner = static_cast<std::size_t>(local) << (VoxelStore::BRICK_BITS * axis);
+            }
+            offset[axis][static_cast<std::size_t>(i)] = static_cast<std::size_t>(i >> VoxelStore::BRICK_BITS) * brick_stride[axis] + inner;
+        }
+    }
+    data.resize(brick_stride[2] * static_cast<std::size_t>(bricks.z) * voxel_size);
+}
+
+// Copy the slices in the range of the linear voxels of the whole volume
+void VoxelStore::copy(const GLushort *voxels, const std::size_t &first, const std::size_t &last) {
+    const std::size_t row = static_cast<std::size_t>(resolution.x);
+    const std::size_t plane = row * static_cast<std::size_t>(resolution.y);
+    const std::size_t *const offset_x = offset[0].data();
+
+    // The linear slices are copied as a block
+    if (layout == VoxelStore::LINEAR) {
+        std::memcpy(&data[first * plane * voxel_size], reinterpret_cast<const GLubyte *>(voxels) + first * plane * voxel_size, (last - first) * plane * voxel_size);
+        return;
+    }
+
+    // The rows are scattered by the offsets
+    for (std::size_t z = first; z < last; z++) {
+        for (std::size_t y = 0U; y < static_cast<std::size_t>(resolution.y); y++) {
+            const std::size_t base = offset[1][y] + offset[2][z];
+            const std::size_t source = z * plane + y * row;
+            if (voxel_size == 1U) {
+                const GLubyte *const input = reinterpret_cast<const GLubyte *>(voxels) + source;
+                GLubyte *const output = data.data() + base;
+                for (std::size_t x = 0U; x < row; x++) {
+                    output[offset_x[x]] = input[x];
+                }
+            }
+            else {
+                const GLushort *const input = voxels + source;
+                GLushort *const output = reinterpret_cast<GLushort *>(data.data()) + base;
+                for (std::size_t x = 0U; x < row; x++) {
+                    output[offset_x[x]] = input[x];
+                }
+            }
+        }
+    }
+}
+
+
+// Destructor
+
+// Voxel store destructor
+VoxelStore::~VoxelStore() {}
+
+
+// Static methods
+
+// Get the layout name
+const char *VoxelStore::getLayoutName(const VoxelStore::Layout &layout) {
+    return layout == VoxelStore::LINEAR ? "linear" : (layout == VoxelStore::BRICKED ? "bricked" : "morton");
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#ifndef __VOXEL_STORE_HPP_
+#define __VOXEL_STORE_HPP_
+
+#include "voxelaccessor.hpp"
+
+#include "../volume/loader/volumedata.hpp"
+#include "../glad/glad.h"
+
+#include <glm/vec3.hpp>
+
+#include <vector>
+
+
+/** Copy of the voxels of a volume in a layout for the CPU kernels, the bricked layouts keep the neighbours along every axis in the same cache lines, the volume keeps it with its voxels */
+class VoxelStore : public VolumeData::Derived {
+    public:
+        // Enumerations
+
+        /** Voxel layouts */
+        enum Layout {
+            /** Rows along x, then y and z, as the volume data */
+            LINEAR,
+
+            /** Bricks of 8³ voxels in linear order, the voxels of every brick in linear order */
+            BRICKED,
+
+            /** Bricks of 8³ voxels in linear order, the voxels of every brick along the Z-order curve */
+            MORTON
+        };
+
+
+    private:
+        // Static const attributes
+
+        /** Bits of the brick side */
+        static const int BRICK_BITS = 3;
+
+
+        // Attributes
+
+        /** Layout */
+        VoxelStore::Layout layout;
+
+        /** Resolution */
+        glm::ivec3 resolution;
+
+        /** Bytes per voxel, one or two */
+        std::size_t voxel_size;
+
+        /** Stored voxels, with the padding of the partial bricks */
+        std::vector<GLubyte> data;
+
+        /** Offsets in voxels of the coordinates along every axis */
+        std::vector<std::size_t> offset[3];
+
+
+        // Constructors
+
+        /** Disable the default copy constructor */
+        VoxelStore(const VoxelStore &) = delete;
+
+        /** Disable the assignation operator */
+        VoxelStore &operator=(const VoxelStore &) = delete;
+
+
+    public:
+        // Constructors
+
+        /** Empty voxel store constructor */
+        VoxelStore();
+
+
+        // Getters
+
+        /** Get the layout */
+        VoxelStore::Layout getLayout() const;
+
+        /** Get the resolution */
+        glm::ivec3 getResolution() const;
+
+        /** Get the size of the stored voxels in bytes */
+        std::size_t getSize() const;
+
+        /** Get the size of the stored voxels and the offsets in bytes */
+        std::size_t getBytes() const;
+
+        /** Get the accessor of the voxels, the type must have the size of the stored voxels */
+        template <typename T>
+        VoxelAccessor<T> getAccessor() const {
+            return VoxelAccessor<T>(reinterpret_cast<const T *>(data.data()), offset[0].data(), offset[1].data(), offset[2].data(), resolution);
+        }
+
+
+        // Methods
+
+        /** Allocate the store and compute the offsets of the layout, the voxels are undefined */
+        void allocate(const glm::ivec3 &new_resolution, const std::size_t &new_voxel_size, const VoxelStore::Layout &new_layout);
+
+        /** Copy the slices in the range of the linear voxels of the whole volume, the slices can be copied in parallel */
+        void copy(const GLushort *voxels, const std::size_t &first, const std::size_t &last);
+
+
+        // Destructor
+
+        /** Voxel store destructor */
+        virtual ~VoxelStore();
+
+
+        // Static methods
+
+        /** Get the layout name, `linear', `bricked' or `morton' */
+        static const char *getLayoutName(const VoxelStore::Layout &layout);
+};
+
+#endif // __VOXEL_STORE_HPP_
\ No newline at end of file
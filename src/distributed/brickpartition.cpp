@@ -0,0 +1,106 @@
+#include "brickpartition.hpp"
+
+
+// Private methods
+
+// Split the node recursively
+void BrickPartition::split(const glm::uvec3 &offset, const glm::uvec3 &size, const unsigned int &level, const unsigned int &brick, std::vector<BrickPartition::Split> &path) {
+    // Store the leaf
+    if (level == levels) {
+        offsets[brick] = offset;
+        sizes[brick] = size;
+        splits[brick] = path;
+        valid = valid && (size.x > 0U) && (size.y > 0U) && (size.z > 0U);
+        return;
+    }
+
+    // Halve the longest side
+    const unsigned int axis = (size.x >= size.y) && (size.x >= size.z) ? 0U : (size.y >= size.z ? 1U : 2U);
+    const unsigned int half = size[axis] / 2U;
+    BrickPartition::Split plane;
+    plane.axis = axis;
+    plane.position = offset[axis] + half;
+    path.push_back(plane);
+
+    // The lower child keeps the bit clear and the upper one sets it
+    glm::uvec3 lower_size = size;
+    glm::uvec3 upper_offset = offset;
+    glm::uvec3 upper_size = size;
+    lower_size[axis] = half;
+    upper_offset[axis] += half;
+    upper_size[axis] -= half;
+
+    const unsigned int bit = 1U << (levels - 1U - level);
+    split(offset, lower_size, level + 1U, brick, path);
+    split(upper_offset, upper_size, level + 1U, brick | bit, path);
+    path.pop_back();
+}
+
+
+// Constructors
+
+// Brick partition constructor
+BrickPartition::BrickPartition(const glm::uvec3 &grid, const unsigned int &count) :
+    levels(0U),
+    valid((count > 0U) && ((count & (count - 1U)) == 0U)) {
+    if (!valid) {
+        return;
+    }
+
+    // Levels of the tree
+    while ((1U << levels) < count) {
+        levels++;
+    }
+
+    // Split the grid
+    offsets.resize(count);
+    sizes.resize(count);
+    splits.resize(count);
+    std::vector<BrickPartition::Split> path;
+    split(glm::uvec3(0U), grid, 0U, 0U, path);
+}
+
+
+// Getters
+
+// Get the valid status
+bool BrickPartition::isValid() const {
+    return valid;
+}
+
+// Get the number of bricks
+unsigned int BrickPartition::getCount() const {
+    return static_cast<unsigned int>(offsets.size());
+}
+
+// Get the number of levels
+unsigned int BrickPartition::getLevels() const {
+    return levels;
+}
+
+// Get the offset of the brick
+glm::uvec3 BrickPartition::getOffset(const unsigned int &brick) const {
+    return offsets[brick];
+}
+
+// Get the size of the brick
+glm::uvec3 BrickPartition::getSize(const unsigned int &brick) const {
+    return sizes[brick];
+}
+
+
+// Methods
+
+// Get whether the side of the brick merged at the stage is in front
+bool BrickPartition::isFront(const unsigned int &brick, const unsigned int &stage, const glm::vec3 &eye) const {
+    // The first stage merges the leaves, the last one the children of the root
+    const BrickPartition::Split &plane = splits[brick][levels - 1U - stage];
+    const bool lower = ((brick >> stage) & 1U) == 0U;
+    return lower == (eye[plane.axis] < static_cast<float>(plane.position));
+}
+
+
+// Destructor
+
+// Brick partition destructor
+BrickPartition::~BrickPartition() {}
\ No newline at end of file
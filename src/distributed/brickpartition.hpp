@@ -0,0 +1,98 @@
+#ifndef __BRICK_PARTITION_HPP_
+#define __BRICK_PARTITION_HPP_
+
+#include <glm/vec3.hpp>
+
+#include <vector>
+
+
+/** Kd partition of a voxel grid in a power of two number of bricks, halving the longest side at every level */
+class BrickPartition {
+    private:
+        // Structures
+
+        /** Split plane of a kd node */
+        struct Split {
+            /** Split axis */
+            unsigned int axis;
+
+            /** Split position in voxels */
+            unsigned int position;
+        };
+
+
+        // Attributes
+
+        /** Number of levels, the bricks are two to the power of it */
+        unsigned int levels;
+
+        /** Valid status */
+        bool valid;
+
+
+        /** Brick offsets */
+        std::vector<glm::uvec3> offsets;
+
+        /** Brick sizes */
+        std::vector<glm::uvec3> sizes;
+
+        /** Split planes of the nodes containing every brick, the root first */
+        std::vector<std::vector<BrickPartition::Split> > splits;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        BrickPartition() = delete;
+
+        /** Disable the default copy constructor */
+        BrickPartition(const BrickPartition &) = delete;
+
+        /** Disable the assignation operator */
+        BrickPartition &operator=(const BrickPartition &) = delete;
+
+
+        // Methods
+
+        /** Split the node recursively, the bit of the level selects the child in the brick index */
+        void split(const glm::uvec3 &offset, const glm::uvec3 &size, const unsigned int &level, const unsigned int &brick, std::vector<BrickPartition::Split> &path);
+
+
+    public:
+        // Constructors
+
+        /** Brick partition constructor, the count must be a power of two */
+        BrickPartition(const glm::uvec3 &grid, const unsigned int &count);
+
+
+        // Getters
+
+        /** Get the valid status, false if the count is not a power of two or a brick is empty */
+        bool isValid() const;
+
+        /** Get the number of bricks */
+        unsigned int getCount() const;
+
+        /** Get the number of levels, also the number of compositing stages */
+        unsigned int getLevels() const;
+
+        /** Get the offset of the brick */
+        glm::uvec3 getOffset(const unsigned int &brick) const;
+
+        /** Get the size of the brick */
+        glm::uvec3 getSize(const unsigned int &brick) const;
+
+
+        // Methods
+
+        /** Get whether the side of the brick merged at the compositing stage is in front of the other side seen from the eye in voxels */
+        bool isFront(const unsigned int &brick, const unsigned int &stage, const glm::vec3 &eye) const;
+
+
+        // Destructor
+
+        /** Brick partition destructor */
+        virtual ~BrickPartition();
+};
+
+#endif // __BRICK_PARTITION_HPP_
\ No newline at end of file
@@ -0,0 +1,352 @@
+#include "sortlastnode.hpp"
+
+#include "../profiler/profilerscope.hpp"
+
+#include <iostream>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+    #include <sys/types.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+
+// Private methods
+
+// Connect to the other nodes
+bool SortLastNode::connect(const int &timeout_ms) {
+    // Swap partners, and every node for the first one that gathers the frame
+    const unsigned int count = static_cast<unsigned int>(peers.size());
+    std::vector<bool> needed(count, rank == 0U);
+    needed[0] = true;
+    for (unsigned int bit = 1U; bit < count; bit <<= 1) {
+        needed[rank ^ bit] = true;
+    }
+    needed[rank] = false;
+
+    // Connect to the lower ranks and introduce the node
+    unsigned int accepted = 0U;
+    for (unsigned int other = 0U; other < count; other++) {
+        if (!needed[other]) {
+            continue;
+        }
+
+        if (other > rank) {
+            accepted++;
+            continue;
+        }
+
+        Socket *const socket = new Socket();
+        const std::uint32_t hello = static_cast<std::uint32_t>(rank);
+        links[other] = socket;
+        if (!socket->connect(peers[other], timeout_ms) || !socket->send(&hello, sizeof(hello))) {
+            return false;
+        }
+    }
+
+    // Accept the higher ranks
+    for (unsigned int i = 0U; i < accepted; i++) {
+        Socket *const socket = listener.accept();
+        std::uint32_t hello = 0U;
+        if (!socket->isOpen() || !socket->receive(&hello, sizeof(hello)) || (hello >= count) || (hello <= rank) || (links.count(hello) > 0U)) {
+            std::cerr << "error: unexpected connection to the sort-last node " << rank << std::endl;
+            delete socket;
+            return false;
+        }
+        links[hello] = socket;
+    }
+
+    return true;
+}
+
+// Send a block while receiving another one
+bool SortLastNode::exchange(const Socket *const socket, const GLfloat *const output, const std::size_t &output_count, GLfloat *const input, const std::size_t &input_count) {
+    // Both nodes send at once, the blocks are larger than the socket buffers
+    bool sent_block = false;
+    std::thread sender([&]() {
+        sent_block = socket->send(output, output_count * sizeof(GLfloat));
+    });
+    const bool received_block = socket->receive(input, input_count * sizeof(GLfloat));
+    sender.join();
+
+    sent += output_count * sizeof(GLfloat);
+    return sent_block && received_block;
+}
+
+// Composite the layer with the other nodes
+bool SortLastNode::composite(std::vector<GLfloat> &layer, const glm::vec3 &eye) {
+    const ProfilerScope scope("composite");
+
+    // Binary swap, every stage halves the kept pixels and merges the partner half
+    const std::size_t pixels = layer.size() / 4U;
+    std::size_t begin = 0U;
+    std::size_t end = pixels;
+    std::vector<GLfloat> block;
+    for (unsigned int stage = 0U; stage < partition->getLevels(); stage++) {
+        const unsigned int partner = rank ^ (1U << stage);
+        const std::size_t middle = begin + (end - begin) / 2U;
+        const bool lower = ((rank >> stage) & 1U) == 0U;
+        const std::size_t keep_begin = lower ? begin : middle;
+        const std::size_t keep_end = lower ? middle : end;
+        const std::size_t give_begin = lower ? middle : begin;
+        const std::size_t give_end = lower ? end : middle;
+
+        block.resize(4U * (keep_end - keep_begin));
+        if (!exchange(links[partner], layer.data() + 4U * give_begin, 4U * (give_end - give_begin), block.data(), block.size())) {
+            std::cerr << "error: the sort-last node " << rank << " lost the node " << partner << std::endl;
+            return false;
+        }
+
+        // Premultiplied over operator in visibility order
+        const bool front = partition->isFront(rank, stage, eye);
+        GLfloat *const kept = layer.data() + 4U * keep_begin;
+        for (std::size_t i = 0U; i < block.size(); i += 4U) {
+            const GLfloat *const near = front ? kept + i : block.data() + i;
+            const GLfloat *const far = front ? block.data() + i : kept + i;
+            const GLfloat transparency = 1.0F - near[3];
+            GLfloat result[4];
+            for (std::size_t c = 0U; c < 4U; c++) {
+                result[c] = near[c] + transparency * far[c];
+            }
+            std::copy(result, result + 4, kept + i);
+        }
+
+        begin = keep_begin;
+        end = keep_end;
+    }
+
+    // Gather the pixels at the first node
+    if (rank != 0U) {
+        sent += 4U * (end - begin) * sizeof(GLfloat);
+        return links[0]->send(layer.data() + 4U * begin, 4U * (end - begin) * sizeof(GLfloat));
+    }
+
+    for (unsigned int other = 1U; other < getCount(); other++) {
+        std::size_t other_begin = 0U;
+        std::size_t other_end = 0U;
+        SortLastNode::getRegion(other, partition->getLevels(), pixels, other_begin, other_end);
+        if (!links[other]->receive(layer.data() + 4U * other_begin, 4U * (other_end - other_begin) * sizeof(GLfloat))) {
+            std::cerr << "error: the sort-last node " << other << " did not send its pixels" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+// Private static methods
+
+// Get the pixels kept by the rank
+void SortLastNode::getRegion(const unsigned int &rank, const unsigned int &stages, const std::size_t &pixels, std::size_t &begin, std::size_t &end) {
+    begin = 0U;
+    end = pixels;
+    for (unsigned int stage = 0U; stage < stages; stage++) {
+        const std::size_t middle = begin + (end - begin) / 2U;
+        if (((rank >> stage) & 1U) == 0U) {
+            end = middle;
+        }
+        else {
+            begin = middle;
+        }
+    }
+}
+
+
+// Constructors
+
+// Sort-last node constructor
+SortLastNode::SortLastNode(const unsigned int &rank, const std::vector<std::string> &peers) :
+    rank(rank),
+    peers(peers),
+    connected(false),
+    partition(nullptr),
+    width(0),
+    height(0),
+    frames(0U),
+    composite_time(0.0),
+    sent(0U) {
+    // Check the ranks
+    const unsigned int count = static_cast<unsigned int>(peers.size());
+    if ((count == 0U) || ((count & (count - 1U)) != 0U) || (rank >= count)) {
+        std::cerr << "error: the sort-last nodes must be a power of two and the rank lower than them" << std::endl;
+        return;
+    }
+
+    // Listen for the higher ranks and connect, the nodes may start in any order
+    connected = ((count == 1U) || listener.listen(peers[rank])) && connect(60000);
+    if (connected) {
+        std::cout << "info: sort-last node " << rank << " of " << count << " connected" << std::endl;
+    }
+}
+
+
+// Getters
+
+// Get the connected status
+bool SortLastNode::isValid() const {
+    return connected;
+}
+
+// Get the rank
+unsigned int SortLastNode::getRank() const {
+    return rank;
+}
+
+// Get the number of nodes
+unsigned int SortLastNode::getCount() const {
+    return static_cast<unsigned int>(peers.size());
+}
+
+// Get the gathered frame
+const std::vector<GLubyte> &SortLastNode::getFrame() const {
+    return frame;
+}
+
+// Get the mean compositing time per frame
+double SortLastNode::getCompositeTime() const {
+    return frames > 0U ? composite_time * 1000.0 / static_cast<double>(frames) : 0.0;
+}
+
+// Get the bytes sent to the other nodes
+unsigned long long int SortLastNode::getSentBytes() const {
+    return sent;
+}
+
+
+// Methods
+
+// Partition the grid and set the brick of the node
+bool SortLastNode::assign(Volume *const volume, const glm::uvec3 &grid) {
+    delete partition;
+    partition = new BrickPartition(grid, getCount());
+    if (!partition->isValid()) {
+        std::cerr << "error: the grid cannot be split in " << getCount() << " bricks" << std::endl;
+        return false;
+    }
+
+    const glm::uvec3 offset = partition->getOffset(rank);
+    const glm::uvec3 size = partition->getSize(rank);
+    volume->setBrick(offset, size);
+    std::cout << "info: sort-last node " << rank << " draws the brick " << size.x << "x" << size.y << "x" << size.z << " at " << offset.x << "," << offset.y << "," << offset.z << std::endl;
+    return true;
+}
+
+// Draw the brick, composite it and gather the frame
+bool SortLastNode::renderFrame(Scene *const scene) {
+    if (!connected || (partition == nullptr)) {
+        return false;
+    }
+
+    // Draw the layer of the brick
+    std::vector<GLfloat> layer = scene->renderLayer();
+    const glm::vec2 resolution = scene->getResolution();
+    width = static_cast<GLsizei>(resolution.x);
+    height = static_cast<GLsizei>(resolution.y);
+
+    // Composite it in the visibility order of the eye
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const glm::vec3 eye = scene->getVolume()->getGridPosition(scene->getCamera()->getPosition());
+    const bool composited = composite(layer, eye);
+    composite_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    frames++;
+    if (!composited || (rank != 0U)) {
+        return composited;
+    }
+
+    // Over the background, rows from the top
+    const glm::vec3 background = scene->getBackgroundColor();
+    const std::size_t row = static_cast<std::size_t>(width);
+    frame.resize(layer.size());
+    for (std::size_t y = 0U; y < static_cast<std::size_t>(height); y++) {
+        const GLfloat *source = layer.data() + 4U * row * (static_cast<std::size_t>(height) - 1U - y);
+        GLubyte *target = frame.data() + 4U * row * y;
+        for (std::size_t x = 0U; x < row; x++, source += 4, target += 4) {
+            const GLfloat transparency = 1.0F - source[3];
+            for (std::size_t c = 0U; c < 3U; c++) {
+                const GLfloat value = source[c] + transparency * background[static_cast<int>(c)];
+                target[c] = static_cast<GLubyte>(std::lround(255.0F * std::min(std::max(value, 0.0F), 1.0F)));
+            }
+            target[3] = 255U;
+        }
+    }
+
+    return true;
+}
+
+
+// Destructor
+
+// Sort-last node destructor
+SortLastNode::~SortLastNode() {
+    for (const std::pair<const unsigned int, Socket *> &link : links) {
+        delete link.second;
+    }
+    delete partition;
+}
+
+
+// Static methods
+
+// Get the addresses of the local nodes
+std::vector<std::string> SortLastNode::getLocalPeers(const unsigned int &count) {
+#if defined(__linux__)
+    const std::string prefix = "unix:/tmp/volumerenderer-" + std::to_string(::getpid()) + "-";
+#else
+    const std::string prefix = "unix:volumerenderer-";
+#endif
+
+    std::vector<std::string> peers;
+    for (unsigned int i = 0U; i < count; i++) {
+        peers.push_back(prefix + std::to_string(i) + ".sock");
+    }
+    return peers;
+}
+
+#if defined(__linux__)
+
+// Fork the local nodes
+unsigned int SortLastNode::spawn(const unsigned int &count) {
+    for (unsigned int i = 1U; i < count; i++) {
+        const pid_t child = ::fork();
+        if (child == 0) {
+            return i;
+        }
+        if (child < 0) {
+            std::cerr << "error: cannot start the sort-last node " << i << std::endl;
+        }
+    }
+
+    return 0U;
+}
+
+// Wait for the forked nodes
+bool SortLastNode::wait() {
+    bool succeeded = true;
+    int status = 0;
+    while (::wait(&status) > 0) {
+        succeeded = succeeded && WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+    }
+    return succeeded;
+}
+
+#else
+
+// Fork the local nodes
+unsigned int SortLastNode::spawn(const unsigned int &) {
+    std::cerr << "error: local sort-last nodes are not supported on this platform" << std::endl;
+    return 0U;
+}
+
+// Wait for the forked nodes
+bool SortLastNode::wait() {
+    return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,144 @@
+#ifndef __SORT_LAST_NODE_HPP_
+#define __SORT_LAST_NODE_HPP_
+
+#include "brickpartition.hpp"
+#include "../remote/socket.hpp"
+#include "../scene/scene.hpp"
+
+#include <string>
+
+#include <map>
+#include <vector>
+
+
+/** Sort-last rendering node drawing a kd brick of the volume and compositing the partial images by binary swap with the other nodes */
+class SortLastNode {
+    private:
+        // Attributes
+
+        /** Rank of the node, the first node gathers the frame */
+        unsigned int rank;
+
+        /** Addresses of all the nodes by rank */
+        std::vector<std::string> peers;
+
+        /** Listening socket */
+        Socket listener;
+
+        /** Connections to the swap partners and the first node by rank */
+        std::map<unsigned int, Socket *> links;
+
+        /** Connected status */
+        bool connected;
+
+
+        /** Partition of the grid, null before the assignation */
+        BrickPartition *partition;
+
+
+        /** Gathered frame of the first node, RGBA rows from the top */
+        std::vector<GLubyte> frame;
+
+        /** Frame width */
+        GLsizei width;
+
+        /** Frame height */
+        GLsizei height;
+
+
+        /** Composited frames */
+        unsigned long long int frames;
+
+        /** Time spent compositing in seconds */
+        double composite_time;
+
+        /** Bytes sent to the other nodes */
+        unsigned long long int sent;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        SortLastNode() = delete;
+
+        /** Disable the default copy constructor */
+        SortLastNode(const SortLastNode &) = delete;
+
+        /** Disable the assignation operator */
+        SortLastNode &operator=(const SortLastNode &) = delete;
+
+
+        // Methods
+
+        /** Connect to the lower ranked nodes and accept the higher ranked ones */
+        bool connect(const int &timeout_ms);
+
+        /** Send a block to the node while receiving another one */
+        bool exchange(const Socket *const socket, const GLfloat *const output, const std::size_t &output_count, GLfloat *const input, const std::size_t &input_count);
+
+        /** Composite the layer with the other nodes, the first node gathers the whole image */
+        bool composite(std::vector<GLfloat> &layer, const glm::vec3 &eye);
+
+
+        // Static methods
+
+        /** Get the pixels of the image kept by the rank after the swap stages */
+        static void getRegion(const unsigned int &rank, const unsigned int &stages, const std::size_t &pixels, std::size_t &begin, std::size_t &end);
+
+
+    public:
+        // Constructors
+
+        /** Sort-last node constructor, listens on its address and connects to the other nodes */
+        SortLastNode(const unsigned int &rank, const std::vector<std::string> &peers);
+
+
+        // Getters
+
+        /** Get the connected status */
+        bool isValid() const;
+
+        /** Get the rank */
+        unsigned int getRank() const;
+
+        /** Get the number of nodes */
+        unsigned int getCount() const;
+
+        /** Get the gathered frame of the first node, RGBA rows from the top */
+        const std::vector<GLubyte> &getFrame() const;
+
+        /** Get the mean compositing time per frame in milliseconds */
+        double getCompositeTime() const;
+
+        /** Get the bytes sent to the other nodes */
+        unsigned long long int getSentBytes() const;
+
+
+        // Methods
+
+        /** Partition the grid and set the brick of the node in the volume before loading it, returns false if the grid cannot be split */
+        bool assign(Volume *const volume, const glm::uvec3 &grid);
+
+        /** Draw the brick, composite it and gather the frame at the first node, returns false on communication errors */
+        bool renderFrame(Scene *const scene);
+
+
+        // Destructor
+
+        /** Sort-last node destructor, closes the connections */
+        virtual ~SortLastNode();
+
+
+        // Static methods
+
+        /** Get the Unix socket addresses of the given number of local nodes */
+        static std::vector<std::string> getLocalPeers(const unsigned int &count);
+
+        /** Fork the local nodes before creating any context, returns the rank of the calling process */
+        static unsigned int spawn(const unsigned int &count);
+
+        /** Wait for the forked nodes, returns false if any of them failed */
+        static bool wait();
+};
+
+#endif // __SORT_LAST_NODE_HPP_
\ No newline at end of file
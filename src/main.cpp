@@ -1,9 +1,70 @@
 #include "scene/gui/interactivescene.hpp"
 #include "volume/loader/volumedata.hpp"
+#include "profiler/tracer.hpp"
+#include "scene/sessionplayer.hpp"
+#include "benchmark/benchmark.hpp"
+#include "remote/remoteclient.hpp"
+#include "distributed/sortlastnode.hpp"
+#include "task/taskscheduler.hpp"
+#include "volume/volumecache.hpp"
 
 #include "dirsep.h"
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
+
+#include <chrono>
+#include <cstdlib>
+
+
+/** Link the programs of the scene */
+static void setupScene(Scene *const scene, const std::string &shader_path) {
+    // Set the background color and camera
+    scene->setBackgroundColor(glm::vec3(0.45F, 0.55F, 0.60F));
+
+    // Set the programs
+    scene->getProgram()->link(shader_path + "vap.vert.glsl", shader_path + "vap.frag.glsl");
+    scene->getUpsampleProgram()->link(shader_path + "screen.vert.glsl", shader_path + "upsample.frag.glsl");
+    scene->getAccumulateProgram()->link(shader_path + "screen.vert.glsl", shader_path + "accumulate.frag.glsl");
+    scene->getMeshProgram()->link(shader_path + "mesh.vert.glsl", shader_path + "mesh.frag.glsl");
+}
+
+/** Parse a list of unsigned integers separated by `x', returns false if the count does not match */
+static bool parseSize(const std::string &text, unsigned int *const value, const std::size_t &count) {
+    std::istringstream stream(text);
+    for (std::size_t i = 0U; i < count; i++) {
+        if (((i > 0U) && (stream.get() != 'x')) || !(stream >> value[i]) || (value[i] == 0U)) {
+            return false;
+        }
+    }
+    return stream.peek() == std::char_traits<char>::eof();
+}
+
+/** Write the last drawn frame as PNG or binary PPM by the extension */
+static bool writeFrame(Scene *const scene, const std::string &image_path) {
+    const glm::vec2 resolution = scene->getResolution();
+    return FrameCapture::write(image_path, static_cast<GLsizei>(resolution.x), static_cast<GLsizei>(resolution.y), scene->readFrame(), false);
+}
+
+/** Render the converged frame without window and write it as PNG or binary PPM */
+static bool renderHeadless(Scene *const scene, const std::string &image_path) {
+    // Draw until the accumulation converges
+    scene->setVolumeScale(1.0F);
+    unsigned int frames = 0U;
+    do {
+        scene->renderFrame();
+        frames++;
+    } while (scene->isDirty() && (frames < 256U));
+
+    // Write the image
+    if (!writeFrame(scene, image_path)) {
+        return false;
+    }
+
+    std::cout << "info: " << frames << " headless frames rendered to `" << image_path << "' with " << Scene::getOpenGLRenderer() << std::endl;
+    return true;
+}
 
 
 /** Main function */
@@ -13,18 +74,260 @@ int main (int argc, char **argv) {
         std::cout << "argv[" << i << "]: " << argv[i] << std::endl;
     }
 
-    // Create the scene and check it
-    InteractiveScene *scene = new InteractiveScene("VolumeRenderer");
+    // Name the thread in the trace
+    Tracer::setThreadName("main");
 
-    // Exit with error if the scene is not valid
-    if (!scene->isValid()) {
-        delete scene;
-        return 1;
-    }
 
+    // Parse the options
+    std::string profile_path;
+    std::string headless_path;
+    bool trace_on_exit = false;
+
+    // Session recording and replay options
+    std::string record_path;
+    std::string replay_path;
+    bool realtime = false;
+
+    // Frame capture images pattern
+    std::string capture_path;
+
+    // Datasets added to the interactive scene, the offset between them in world space and their preset
+    std::vector<std::string> overlays;
+    glm::vec3 overlay_offset(0.0F);
+    std::string overlay_preset;
+
+    // Remote rendering server and client options
+    std::string server_address;
+    std::string client_address;
+    unsigned int quality = 0U;
+    bool quit_server = false;
+
+    // Sort-last nodes, forked locally or one per host with the addresses of all of them
+    unsigned int node_count = 0U;
+    unsigned int node_rank = 0U;
+    std::vector<std::string> peers;
+
+    // Benchmark frames or remote client events
+    unsigned int frames = 256U;
+
+    // Benchmark options
+    std::string benchmark_path;
+    std::string dataset;
+    std::string dataset_format;
+    unsigned int dataset_size[3] = {256U, 256U, 256U};
+    glm::uvec3 crop_offset(0U);
+    unsigned int crop_size[3] = {0U, 0U, 0U};
+    unsigned int resolution[2] = {800U, 600U};
+    Benchmark *benchmark = new Benchmark();
+    bool valid_options = true;
+    for (int i = 1; i < argc; i++) {
+        const std::string option = argv[i];
+
+        // Export the frame phases profile as CSV or JSON
+        if ((option == "--profile") && (i + 1 < argc)) {
+            profile_path = argv[++i];
+        }
+
+        // Dump the trace events as Chrome trace JSON on exit
+        else if ((option == "--trace") && (i + 1 < argc)) {
+            Tracer::setPath(argv[++i]);
+            trace_on_exit = true;
+        }
+
+        // Render offscreen without window to a PNG or PPM image
+        else if ((option == "--headless") && (i + 1 < argc)) {
+            headless_path = argv[++i];
+        }
+
+        // Record the session states to a binary log
+        else if ((option == "--record") && (i + 1 < argc)) {
+            record_path = argv[++i];
+        }
+
+        // Replay a session log without window, as fast as possible or at real time
+        else if ((option == "--replay") && (i + 1 < argc)) {
+            replay_path = argv[++i];
+        }
+
+        else if (option == "--realtime") {
+            realtime = true;
+        }
+
+        // Capture the drawn frames as numbered PNG or PPM images
+        else if ((option == "--capture") && (i + 1 < argc)) {
+            capture_path = argv[++i];
+        }
+
+        // Serve the frames of an offscreen scene to a remote client
+        else if ((option == "--server") && (i + 1 < argc)) {
+            server_address = argv[++i];
+        }
+
+        // Dropped low bits of the streamed frames, zero for lossless
+        else if ((option == "--quality") && (i + 1 < argc)) {
+            quality = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        }
+
+        // Connect to a remote server, orbit for the given frames and report the latency
+        else if ((option == "--client") && (i + 1 < argc)) {
+            client_address = argv[++i];
+        }
+
+        else if (option == "--quit") {
+            quit_server = true;
+        }
+
+        // Draw the benchmark with local sort-last nodes, each one drawing a brick of the dataset
+        else if ((option == "--nodes") && (i + 1 < argc)) {
+            if (!parseSize(argv[++i], &node_count, 1U) || ((node_count & (node_count - 1U)) != 0U)) {
+                std::cerr << "error: the number of nodes must be a power of two" << std::endl;
+                valid_options = false;
+            }
+        }
+
+        // Rank of this node and addresses of all the sort-last nodes separated by commas
+        else if ((option == "--rank") && (i + 1 < argc)) {
+            node_rank = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        }
+
+        else if ((option == "--peers") && (i + 1 < argc)) {
+            std::istringstream stream(argv[++i]);
+            for (std::string address; std::getline(stream, address, ',');) {
+                peers.push_back(address);
+            }
+        }
+
+        // Render a camera path without window and write the timing report as JSON
+        else if ((option == "--benchmark") && (i + 1 < argc)) {
+            benchmark_path = argv[++i];
+        }
+
+        // Benchmark dataset, format and size
+        else if ((option == "--dataset") && (i + 1 < argc)) {
+            dataset = argv[++i];
+        }
+
+        else if ((option == "--format") && (i + 1 < argc)) {
+            dataset_format = argv[++i];
+        }
+
+        else if ((option == "--size") && (i + 1 < argc)) {
+            if (!parseSize(argv[++i], dataset_size, 3U)) {
+                std::cerr << "error: the size must be `WIDTHxHEIGHTxDEPTH'" << std::endl;
+                valid_options = false;
+            }
+        }
+
+        // Benchmark box of the grid read from the datasets, its lower corner and size
+        else if ((option == "--crop-offset") && (i + 1 < argc)) {
+            std::istringstream stream(argv[++i]);
+            std::string component;
+            for (int axis = 0; (axis < 3) && std::getline(stream, component, ','); axis++) {
+                crop_offset[axis] = static_cast<unsigned int>(std::strtoul(component.c_str(), nullptr, 10));
+            }
+        }
+
+        else if ((option == "--crop") && (i + 1 < argc)) {
+            if (!parseSize(argv[++i], crop_size, 3U)) {
+                std::cerr << "error: the crop must be `WIDTHxHEIGHTxDEPTH'" << std::endl;
+                valid_options = false;
+            }
+        }
+
+        // Benchmark voxels of the grid per read voxel, the boxes averaged by `--downsample' or their middle voxels taken by `--stride'
+        else if (((option == "--downsample") || (option == "--stride")) && (i + 1 < argc)) {
+            const std::string text = argv[++i];
+            unsigned int stride[3] = {1U, 1U, 1U};
+            if (parseSize(text, stride, 1U)) {
+                stride[1] = stride[0];
+                stride[2] = stride[0];
+            }
+            else if (!parseSize(text, stride, 3U)) {
+                std::cerr << "error: the " << option.substr(2U) << " must be `FACTOR' or `XxYxZ'" << std::endl;
+                valid_options = false;
+            }
+            benchmark->setStride(glm::uvec3(stride[0], stride[1], stride[2]), option == "--downsample");
+        }
+
+        // Datasets drawn with the dataset by the ray casting modes, the offset between them in world space and their preset, for the benchmark and the interactive scene
+        else if ((option == "--overlay") && (i + 1 < argc)) {
+            overlays.push_back(argv[++i]);
+            benchmark->addOverlay(overlays.back());
+        }
+
+        else if ((option == "--overlay-offset") && (i + 1 < argc)) {
+            std::istringstream stream(argv[++i]);
+            std::string component;
+            for (int axis = 0; (axis < 3) && std::getline(stream, component, ','); axis++) {
+                overlay_offset[axis] = std::strtof(component.c_str(), nullptr);
+            }
+            benchmark->setOverlayOffset(overlay_offset);
+        }
+
+        else if ((option == "--overlay-preset") && (i + 1 < argc)) {
+            overlay_preset = argv[++i];
+            benchmark->setOverlayPreset(overlay_preset);
+        }
+
+        // Benchmark transfer function preset, render mode, isovalue and camera path
+        else if ((option == "--preset") && (i + 1 < argc)) {
+            benchmark->setPreset(argv[++i]);
+        }
+
+        else if ((option == "--mode") && (i + 1 < argc)) {
+            valid_options = benchmark->setMode(argv[++i]) && valid_options;
+        }
+
+        else if ((option == "--isovalue") && (i + 1 < argc)) {
+            benchmark->setIsovalue(std::strtof(argv[++i], nullptr));
+        }
+
+        else if ((option == "--path") && (i + 1 < argc)) {
+            valid_options = benchmark->setCameraPath(argv[++i]) && valid_options;
+        }
+
+        // Benchmark orthographic projection
+        else if (option == "--ortho") {
+            benchmark->setOrthogonal(true);
+        }
+
+        // Benchmark voxel layout of the CPU ray caster
+        else if ((option == "--layout") && (i + 1 < argc)) {
+            valid_options = benchmark->setLayout(argv[++i]) && valid_options;
+        }
+
+        // Benchmark measured and warm up frames, the measured frames are also the remote client events
+        else if ((option == "--frames") && (i + 1 < argc)) {
+            valid_options = parseSize(argv[++i], &frames, 1U) && valid_options;
+            benchmark->setFrames(frames);
+        }
+
+        else if ((option == "--warmup") && (i + 1 < argc)) {
+            benchmark->setWarmup(static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10)));
+        }
+
+        // Budgets of the cached host voxels and resident textures of the closed volumes in MiB
+        else if ((option == "--cache") && (i + 1 < argc)) {
+            VolumeCache::setBudget(static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10)) << 20U);
+        }
+
+        else if ((option == "--cache-textures") && (i + 1 < argc)) {
+            VolumeCache::setTextureBudget(static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10)) << 20U);
+        }
+
+        // Offscreen resolution
+        else if ((option == "--resolution") && (i + 1 < argc)) {
+            if (!parseSize(argv[++i], resolution, 2U)) {
+                std::cerr << "error: the resolution must be `WIDTHxHEIGHT'" << std::endl;
+                valid_options = false;
+            }
+        }
+
+        else {
+            std::cerr << "warning: unknown option `" << option << "'" << std::endl;
+        }
+    }
 
-    // Set the background color and camera
-    scene->setBackgroundColor(glm::vec3(0.45F, 0.55F, 0.60F));
 
     // Setup directories
     const std::string bin_path = argv[0];
@@ -32,15 +335,210 @@ int main (int argc, char **argv) {
 
     const std::string volume_path = relative + ".." + DIR_SEP + "volume" + DIR_SEP;
     const std::string shader_path = relative + ".." + DIR_SEP + "shader" + DIR_SEP;
+    const std::string cache_path = relative + "cache" + DIR_SEP;
+
+    // Setup the shader binary cache and log
+    GLSLProgram::setCachePath(cache_path);
+    GLSLProgram::setLogPath(relative + "shader.log");
+
+    // Setup the on demand trace file
+    if (Tracer::getPath().empty()) {
+        Tracer::setPath(relative + "trace.json");
+    }
+
+
+    // Benchmark dataset, the default volume if none is given
+    if (dataset.empty()) {
+        dataset = volume_path + "foot.dat";
+    }
+
+    VolumeData::Format format = VolumeData::RAW8;
+    if (dataset_format == "raw16") {
+        format = VolumeData::RAW16;
+    }
+    else if ((dataset_format == "pvm") || (dataset_format.empty() && (dataset.size() > 4U) && (dataset.compare(dataset.size() - 4U, 4U, ".pvm") == 0))) {
+        format = VolumeData::PVM;
+    }
+    else if (!dataset_format.empty() && (dataset_format != "raw8")) {
+        std::cerr << "error: unknown dataset format `" << dataset_format << "'" << std::endl;
+        valid_options = false;
+    }
+
+    benchmark->setDataset(dataset, format, glm::uvec3(dataset_size[0], dataset_size[1], dataset_size[2]));
+    benchmark->setCrop(crop_offset, glm::uvec3(crop_size[0], crop_size[1], crop_size[2]));
+
+
+    // Start the local sort-last nodes and connect all the nodes
+    SortLastNode *node = nullptr;
+    const bool forked = peers.empty() && (node_count > 1U);
+    if (valid_options && (!peers.empty() || (node_count > 0U))) {
+        if (peers.empty()) {
+            peers = SortLastNode::getLocalPeers(node_count);
+            node_rank = forked ? SortLastNode::spawn(node_count) : 0U;
+        }
+
+        node = new SortLastNode(node_rank, peers);
+        benchmark->setNode(node);
+        valid_options = node->isValid();
+    }
+
+
+    // Task scheduler shared by the CPU subsystems, started after the local nodes are forked
+    TaskScheduler *scheduler = new TaskScheduler();
+    TaskScheduler::setActive(scheduler);
+
+
+    // Remote client without OpenGL context, the frames option sets the number of orbit events
+    if (!client_address.empty()) {
+        RemoteClient *client = new RemoteClient(client_address);
+        bool connected = valid_options && client->isConnected() && client->orbit(frames);
+        if (connected) {
+            client->printReport();
+            if (!headless_path.empty()) {
+                connected = client->writeFrame(headless_path);
+            }
+            if (quit_server) {
+                client->sendEvent(RemoteServer::QUIT);
+            }
+        }
+
+        delete client;
+        delete benchmark;
+        delete scheduler;
+        return connected ? 0 : 1;
+    }
+
+
+    // Headless rendering, benchmark, sort-last nodes, replay and remote server
+    if (!headless_path.empty() || !benchmark_path.empty() || !peers.empty() || (node_count > 0U) || !replay_path.empty() || !server_address.empty()) {
+        // Create the offscreen scene and check it
+        Scene *scene = nullptr;
+        bool rendered = false;
+        if (valid_options) {
+            scene = new Scene("VolumeRenderer", static_cast<int>(resolution[0]), static_cast<int>(resolution[1]), 3, 3, true);
+        }
+
+        if ((scene != nullptr) && scene->isValid()) {
+            if (!profile_path.empty()) {
+                scene->getProfiler()->open(profile_path);
+            }
+
+            setupScene(scene, shader_path);
+
+            if (!capture_path.empty()) {
+                scene->startCapture(capture_path);
+            }
+
+            // Run the benchmark, only the first sort-last node writes the report and the composited frame
+            if (!benchmark_path.empty() || (node != nullptr)) {
+                rendered = benchmark->run(scene);
+                if (rendered && ((node == nullptr) || (node->getRank() == 0U))) {
+                    const glm::vec2 size = scene->getResolution();
+                    rendered = (benchmark_path.empty() || benchmark->write(benchmark_path, scene)) && (headless_path.empty() || (node == nullptr ? writeFrame(scene, headless_path) : FrameCapture::write(headless_path, static_cast<GLsizei>(size.x), static_cast<GLsizei>(size.y), node->getFrame(), false)));
+                }
+            }
+
+            // Serve the default volume until a client asks to stop
+            else if (!server_address.empty()) {
+                RemoteServer *server = new RemoteServer(scene, server_address, quality);
+                if (server->isValid()) {
+                    scene->getVolume()->setPath(volume_path + "foot.dat", VolumeData::RAW8, 256, 256, 256);
+                    server->run();
+                    rendered = true;
+                }
+                delete server;
+            }
+
+            // Replay the session and write the last frame if requested
+            else if (!replay_path.empty()) {
+                SessionPlayer *player = new SessionPlayer(replay_path);
+                if (player->isValid()) {
+                    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                    const unsigned long long int replayed = player->play(scene, realtime);
+                    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    std::cout << "info: " << player->getRecords() << " session records of " << player->getDuration() << " s replayed in " << replayed << " frames and " << elapsed << " s" << std::endl;
+                    rendered = headless_path.empty() || writeFrame(scene, headless_path);
+                }
+                delete player;
+            }
+
+            // Render the default volume
+            else {
+                scene->getVolume()->setPath(volume_path + "foot.dat", VolumeData::RAW8, 256, 256, 256);
+                rendered = renderHeadless(scene, headless_path);
+            }
+        }
+
+        // Clean up and exit
+        delete benchmark;
+        delete scene;
+        delete node;
+        delete scheduler;
+        if (trace_on_exit) {
+            Tracer::dump();
+        }
+
+        // The first local node waits for the others
+        if (forked && (node_rank == 0U)) {
+            rendered = SortLastNode::wait() && rendered;
+        }
+
+        return rendered ? 0 : 1;
+    }
+
+
+    // The benchmark settings are not used by the interactive scene
+    delete benchmark;
+
+
+    // Create the scene and check it
+    InteractiveScene *scene = new InteractiveScene("VolumeRenderer");
+
+    // Exit with error if the scene is not valid
+    if (!scene->isValid()) {
+        delete scene;
+        delete scheduler;
+        return 1;
+    }
+
+    // Export the profile
+    if (!profile_path.empty()) {
+        scene->getProfiler()->open(profile_path);
+    }
+
+    // Record the session from the start, the F9 key toggles the recording
+    scene->setRecordingPath(record_path.empty() ? relative + "session.bin" : record_path);
 
     // Setup the interactive scene programs
     scene->getGUIProgram()->link(shader_path + "gui.vert.glsl", shader_path + "gui.frag.glsl");
     scene->getTransferFunctionProgram()->link(shader_path + "func.vert.glsl", shader_path + "func.frag.glsl");
 
     // Set the program and volume
-    scene->getProgram()->link(shader_path + "vap.vert.glsl", shader_path + "vap.frag.glsl");
+    setupScene(scene, shader_path);
     scene->getVolume()->setPath(volume_path + "foot.dat", VolumeData::RAW8, 256, 256, 256);
 
+    // Add the overlays, the O key adds and removes them too
+    for (const std::string &overlay : overlays) {
+        Volume *const added = scene->addOverlay(overlay, overlay_offset);
+        if ((added != nullptr) && !overlay_preset.empty()) {
+            added->getTransferFunction()->loadPreset(overlay_preset);
+        }
+    }
+
+    // Report the programs startup latency
+    scene->printLinkReport("startup");
+
+    // Record the session including the initial state
+    if (!record_path.empty()) {
+        scene->startRecording();
+    }
+
+    // Capture the frames from the start, the F10 key toggles the capture
+    scene->setCapturePath(capture_path.empty() ? relative + "frame.png" : capture_path);
+    if (!capture_path.empty()) {
+        scene->startCapture(capture_path);
+    }
+
 
     // Esecute the main loop
     scene->mainLoop();
@@ -48,5 +546,12 @@ int main (int argc, char **argv) {
 
     // Clean up and normal exit
     delete scene;
+    delete scheduler;
+
+    // Write the trace including the shutdown
+    if (trace_on_exit) {
+        Tracer::dump();
+    }
+
     return 0;
 }
\ No newline at end of file
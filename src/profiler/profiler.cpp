@@ -0,0 +1,448 @@
+#include "profiler.hpp"
+
+#include "tracer.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+
+// Static const attributes
+
+// Maximum number of timestamp queries in flight
+const std::size_t Profiler::MAX_QUERIES;
+
+// Number of frames kept for the rolling percentiles
+const std::size_t Profiler::WINDOW;
+
+
+// Private static attributes
+
+// Profiler receiving the scopes of the subsystems on the calling thread
+thread_local Profiler *Profiler::active = nullptr;
+
+
+// Private methods
+
+// Get a free timestamp query, zero if all of them are in flight
+GLuint Profiler::acquireQuery() {
+    // Check the GPU timer
+    if (!gpu_timer) {
+        return GL_FALSE;
+    }
+
+    // Reuse a query
+    if (!free_queries.empty()) {
+        const GLuint query = free_queries.back();
+        free_queries.pop_back();
+        return query;
+    }
+
+    // Generate a new query if the limit has not been reached
+    GLuint query = GL_FALSE;
+    if (query_stock.size() < Profiler::MAX_QUERIES) {
+        glGenQueries(1, &query);
+        query_stock.push_back(query);
+    }
+
+    return query;
+}
+
+// Read the GPU intervals of the record, returns false if a result is not available and it must not wait
+bool Profiler::resolve(Profiler::Record &record, const bool &wait) {
+    // Check all the results before reading any of them
+    if (!wait) {
+        for (const Profiler::Interval &interval : record.intervals) {
+            for (const GLuint &query : interval.query) {
+                GLint available = GL_FALSE;
+                glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+                if (available == GL_FALSE) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    // Add the elapsed times and release the queries
+    for (const Profiler::Interval &interval : record.intervals) {
+        GLuint64 start = 0U;
+        GLuint64 stop = 0U;
+        glGetQueryObjectui64v(interval.query[0], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(interval.query[1], GL_QUERY_RESULT, &stop);
+        free_queries.push_back(interval.query[0]);
+        free_queries.push_back(interval.query[1]);
+
+        // Nanoseconds to milliseconds
+        Profiler::Timing &timing = record.phases[interval.phase];
+        timing.gpu = std::max(0.0, timing.gpu) + (stop > start ? static_cast<double>(stop - start) / 1000000.0 : 0.0);
+    }
+
+    record.intervals.clear();
+    return true;
+}
+
+// Add the completed record to the history and the export stream
+void Profiler::complete(const Profiler::Record &record) {
+    // Add the samples of the phases in the frame
+    for (const std::pair<const std::string, Profiler::Timing> &phase : record.phases) {
+        std::deque<double> &cpu = cpu_history[phase.first];
+        cpu.push_back(phase.second.cpu);
+        if (cpu.size() > Profiler::WINDOW) {
+            cpu.pop_front();
+        }
+
+        if (phase.second.gpu >= 0.0) {
+            std::deque<double> &gpu = gpu_history[phase.first];
+            gpu.push_back(phase.second.gpu);
+            if (gpu.size() > Profiler::WINDOW) {
+                gpu.pop_front();
+            }
+        }
+    }
+
+    completed++;
+    write(record);
+}
+
+// Write the record to the export stream
+void Profiler::write(const Profiler::Record &record) {
+    // Check the export stream
+    if (!output.is_open()) {
+        return;
+    }
+
+    output << std::fixed << std::setprecision(4);
+
+    // One row per phase
+    if (output_format == Profiler::CSV) {
+        for (const std::pair<const std::string, Profiler::Timing> &phase : record.phases) {
+            output << record.frame << ',' << record.time << ',' << phase.first << ',' << phase.second.calls << ',' << phase.second.cpu << ',';
+            if (phase.second.gpu >= 0.0) {
+                output << phase.second.gpu;
+            }
+            output << '\n';
+        }
+    }
+
+    // One object per frame
+    else {
+        output << (exported == 0U ? "\n" : ",\n") << "  {\"frame\": " << record.frame << ", \"time\": " << record.time << ", \"phases\": {";
+        bool first = true;
+        for (const std::pair<const std::string, Profiler::Timing> &phase : record.phases) {
+            output << (first ? "" : ", ") << '"' << phase.first << "\": {\"calls\": " << phase.second.calls << ", \"cpu_ms\": " << phase.second.cpu << ", \"gpu_ms\": ";
+            if (phase.second.gpu >= 0.0) {
+                output << phase.second.gpu;
+            }
+            else {
+                output << "null";
+            }
+            output << '}';
+            first = false;
+        }
+        output << "}}";
+    }
+
+    exported++;
+}
+
+
+// Private static methods
+
+// Get the steady time in seconds
+double Profiler::now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Get the percentiles of the given samples
+Profiler::Statistics Profiler::percentiles(const std::deque<double> &samples) {
+    // Without samples
+    if (samples.empty()) {
+        return Profiler::Statistics{-1.0, -1.0, -1.0};
+    }
+
+    // Nearest rank percentiles
+    std::vector<double> sorted(samples.begin(), samples.end());
+    std::sort(sorted.begin(), sorted.end());
+    const double size = static_cast<double>(sorted.size());
+    const std::size_t p50 = static_cast<std::size_t>(std::max(1.0, std::ceil(0.50 * size))) - 1U;
+    const std::size_t p95 = static_cast<std::size_t>(std::max(1.0, std::ceil(0.95 * size))) - 1U;
+    const std::size_t p99 = static_cast<std::size_t>(std::max(1.0, std::ceil(0.99 * size))) - 1U;
+    return Profiler::Statistics{sorted[p50], sorted[p95], sorted[p99]};
+}
+
+
+// Constructors
+
+// Profiler constructor, needs a current OpenGL context
+Profiler::Profiler() :
+    // Status
+    enabled(true),
+    gpu_timer(false),
+    origin(Profiler::now()),
+
+    // Records
+    current{0U, 0.0, {}, {}},
+
+    // History
+    completed(0U),
+
+    // Export
+    output_format(Profiler::CSV),
+    exported(0U) {
+    // Check the timestamp queries support
+    if ((GLAD_GL_VERSION_3_3 != 0) || (GLAD_GL_ARB_timer_query != 0)) {
+        GLint bits = 0;
+        glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &bits);
+        gpu_timer = bits > 0;
+    }
+}
+
+
+// Getters
+
+// Get the enabled status
+bool Profiler::isEnabled() const {
+    return enabled;
+}
+
+// Get the GPU timer status
+bool Profiler::isGPUTimer() const {
+    return gpu_timer;
+}
+
+// Get the number of completed frames
+unsigned long long int Profiler::getCompletedFrames() const {
+    return completed;
+}
+
+// Get the exporting status
+bool Profiler::isExporting() const {
+    return output.is_open();
+}
+
+
+// Get the names of the phases with completed frames
+std::vector<std::string> Profiler::getPhases() const {
+    std::vector<std::string> phases;
+    for (const std::pair<const std::string, std::deque<double> > &phase : cpu_history) {
+        phases.push_back(phase.first);
+    }
+    return phases;
+}
+
+// Get the rolling CPU percentiles of the phase
+Profiler::Statistics Profiler::getCPUStatistics(const std::string &phase) const {
+    const std::map<std::string, std::deque<double> >::const_iterator history = cpu_history.find(phase);
+    return Profiler::percentiles(history == cpu_history.end() ? std::deque<double>() : history->second);
+}
+
+// Get the rolling GPU percentiles of the phase
+Profiler::Statistics Profiler::getGPUStatistics(const std::string &phase) const {
+    const std::map<std::string, std::deque<double> >::const_iterator history = gpu_history.find(phase);
+    return Profiler::percentiles(history == gpu_history.end() ? std::deque<double>() : history->second);
+}
+
+// Get the rolling times of the phase, oldest first, GPU if measured, otherwise CPU
+std::vector<double> Profiler::getHistory(const std::string &phase) const {
+    std::map<std::string, std::deque<double> >::const_iterator history = gpu_history.find(phase);
+    if (history == gpu_history.end()) {
+        history = cpu_history.find(phase);
+        if (history == cpu_history.end()) {
+            return std::vector<double>();
+        }
+    }
+    return std::vector<double>(history->second.begin(), history->second.end());
+}
+
+// Get the percentiles summary of the given phases
+std::string Profiler::getSummary(const std::vector<std::string> &phases) const {
+    std::ostringstream summary;
+    summary << std::fixed << std::setprecision(2) << "p50/p95/p99";
+    for (const std::string &phase : phases) {
+        // GPU if measured, otherwise CPU
+        const bool gpu = gpu_history.count(phase) != 0U;
+        const Profiler::Statistics statistics = gpu ? getGPUStatistics(phase) : getCPUStatistics(phase);
+        if (statistics.p50 >= 0.0) {
+            summary << ' ' << phase << ' ' << statistics.p50 << '/' << statistics.p95 << '/' << statistics.p99 << (gpu ? " ms (gpu)" : " ms (cpu)");
+        }
+    }
+    return summary.str();
+}
+
+
+// Setters
+
+// Set the enabled status
+void Profiler::setEnabled(const bool &status) {
+    enabled = status;
+}
+
+
+// Methods
+
+// Start timing a phase, scopes can be nested, the phase is also traced
+void Profiler::begin(const std::string &phase) {
+    Tracer::begin(phase.c_str());
+
+    // The scopes opened while disabled are ignored by their end
+    if (!enabled) {
+        scopes.push_back(Profiler::Scope{std::string(), 0.0, GL_FALSE});
+        return;
+    }
+
+    // Start timestamp, the GPU is not measured if the queries are exhausted
+    const GLuint query = acquireQuery();
+    if (query != GL_FALSE) {
+        glQueryCounter(query, GL_TIMESTAMP);
+    }
+
+    scopes.push_back(Profiler::Scope{phase, Profiler::now(), query});
+}
+
+// Stop timing the innermost phase, the phase is also traced
+void Profiler::end() {
+    // Check the open scopes
+    if (scopes.empty()) {
+        std::cerr << "warning: profiler scope ended without beginning" << std::endl;
+        return;
+    }
+
+    Tracer::end();
+
+    const Profiler::Scope scope = scopes.back();
+    scopes.pop_back();
+    if (scope.phase.empty()) {
+        return;
+    }
+
+    // Add the CPU time, the GPU time starts as not measured
+    Profiler::Timing &timing = current.phases.insert(std::make_pair(scope.phase, Profiler::Timing{0.0, -1.0, 0U})).first->second;
+    timing.cpu += 1000.0 * (Profiler::now() - scope.start);
+    timing.calls++;
+
+    // End timestamp, the result is read on later frames
+    if (scope.query != GL_FALSE) {
+        const GLuint query = acquireQuery();
+        if (query == GL_FALSE) {
+            free_queries.push_back(scope.query);
+        }
+        else {
+            glQueryCounter(query, GL_TIMESTAMP);
+            current.intervals.push_back(Profiler::Interval{scope.phase, {scope.query, query}});
+        }
+    }
+}
+
+// Seal the record of the current frame and read the available GPU results
+void Profiler::endFrame(const unsigned long long int &frame) {
+    // Seal the record, the scopes still open are added to the next one
+    current.frame = frame;
+    current.time = Profiler::now() - origin;
+    if (!current.phases.empty()) {
+        pending.push_back(current);
+    }
+
+    // Start a new record
+    current.phases.clear();
+    current.intervals.clear();
+
+    // Read the finished frames
+    collect();
+}
+
+// Read the available GPU results without blocking
+void Profiler::collect() {
+    // Frames are completed in order
+    while (!pending.empty() && resolve(pending.front(), false)) {
+        complete(pending.front());
+        pending.pop_front();
+    }
+}
+
+
+// Open the export file, the format is JSON for the `.json' extension and CSV otherwise
+bool Profiler::open(const std::string &path) {
+    // Close the previous file
+    close();
+
+    // Open the file
+    output.open(path, std::ofstream::out | std::ofstream::trunc);
+    if (!output.is_open()) {
+        std::cerr << "error: cannot open the profile file `" << path << "'" << std::endl;
+        return false;
+    }
+
+    // Write the header
+    const std::string::size_type dot = path.find_last_of('.');
+    output_format = (dot != std::string::npos) && (path.substr(dot) == ".json") ? Profiler::JSON : Profiler::CSV;
+    if (output_format == Profiler::CSV) {
+        output << "frame,time,phase,calls,cpu_ms,gpu_ms\n";
+    }
+    else {
+        output << "{\"frames\": [";
+    }
+
+    exported = 0U;
+    return true;
+}
+
+// Flush the pending records and close the export file
+void Profiler::close() {
+    // Wait the pending frames
+    while (!pending.empty()) {
+        resolve(pending.front(), true);
+        complete(pending.front());
+        pending.pop_front();
+    }
+
+    // Check the export stream
+    if (!output.is_open()) {
+        return;
+    }
+
+    // Write the footer
+    if (output_format == Profiler::JSON) {
+        output << "\n]}\n";
+    }
+
+    output.close();
+}
+
+
+// Destructor
+
+// Profiler destructor
+Profiler::~Profiler() {
+    // Flush the export file
+    close();
+
+    // Delete the timestamp queries
+    if (!query_stock.empty()) {
+        glDeleteQueries(static_cast<GLsizei>(query_stock.size()), query_stock.data());
+    }
+
+    // Stop receiving the scopes
+    if (Profiler::active == this) {
+        Profiler::active = nullptr;
+    }
+}
+
+
+// Static getters
+
+// Get the profiler receiving the scopes of the subsystems on the calling thread
+Profiler *Profiler::getActive() {
+    return Profiler::active;
+}
+
+
+// Static setters
+
+// Set the profiler receiving the scopes of the subsystems on the calling thread
+void Profiler::setActive(Profiler *const profiler) {
+    Profiler::active = profiler;
+}
\ No newline at end of file
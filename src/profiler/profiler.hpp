@@ -0,0 +1,277 @@
+#ifndef __PROFILER_HPP_
+#define __PROFILER_HPP_
+
+#include "../glad/glad.h"
+
+#include <string>
+#include <fstream>
+
+#include <deque>
+#include <map>
+#include <vector>
+
+
+/** Frame phase profiler with CPU timers and asynchronous GPU timestamp queries, it must be used from the OpenGL context thread */
+class Profiler {
+    public:
+        // Enumerations
+
+        /** Export format */
+        enum Format {
+            CSV,
+            JSON
+        };
+
+
+        // Structures
+
+        /** Time spent by a phase within a frame */
+        struct Timing {
+            /** CPU time in milliseconds */
+            double cpu;
+
+            /** GPU time in milliseconds, negative if it was not measured */
+            double gpu;
+
+            /** Number of scopes */
+            unsigned int calls;
+        };
+
+        /** Rolling percentiles of a phase in milliseconds, negative if there are no samples */
+        struct Statistics {
+            /** Median */
+            double p50;
+
+            /** 95th percentile */
+            double p95;
+
+            /** 99th percentile */
+            double p99;
+        };
+
+
+    private:
+        // Structures
+
+        /** Open scope */
+        struct Scope {
+            /** Phase name */
+            std::string phase;
+
+            /** CPU start time in seconds */
+            double start;
+
+            /** Start timestamp query, zero if the GPU is not measured */
+            GLuint query;
+        };
+
+        /** Pair of timestamp queries waiting for the result */
+        struct Interval {
+            /** Phase name */
+            std::string phase;
+
+            /** Start and end timestamp queries */
+            GLuint query[2];
+        };
+
+        /** Frame record */
+        struct Record {
+            /** Frame number */
+            unsigned long long int frame;
+
+            /** Time since the profiler creation in seconds */
+            double time;
+
+            /** Phases timing */
+            std::map<std::string, Profiler::Timing> phases;
+
+            /** GPU intervals waiting for the result */
+            std::vector<Profiler::Interval> intervals;
+        };
+
+
+        // Static const attributes
+
+        /** Maximum number of timestamp queries in flight */
+        static const std::size_t MAX_QUERIES = 512U;
+
+
+        // Attributes
+
+        /** Enabled status */
+        bool enabled;
+
+        /** GPU timer status */
+        bool gpu_timer;
+
+        /** Creation time in seconds */
+        double origin;
+
+
+        /** Open scopes stack */
+        std::vector<Profiler::Scope> scopes;
+
+        /** Record of the current frame */
+        Profiler::Record current;
+
+        /** Sealed records waiting for the GPU results, oldest first */
+        std::deque<Profiler::Record> pending;
+
+
+        /** Generated timestamp queries */
+        std::vector<GLuint> query_stock;
+
+        /** Free timestamp queries */
+        std::vector<GLuint> free_queries;
+
+
+        /** Rolling CPU times of the completed frames by phase */
+        std::map<std::string, std::deque<double> > cpu_history;
+
+        /** Rolling GPU times of the completed frames by phase */
+        std::map<std::string, std::deque<double> > gpu_history;
+
+        /** Number of completed frames */
+        unsigned long long int completed;
+
+
+        /** Export stream */
+        std::ofstream output;
+
+        /** Export format */
+        Profiler::Format output_format;
+
+        /** Exported records */
+        unsigned long long int exported;
+
+
+        // Constructors
+
+        /** Disable the default copy constructor */
+        Profiler(const Profiler &) = delete;
+
+        /** Disable the assignation operator */
+        Profiler &operator=(const Profiler &) = delete;
+
+
+        // Methods
+
+        /** Get a free timestamp query, zero if all of them are in flight */
+        GLuint acquireQuery();
+
+        /** Read the GPU intervals of the record, returns false if a result is not available and it must not wait */
+        bool resolve(Profiler::Record &record, const bool &wait);
+
+        /** Add the completed record to the history and the export stream */
+        void complete(const Profiler::Record &record);
+
+        /** Write the record to the export stream */
+        void write(const Profiler::Record &record);
+
+
+        // Static attributes
+
+        /** Profiler receiving the scopes of the subsystems on the calling thread */
+        static thread_local Profiler *active;
+
+
+        // Static methods
+
+        /** Get the steady time in seconds */
+        static double now();
+
+        /** Get the percentiles of the given samples */
+        static Profiler::Statistics percentiles(const std::deque<double> &samples);
+
+
+    public:
+        // Static const attributes
+
+        /** Number of frames kept for the rolling percentiles */
+        static const std::size_t WINDOW = 256U;
+
+
+        // Constructors
+
+        /** Profiler constructor, needs a current OpenGL context */
+        Profiler();
+
+
+        // Getters
+
+        /** Get the enabled status */
+        bool isEnabled() const;
+
+        /** Get the GPU timer status */
+        bool isGPUTimer() const;
+
+        /** Get the number of completed frames */
+        unsigned long long int getCompletedFrames() const;
+
+        /** Get the exporting status */
+        bool isExporting() const;
+
+
+        /** Get the names of the phases with completed frames */
+        std::vector<std::string> getPhases() const;
+
+        /** Get the rolling CPU percentiles of the phase */
+        Profiler::Statistics getCPUStatistics(const std::string &phase) const;
+
+        /** Get the rolling GPU percentiles of the phase */
+        Profiler::Statistics getGPUStatistics(const std::string &phase) const;
+
+        /** Get the rolling times of the phase, oldest first, GPU if measured, otherwise CPU */
+        std::vector<double> getHistory(const std::string &phase) const;
+
+        /** Get the percentiles summary of the given phases */
+        std::string getSummary(const std::vector<std::string> &phases) const;
+
+
+        // Setters
+
+        /** Set the enabled status */
+        void setEnabled(const bool &status);
+
+
+        // Methods
+
+        /** Start timing a phase, scopes can be nested, the phase is also traced */
+        void begin(const std::string &phase);
+
+        /** Stop timing the innermost phase, the phase is also traced */
+        void end();
+
+        /** Seal the record of the current frame and read the available GPU results */
+        void endFrame(const unsigned long long int &frame);
+
+        /** Read the available GPU results without blocking */
+        void collect();
+
+
+        /** Open the export file, the format is JSON for the `.json' extension and CSV otherwise */
+        bool open(const std::string &path);
+
+        /** Flush the pending records and close the export file */
+        void close();
+
+
+        // Destructor
+
+        /** Profiler destructor */
+        virtual ~Profiler();
+
+
+        // Static getters
+
+        /** Get the profiler receiving the scopes of the subsystems on the calling thread */
+        static Profiler *getActive();
+
+
+        // Static setters
+
+        /** Set the profiler receiving the scopes of the subsystems on the calling thread */
+        static void setActive(Profiler *const profiler);
+};
+
+#endif // __PROFILER_HPP_
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include "profilerscope.hpp"
+
+#include "tracer.hpp"
+
+
+// Constructors
+
+// Start timing the phase in the active profiler of the thread
+ProfilerScope::ProfilerScope(const std::string &phase) :
+    // Active profiler
+    profiler(Profiler::getActive()) {
+    // The profiler also traces the phase
+    if (profiler != nullptr) {
+        profiler->begin(phase);
+    }
+    else {
+        Tracer::begin(phase.c_str());
+    }
+}
+
+
+// Destructor
+
+// Stop timing the phase
+ProfilerScope::~ProfilerScope() {
+    if (profiler != nullptr) {
+        profiler->end();
+    }
+    else {
+        Tracer::end();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef __PROFILER_SCOPE_HPP_
+#define __PROFILER_SCOPE_HPP_
+
+#include "profiler.hpp"
+
+#include <string>
+
+
+/** Scoped timer of a phase in the active profiler of the thread, or only traced if there is none */
+class ProfilerScope {
+    private:
+        // Attributes
+
+        /** Profiler timing the phase, null if the thread has no active profiler */
+        Profiler *const profiler;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        ProfilerScope() = delete;
+
+        /** Disable the default copy constructor */
+        ProfilerScope(const ProfilerScope &) = delete;
+
+        /** Disable the assignation operator */
+        ProfilerScope &operator=(const ProfilerScope &) = delete;
+
+
+    public:
+        // Constructors
+
+        /** Start timing the phase in the active profiler of the thread */
+        ProfilerScope(const std::string &phase);
+
+
+        // Destructor
+
+        /** Stop timing the phase */
+        virtual ~ProfilerScope();
+};
+
+#endif // __PROFILER_SCOPE_HPP_
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "tracer.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <algorithm>
+#include <cstring>
+
+
+// Private static const attributes
+
+// Events per thread ring buffer
+const std::size_t Tracer::CAPACITY;
+
+
+// Private static attributes
+
+// Enabled status
+std::atomic<bool> Tracer::enabled(true);
+
+// Buffers of all the threads that have traced, they live until the exit
+std::vector<Tracer::Buffer *> Tracer::buffers;
+
+// Buffers list and names lock
+std::mutex Tracer::buffers_mutex;
+
+// Buffer of the calling thread
+thread_local Tracer::Buffer *Tracer::buffer = nullptr;
+
+// Trace file path
+std::string Tracer::path;
+
+// Origin of the timestamps
+const std::chrono::steady_clock::time_point Tracer::origin = std::chrono::steady_clock::now();
+
+
+// Private static methods
+
+// Get the buffer of the calling thread, creating it on first use
+Tracer::Buffer *Tracer::getBuffer() {
+    // Create and register the buffer of the thread
+    if (Tracer::buffer == nullptr) {
+        Tracer::Buffer *const created = new Tracer::Buffer();
+        created->events = new Tracer::Event[Tracer::CAPACITY];
+        created->head = 0U;
+
+        std::lock_guard<std::mutex> lock(Tracer::buffers_mutex);
+        created->id = static_cast<unsigned int>(Tracer::buffers.size()) + 1U;
+        Tracer::buffers.push_back(created);
+        Tracer::buffer = created;
+    }
+
+    return Tracer::buffer;
+}
+
+// Append an event to the buffer of the calling thread
+void Tracer::record(const char *name, const char &type) {
+    // Write the next slot, only this thread writes the buffer
+    Tracer::Buffer *const target = Tracer::getBuffer();
+    const std::uint64_t head = target->head.load(std::memory_order_relaxed);
+    Tracer::Event &event = target->events[head % Tracer::CAPACITY];
+    std::strncpy(event.name, name, sizeof(event.name) - 1U);
+    event.name[sizeof(event.name) - 1U] = '\0';
+    event.type = type;
+    event.time = Tracer::now();
+
+    // Publish the event
+    target->head.store(head + 1U, std::memory_order_release);
+}
+
+// Get the time since the tracer origin in nanoseconds
+std::uint64_t Tracer::now() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Tracer::origin).count());
+}
+
+// Escape a text for a JSON string
+std::string Tracer::escape(const std::string &text) {
+    std::ostringstream escaped;
+    for (const char &character : text) {
+        if ((character == '"') || (character == '\\')) {
+            escaped << '\\' << character;
+        } else if (static_cast<unsigned char>(character) < 0x20U) {
+            escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(character);
+        } else {
+            escaped << character;
+        }
+    }
+    return escaped.str();
+}
+
+
+// Static getters
+
+// Get the enabled status
+bool Tracer::isEnabled() {
+    return Tracer::enabled.load(std::memory_order_relaxed);
+}
+
+// Get the trace file path
+std::string Tracer::getPath() {
+    return Tracer::path;
+}
+
+
+// Static setters
+
+// Set the enabled status
+void Tracer::setEnabled(const bool &status) {
+    Tracer::enabled.store(status, std::memory_order_relaxed);
+}
+
+// Set the trace file path
+void Tracer::setPath(const std::string &new_path) {
+    Tracer::path = new_path;
+}
+
+// Set the name of the calling thread in the trace
+void Tracer::setThreadName(const std::string &name) {
+    Tracer::Buffer *const target = Tracer::getBuffer();
+    std::lock_guard<std::mutex> lock(Tracer::buffers_mutex);
+    target->name = name;
+}
+
+
+// Static methods
+
+// Begin a phase on the calling thread
+void Tracer::begin(const char *name) {
+    if (Tracer::enabled.load(std::memory_order_relaxed)) {
+        Tracer::record(name, 'B');
+    }
+}
+
+// End the innermost phase of the calling thread
+void Tracer::end() {
+    if (Tracer::enabled.load(std::memory_order_relaxed)) {
+        Tracer::record("", 'E');
+    }
+}
+
+// Write the events of all the threads to the trace file path
+bool Tracer::dump() {
+    // Check the path
+    if (Tracer::path.empty()) {
+        std::cerr << "warning: there is no trace file path" << std::endl;
+        return false;
+    }
+
+    return Tracer::dump(Tracer::path);
+}
+
+// Write the events of all the threads to the given path as Chrome trace JSON
+bool Tracer::dump(const std::string &file_path) {
+    // Open the trace file
+    std::ofstream file(file_path, std::ofstream::out | std::ofstream::trunc);
+    if (!file.is_open()) {
+        std::cerr << "error: cannot open the trace file `" << file_path << "'" << std::endl;
+        return false;
+    }
+
+    // Copy the buffers list, the buffers are never deleted
+    std::vector<Tracer::Buffer *> targets;
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(Tracer::buffers_mutex);
+        targets = Tracer::buffers;
+        for (const Tracer::Buffer *const target : targets) {
+            names.push_back(target->name.empty() ? "thread " + std::to_string(target->id) : target->name);
+        }
+    }
+
+    // Events in microseconds with nanoseconds precision
+    file << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [" << std::fixed << std::setprecision(3);
+    bool first = true;
+    std::size_t count = 0U;
+    for (std::size_t i = 0U; i < targets.size(); i++) {
+        // Thread name
+        const Tracer::Buffer *const target = targets[i];
+        file << (first ? "\n" : ",\n") << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << target->id << ", \"args\": {\"name\": \"" << Tracer::escape(names[i]) << "\"}}";
+        first = false;
+
+        // Copy the ring without stopping the thread
+        const std::uint64_t head = target->head.load(std::memory_order_acquire);
+        const std::uint64_t start = head > Tracer::CAPACITY ? head - Tracer::CAPACITY : 0U;
+        std::vector<Tracer::Event> events;
+        for (std::uint64_t j = start; j < head; j++) {
+            events.push_back(target->events[j % Tracer::CAPACITY]);
+        }
+
+        // Discard the events overwritten while copying, the slot of the event being written too, the copy is ordered before the new head
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::uint64_t after = target->head.load(std::memory_order_acquire);
+        const std::uint64_t valid = after + 1U > Tracer::CAPACITY ? after + 1U - Tracer::CAPACITY : 0U;
+        for (std::uint64_t j = std::max(start, valid); j < head; j++) {
+            const Tracer::Event &event = events[static_cast<std::size_t>(j - start)];
+            file << ",\n  {\"name\": \"" << Tracer::escape(event.name) << "\", \"ph\": \"" << event.type << "\", \"ts\": " << static_cast<double>(event.time) / 1000.0 << ", \"pid\": 1, \"tid\": " << target->id << "}";
+            count++;
+        }
+    }
+    file << "\n]}\n";
+
+    std::cout << "info: " << count << " trace events written to `" << file_path << "'" << std::endl;
+    return true;
+}
\ No newline at end of file
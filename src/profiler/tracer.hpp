@@ -0,0 +1,137 @@
+#ifndef __TRACER_HPP_
+#define __TRACER_HPP_
+
+#include <string>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+/** Begin and end events tracer with a lock-free ring buffer per thread, dumped as Chrome trace JSON */
+class Tracer {
+    private:
+        // Structures
+
+        /** Trace event */
+        struct Event {
+            /** Phase name, truncated */
+            char name[32];
+
+            /** Begin or end phase, `B' or `E' */
+            char type;
+
+            /** Time since the tracer origin in nanoseconds */
+            std::uint64_t time;
+        };
+
+        /** Ring buffer of a thread, it is only written by its thread */
+        struct Buffer {
+            /** Events ring */
+            Tracer::Event *events;
+
+            /** Number of written events, the ring holds the last ones */
+            std::atomic<std::uint64_t> head;
+
+            /** Thread identifier in the trace */
+            unsigned int id;
+
+            /** Thread name */
+            std::string name;
+        };
+
+
+        // Static const attributes
+
+        /** Events per thread ring buffer */
+        static const std::size_t CAPACITY = 16384U;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        Tracer() = delete;
+
+        /** Disable the default copy constructor */
+        Tracer(const Tracer &) = delete;
+
+        /** Disable the assignation operator */
+        Tracer &operator=(const Tracer &) = delete;
+
+
+        // Static attributes
+
+        /** Enabled status */
+        static std::atomic<bool> enabled;
+
+        /** Buffers of all the threads that have traced, they live until the exit */
+        static std::vector<Tracer::Buffer *> buffers;
+
+        /** Buffers list and names lock */
+        static std::mutex buffers_mutex;
+
+        /** Buffer of the calling thread */
+        static thread_local Tracer::Buffer *buffer;
+
+        /** Trace file path */
+        static std::string path;
+
+        /** Origin of the timestamps */
+        static const std::chrono::steady_clock::time_point origin;
+
+
+        // Static methods
+
+        /** Get the buffer of the calling thread, creating it on first use */
+        static Tracer::Buffer *getBuffer();
+
+        /** Append an event to the buffer of the calling thread */
+        static void record(const char *name, const char &type);
+
+        /** Get the time since the tracer origin in nanoseconds */
+        static std::uint64_t now();
+
+        /** Escape a text for a JSON string */
+        static std::string escape(const std::string &text);
+
+
+    public:
+        // Static getters
+
+        /** Get the enabled status */
+        static bool isEnabled();
+
+        /** Get the trace file path */
+        static std::string getPath();
+
+
+        // Static setters
+
+        /** Set the enabled status */
+        static void setEnabled(const bool &status);
+
+        /** Set the trace file path */
+        static void setPath(const std::string &new_path);
+
+        /** Set the name of the calling thread in the trace */
+        static void setThreadName(const std::string &name);
+
+
+        // Static methods
+
+        /** Begin a phase on the calling thread */
+        static void begin(const char *name);
+
+        /** End the innermost phase of the calling thread */
+        static void end();
+
+        /** Write the events of all the threads to the trace file path */
+        static bool dump();
+
+        /** Write the events of all the threads to the given path as Chrome trace JSON */
+        static bool dump(const std::string &file_path);
+};
+
+#endif // __TRACER_HPP_
\ No newline at end of file
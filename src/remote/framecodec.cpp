@@ -0,0 +1,256 @@
+#include "framecodec.hpp"
+
+#include "../profiler/profilerscope.hpp"
+#include "../task/taskscheduler.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+
+// Private static methods
+
+// Code the delta of the quantized pixels
+void FrameCodec::encodeStrip(const GLubyte *rgba, GLubyte *rgb, const std::size_t &pixels, const unsigned int &bits, std::string &output) {
+    // Quantize to the center of the dropped range
+    const GLubyte mask = static_cast<GLubyte>(0xFFU << bits);
+    const GLubyte half = static_cast<GLubyte>((1U << bits) >> 1);
+
+    // Delta to the previous channels
+    const std::size_t length = 3U * pixels;
+    std::vector<GLubyte> delta(length);
+    for (std::size_t i = 0U; i < pixels; i++) {
+        for (std::size_t c = 0U; c < 3U; c++) {
+            const GLubyte value = static_cast<GLubyte>((rgba[4U * i + c] & mask) | half);
+            delta[3U * i + c] = static_cast<GLubyte>(value - rgb[3U * i + c]);
+            rgb[3U * i + c] = value;
+        }
+    }
+
+    // Runs of three or more bytes as 128 + length - 3, up to 130 bytes, otherwise blocks of up to 128 literals as length - 1
+    output.clear();
+    output.reserve(length / 4U);
+    std::size_t literal = std::string::npos;
+    for (std::size_t i = 0U; i < length;) {
+        std::size_t run = 1U;
+        while ((i + run < length) && (run < 130U) && (delta[i + run] == delta[i])) {
+            run++;
+        }
+
+        if (run >= 3U) {
+            output += static_cast<char>(128U + run - 3U);
+            output += static_cast<char>(delta[i]);
+            literal = std::string::npos;
+            i += run;
+            continue;
+        }
+
+        // Extend the literal block or start a new one
+        if ((literal == std::string::npos) || (static_cast<unsigned char>(output[literal]) == 127U)) {
+            literal = output.size();
+            output += static_cast<char>(0);
+        }
+        else {
+            output[literal] = static_cast<char>(output[literal] + 1);
+        }
+        output += static_cast<char>(delta[i]);
+        i++;
+    }
+}
+
+// Add the coded delta to the previous channels
+bool FrameCodec::decodeStrip(const unsigned char *data, const std::size_t &size, GLubyte *rgb, const std::size_t &length) {
+    std::size_t position = 0U;
+    for (std::size_t i = 0U; i < size;) {
+        const unsigned int control = data[i++];
+
+        // Run
+        if (control >= 128U) {
+            const std::size_t run = control - 125U;
+            if ((i >= size) || (position + run > length)) {
+                return false;
+            }
+            const GLubyte value = data[i++];
+            for (std::size_t j = 0U; j < run; j++) {
+                rgb[position++] += value;
+            }
+        }
+
+        // Literals
+        else {
+            const std::size_t count = control + 1U;
+            if ((i + count > size) || (position + count > length)) {
+                return false;
+            }
+            for (std::size_t j = 0U; j < count; j++) {
+                rgb[position++] += data[i++];
+            }
+        }
+    }
+
+    return position == length;
+}
+
+
+// Constructors
+
+// Frame codec constructor
+FrameCodec::FrameCodec(const unsigned int &quality_bits, const unsigned int &threads) :
+    quality(std::min(quality_bits, 7U)),
+    strips(threads > 0U ? threads : std::max(1U, std::thread::hardware_concurrency())),
+    keyframe_interval(0U),
+    since_keyframe(0U),
+    keyframe_requested(true),
+    width(0),
+    height(0) {}
+
+
+// Getters
+
+// Get the low bits dropped from every channel
+unsigned int FrameCodec::getQuality() const {
+    return quality;
+}
+
+// Get the RGB channels of the last frame
+const std::vector<GLubyte> &FrameCodec::getFrame() const {
+    return previous;
+}
+
+
+// Setters
+
+// Set the low bits dropped from every channel
+void FrameCodec::setQuality(const unsigned int &bits) {
+    quality = std::min(bits, 7U);
+    keyframe_requested = true;
+}
+
+// Set the frames between key frames
+void FrameCodec::setKeyframeInterval(const unsigned int &frames) {
+    keyframe_interval = frames;
+}
+
+
+// Methods
+
+// Code the next frame as a key frame
+void FrameCodec::requestKeyframe() {
+    keyframe_requested = true;
+}
+
+// Code the RGBA frame
+std::string FrameCodec::encode(const std::vector<GLubyte> &rgba, const GLsizei &frame_width, const GLsizei &frame_height) {
+    // Time the phase
+    const ProfilerScope scope("encode");
+
+    // Key frames restart from black
+    const bool keyframe = keyframe_requested || (frame_width != width) || (frame_height != height) || ((keyframe_interval > 0U) && (since_keyframe >= keyframe_interval));
+    const std::size_t pixels = static_cast<std::size_t>(frame_width) * static_cast<std::size_t>(frame_height);
+    if (keyframe) {
+        previous.assign(3U * pixels, 0U);
+        width = frame_width;
+        height = frame_height;
+        keyframe_requested = false;
+        since_keyframe = 0U;
+    }
+    since_keyframe++;
+
+    // Code the strips of whole pixels in parallel
+    const std::size_t count = std::max(static_cast<std::size_t>(1U), std::min(static_cast<std::size_t>(strips), static_cast<std::size_t>(frame_height)));
+    std::vector<std::string> coded(count);
+    const unsigned int bits = quality;
+    TaskScheduler::getActive()->parallel(count, 1U, [this, &rgba, &coded, pixels, count, bits](const std::size_t &first_strip, const std::size_t &last_strip) {
+        for (std::size_t s = first_strip; s < last_strip; s++) {
+            const std::size_t first = pixels * s / count;
+            const std::size_t last = pixels * (s + 1U) / count;
+            FrameCodec::encodeStrip(&rgba[4U * first], &previous[3U * first], last - first, bits, coded[s]);
+        }
+    }, TaskScheduler::INTERACTIVE, "encode strips");
+
+    // Header and strip sizes followed by the strips
+    std::string payload;
+    const std::uint32_t header[2] = {static_cast<std::uint32_t>(frame_width), static_cast<std::uint32_t>(frame_height)};
+    const std::uint8_t flags[2] = {static_cast<std::uint8_t>(keyframe), static_cast<std::uint8_t>(quality)};
+    const std::uint16_t strip_count = static_cast<std::uint16_t>(count);
+    payload.append(reinterpret_cast<const char *>(header), sizeof(header));
+    payload.append(reinterpret_cast<const char *>(flags), sizeof(flags));
+    payload.append(reinterpret_cast<const char *>(&strip_count), sizeof(strip_count));
+    for (const std::string &strip : coded) {
+        const std::uint32_t size = static_cast<std::uint32_t>(strip.size());
+        payload.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    }
+    for (const std::string &strip : coded) {
+        payload.append(strip);
+    }
+
+    return payload;
+}
+
+// Decode the payload into the RGB frame
+bool FrameCodec::decode(const std::string &payload, GLsizei &frame_width, GLsizei &frame_height) {
+    // Time the phase
+    const ProfilerScope scope("decode");
+
+    // Header
+    std::uint32_t header[2];
+    std::uint8_t flags[2];
+    std::uint16_t count = 0U;
+    const std::size_t header_size = sizeof(header) + sizeof(flags) + sizeof(count);
+    if (payload.size() < header_size) {
+        return false;
+    }
+    std::memcpy(header, payload.data(), sizeof(header));
+    std::memcpy(flags, payload.data() + sizeof(header), sizeof(flags));
+    std::memcpy(&count, payload.data() + sizeof(header) + sizeof(flags), sizeof(count));
+
+    const std::size_t pixels = static_cast<std::size_t>(header[0]) * static_cast<std::size_t>(header[1]);
+    if ((count == 0U) || (payload.size() < header_size + 4U * count) || (pixels > (1U << 28))) {
+        return false;
+    }
+
+    // Key frames restart from black, deltas need the previous frame of the same size
+    if (flags[0] != 0U) {
+        previous.assign(3U * pixels, 0U);
+        width = static_cast<GLsizei>(header[0]);
+        height = static_cast<GLsizei>(header[1]);
+    }
+    else if ((static_cast<GLsizei>(header[0]) != width) || (static_cast<GLsizei>(header[1]) != height) || previous.empty()) {
+        return false;
+    }
+    quality = flags[1];
+
+    // Strip offsets
+    std::vector<std::size_t> offset(count + 1U);
+    offset[0] = header_size + 4U * count;
+    for (std::size_t s = 0U; s < count; s++) {
+        std::uint32_t size = 0U;
+        std::memcpy(&size, payload.data() + header_size + 4U * s, sizeof(size));
+        offset[s + 1U] = offset[s] + size;
+    }
+    if (offset[count] != payload.size()) {
+        return false;
+    }
+
+    // Decode the strips in parallel
+    std::vector<char> valid(count, 0);
+    const unsigned char *const data = reinterpret_cast<const unsigned char *>(payload.data());
+    TaskScheduler::getActive()->parallel(count, 1U, [this, &offset, &valid, data, pixels, count](const std::size_t &first_strip, const std::size_t &last_strip) {
+        for (std::size_t s = first_strip; s < last_strip; s++) {
+            const std::size_t first = pixels * s / count;
+            const std::size_t last = pixels * (s + 1U) / count;
+            valid[s] = FrameCodec::decodeStrip(data + offset[s], offset[s + 1U] - offset[s], &previous[3U * first], 3U * (last - first)) ? 1 : 0;
+        }
+    }, TaskScheduler::INTERACTIVE, "decode strips");
+
+    frame_width = width;
+    frame_height = height;
+    return std::find(valid.begin(), valid.end(), 0) == valid.end();
+}
+
+
+// Destructor
+
+// Frame codec destructor
+FrameCodec::~FrameCodec() {}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#ifndef __FRAME_CODEC_HPP_
+#define __FRAME_CODEC_HPP_
+
+#include "../glad/glad.h"
+
+#include <string>
+
+#include <vector>
+
+
+/** Frame codec with the delta to the previous frame and run length coding, optionally lossy by quantization, the strips of a frame are coded by the tasks of the scheduler */
+class FrameCodec {
+    private:
+        // Attributes
+
+        /** Low bits dropped from every channel, zero is lossless */
+        unsigned int quality;
+
+        /** Number of strips coded in parallel */
+        unsigned int strips;
+
+        /** Frames between key frames */
+        unsigned int keyframe_interval;
+
+        /** Frames since the last key frame */
+        unsigned int since_keyframe;
+
+        /** Key frame requested status */
+        bool keyframe_requested;
+
+
+        /** Width of the previous frame */
+        GLsizei width;
+
+        /** Height of the previous frame */
+        GLsizei height;
+
+        /** RGB channels of the previous frame as seen by the decoder */
+        std::vector<GLubyte> previous;
+
+
+        // Constructors
+
+        /** Disable the default copy constructor */
+        FrameCodec(const FrameCodec &) = delete;
+
+        /** Disable the assignation operator */
+        FrameCodec &operator=(const FrameCodec &) = delete;
+
+
+        // Static methods
+
+        /** Code the delta of the quantized RGBA pixels to the previous RGB channels and update them */
+        static void encodeStrip(const GLubyte *rgba, GLubyte *rgb, const std::size_t &pixels, const unsigned int &bits, std::string &output);
+
+        /** Add the coded delta to the previous RGB channels, returns false if the data is corrupt */
+        static bool decodeStrip(const unsigned char *data, const std::size_t &size, GLubyte *rgb, const std::size_t &length);
+
+
+    public:
+        // Constructors
+
+        /** Frame codec constructor, the strips default to the number of cores */
+        FrameCodec(const unsigned int &quality_bits = 0U, const unsigned int &threads = 0U);
+
+
+        // Getters
+
+        /** Get the low bits dropped from every channel */
+        unsigned int getQuality() const;
+
+        /** Get the RGB channels of the last frame */
+        const std::vector<GLubyte> &getFrame() const;
+
+
+        // Setters
+
+        /** Set the low bits dropped from every channel, from zero for lossless to seven, forces a key frame */
+        void setQuality(const unsigned int &bits);
+
+        /** Set the frames between key frames, zero only codes a key frame on request or resize */
+        void setKeyframeInterval(const unsigned int &frames);
+
+
+        // Methods
+
+        /** Code the next frame as a key frame */
+        void requestKeyframe();
+
+        /** Code the RGBA frame, returns the payload */
+        std::string encode(const std::vector<GLubyte> &rgba, const GLsizei &frame_width, const GLsizei &frame_height);
+
+        /** Decode the payload into the RGB frame, returns false if it is corrupt or a delta without its key frame */
+        bool decode(const std::string &payload, GLsizei &frame_width, GLsizei &frame_height);
+
+
+        // Destructor
+
+        /** Frame codec destructor */
+        virtual ~FrameCodec();
+};
+
+#endif // __FRAME_CODEC_HPP_
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "remoteclient.hpp"
+
+#include "../scene/framecapture.hpp"
+
+#include <iostream>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+
+/** Get the percentile of the sorted samples */
+static double percentile(const std::vector<double> &sorted, const double &fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    return sorted[std::min(sorted.size() - 1U, static_cast<std::size_t>(fraction * static_cast<double>(sorted.size())))];
+}
+
+/** Get the mean of the samples */
+static double mean(const std::vector<double> &samples) {
+    double sum = 0.0;
+    for (const double &sample : samples) {
+        sum += sample;
+    }
+    return samples.empty() ? 0.0 : sum / static_cast<double>(samples.size());
+}
+
+
+// Constructors
+
+// Remote client constructor
+RemoteClient::RemoteClient(const std::string &address) :
+    codec(new FrameCodec()),
+    width(0),
+    height(0),
+    start(0.0),
+    last(0.0),
+    echo(0.0),
+    frames(0U),
+    received(0U),
+    decoded(0U) {
+    if (socket.connect(address)) {
+        std::cout << "info: connected to the remote server `" << address << "'" << std::endl;
+    }
+}
+
+
+// Getters
+
+// Get the connected status
+bool RemoteClient::isConnected() const {
+    return socket.isOpen();
+}
+
+// Get the last decoded frame
+const std::vector<GLubyte> &RemoteClient::getFrame() const {
+    return codec->getFrame();
+}
+
+// Get the frame width
+GLsizei RemoteClient::getWidth() const {
+    return width;
+}
+
+// Get the frame height
+GLsizei RemoteClient::getHeight() const {
+    return height;
+}
+
+
+// Methods
+
+// Send an input event
+double RemoteClient::sendEvent(const RemoteServer::Event &event, const float &x, const float &y, const float &z) {
+    const std::uint8_t type = static_cast<std::uint8_t>(event);
+    const float value[3] = {x, y, z};
+    const double time = RemoteClient::now();
+
+    std::string payload;
+    payload.append(reinterpret_cast<const char *>(&type), sizeof(type));
+    payload.append(reinterpret_cast<const char *>(value), sizeof(value));
+    payload.append(reinterpret_cast<const char *>(&time), sizeof(time));
+    return RemoteServer::send(&socket, RemoteServer::INPUT, payload) ? time : -1.0;
+}
+
+// Receive and decode a frame
+bool RemoteClient::receiveFrame() {
+    RemoteServer::Message type;
+    std::string payload;
+    do {
+        if (!RemoteServer::receive(&socket, type, payload)) {
+            return false;
+        }
+    } while (type != RemoteServer::FRAME);
+
+    // Frame number, echoed input time and server timings
+    std::uint64_t frame = 0U;
+    double time = 0.0;
+    float timing[2];
+    const std::size_t header = sizeof(frame) + sizeof(time) + sizeof(timing);
+    if (payload.size() < header) {
+        std::cerr << "error: invalid remote frame" << std::endl;
+        return false;
+    }
+    std::memcpy(&frame, payload.data(), sizeof(frame));
+    std::memcpy(&time, payload.data() + sizeof(frame), sizeof(time));
+    std::memcpy(timing, payload.data() + sizeof(frame) + sizeof(time), sizeof(timing));
+
+    // Decode the frame
+    const double decode_start = RemoteClient::now();
+    if (!codec->decode(payload.substr(header), width, height)) {
+        std::cerr << "error: the remote frame " << frame << " could not be decoded" << std::endl;
+        return false;
+    }
+    last = RemoteClient::now();
+
+    // The first frame showing an input measures its latency
+    if ((time > echo) && (frames > 0U)) {
+        latency.push_back((last - time) * 1000.0);
+    }
+    if (frames == 0U) {
+        start = last;
+    }
+
+    echo = std::max(echo, time);
+    frames++;
+    received += payload.size() + 5U;
+    decoded += static_cast<unsigned long long int>(width) * static_cast<unsigned long long int>(height) * 4U;
+    render_time.push_back(static_cast<double>(timing[0]));
+    encode_time.push_back(static_cast<double>(timing[1]));
+    decode_time.push_back((last - decode_start) * 1000.0);
+    return true;
+}
+
+// Send the orbit events
+bool RemoteClient::orbit(const unsigned int &events) {
+    // The first frame is the key frame
+    if (!receiveFrame()) {
+        return false;
+    }
+
+    for (unsigned int i = 0U; i < events; i++) {
+        // Orbit around the volume
+        const double time = sendEvent(RemoteServer::ROTATE, 1.0F, 0.0F);
+        if (time < 0.0) {
+            return false;
+        }
+
+        // Wait for the frame showing the event and drop the refinements already sent
+        do {
+            if (!receiveFrame()) {
+                return false;
+            }
+        } while (echo < time);
+
+        while (socket.wait(0)) {
+            if (!receiveFrame()) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Write the last decoded frame
+bool RemoteClient::writeFrame(const std::string &path) const {
+    const std::vector<GLubyte> &rgb = codec->getFrame();
+    std::vector<GLubyte> rgba(rgb.size() / 3U * 4U, 255U);
+    for (std::size_t i = 0U, j = 0U; i < rgb.size(); i += 3U, j += 4U) {
+        rgba[j]      = rgb[i];
+        rgba[j + 1U] = rgb[i + 1U];
+        rgba[j + 2U] = rgb[i + 2U];
+    }
+    return FrameCapture::write(path, width, height, rgba, false);
+}
+
+// Print the report
+void RemoteClient::printReport() const {
+    std::vector<double> sorted = latency;
+    std::sort(sorted.begin(), sorted.end());
+
+    const double seconds = last - start;
+    std::cout << "info: " << frames << " remote frames of " << width << "x" << height << " received in " << seconds << " s, " << (seconds > 0.0 ? static_cast<double>(frames - 1U) / seconds : 0.0) << " fps" << std::endl;
+    std::cout << "info: input latency p50 " << percentile(sorted, 0.50) << " ms, p95 " << percentile(sorted, 0.95) << " ms, p99 " << percentile(sorted, 0.99) << " ms over " << sorted.size() << " events" << std::endl;
+    std::cout << "info: server render " << mean(render_time) << " ms, encode " << mean(encode_time) << " ms, client decode " << mean(decode_time) << " ms" << std::endl;
+    std::cout << "info: " << received << " bytes received, " << (seconds > 0.0 ? static_cast<double>(received) / seconds / 1048576.0 : 0.0) << " MiB/s, compression ratio " << (received > 0U ? static_cast<double>(decoded) / static_cast<double>(received) : 0.0) << std::endl;
+}
+
+
+// Destructor
+
+// Remote client destructor
+RemoteClient::~RemoteClient() {
+    delete codec;
+}
+
+
+// Static methods
+
+// Get the steady time
+double RemoteClient::now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
\ No newline at end of file
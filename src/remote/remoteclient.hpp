@@ -0,0 +1,124 @@
+#ifndef __REMOTE_CLIENT_HPP_
+#define __REMOTE_CLIENT_HPP_
+
+#include "remoteserver.hpp"
+
+#include <string>
+#include <vector>
+
+
+/** Thin remote rendering client decoding the streamed frames, measuring the input to photon latency and the bandwidth */
+class RemoteClient {
+    private:
+        // Attributes
+
+        /** Connected socket */
+        Socket socket;
+
+        /** Frame codec */
+        FrameCodec *const codec;
+
+        /** Frame width */
+        GLsizei width;
+
+        /** Frame height */
+        GLsizei height;
+
+
+        /** Client time of the first frame in seconds */
+        double start;
+
+        /** Client time of the last frame in seconds */
+        double last;
+
+        /** Input time echoed by the last frame */
+        double echo;
+
+        /** Number of received frames */
+        unsigned long long int frames;
+
+        /** Received bytes */
+        unsigned long long int received;
+
+        /** Decoded frame bytes */
+        unsigned long long int decoded;
+
+
+        /** Input to frame latencies in milliseconds */
+        std::vector<double> latency;
+
+        /** Server render times in milliseconds */
+        std::vector<double> render_time;
+
+        /** Server encode times in milliseconds */
+        std::vector<double> encode_time;
+
+        /** Client decode times in milliseconds */
+        std::vector<double> decode_time;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        RemoteClient() = delete;
+
+        /** Disable the default copy constructor */
+        RemoteClient(const RemoteClient &) = delete;
+
+        /** Disable the assignation operator */
+        RemoteClient &operator=(const RemoteClient &) = delete;
+
+
+    public:
+        // Constructors
+
+        /** Remote client constructor, connects to `host:port' or `unix:path' */
+        explicit RemoteClient(const std::string &address);
+
+
+        // Getters
+
+        /** Get the connected status */
+        bool isConnected() const;
+
+        /** Get the last decoded RGB frame, top row first */
+        const std::vector<GLubyte> &getFrame() const;
+
+        /** Get the frame width */
+        GLsizei getWidth() const;
+
+        /** Get the frame height */
+        GLsizei getHeight() const;
+
+
+        // Methods
+
+        /** Send an input event stamped with the client time, returns the stamp */
+        double sendEvent(const RemoteServer::Event &event, const float &x = 0.0F, const float &y = 0.0F, const float &z = 0.0F);
+
+        /** Receive and decode a frame, returns false if the connection closed or the frame is invalid */
+        bool receiveFrame();
+
+        /** Send the given number of orbit events, each one after the frame of the previous one */
+        bool orbit(const unsigned int &events);
+
+        /** Write the last decoded frame as PNG or PPM by the path extension */
+        bool writeFrame(const std::string &path) const;
+
+        /** Print the latency, frame rate and bandwidth report */
+        void printReport() const;
+
+
+        // Destructor
+
+        /** Remote client destructor */
+        virtual ~RemoteClient();
+
+
+        // Static methods
+
+        /** Get the steady time in seconds */
+        static double now();
+};
+
+#endif // __REMOTE_CLIENT_HPP_
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "remoteserver.hpp"
+
+#include "../profiler/profilerscope.hpp"
+
+#include <iostream>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+
+// Private methods
+
+// Apply an input event
+void RemoteServer::process(const std::string &payload) {
+    // Event type, values and client time
+    std::uint8_t event = 0U;
+    float value[3];
+    double time = 0.0;
+    if (payload.size() != sizeof(event) + sizeof(value) + sizeof(time)) {
+        std::cerr << "warning: invalid remote input event" << std::endl;
+        return;
+    }
+    std::memcpy(&event, payload.data(), sizeof(event));
+    std::memcpy(value, payload.data() + sizeof(event), sizeof(value));
+    std::memcpy(&time, payload.data() + sizeof(event) + sizeof(value), sizeof(time));
+
+    switch (static_cast<RemoteServer::Event>(event)) {
+        case RemoteServer::ROTATE:
+            scene->getCamera()->rotate(glm::vec2(value[0], value[1]));
+            break;
+
+        case RemoteServer::ZOOM:
+            scene->getCamera()->zoom(value[0]);
+            break;
+
+        case RemoteServer::TRAVELL:
+            if ((value[0] >= 0.0F) && (value[0] <= static_cast<float>(Camera::BACK))) {
+                scene->getCamera()->travell(static_cast<Camera::Movement>(static_cast<int>(value[0])), value[1]);
+            }
+            break;
+
+        case RemoteServer::ROTATE_VOLUME:
+            scene->getVolume()->rotate(glm::vec3(value[0], value[1], value[2]));
+            break;
+
+        case RemoteServer::RESIZE:
+            if ((value[0] >= 1.0F) && (value[1] >= 1.0F)) {
+                scene->setResolution(static_cast<int>(value[0]), static_cast<int>(value[1]));
+            }
+            break;
+
+        case RemoteServer::QUALITY:
+            codec->setQuality(static_cast<unsigned int>(value[0]));
+            scene->requestRedraw();
+            break;
+
+        case RemoteServer::KEYFRAME:
+            codec->requestKeyframe();
+            scene->requestRedraw();
+            break;
+
+        case RemoteServer::QUIT:
+            quitting = true;
+            break;
+
+        default:
+            std::cerr << "warning: unknown remote input event " << static_cast<unsigned int>(event) << std::endl;
+            return;
+    }
+
+    input_time = time;
+}
+
+// Serve a client
+void RemoteServer::serve(const Socket *const client) {
+    // Start with a key frame
+    codec->requestKeyframe();
+    scene->requestRedraw();
+    input_time = 0.0;
+    unsigned long long int sent = 0U;
+
+    while (!quitting) {
+        // Apply the pending input, waiting for it while there is nothing to draw
+        if (client->wait(scene->isDirty() ? 0 : 250)) {
+            do {
+                RemoteServer::Message type;
+                std::string payload;
+                if (!RemoteServer::receive(client, type, payload)) {
+                    std::cout << "info: remote client disconnected after " << sent << " frames" << std::endl;
+                    return;
+                }
+
+                if (type == RemoteServer::INPUT) {
+                    process(payload);
+                }
+            } while (!quitting && client->wait(0));
+        }
+
+        if (quitting || !scene->isDirty()) {
+            continue;
+        }
+
+        // Draw and read back the frame
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        scene->renderFrame();
+        const glm::vec2 resolution = scene->getResolution();
+        const std::vector<GLubyte> pixels = scene->readFrame();
+        const std::chrono::steady_clock::time_point drawn = std::chrono::steady_clock::now();
+
+        // Code it
+        const std::string coded = codec->encode(pixels, static_cast<GLsizei>(resolution.x), static_cast<GLsizei>(resolution.y));
+        const std::chrono::steady_clock::time_point encoded = std::chrono::steady_clock::now();
+
+        // Frame number, echoed input time and timings before the coded frame
+        const std::uint64_t frame = scene->getFrames();
+        const float timing[2] = {std::chrono::duration<float, std::milli>(drawn - start).count(), std::chrono::duration<float, std::milli>(encoded - drawn).count()};
+        std::string payload;
+        payload.append(reinterpret_cast<const char *>(&frame), sizeof(frame));
+        payload.append(reinterpret_cast<const char *>(&input_time), sizeof(input_time));
+        payload.append(reinterpret_cast<const char *>(timing), sizeof(timing));
+        payload.append(coded);
+
+        // Send it
+        const ProfilerScope scope("send");
+        if (!RemoteServer::send(client, RemoteServer::FRAME, payload)) {
+            std::cout << "info: remote client disconnected after " << sent << " frames" << std::endl;
+            return;
+        }
+        sent++;
+    }
+}
+
+
+// Constructors
+
+// Remote server constructor
+RemoteServer::RemoteServer(Scene *const scene, const std::string &address, const unsigned int &quality) :
+    scene(scene),
+    codec(new FrameCodec(quality)),
+    input_time(0.0),
+    quitting(false) {
+    if (listener.listen(address)) {
+        std::cout << "info: remote server listening on `" << address << "'" << std::endl;
+    }
+}
+
+
+// Getters
+
+// Get the listening status
+bool RemoteServer::isValid() const {
+    return listener.isOpen();
+}
+
+
+// Methods
+
+// Serve the clients one after another
+void RemoteServer::run() {
+    while (isValid() && !quitting) {
+        Socket *const client = listener.accept();
+        if (client->isOpen()) {
+            std::cout << "info: remote client connected" << std::endl;
+            serve(client);
+        }
+        delete client;
+    }
+
+    if (quitting) {
+        std::cout << "info: remote server stopped by the client" << std::endl;
+    }
+}
+
+
+// Destructor
+
+// Remote server destructor
+RemoteServer::~RemoteServer() {
+    delete codec;
+}
+
+
+// Static methods
+
+// Send a message
+bool RemoteServer::send(const Socket *const socket, const RemoteServer::Message &type, const std::string &payload) {
+    char header[5];
+    const std::uint32_t size = static_cast<std::uint32_t>(payload.size());
+    header[0] = static_cast<char>(type);
+    std::memcpy(header + 1, &size, sizeof(size));
+    return socket->send(header, sizeof(header)) && socket->send(payload.data(), payload.size());
+}
+
+// Receive a message
+bool RemoteServer::receive(const Socket *const socket, RemoteServer::Message &type, std::string &payload) {
+    char header[5];
+    std::uint32_t size = 0U;
+    if (!socket->receive(header, sizeof(header))) {
+        return false;
+    }
+    std::memcpy(&size, header + 1, sizeof(size));
+
+    // Frames are bounded by the largest key frame
+    if (size > (1U << 30)) {
+        return false;
+    }
+
+    type = static_cast<RemoteServer::Message>(header[0]);
+    payload.resize(size);
+    return (size == 0U) || socket->receive(&payload[0], size);
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#ifndef __REMOTE_SERVER_HPP_
+#define __REMOTE_SERVER_HPP_
+
+#include "socket.hpp"
+#include "framecodec.hpp"
+#include "../scene/scene.hpp"
+
+#include <string>
+
+
+/** Remote rendering server drawing a headless scene and streaming the coded frames to a client that sends back input events */
+class RemoteServer {
+    public:
+        // Enumerations
+
+        /** Message types, every message is the type byte, the payload size and the payload */
+        enum Message {
+            /** Frame from the server, number, echoed input time, render and encode times and the coded frame */
+            FRAME = 1,
+
+            /** Input event from the client, event type, three values and the client time */
+            INPUT = 2
+        };
+
+        /** Input events */
+        enum Event {
+            /** Rotate the camera by the mouse delta */
+            ROTATE,
+
+            /** Zoom the camera in the direction */
+            ZOOM,
+
+            /** Move the camera in the direction for the time */
+            TRAVELL,
+
+            /** Rotate the volume by the angles */
+            ROTATE_VOLUME,
+
+            /** Resize the frame */
+            RESIZE,
+
+            /** Set the quality of the codec */
+            QUALITY,
+
+            /** Send the next frame as a key frame */
+            KEYFRAME,
+
+            /** Stop the server */
+            QUIT
+        };
+
+
+    private:
+        // Attributes
+
+        /** Rendered scene */
+        Scene *const scene;
+
+        /** Listening socket */
+        Socket listener;
+
+        /** Frame codec */
+        FrameCodec *const codec;
+
+        /** Client time of the last applied input event, echoed in the frames */
+        double input_time;
+
+        /** Stop requested status */
+        bool quitting;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        RemoteServer() = delete;
+
+        /** Disable the default copy constructor */
+        RemoteServer(const RemoteServer &) = delete;
+
+        /** Disable the assignation operator */
+        RemoteServer &operator=(const RemoteServer &) = delete;
+
+
+        // Methods
+
+        /** Apply an input event */
+        void process(const std::string &payload);
+
+        /** Serve a client until it disconnects or asks to stop */
+        void serve(const Socket *const client);
+
+
+    public:
+        // Constructors
+
+        /** Remote server constructor, listens on `host:port' or `unix:path' */
+        RemoteServer(Scene *const scene, const std::string &address, const unsigned int &quality = 0U);
+
+
+        // Getters
+
+        /** Get the listening status */
+        bool isValid() const;
+
+
+        // Methods
+
+        /** Serve the clients one after another until one of them asks to stop */
+        void run();
+
+
+        // Destructor
+
+        /** Remote server destructor */
+        virtual ~RemoteServer();
+
+
+        // Static methods
+
+        /** Send a message */
+        static bool send(const Socket *const socket, const RemoteServer::Message &type, const std::string &payload);
+
+        /** Receive a message, returns false if the connection closed */
+        static bool receive(const Socket *const socket, RemoteServer::Message &type, std::string &payload);
+};
+
+#endif // __REMOTE_SERVER_HPP_
\ No newline at end of file
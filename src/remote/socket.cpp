@@ -0,0 +1,320 @@
+#include "socket.hpp"
+
+#include <iostream>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#if defined(__linux__)
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <netdb.h>
+    #include <poll.h>
+    #include <unistd.h>
+#endif
+
+
+// Constructors
+
+// Closed socket constructor
+Socket::Socket() :
+    descriptor(-1) {}
+
+// Socket constructor adopting an open file descriptor
+Socket::Socket(const int &fd) :
+    descriptor(fd) {}
+
+
+// Getters
+
+// Get the open status
+bool Socket::isOpen() const {
+    return descriptor >= 0;
+}
+
+
+// Methods
+
+#if defined(__linux__)
+
+// Listen on the address
+bool Socket::listen(const std::string &address) {
+    close();
+
+    // Unix domain socket, replacing a stale one
+    if (address.compare(0U, 5U, "unix:") == 0) {
+        const std::string path = address.substr(5U);
+        sockaddr_un local;
+        std::memset(&local, 0, sizeof(local));
+        local.sun_family = AF_UNIX;
+        if (path.empty() || (path.size() >= sizeof(local.sun_path))) {
+            std::cerr << "error: invalid unix socket path `" << path << "'" << std::endl;
+            return false;
+        }
+        std::strncpy(local.sun_path, path.c_str(), sizeof(local.sun_path) - 1U);
+        ::unlink(path.c_str());
+
+        descriptor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if ((descriptor < 0) || (::bind(descriptor, reinterpret_cast<sockaddr *>(&local), sizeof(local)) != 0) || (::listen(descriptor, 1) != 0)) {
+            std::cerr << "error: cannot listen on `" << address << "': " << std::strerror(errno) << std::endl;
+            close();
+            return false;
+        }
+
+        unlink_path = path;
+        return true;
+    }
+
+    // TCP on any interface if the host is empty
+    const std::size_t colon = address.find_last_of(':');
+    if (colon == std::string::npos) {
+        std::cerr << "error: the address must be `host:port' or `unix:path'" << std::endl;
+        return false;
+    }
+
+    const std::string host = address.substr(0U, colon);
+    const std::string port = address.substr(colon + 1U);
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo *result = nullptr;
+    if (::getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &result) != 0) {
+        std::cerr << "error: cannot resolve `" << address << "'" << std::endl;
+        return false;
+    }
+
+    for (addrinfo *entry = result; (entry != nullptr) && (descriptor < 0); entry = entry->ai_next) {
+        descriptor = ::socket(entry->ai_family, entry->ai_socktype, entry->ai_protocol);
+        if (descriptor < 0) {
+            continue;
+        }
+
+        const int reuse = 1;
+        ::setsockopt(descriptor, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if ((::bind(descriptor, entry->ai_addr, entry->ai_addrlen) != 0) || (::listen(descriptor, 1) != 0)) {
+            ::close(descriptor);
+            descriptor = -1;
+        }
+    }
+    ::freeaddrinfo(result);
+
+    if (descriptor < 0) {
+        std::cerr << "error: cannot listen on `" << address << "': " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Connect once to the address
+bool Socket::open(const std::string &address, const bool &report) {
+    close();
+
+    // Unix domain socket
+    if (address.compare(0U, 5U, "unix:") == 0) {
+        const std::string path = address.substr(5U);
+        sockaddr_un remote;
+        std::memset(&remote, 0, sizeof(remote));
+        remote.sun_family = AF_UNIX;
+        std::strncpy(remote.sun_path, path.c_str(), sizeof(remote.sun_path) - 1U);
+
+        descriptor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if ((descriptor < 0) || (::connect(descriptor, reinterpret_cast<sockaddr *>(&remote), sizeof(remote)) != 0)) {
+            if (report) {
+                std::cerr << "error: cannot connect to `" << address << "': " << std::strerror(errno) << std::endl;
+            }
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    // TCP
+    const std::size_t colon = address.find_last_of(':');
+    if (colon == std::string::npos) {
+        if (report) {
+            std::cerr << "error: the address must be `host:port' or `unix:path'" << std::endl;
+        }
+        return false;
+    }
+
+    const std::string host = address.substr(0U, colon);
+    const std::string port = address.substr(colon + 1U);
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *result = nullptr;
+    if (::getaddrinfo(host.empty() ? "localhost" : host.c_str(), port.c_str(), &hints, &result) != 0) {
+        if (report) {
+            std::cerr << "error: cannot resolve `" << address << "'" << std::endl;
+        }
+        return false;
+    }
+
+    for (addrinfo *entry = result; (entry != nullptr) && (descriptor < 0); entry = entry->ai_next) {
+        descriptor = ::socket(entry->ai_family, entry->ai_socktype, entry->ai_protocol);
+        if ((descriptor >= 0) && (::connect(descriptor, entry->ai_addr, entry->ai_addrlen) != 0)) {
+            ::close(descriptor);
+            descriptor = -1;
+        }
+    }
+    ::freeaddrinfo(result);
+
+    if (descriptor < 0) {
+        if (report) {
+            std::cerr << "error: cannot connect to `" << address << "': " << std::strerror(errno) << std::endl;
+        }
+        return false;
+    }
+
+    // Input events are small and latency bound
+    const int no_delay = 1;
+    ::setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+    return true;
+}
+
+// Connect to the address, retrying while nobody listens on it
+bool Socket::connect(const std::string &address, const int &timeout_ms) {
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (!open(address, false)) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return open(address, true);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    return true;
+}
+
+// Accept a connection
+Socket *Socket::accept() const {
+    const int fd = ::accept(descriptor, nullptr, nullptr);
+    if (fd < 0) {
+        std::cerr << "error: cannot accept the connection: " << std::strerror(errno) << std::endl;
+    }
+    else if (unlink_path.empty()) {
+        const int no_delay = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+    }
+    return new Socket(fd);
+}
+
+
+// Wait until there is data to read
+bool Socket::wait(const int &timeout_ms) const {
+    pollfd request;
+    request.fd = descriptor;
+    request.events = POLLIN;
+    request.revents = 0;
+    return ::poll(&request, 1, timeout_ms) > 0;
+}
+
+// Send all the bytes
+bool Socket::send(const void *data, const std::size_t &size) const {
+    const char *pointer = static_cast<const char *>(data);
+    for (std::size_t sent = 0U; sent < size;) {
+        const ssize_t count = ::send(descriptor, pointer + sent, size - sent, MSG_NOSIGNAL);
+        if (count <= 0) {
+            if ((count < 0) && (errno == EINTR)) {
+                continue;
+            }
+            return false;
+        }
+        sent += static_cast<std::size_t>(count);
+    }
+    return true;
+}
+
+// Receive exactly the bytes
+bool Socket::receive(void *data, const std::size_t &size) const {
+    char *pointer = static_cast<char *>(data);
+    for (std::size_t received = 0U; received < size;) {
+        const ssize_t count = ::recv(descriptor, pointer + received, size - received, 0);
+        if (count <= 0) {
+            if ((count < 0) && (errno == EINTR)) {
+                continue;
+            }
+            return false;
+        }
+        received += static_cast<std::size_t>(count);
+    }
+    return true;
+}
+
+
+// Close the socket
+void Socket::close() {
+    if (descriptor >= 0) {
+        ::close(descriptor);
+        descriptor = -1;
+    }
+
+    if (!unlink_path.empty()) {
+        ::unlink(unlink_path.c_str());
+        unlink_path.clear();
+    }
+}
+
+#else
+
+// Listen on the address
+bool Socket::listen(const std::string &) {
+    std::cerr << "error: sockets are not supported on this platform" << std::endl;
+    return false;
+}
+
+// Connect once to the address
+bool Socket::open(const std::string &, const bool &) {
+    return false;
+}
+
+// Connect to the address
+bool Socket::connect(const std::string &, const int &) {
+    std::cerr << "error: sockets are not supported on this platform" << std::endl;
+    return false;
+}
+
+// Accept a connection
+Socket *Socket::accept() const {
+    return new Socket();
+}
+
+
+// Wait until there is data to read
+bool Socket::wait(const int &) const {
+    return false;
+}
+
+// Send all the bytes
+bool Socket::send(const void *, const std::size_t &) const {
+    return false;
+}
+
+// Receive exactly the bytes
+bool Socket::receive(void *, const std::size_t &) const {
+    return false;
+}
+
+
+// Close the socket
+void Socket::close() {
+    descriptor = -1;
+}
+
+#endif
+
+
+// Destructor
+
+// Socket destructor
+Socket::~Socket() {
+    close();
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef __SOCKET_HPP_
+#define __SOCKET_HPP_
+
+#include <string>
+
+#include <cstddef>
+
+
+/** Blocking stream socket over TCP, `host:port', or a Unix domain socket, `unix:path' */
+class Socket {
+    private:
+        // Attributes
+
+        /** File descriptor, negative if closed */
+        int descriptor;
+
+        /** Unix socket path to remove when the listening socket closes */
+        std::string unlink_path;
+
+
+        // Constructors
+
+        /** Disable the default copy constructor */
+        Socket(const Socket &) = delete;
+
+        /** Disable the assignation operator */
+        Socket &operator=(const Socket &) = delete;
+
+
+        // Methods
+
+        /** Connect once to the address, the errors are printed if requested */
+        bool open(const std::string &address, const bool &report);
+
+
+    public:
+        // Constructors
+
+        /** Closed socket constructor */
+        Socket();
+
+        /** Socket constructor adopting an open file descriptor */
+        explicit Socket(const int &fd);
+
+
+        // Getters
+
+        /** Get the open status */
+        bool isOpen() const;
+
+
+        // Methods
+
+        /** Listen on the address, returns false on error */
+        bool listen(const std::string &address);
+
+        /** Connect to the address, retrying for the given time while nobody listens on it, returns false on error */
+        bool connect(const std::string &address, const int &timeout_ms = 0);
+
+        /** Accept a connection, the result is closed on error */
+        Socket *accept() const;
+
+
+        /** Wait until there is data to read, negative timeout waits forever, returns false on timeout */
+        bool wait(const int &timeout_ms) const;
+
+        /** Send all the bytes, returns false if the connection failed */
+        bool send(const void *data, const std::size_t &size) const;
+
+        /** Receive exactly the bytes, returns false if the connection closed or failed */
+        bool receive(void *data, const std::size_t &size) const;
+
+
+        /** Close the socket */
+        void close();
+
+
+        // Destructor
+
+        /** Socket destructor, closes it */
+        virtual ~Socket();
+};
+
+#endif // __SOCKET_HPP_
\ No newline at end of file
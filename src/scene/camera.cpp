@@ -30,11 +30,15 @@ float Camera::zoom_factor = 1.0625F;
 
 // updateViewMatrix
 void Camera::updateViewMatrix() {
+    revision++;
     view_mat = glm::lookAt(position, position + front, glm::cross(right, front));
 }
 
 // Update projection matrices
 void Camera::updateProjectionMatrices() {
+    // Count the change
+    revision++;
+
     // Auxiliar values
     const float aspect = static_cast<float>(resolution.x) / static_cast<float>(resolution.y);
     const float ratio = std::atan(fov / 2.0F);
@@ -55,7 +59,8 @@ void Camera::updateProjectionMatrices() {
 // Camera constructor
 Camera::Camera(const int &width, const int &height, const bool &orthogonal) :
     orthogonal(orthogonal),
-    resolution(static_cast<unsigned int>(width), static_cast<unsigned int>(height == 0 ? 1 : height)) {
+    resolution(static_cast<unsigned int>(width), static_cast<unsigned int>(height == 0 ? 1 : height)),
+    revision(0U) {
     // Load default values
     reset();
 }
@@ -127,11 +132,18 @@ glm::mat4 Camera::getProjectionMatrix() const {
 }
 
 
+// Get the revision counter
+unsigned long long int Camera::getRevision() const {
+    return revision;
+}
+
+
 // Setters
 
 // Set the orthogonal projection status
 void Camera::setOrthogonal(const bool &status) {
     orthogonal = status;
+    revision++;
 }
 
 
@@ -58,6 +58,10 @@ class Camera {
         float yaw;
 
 
+        /** Revision counter increased on every change */
+        unsigned long long int revision;
+
+
         // Constructors
 
         /** Delete the default constructor */
@@ -166,6 +170,10 @@ class Camera {
         glm::mat4 getProjectionMatrix() const;
 
 
+        /** Get the revision counter */
+        unsigned long long int getRevision() const;
+
+
         // Setters
 
         /** Set the orthogonal projection status */
@@ -0,0 +1,152 @@
+#include "framebuffer.hpp"
+
+#include <iostream>
+
+
+// Private methods
+
+// Delete the framebuffer objects
+void Framebuffer::clear() {
+    // Framebuffer
+    glDeleteFramebuffers(1, &fbo);
+    fbo = GL_FALSE;
+
+    // Attachments
+    glDeleteTextures(1, &color);
+    glDeleteRenderbuffers(1, &depth);
+    color = GL_FALSE;
+    depth = GL_FALSE;
+
+    // Resolution
+    width = 0;
+    height = 0;
+}
+
+
+// Constructors
+
+// Framebuffer constructor
+Framebuffer::Framebuffer(const GLsizei &width, const GLsizei &height, const GLenum &format, const bool &depth_buffer) :
+    // Objects
+    fbo(GL_FALSE),
+    color(GL_FALSE),
+    depth(GL_FALSE),
+
+    // Formats
+    format(format),
+    depth_buffer(depth_buffer),
+
+    // Resolution
+    width(0),
+    height(0) {
+    // Create the attachments
+    resize(width, height);
+}
+
+
+// Getters
+
+// Get the valid status
+bool Framebuffer::isValid() const {
+    return fbo != GL_FALSE;
+}
+
+// Get the framebuffer object
+GLuint Framebuffer::getFramebufferObject() const {
+    return fbo;
+}
+
+// Get the color texture
+GLuint Framebuffer::getColorTexture() const {
+    return color;
+}
+
+// Get the color internal format
+GLenum Framebuffer::getFormat() const {
+    return format;
+}
+
+// Get the resolution
+glm::uvec2 Framebuffer::getResolution() const {
+    return glm::uvec2(static_cast<unsigned int>(width), static_cast<unsigned int>(height));
+}
+
+
+// Methods
+
+// Create the attachments with the given resolution, nothing is done if it has not changed
+void Framebuffer::resize(const GLsizei &new_width, const GLsizei &new_height) {
+    // Keep the current attachments for empty or unchanged resolutions (minimized window)
+    if ((new_width <= 0) || (new_height <= 0) || ((new_width == width) && (new_height == height))) {
+        return;
+    }
+
+    // Delete the previous objects
+    clear();
+    width = new_width;
+    height = new_height;
+
+    // Create the framebuffer object
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+
+    // Color texture
+    glGenTextures(1, &color);
+    glBindTexture(GL_TEXTURE_2D, color);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, GL_RGBA, format == GL_RGBA8 ? GL_UNSIGNED_BYTE : GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, GL_FALSE);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+
+    // Depth renderbuffer
+    if (depth_buffer) {
+        glGenRenderbuffers(1, &depth);
+        glBindRenderbuffer(GL_RENDERBUFFER, depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, GL_FALSE);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+    }
+
+    // Check the completeness
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "error: the framebuffer is not complete (" << width << "x" << height << ")" << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, GL_FALSE);
+        clear();
+        return;
+    }
+
+    // Unbind the framebuffer
+    glBindFramebuffer(GL_FRAMEBUFFER, GL_FALSE);
+}
+
+// Bind the framebuffer as the render target
+void Framebuffer::bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+}
+
+// Copy the color buffer into the target framebuffer with the given resolution
+void Framebuffer::blit(const GLuint &target, const GLsizei &target_width, const GLsizei &target_height, const GLenum &filter) const {
+    // Check the framebuffer status
+    if (fbo == GL_FALSE) {
+        return;
+    }
+
+    // Copy the color buffer
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, target_width, target_height, GL_COLOR_BUFFER_BIT, filter);
+
+    // Leave the target bound
+    glBindFramebuffer(GL_FRAMEBUFFER, target);
+}
+
+
+// Destructor
+
+// Framebuffer destructor
+Framebuffer::~Framebuffer() {
+    clear();
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#ifndef __FRAMEBUFFER_HPP_
+#define __FRAMEBUFFER_HPP_
+
+#include "../glad/glad.h"
+
+#include <glm/vec2.hpp>
+
+
+/** Offscreen framebuffer with a color texture and an optional depth buffer */
+class Framebuffer {
+    private:
+        // Attributes
+
+        /** Framebuffer object */
+        GLuint fbo;
+
+        /** Color texture */
+        GLuint color;
+
+        /** Depth renderbuffer */
+        GLuint depth;
+
+
+        /** Color internal format */
+        GLenum format;
+
+        /** Depth buffer status */
+        bool depth_buffer;
+
+
+        /** Width */
+        GLsizei width;
+
+        /** Height */
+        GLsizei height;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        Framebuffer() = delete;
+
+        /** Disable the default copy constructor */
+        Framebuffer(const Framebuffer &) = delete;
+
+        /** Disable the assignation operator */
+        Framebuffer &operator=(const Framebuffer &) = delete;
+
+
+        // Methods
+
+        /** Delete the framebuffer objects */
+        void clear();
+
+
+    public:
+        // Constructors
+
+        /** Framebuffer constructor */
+        Framebuffer(const GLsizei &width, const GLsizei &height, const GLenum &format = GL_RGBA8, const bool &depth_buffer = true);
+
+
+        // Getters
+
+        /** Get the valid status */
+        bool isValid() const;
+
+        /** Get the framebuffer object */
+        GLuint getFramebufferObject() const;
+
+        /** Get the color texture */
+        GLuint getColorTexture() const;
+
+        /** Get the color internal format */
+        GLenum getFormat() const;
+
+        /** Get the resolution */
+        glm::uvec2 getResolution() const;
+
+
+        // Methods
+
+        /** Create the attachments with the given resolution, nothing is done if it has not changed */
+        void resize(const GLsizei &new_width, const GLsizei &new_height);
+
+        /** Bind the framebuffer as the render target */
+        void bind() const;
+
+        /** Copy the color buffer into the target framebuffer with the given resolution */
+        void blit(const GLuint &target, const GLsizei &target_width, const GLsizei &target_height, const GLenum &filter = GL_NEAREST) const;
+
+
+        // Destructor
+
+        /** Framebuffer destructor */
+        virtual ~Framebuffer();
+};
+
+#endif // __FRAMEBUFFER_HPP_
\ No newline at end of file
@@ -0,0 +1,388 @@
+#include "framecapture.hpp"
+
+#include "../profiler/profilerscope.hpp"
+#include "../task/taskscheduler.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+
+
+// Static const attributes
+
+// Number of pixel buffer objects, the read back is this many frames behind
+const std::size_t FrameCapture::RING_SIZE;
+
+
+// Private methods
+
+// Map the finished slot, queue its pixels and free it
+void FrameCapture::retire(FrameCapture::Slot &target) {
+    // Wait for the read back, flushing the commands the first time
+    GLenum status = glClientWaitSync(target.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0U);
+    while (status == GL_TIMEOUT_EXPIRED) {
+        status = glClientWaitSync(target.fence, 0U, 1000000000U);
+    }
+
+    glDeleteSync(target.fence);
+    target.fence = nullptr;
+
+    // Copy the pixels
+    FrameCapture::Job job;
+    std::ostringstream name;
+    name << prefix << std::setw(6) << std::setfill('0') << target.frame << extension;
+    job.path = name.str();
+    job.width = target.width;
+    job.height = target.height;
+
+    const std::size_t size = 4U * static_cast<std::size_t>(target.width) * static_cast<std::size_t>(target.height);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, target.buffer);
+    const GLubyte *const data = static_cast<const GLubyte *>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(size), GL_MAP_READ_BIT));
+    if (data != nullptr) {
+        job.pixels.assign(data, data + size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, GL_FALSE);
+
+    if (job.pixels.empty()) {
+        std::cerr << "error: cannot map the captured frame " << target.frame << std::endl;
+        return;
+    }
+
+    // Queue the image, waiting for the encoding tasks if they fall behind
+    std::unique_lock<std::mutex> lock(jobs_mutex);
+    if (jobs.size() >= max_jobs) {
+        stalls++;
+        jobs_space.wait(lock, [this] { return jobs.size() < max_jobs; });
+    }
+    jobs.push_back(std::move(job));
+
+    // Start an encoding task unless enough of them are draining the queue
+    if (draining < encoders) {
+        draining++;
+        lock.unlock();
+        TaskScheduler::getActive()->submit([this] {
+            work();
+        }, TaskScheduler::BACKGROUND, "capture encode");
+    }
+}
+
+// Retire the slots in frame order
+void FrameCapture::collect(const bool &wait) {
+    for (std::size_t i = 0U; i < FrameCapture::RING_SIZE; i++) {
+        FrameCapture::Slot &target = slot[(next + i) % FrameCapture::RING_SIZE];
+        if (target.fence == nullptr) {
+            continue;
+        }
+
+        // Keep the order, the later frames are not finished either
+        if (!wait) {
+            const GLenum status = glClientWaitSync(target.fence, 0U, 0U);
+            if ((status != GL_ALREADY_SIGNALED) && (status != GL_CONDITION_SATISFIED)) {
+                return;
+            }
+        }
+
+        retire(target);
+    }
+}
+
+// Encode the queued images until there are none
+void FrameCapture::work() {
+    std::unique_lock<std::mutex> lock(jobs_mutex);
+    while (!jobs.empty()) {
+        // Take the oldest image
+        FrameCapture::Job job = std::move(jobs.front());
+        jobs.pop_front();
+        lock.unlock();
+        jobs_space.notify_all();
+
+        // Encode it
+        bool written = false;
+        {
+            const ProfilerScope scope("encode");
+            written = FrameCapture::write(job.path, job.width, job.height, job.pixels);
+        }
+
+        // Count it
+        lock.lock();
+        if (written) {
+            encoded++;
+        }
+        else {
+            failed++;
+        }
+    }
+
+    // The capture may be waiting for the last task, signal it while locked
+    draining--;
+    jobs_space.notify_all();
+}
+
+
+// Private static methods
+
+// Get the RGB channels of an image row counted from the top
+void FrameCapture::getRow(const std::vector<GLubyte> &pixels, const GLsizei &width, const GLsizei &height, const GLsizei &row, const bool &bottom_up, GLubyte *const rgb) {
+    const std::size_t source = static_cast<std::size_t>(bottom_up ? height - 1 - row : row) * 4U * static_cast<std::size_t>(width);
+    for (std::size_t x = 0U; x < static_cast<std::size_t>(width); x++) {
+        rgb[3U * x]      = pixels[source + 4U * x];
+        rgb[3U * x + 1U] = pixels[source + 4U * x + 1U];
+        rgb[3U * x + 2U] = pixels[source + 4U * x + 2U];
+    }
+}
+
+// Write a PPM image
+bool FrameCapture::writePPM(const std::string &path, const GLsizei &width, const GLsizei &height, const std::vector<GLubyte> &pixels, const bool &bottom_up) {
+    // Open the file
+    std::ofstream file(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!file.is_open()) {
+        std::cerr << "error: cannot open the image file `" << path << "'" << std::endl;
+        return false;
+    }
+
+    // Header and RGB rows from the top
+    file << "P6\n" << width << " " << height << "\n255\n";
+    std::vector<GLubyte> rgb(3U * static_cast<std::size_t>(width));
+    for (GLsizei y = 0; y < height; y++) {
+        FrameCapture::getRow(pixels, width, height, y, bottom_up, rgb.data());
+        file.write(reinterpret_cast<const char *>(rgb.data()), static_cast<std::streamsize>(rgb.size()));
+    }
+
+    return static_cast<bool>(file);
+}
+
+// Write a PNG image with stored deflate blocks
+bool FrameCapture::writePNG(const std::string &path, const GLsizei &width, const GLsizei &height, const std::vector<GLubyte> &pixels, const bool &bottom_up) {
+    // CRC-32 table of the chunks
+    static const std::vector<std::uint32_t> crc_table = [] {
+        std::vector<std::uint32_t> table(256U);
+        for (std::uint32_t n = 0U; n < 256U; n++) {
+            std::uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1U) != 0U ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        return table;
+    }();
+
+    // Filter type zero followed by the RGB channels on every row
+    const std::size_t row_size = 1U + 3U * static_cast<std::size_t>(width);
+    std::vector<GLubyte> raw(row_size * static_cast<std::size_t>(height));
+    for (GLsizei y = 0; y < height; y++) {
+        raw[static_cast<std::size_t>(y) * row_size] = 0U;
+        FrameCapture::getRow(pixels, width, height, y, bottom_up, &raw[static_cast<std::size_t>(y) * row_size + 1U]);
+    }
+
+    // Zlib stream of stored blocks with the Adler-32 checksum
+    std::string data("\x78\x01", 2);
+    std::uint32_t a = 1U, b = 0U;
+    for (std::size_t offset = 0U; (offset < raw.size()) || (offset == 0U); ) {
+        const std::size_t length = std::min(raw.size() - offset, static_cast<std::size_t>(65535U));
+        const bool last = offset + length >= raw.size();
+        data += static_cast<char>(last ? 1 : 0);
+        data += static_cast<char>(length & 0xFFU);
+        data += static_cast<char>(length >> 8);
+        data += static_cast<char>(~length & 0xFFU);
+        data += static_cast<char>((~length >> 8) & 0xFFU);
+        data.append(reinterpret_cast<const char *>(&raw[offset]), length);
+        for (std::size_t i = offset; i < offset + length; i++) {
+            a = (a + raw[i]) % 65521U;
+            b = (b + a) % 65521U;
+        }
+        offset += length;
+        if (last) {
+            break;
+        }
+    }
+    const std::uint32_t adler = (b << 16) | a;
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        data += static_cast<char>((adler >> shift) & 0xFFU);
+    }
+
+    // Open the file
+    std::ofstream file(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!file.is_open()) {
+        std::cerr << "error: cannot open the image file `" << path << "'" << std::endl;
+        return false;
+    }
+
+    // Chunk writer with the big endian length and the CRC of the type and data
+    const auto chunk = [&file](const char *type, const std::string &content) {
+        std::string body(type, 4);
+        body += content;
+        std::uint32_t crc = 0xFFFFFFFFU;
+        for (const char &c : body) {
+            crc = crc_table[(crc ^ static_cast<std::uint8_t>(c)) & 0xFFU] ^ (crc >> 8);
+        }
+        crc ^= 0xFFFFFFFFU;
+
+        const std::uint32_t length = static_cast<std::uint32_t>(content.size());
+        const char header[4] = {static_cast<char>(length >> 24), static_cast<char>(length >> 16), static_cast<char>(length >> 8), static_cast<char>(length)};
+        const char footer[4] = {static_cast<char>(crc >> 24), static_cast<char>(crc >> 16), static_cast<char>(crc >> 8), static_cast<char>(crc)};
+        file.write(header, 4);
+        file.write(body.data(), static_cast<std::streamsize>(body.size()));
+        file.write(footer, 4);
+    };
+
+    // Signature, 8 bits RGB header, data and end
+    const std::uint32_t w = static_cast<std::uint32_t>(width), h = static_cast<std::uint32_t>(height);
+    const char header[13] = {static_cast<char>(w >> 24), static_cast<char>(w >> 16), static_cast<char>(w >> 8), static_cast<char>(w), static_cast<char>(h >> 24), static_cast<char>(h >> 16), static_cast<char>(h >> 8), static_cast<char>(h), 8, 2, 0, 0, 0};
+    file.write("\x89PNG\r\n\x1a\n", 8);
+    chunk("IHDR", std::string(header, 13));
+    chunk("IDAT", data);
+    chunk("IEND", std::string());
+
+    return static_cast<bool>(file);
+}
+
+
+// Constructors
+
+// Frame capture constructor
+FrameCapture::FrameCapture(const std::string &pattern, const unsigned int &threads) :
+    next(0U),
+    buffer_size(0U),
+    captured(0U),
+    stalls(0U),
+    encoders(0U),
+    draining(0U),
+    max_jobs(0U),
+    encoded(0U),
+    failed(0U) {
+    // Split the pattern around the extension
+    const std::size_t dot = pattern.find_last_of('.');
+    const std::size_t separator = pattern.find_last_of("/\\");
+    if ((dot != std::string::npos) && ((separator == std::string::npos) || (dot > separator))) {
+        prefix = pattern.substr(0U, dot) + "_";
+        extension = pattern.substr(dot);
+    }
+    else {
+        prefix = pattern + "_";
+        extension = ".ppm";
+    }
+
+    std::string lower = extension;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if ((lower != ".png") && (lower != ".ppm")) {
+        std::cerr << "warning: unknown capture extension `" << extension << "', writing PPM images" << std::endl;
+        extension = ".ppm";
+    }
+
+    // Generate the ring
+    for (FrameCapture::Slot &target : slot) {
+        glGenBuffers(1, &target.buffer);
+        target.fence = nullptr;
+        target.frame = 0U;
+        target.width = 0;
+        target.height = 0;
+    }
+
+    // Encode on half the threads of the scheduler by default, the background tasks never take all of them
+    encoders = threads > 0U ? threads : std::max(1U, TaskScheduler::getActive()->getThreads() / 2U);
+    max_jobs = 2U * static_cast<std::size_t>(encoders) + FrameCapture::RING_SIZE;
+
+    std::cout << "info: capturing frames to `" << prefix << "*" << extension << "' with " << encoders << " encoding tasks" << std::endl;
+}
+
+
+// Getters
+
+// Get the number of captured frames
+unsigned long long int FrameCapture::getCapturedFrames() const {
+    return captured;
+}
+
+// Get the number of encoded images
+unsigned long long int FrameCapture::getEncodedImages() const {
+    std::lock_guard<std::mutex> lock(jobs_mutex);
+    return encoded;
+}
+
+// Get the number of times the capture waited
+unsigned long long int FrameCapture::getStalls() const {
+    return stalls;
+}
+
+
+// Methods
+
+// Read back the color attachment of the framebuffer without waiting
+void FrameCapture::capture(const GLuint &framebuffer, const GLsizei &width, const GLsizei &height) {
+    // Queue the finished read backs
+    collect(false);
+
+    // Reallocate the ring when the resolution changes
+    const std::size_t size = 4U * static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    if (size != buffer_size) {
+        collect(true);
+        for (FrameCapture::Slot &target : slot) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, target.buffer);
+            glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, GL_FALSE);
+        buffer_size = size;
+    }
+
+    // The oldest slot must be free, it is only pending if the GPU is more than the ring behind
+    FrameCapture::Slot &target = slot[next];
+    if (target.fence != nullptr) {
+        stalls++;
+        retire(target);
+    }
+
+    // Read back into the buffer and fence it
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, target.buffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, GL_FALSE);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, GL_FALSE);
+
+    target.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0U);
+    target.frame = captured++;
+    target.width = width;
+    target.height = height;
+    next = (next + 1U) % FrameCapture::RING_SIZE;
+}
+
+// Wait for the pending read backs and encodings
+void FrameCapture::flush() {
+    collect(true);
+
+    std::unique_lock<std::mutex> lock(jobs_mutex);
+    jobs_space.wait(lock, [this] { return jobs.empty() && (draining == 0U); });
+}
+
+
+// Destructor
+
+// Frame capture destructor
+FrameCapture::~FrameCapture() {
+    // Encode the pending frames
+    flush();
+
+    // Delete the ring
+    for (FrameCapture::Slot &target : slot) {
+        glDeleteBuffers(1, &target.buffer);
+    }
+
+    std::cout << "info: " << encoded << " of " << captured << " captured frames encoded to `" << prefix << "*" << extension << "'";
+    if (failed > 0U) {
+        std::cout << ", " << failed << " failed";
+    }
+    std::cout << ", " << stalls << " stalls" << std::endl;
+}
+
+// Write RGBA pixels as PNG or PPM by the path extension
+bool FrameCapture::write(const std::string &path, const GLsizei &width, const GLsizei &height, const std::vector<GLubyte> &pixels, const bool &bottom_up) {
+    std::string lower = path.substr(std::min(path.size(), path.find_last_of('.')));
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    return lower == ".png" ? FrameCapture::writePNG(path, width, height, pixels, bottom_up) : FrameCapture::writePPM(path, width, height, pixels, bottom_up);
+}
\ No newline at end of file
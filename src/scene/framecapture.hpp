@@ -0,0 +1,185 @@
+#ifndef __FRAME_CAPTURE_HPP_
+#define __FRAME_CAPTURE_HPP_
+
+#include "../glad/glad.h"
+
+#include <string>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+
+/** Asynchronous frame capture reading back through a ring of pixel buffer objects and encoding PNG or PPM sequences as background tasks of the scheduler */
+class FrameCapture {
+    private:
+        // Structures
+
+        /** Pixel buffer object of the ring */
+        struct Slot {
+            /** Pixel pack buffer */
+            GLuint buffer;
+
+            /** Fence of the read back, null if the slot is free */
+            GLsync fence;
+
+            /** Frame number */
+            unsigned long long int frame;
+
+            /** Frame width */
+            GLsizei width;
+
+            /** Frame height */
+            GLsizei height;
+        };
+
+        /** Image waiting to be encoded */
+        struct Job {
+            /** Image file path */
+            std::string path;
+
+            /** Image width */
+            GLsizei width;
+
+            /** Image height */
+            GLsizei height;
+
+            /** RGBA pixels from the bottom row */
+            std::vector<GLubyte> pixels;
+        };
+
+
+        // Static const attributes
+
+        /** Number of pixel buffer objects, the read back is this many frames behind */
+        static const std::size_t RING_SIZE = 3U;
+
+
+        // Attributes
+
+        /** Path prefix of the images */
+        std::string prefix;
+
+        /** Extension of the images, `.png' or `.ppm' */
+        std::string extension;
+
+
+        /** Pixel buffer objects ring */
+        FrameCapture::Slot slot[FrameCapture::RING_SIZE];
+
+        /** Next slot to read into */
+        std::size_t next;
+
+        /** Size of the pixel buffer objects in bytes */
+        std::size_t buffer_size;
+
+        /** Captured frames */
+        unsigned long long int captured;
+
+        /** Times the capture waited for a fence or an encoding task */
+        unsigned long long int stalls;
+
+
+        /** Maximum number of encoding tasks */
+        unsigned int encoders;
+
+        /** Queued or running encoding tasks */
+        unsigned int draining;
+
+        /** Images waiting to be encoded */
+        std::deque<FrameCapture::Job> jobs;
+
+        /** Maximum number of queued images before the capture waits */
+        std::size_t max_jobs;
+
+        /** Jobs queue lock */
+        mutable std::mutex jobs_mutex;
+
+        /** Signals a dequeued job or a finished encoding task to the capture */
+        std::condition_variable jobs_space;
+
+        /** Encoded images */
+        unsigned long long int encoded;
+
+        /** Failed images */
+        unsigned long long int failed;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        FrameCapture() = delete;
+
+        /** Disable the default copy constructor */
+        FrameCapture(const FrameCapture &) = delete;
+
+        /** Disable the assignation operator */
+        FrameCapture &operator=(const FrameCapture &) = delete;
+
+
+        // Methods
+
+        /** Map the finished slot, queue its pixels and free it */
+        void retire(FrameCapture::Slot &target);
+
+        /** Retire the slots in frame order, waiting for their fences or only the finished ones */
+        void collect(const bool &wait);
+
+        /** Encode the queued images until there are none */
+        void work();
+
+
+        // Static methods
+
+        /** Get the RGB channels of an image row counted from the top */
+        static void getRow(const std::vector<GLubyte> &pixels, const GLsizei &width, const GLsizei &height, const GLsizei &row, const bool &bottom_up, GLubyte *const rgb);
+
+        /** Write a PPM image */
+        static bool writePPM(const std::string &path, const GLsizei &width, const GLsizei &height, const std::vector<GLubyte> &pixels, const bool &bottom_up);
+
+        /** Write a PNG image with stored deflate blocks */
+        static bool writePNG(const std::string &path, const GLsizei &width, const GLsizei &height, const std::vector<GLubyte> &pixels, const bool &bottom_up);
+
+
+    public:
+        // Constructors
+
+        /** Frame capture constructor, images are named as the pattern with the frame number before the `.png' or `.ppm' extension, the encoding tasks default to half the threads of the scheduler */
+        FrameCapture(const std::string &pattern, const unsigned int &threads = 0U);
+
+
+        // Getters
+
+        /** Get the number of captured frames */
+        unsigned long long int getCapturedFrames() const;
+
+        /** Get the number of encoded images */
+        unsigned long long int getEncodedImages() const;
+
+        /** Get the number of times the capture waited */
+        unsigned long long int getStalls() const;
+
+
+        // Methods
+
+        /** Read back the color attachment of the framebuffer without waiting, needs the context of the frames */
+        void capture(const GLuint &framebuffer, const GLsizei &width, const GLsizei &height);
+
+        /** Wait for the pending read backs and encodings */
+        void flush();
+
+
+        // Destructor
+
+        /** Frame capture destructor, flushes the pending frames */
+        virtual ~FrameCapture();
+
+
+        // Static methods
+
+        /** Write RGBA pixels as PNG or PPM by the path extension, the rows go from the bottom as read back by OpenGL or from the top */
+        static bool write(const std::string &path, const GLsizei &width, const GLsizei &height, const std::vector<GLubyte> &pixels, const bool &bottom_up = true);
+};
+
+#endif // __FRAME_CAPTURE_HPP_
\ No newline at end of file
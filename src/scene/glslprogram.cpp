@@ -1,7 +1,24 @@
 #include "glslprogram.hpp"
 
+#include "scene.hpp"
+
+#include "../profiler/profilerscope.hpp"
+
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+
+#if defined(_WIN32)
+    #include <direct.h>
+#else
+    #include <sys/stat.h>
+#endif
 
 
 // Static attributes
@@ -10,6 +27,19 @@
 GLuint GLSLProgram::current_program = GL_FALSE;
 
 
+/** Binary cache directory path */
+std::string GLSLProgram::cache_path;
+
+/** Log file path */
+std::string GLSLProgram::log_path;
+
+
+/** Get the steady clock time in seconds */
+static double steadyTime() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
 // Private getters
 
 // Get the location of the given uniform within the program
@@ -20,51 +50,396 @@ GLint GLSLProgram::getUniformLocation(const GLchar *&name) {
     }
 
     // Return stored location
-    std::map<std::string, GLint>::const_iterator result = location_stock.find(name);
-    if (result != location_stock.end()) {
+    std::map<std::string, GLint>::const_iterator result = variant->location_stock.find(name);
+    if (result != variant->location_stock.end()) {
         return result->second;
     }
 
     // Query the non stored uniform location and insert in the location stock
     GLint location = glGetUniformLocation(program, name);
-    location_stock[name] = location;
+    variant->location_stock[name] = location;
 
     // Return the uniform location
     return location;
 }
 
 
-// Private static methods
+// Private methods
+
+// Get the binary cache file path for the given sources
+std::string GLSLProgram::getCacheFile(const std::string &vert, const std::string &geom, const std::string &frag) const {
+    // Binary cache disabled
+    if (GLSLProgram::cache_path.empty() || !GLSLProgram::isBinaryCacheSupported()) {
+        return std::string();
+    }
+
+    // Driver identity, binaries are only valid for the same driver
+    const GLubyte *const identity[] = {Scene::getOpenGLVendor(), Scene::getOpenGLRenderer(), Scene::getOpenGLVersion(), Scene::getGLSLVersion()};
+
+    // FNV-1a hash of the sources and the driver identity
+    unsigned long long int hash = 14695981039346656037ULL;
+    const std::string *const source[] = {&vert, &geom, &frag};
+    for (const std::string *const text : source) {
+        for (const char &byte : *text) {
+            hash = (hash ^ static_cast<unsigned char>(byte)) * 1099511628211ULL;
+        }
+        hash = (hash ^ 0xFFU) * 1099511628211ULL;
+    }
+    for (const GLubyte *const text : identity) {
+        for (const GLubyte *byte = text; (byte != nullptr) && (*byte != 0U); byte++) {
+            hash = (hash ^ *byte) * 1099511628211ULL;
+        }
+        hash = (hash ^ 0xFFU) * 1099511628211ULL;
+    }
+
+    // Build the file path
+    std::ostringstream file;
+    file << GLSLProgram::cache_path << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+    return file.str();
+}
+
+// Load the variant program from the binary cache file
+bool GLSLProgram::loadBinary(GLSLProgram::Variant &target) const {
+    // Binary cache disabled
+    if (target.cache_file.empty()) {
+        return false;
+    }
+
+    // Open the binary file, a missing file is a cache miss
+    std::ifstream input(target.cache_file, std::ios::binary);
+    if (!input.is_open()) {
+        return false;
+    }
+
+    // Read the header and the binary data
+    GLenum format = GL_FALSE;
+    GLint length = 0;
+    input.read(reinterpret_cast<char *>(&format), sizeof(GLenum));
+    input.read(reinterpret_cast<char *>(&length), sizeof(GLint));
+    if (!input || (length <= 0)) {
+        std::cerr << "warning: corrupted shader binary cache file `" << target.cache_file << "'" << std::endl;
+        input.close();
+        std::remove(target.cache_file.c_str());
+        return false;
+    }
+
+    GLchar *binary = new GLchar[length];
+    input.read(binary, length);
+    const bool complete = static_cast<bool>(input);
+    input.close();
+
+    // Create the program and load the binary
+    GLint status = GL_FALSE;
+    if (complete) {
+        target.program = glCreateProgram();
+        glProgramBinary(target.program, format, binary, length);
+        glGetProgramiv(target.program, GL_LINK_STATUS, &status);
+    }
+    delete[] binary;
+
+    // Discard the binary if it is rejected by the driver
+    if (status == GL_FALSE) {
+        std::cerr << "warning: shader binary cache file `" << target.cache_file << "' rejected, compiling from source" << std::endl;
+        if (target.program != GL_FALSE) {
+            glDeleteProgram(target.program);
+            target.program = GL_FALSE;
+        }
+        std::remove(target.cache_file.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+// Store the variant program into the binary cache file
+void GLSLProgram::saveBinary(const GLSLProgram::Variant &target) const {
+    // Binary cache disabled or invalid program
+    if (target.cache_file.empty() || (target.program == GL_FALSE)) {
+        return;
+    }
+
+    // Get the binary length
+    GLint length = 0;
+    glGetProgramiv(target.program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    // Get the binary data
+    GLenum format = GL_FALSE;
+    GLchar *binary = new GLchar[length];
+    glGetProgramBinary(target.program, length, nullptr, &format, binary);
+
+    // Write the header and the binary data
+    std::ofstream output(target.cache_file, std::ios::binary);
+    if (output.is_open()) {
+        output.write(reinterpret_cast<const char *>(&format), sizeof(GLenum));
+        output.write(reinterpret_cast<const char *>(&length), sizeof(GLint));
+        output.write(binary, length);
+        output.close();
+    }
+    else {
+        std::cerr << "warning: cannot write the shader binary cache file `" << target.cache_file << "'" << std::endl;
+    }
+
+    delete[] binary;
+}
+
+
+// Start the build of the variant with the given defines and sources
+void GLSLProgram::build(GLSLProgram::Variant &target, const std::set<std::string> &defines, const std::string &vert, const std::string &geom, const std::string &frag) const {
+    // Reset the variant
+    target.program = GL_FALSE;
+    target.shader[0] = GL_FALSE;
+    target.shader[1] = GL_FALSE;
+    target.shader[2] = GL_FALSE;
+    target.pending = false;
+    target.cache_file.clear();
+    target.location_stock.clear();
+    target.start = steadyTime();
+    target.link_time = 0.0;
+    target.binary_cached = false;
+
+    // Check the sources
+    if (vert.empty() || frag.empty()) {
+        return;
+    }
+
+    // Specialize the sources
+    const std::string vert_variant = GLSLProgram::injectDefines(vert, defines);
+    const std::string geom_variant = geom.empty() ? std::string() : GLSLProgram::injectDefines(geom, defines);
+    const std::string frag_variant = GLSLProgram::injectDefines(frag, defines);
+
+    // Try to load the program from the binary cache
+    target.cache_file = getCacheFile(vert_variant, geom_variant, frag_variant);
+    target.binary_cached = loadBinary(target);
+    if (target.binary_cached) {
+        target.link_time = 1000.0 * (steadyTime() - target.start);
+        return;
+    }
+
+    // Create the new program object
+    target.program = glCreateProgram();
+    if (target.program == GL_FALSE) {
+        GLSLProgram::log("error: could not create the shader program object\n");
+        return;
+    }
+
+    // Compile and attach the shaders, the status is checked when the link is finalized
+    target.shader[0] = GLSLProgram::compileShaderSource(vert_variant.c_str(), GL_VERTEX_SHADER);
+    target.shader[1] = GLSLProgram::compileShaderSource(frag_variant.c_str(), GL_FRAGMENT_SHADER);
+    target.shader[2] = geom_variant.empty() ? GL_FALSE : GLSLProgram::compileShaderSource(geom_variant.c_str(), GL_GEOMETRY_SHADER);
+    for (const GLuint &shader : target.shader) {
+        if (shader != GL_FALSE) {
+            glAttachShader(target.program, shader);
+        }
+    }
+
+    // Allow to retrieve the binary for the cache
+    if (!target.cache_file.empty()) {
+        glProgramParameteri(target.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    // Link the program, with parallel compile this does not block
+    glLinkProgram(target.program);
+    target.pending = true;
+}
+
+// Start the build of the variant with the given defines
+GLSLProgram::Variant &GLSLProgram::build(const std::set<std::string> &defines) {
+    GLSLProgram::Variant &target = variant_stock[GLSLProgram::getVariantKey(defines)];
+    build(target, defines, vert_source, geom_source, frag_source);
+    return target;
+}
+
+// Get the link completion status of the variant without blocking
+bool GLSLProgram::isComplete(const GLSLProgram::Variant &target) const {
+    // Finalized variant
+    if (!target.pending) {
+        return true;
+    }
+
+    // Without parallel compile querying the status blocks, so the variant is reported as complete
+    if (!GLSLProgram::isParallelCompileSupported()) {
+        return true;
+    }
+
+    // Query the completion status without blocking
+    GLint complete = GL_FALSE;
+    glGetProgramiv(target.program, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete != GL_FALSE;
+}
 
-// Compile a shader from the given source path and type
-GLuint GLSLProgram::compileShaderFile(const std::string &path, const GLenum &type) {
-    // Empty source path
-    if (path.empty()) {
-        return GL_FALSE;
+// Wait and check the link of the variant
+void GLSLProgram::finalize(GLSLProgram::Variant &target) const {
+    // Nothing to wait
+    if (!target.pending) {
+        return;
     }
+    target.pending = false;
+
+    // Check the link status, this blocks until the compilation is complete
+    GLint status = GL_FALSE;
+    glGetProgramiv(target.program, GL_LINK_STATUS, &status);
 
+    // Link error
+    if (status == GL_FALSE) {
+        // Write the compilation errors of the shaders
+        std::ostringstream report;
+        const std::string *const path[] = {&vert_path, &frag_path, &geom_path};
+        for (int i = 0; i < 3; i++) {
+            if ((target.shader[i] != GL_FALSE) && !GLSLProgram::checkShader(target.shader[i], report)) {
+                report << "error: shader source path `" << *path[i] << "'" << std::endl;
+            }
+        }
+
+        // Get the log length
+        GLint length;
+        glGetProgramiv(target.program, GL_INFO_LOG_LENGTH, &length);
+
+        // Write the information log if is not empty
+        if (length > 0) {
+            // Get the information log data
+            GLchar *log = new GLchar[length];
+            glGetProgramInfoLog(target.program, length, nullptr, log);
+
+            // Write the information log data
+            report << log;
+            delete[] log;
+        }
+
+        // Write the link error message and print the report
+        report << "error: could not link the shader program object" << std::endl;
+        GLSLProgram::log(report.str());
+
+        // Delete the program and reset it
+        glDeleteProgram(target.program);
+        target.program = GL_FALSE;
+    }
+
+    // Store the linked program into the binary cache
+    else {
+        saveBinary(target);
+    }
+
+    // Delete the shaders
+    for (GLuint &shader : target.shader) {
+        if (shader != GL_FALSE) {
+            glDeleteShader(shader);
+            shader = GL_FALSE;
+        }
+    }
+
+    // Stop the link timer
+    target.link_time = 1000.0 * (steadyTime() - target.start);
+}
+
+// Delete the objects of the variant
+void GLSLProgram::deleteVariant(GLSLProgram::Variant &target) const {
+    // Delete the pending shaders
+    for (GLuint &shader : target.shader) {
+        if (shader != GL_FALSE) {
+            glDeleteShader(shader);
+            shader = GL_FALSE;
+        }
+    }
+
+    // Delete the program
+    if (target.program != GL_FALSE) {
+        glDeleteProgram(target.program);
+
+        // The name of a deleted program could be reused
+        if (target.program == GLSLProgram::current_program) {
+            GLSLProgram::current_program = GL_FALSE;
+        }
+
+        target.program = GL_FALSE;
+    }
+
+    target.pending = false;
+}
+
+// Delete all the variants
+void GLSLProgram::clearVariants() {
+    // Delete the programs and pending shaders
+    for (std::pair<const std::string, GLSLProgram::Variant> &entry : variant_stock) {
+        deleteVariant(entry.second);
+    }
+
+    // Reset the stock and the active variant
+    variant_stock.clear();
+    variant = nullptr;
+    program = GL_FALSE;
+}
+
+// Discard the pending reload
+void GLSLProgram::cancelReload() {
+    if (reloading) {
+        deleteVariant(reload_variant);
+        reloading = false;
+    }
+}
+
+
+// Private static methods
+
+// Read a shader source from the given path
+bool GLSLProgram::readShaderFile(const std::string &path, std::string &source) {
     // Open the file and check it
     std::ifstream file(path);
     if (!file.is_open()) {
         std::cerr << "error: cannot open the shader source file `" << path << "'" << std::endl;
-        return GL_FALSE;
+        return false;
     }
 
     // Read the source code from file and close it
-    const std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    source.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
     file.close();
 
-    // Compile the shader
-    GLuint shader = GLSLProgram::compileShaderSource(source.c_str(), type);
-    if (shader == GL_FALSE) {
-        std::cerr << "error: shader source path `" << path << "'" << std::endl;
+    return true;
+}
+
+// Insert the defines after the version directive of the source
+std::string GLSLProgram::injectDefines(const std::string &source, const std::set<std::string> &defines) {
+    // Nothing to insert
+    if (defines.empty()) {
+        return source;
     }
 
-    // Return the shader
-    return shader;
+    // The defines go after the version directive, which must be the first directive
+    std::size_t position = 0U;
+    const std::size_t version = source.find_first_not_of(" \t\r\n");
+    if ((version != std::string::npos) && (source.compare(version, 8U, "#version") == 0)) {
+        const std::size_t end = source.find('\n', version);
+        position = end == std::string::npos ? source.size() : end + 1U;
+    }
+
+    // Number of lines before the defines
+    const std::size_t line = static_cast<std::size_t>(std::count(source.begin(), source.begin() + position, '\n'));
+
+    // Build the defines block and restore the line numbers of the errors
+    std::ostringstream block;
+    for (const std::string &define : defines) {
+        block << "#define " << define << " 1\n";
+    }
+    block << "#line " << (line + 1U) << "\n";
+
+    // Return the specialized source
+    return source.substr(0U, position) + (position == source.size() ? "\n" : "") + block.str() + source.substr(position);
+}
+
+// Get the key of a set of defines
+std::string GLSLProgram::getVariantKey(const std::set<std::string> &defines) {
+    std::string key;
+    for (const std::string &define : defines) {
+        key += define;
+        key += ' ';
+    }
+    return key;
 }
 
-// Compile a shader with the given source and type
+
+// Compile a shader with the given source and type without waiting the result
 GLuint GLSLProgram::compileShaderSource(const GLchar *const &source, const GLenum &type) {
     // Create the new shader of the given type
     GLuint shader = glCreateShader(type);
@@ -82,37 +457,69 @@ GLuint GLSLProgram::compileShaderSource(const GLchar *const &source, const GLenu
     glShaderSource(shader, 1, &source, nullptr);
     glCompileShader(shader);
 
+    // Return the shader
+    return shader;
+}
+
+// Write the information log of the shader if the compilation failed
+bool GLSLProgram::checkShader(const GLuint &shader, std::ostream &output) {
     // Check the compilation status
     GLint status = GL_FALSE;
     glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_FALSE) {
+        return true;
+    }
 
-    // Compilation error
-    if (status == GL_FALSE) {
-        // Get the log length
-        GLint length;
-        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+    // Get the log length
+    GLint length;
+    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
 
-        // Print the information log if is not empty
-        if (length > 0) {
-            // Get the information log data
-            GLchar *log = new GLchar[length];
-            glGetShaderInfoLog(shader, length, nullptr, log);
+    // Write the information log if is not empty
+    if (length > 0) {
+        // Get the information log data
+        GLchar *log = new GLchar[length];
+        glGetShaderInfoLog(shader, length, nullptr, log);
 
-            // Print the information log data
-            std::cerr << log;
-            delete[] log;
+        // Write the information log data
+        output << log;
+        delete[] log;
+    }
+
+    // Write compilation error message
+    output << "error: could not compile the shader source" << std::endl;
+    return false;
+}
+
+
+// Write a message to the error output and the log file
+void GLSLProgram::log(const std::string &message) {
+    // Error output
+    std::cerr << message;
+
+    // Append to the log file with a time stamp
+    if (!GLSLProgram::log_path.empty()) {
+        std::ofstream file(GLSLProgram::log_path, std::ios::app);
+        if (file.is_open()) {
+            char stamp[32];
+            const std::time_t now = std::time(nullptr);
+            std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+            file << "[" << stamp << "]" << std::endl << message;
         }
+    }
+}
 
-        // Print compilation error message
-        std::cerr << "error: could not compile the shader source" << std::endl;
 
-        // Delete the shader and reset it
-        glDeleteShader(shader);
-        shader = GL_FALSE;
+// Get the binary cache support status of the current context
+bool GLSLProgram::isBinaryCacheSupported() {
+    // Program binaries are core since OpenGL 4.1
+    if ((GLAD_GL_ARB_get_program_binary == 0) && ((GLVersion.major < 4) || ((GLVersion.major == 4) && (GLVersion.minor < 1)))) {
+        return false;
     }
 
-    // Return the shader
-    return shader;
+    // The driver must support at least one binary format
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
 }
 
 
@@ -121,7 +528,9 @@ GLuint GLSLProgram::compileShaderSource(const GLchar *const &source, const GLenu
 // Empty program constructor
 GLSLProgram::GLSLProgram() :
     program(GL_FALSE),
-    shaders(0U) {}
+    shaders(0U),
+    variant(nullptr),
+    reloading(false) {}
 
 // GLSL program without geometry shader constructor
 GLSLProgram::GLSLProgram(const std::string &vert, const std::string &frag) :
@@ -133,7 +542,11 @@ GLSLProgram::GLSLProgram(const std::string &vert, const std::string &frag) :
     frag_path(frag),
 
     // Number of shaders
-    shaders(0U) {
+    shaders(0U),
+
+    // Variants
+    variant(nullptr),
+    reloading(false) {
     // Link the program
     link();
 }
@@ -149,7 +562,11 @@ GLSLProgram::GLSLProgram(const std::string &vert, const std::string &geom, const
     frag_path(frag),
 
     // Number of shaders
-    shaders(0U) {
+    shaders(0U),
+
+    // Variants
+    variant(nullptr),
+    reloading(false) {
     // Link the program
     link();
 }
@@ -199,6 +616,46 @@ std::size_t GLSLProgram::getNumberOfShaders() const {
 }
 
 
+// Get the time spent by the last link in milliseconds
+double GLSLProgram::getLinkTime() const {
+    return variant == nullptr ? 0.0 : variant->link_time;
+}
+
+// Get the loaded from the binary cache status of the last link
+bool GLSLProgram::isBinaryCached() const {
+    return (variant != nullptr) && variant->binary_cached;
+}
+
+
+// Get the defines of the active variant
+std::set<std::string> GLSLProgram::getVariant() const {
+    return variant_defines;
+}
+
+// Get the ready status of the variant with the given defines
+bool GLSLProgram::isVariantReady(const std::set<std::string> &defines) const {
+    // Not built variant
+    std::map<std::string, GLSLProgram::Variant>::const_iterator result = variant_stock.find(GLSLProgram::getVariantKey(defines));
+    if (result == variant_stock.end()) {
+        return false;
+    }
+
+    // Check the completion status
+    return isComplete(result->second);
+}
+
+// Get the number of built variants
+std::size_t GLSLProgram::getNumberOfVariants() const {
+    return variant_stock.size();
+}
+
+
+// Get the reloading status
+bool GLSLProgram::isReloading() const {
+    return reloading;
+}
+
+
 // Setters
 
 // Set the value for an integer uniform
@@ -242,16 +699,38 @@ void GLSLProgram::setUniform(const GLchar *name, const glm::mat4 &matrix) {
 }
 
 
+// Set the active variant, building it if has not been used before
+void GLSLProgram::setVariant(const std::set<std::string> &defines) {
+    // Already active and finalized
+    if ((variant != nullptr) && !variant->pending && (defines == variant_defines)) {
+        return;
+    }
+
+    // Find or build the variant
+    std::map<std::string, GLSLProgram::Variant>::iterator result = variant_stock.find(GLSLProgram::getVariantKey(defines));
+    GLSLProgram::Variant &target = result == variant_stock.end() ? build(defines) : result->second;
+
+    // Wait the link and activate the variant
+    finalize(target);
+    variant = &target;
+    variant_defines = defines;
+    program = target.program;
+}
+
+
 // Methods
 
 // Link a new pogram using the current shaders source paths
 void GLSLProgram::link() {
-    // Delete previous program and reset ID
-    if (program != GL_FALSE) {
-        location_stock.clear();
-        glDeleteProgram(program);
-        program = GL_FALSE;
-    }
+    // Time the phase
+    const ProfilerScope scope("link");
+
+    // Delete previous variants
+    cancelReload();
+    clearVariants();
+    vert_source.clear();
+    geom_source.clear();
+    frag_source.clear();
 
     // Count not empty shaders and check mandatories
     shaders = 0;
@@ -285,82 +764,16 @@ void GLSLProgram::link() {
         return;
     }
 
-    // Compile the vertex shader
-    const GLuint vert = GLSLProgram::compileShaderFile(vert_path, GL_VERTEX_SHADER);
-    if (vert == GL_FALSE) {
-        return;
-    }
-
-    // Compile the fragment shader
-    const GLuint frag = GLSLProgram::compileShaderFile(frag_path, GL_FRAGMENT_SHADER);
-    if (frag == GL_FALSE) {
-        glDeleteShader(vert);
-        return;
-    }
-
-    // Compile the geometry shader
-    const GLuint geom = GLSLProgram::compileShaderFile(geom_path, GL_GEOMETRY_SHADER);
-    if (!geom_path.empty() && (geom == GL_FALSE)) {
-        glDeleteShader(vert);
-        glDeleteShader(frag);
-        return;
-    }
-
-    // Create the new program object
-    program = glCreateProgram();
-    if (program == GL_FALSE) {
-        std::cerr << "error: could not create the shader program object" << std::endl;
-
-        // Delete shaders and return
-        glDeleteShader(vert);
-        glDeleteShader(frag);
-        glDeleteShader(geom);
+    // Read the shaders sources
+    if (!GLSLProgram::readShaderFile(vert_path, vert_source) || !GLSLProgram::readShaderFile(frag_path, frag_source) || (!geom_path.empty() && !GLSLProgram::readShaderFile(geom_path, geom_source))) {
+        vert_source.clear();
+        geom_source.clear();
+        frag_source.clear();
         return;
     }
 
-    // Attach mandatory shaders
-    glAttachShader(program, vert);
-    glAttachShader(program, frag);
-
-    // Attach geometry shader if is not empty
-    if (geom != GL_FALSE) {
-        glAttachShader(program, geom);
-    }
-
-    // Link program and delete attached shaders
-    glLinkProgram(program);
-    glDeleteShader(vert);
-    glDeleteShader(frag);
-    glDeleteShader(geom);
-
-    // Check the link status
-    GLint status;
-    glGetProgramiv(program, GL_LINK_STATUS, &status);
-
-    // Link error
-    if (status == GL_FALSE) {
-        // Get the log length
-        GLint length;
-        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
-
-        // Print the information log if is not empty
-        if (length > 0) {
-            // Get the information log data
-            GLchar *log = new GLchar[length];
-            glGetProgramInfoLog(program, length, nullptr, log);
-
-            // Print the information log data
-            std::cerr << log;
-            delete[] log;
-        }
-
-        // Print compilation error message
-        std::cerr << "error: could not link the shader program object" << std::endl;
-
-        // Delete the program and reset it
-        glDeleteProgram(program);
-        program = GL_FALSE;
-    }
+    // Build the active variant, the other variants are built on demand
+    setVariant(variant_defines);
 }
 
 // Link a new program using the given shaders source paths
@@ -387,6 +800,72 @@ void GLSLProgram::link(const std::string &vert, const std::string &geom, const s
     link();
 }
 
+// Start building a variant in background without activating it
+void GLSLProgram::prepareVariant(const std::set<std::string> &defines) {
+    if (variant_stock.find(GLSLProgram::getVariantKey(defines)) == variant_stock.end()) {
+        build(defines);
+    }
+}
+
+
+// Start a reload from disk keeping the current program until the new one is linked
+void GLSLProgram::reload() {
+    // Restart any pending reload
+    cancelReload();
+
+    // Read the shaders sources, the current program is kept on errors
+    std::string vert;
+    std::string geom;
+    std::string frag;
+    if (vert_path.empty() || frag_path.empty() || !GLSLProgram::readShaderFile(vert_path, vert) || !GLSLProgram::readShaderFile(frag_path, frag) || (!geom_path.empty() && !GLSLProgram::readShaderFile(geom_path, geom))) {
+        GLSLProgram::log("error: could not read the shader sources of `" + frag_path + "', keeping the current program\n");
+        return;
+    }
+
+    // Start building the active variant with the new sources
+    build(reload_variant, variant_defines, vert, geom, frag);
+    reload_vert_source = vert;
+    reload_geom_source = geom;
+    reload_frag_source = frag;
+    reloading = true;
+}
+
+// Swap in the reloaded program once it has been linked, returns true if swapped
+bool GLSLProgram::update() {
+    // Nothing pending or still compiling
+    if (!reloading || !isComplete(reload_variant)) {
+        return false;
+    }
+
+    // Check the link, the current program is kept on errors
+    reloading = false;
+    finalize(reload_variant);
+    if (reload_variant.program == GL_FALSE) {
+        GLSLProgram::log("error: reload of `" + frag_path + "' failed, keeping the current program\n");
+        deleteVariant(reload_variant);
+        return false;
+    }
+
+    // Replace the variants with the reloaded one, the other variants are built on demand
+    clearVariants();
+    vert_source.swap(reload_vert_source);
+    geom_source.swap(reload_geom_source);
+    frag_source.swap(reload_frag_source);
+    reload_vert_source.clear();
+    reload_geom_source.clear();
+    reload_frag_source.clear();
+
+    // Activate the reloaded variant
+    GLSLProgram::Variant &target = variant_stock[GLSLProgram::getVariantKey(variant_defines)];
+    target = reload_variant;
+    reload_variant.program = GL_FALSE;
+    reload_variant.location_stock.clear();
+    variant = &target;
+    program = target.program;
+
+    return true;
+}
+
 // Use the program
 void GLSLProgram::use() const {
     // Update the current program if is not the current program
@@ -401,7 +880,47 @@ void GLSLProgram::use() const {
 
 // GLSL program destructor
 GLSLProgram::~GLSLProgram() {
-    if (program != GL_FALSE) {
-        glDeleteProgram(program);
+    cancelReload();
+    clearVariants();
+}
+
+
+// Static getters
+
+// Get the binary cache directory path
+std::string GLSLProgram::getCachePath() {
+    return GLSLProgram::cache_path;
+}
+
+
+// Get the log file path
+std::string GLSLProgram::getLogPath() {
+    return GLSLProgram::log_path;
+}
+
+// Get the parallel shader compile support status of the current context
+bool GLSLProgram::isParallelCompileSupported() {
+    return (GLAD_GL_KHR_parallel_shader_compile != 0) || (GLAD_GL_ARB_parallel_shader_compile != 0);
+}
+
+
+// Static setters
+
+// Set the binary cache directory path, an empty path disables the cache
+void GLSLProgram::setCachePath(const std::string &path) {
+    GLSLProgram::cache_path = path;
+
+    // Create the directory if does not exist
+    if (!path.empty()) {
+#if defined(_WIN32)
+        _mkdir(path.c_str());
+#else
+        mkdir(path.c_str(), 0755);
+#endif
     }
+}
+
+// Set the log file path, an empty path disables the log file
+void GLSLProgram::setLogPath(const std::string &path) {
+    GLSLProgram::log_path = path;
 }
\ No newline at end of file
@@ -10,16 +10,50 @@
 #include <glm/mat4x4.hpp>
 
 #include <string>
+#include <ostream>
 
 #include <map>
+#include <set>
 
 
 /** GLSL program */
 class GLSLProgram {
     private:
+        // Structures
+
+        /** Program variant compiled with a set of defines */
+        struct Variant {
+            /** Program object */
+            GLuint program;
+
+            /** Shader objects kept until the link is finalized */
+            GLuint shader[3];
+
+            /** Pending link status */
+            bool pending;
+
+
+            /** Binary cache file path */
+            std::string cache_file;
+
+            /** Uniform location stock */
+            std::map<std::string, GLint> location_stock;
+
+
+            /** Build start time in seconds */
+            double start;
+
+            /** Time spent by the link in milliseconds */
+            double link_time;
+
+            /** Loaded from the binary cache status */
+            bool binary_cached;
+        };
+
+
         // Attributes
 
-        /** Program object */
+        /** Program object of the active variant */
         GLuint program;
 
 
@@ -33,12 +67,45 @@ class GLSLProgram {
         std::string frag_path;
 
 
+        /** Vertex shader source */
+        std::string vert_source;
+
+        /** Geometry shader source */
+        std::string geom_source;
+
+        /** Fragment shader source */
+        std::string frag_source;
+
+
         /** Number of shaders */
         std::size_t shaders;
 
 
-        /** Uniform location stock */
-        std::map<std::string, GLint> location_stock;
+        /** Variants stock by defines key */
+        std::map<std::string, GLSLProgram::Variant> variant_stock;
+
+        /** Defines of the active variant */
+        std::set<std::string> variant_defines;
+
+        /** Active variant */
+        GLSLProgram::Variant *variant;
+
+
+        /** Reloaded vertex shader source */
+        std::string reload_vert_source;
+
+        /** Reloaded geometry shader source */
+        std::string reload_geom_source;
+
+        /** Reloaded fragment shader source */
+        std::string reload_frag_source;
+
+        /** Reloaded active variant */
+        GLSLProgram::Variant reload_variant;
+
+        /** Reloading status */
+        bool reloading;
+
 
         // Constructors
 
@@ -61,14 +128,73 @@ class GLSLProgram {
         static GLuint current_program;
 
 
+        /** Binary cache directory path */
+        static std::string cache_path;
+
+        /** Log file path */
+        static std::string log_path;
+
+
+        // Methods
+
+        /** Get the binary cache file path for the given sources */
+        std::string getCacheFile(const std::string &vert, const std::string &geom, const std::string &frag) const;
+
+        /** Load the variant program from the binary cache file */
+        bool loadBinary(GLSLProgram::Variant &target) const;
+
+        /** Store the variant program into the binary cache file */
+        void saveBinary(const GLSLProgram::Variant &target) const;
+
+
+        /** Start the build of the variant with the given defines and sources */
+        void build(GLSLProgram::Variant &target, const std::set<std::string> &defines, const std::string &vert, const std::string &geom, const std::string &frag) const;
+
+        /** Start the build of the variant with the given defines */
+        GLSLProgram::Variant &build(const std::set<std::string> &defines);
+
+        /** Get the link completion status of the variant without blocking */
+        bool isComplete(const GLSLProgram::Variant &target) const;
+
+        /** Wait and check the link of the variant */
+        void finalize(GLSLProgram::Variant &target) const;
+
+        /** Delete the objects of the variant */
+        void deleteVariant(GLSLProgram::Variant &target) const;
+
+        /** Delete all the variants */
+        void clearVariants();
+
+        /** Discard the pending reload */
+        void cancelReload();
+
+
         // Static methods
 
-        /** Compile a shader from the given source path and type */
-        static GLuint compileShaderFile(const std::string &path, const GLenum &type);
+        /** Read a shader source from the given path */
+        static bool readShaderFile(const std::string &path, std::string &source);
 
-        /** Compile a shader with the given source and type */
+        /** Insert the defines after the version directive of the source */
+        static std::string injectDefines(const std::string &source, const std::set<std::string> &defines);
+
+        /** Get the key of a set of defines */
+        static std::string getVariantKey(const std::set<std::string> &defines);
+
+
+        /** Compile a shader with the given source and type without waiting the result */
         static GLuint compileShaderSource(const GLchar *const &source, const GLenum &type);
 
+        /** Write the information log of the shader if the compilation failed */
+        static bool checkShader(const GLuint &shader, std::ostream &output);
+
+
+        /** Write a message to the error output and the log file */
+        static void log(const std::string &message);
+
+
+        /** Get the binary cache support status of the current context */
+        static bool isBinaryCacheSupported();
+
 
     public:
         // Constructors
@@ -99,6 +225,27 @@ class GLSLProgram {
         std::size_t getNumberOfShaders() const;
 
 
+        /** Get the time spent by the last link in milliseconds */
+        double getLinkTime() const;
+
+        /** Get the loaded from the binary cache status of the last link */
+        bool isBinaryCached() const;
+
+
+        /** Get the defines of the active variant */
+        std::set<std::string> getVariant() const;
+
+        /** Get the ready status of the variant with the given defines */
+        bool isVariantReady(const std::set<std::string> &defines) const;
+
+        /** Get the number of built variants */
+        std::size_t getNumberOfVariants() const;
+
+
+        /** Get the reloading status */
+        bool isReloading() const;
+
+
         // Setters
 
         /** Set the value for an integer uniform */
@@ -126,6 +273,10 @@ class GLSLProgram {
         void setUniform(const GLchar *name, const glm::mat4 &matrix);
 
 
+        /** Set the active variant, building it if has not been used before */
+        void setVariant(const std::set<std::string> &defines);
+
+
         // Methods
 
         /** Link a new pogram using the current shaders source paths */
@@ -137,6 +288,16 @@ class GLSLProgram {
         /** Link a new program using the given shaders source paths */
         void link(const std::string &vert, const std::string &geom, const std::string &frag);
 
+        /** Start building a variant in background without activating it */
+        void prepareVariant(const std::set<std::string> &defines);
+
+
+        /** Start a reload from disk keeping the current program until the new one is linked */
+        void reload();
+
+        /** Swap in the reloaded program once it has been linked, returns true if swapped */
+        bool update();
+
         /** Use the program */
         void use() const;
 
@@ -146,6 +307,26 @@ class GLSLProgram {
         /** GLSL program destructor */
         virtual ~GLSLProgram();
 
+
+        // Static getters
+
+        /** Get the binary cache directory path */
+        static std::string getCachePath();
+
+        /** Get the log file path */
+        static std::string getLogPath();
+
+        /** Get the parallel shader compile support status of the current context */
+        static bool isParallelCompileSupported();
+
+
+        // Static setters
+
+        /** Set the binary cache directory path, an empty path disables the cache */
+        static void setCachePath(const std::string &path);
+
+        /** Set the log file path, an empty path disables the log file */
+        static void setLogPath(const std::string &path);
 };
 
 #endif // __GLSL_PROGRAM_HPP_
\ No newline at end of file
@@ -1,6 +1,15 @@
 #include "interactivescene.hpp"
 
+#include "../../profiler/profilerscope.hpp"
+#include "../../profiler/tracer.hpp"
+
 #include <iostream>
+#include <iomanip>
+#include <sstream>
+
+#include <algorithm>
+#include <vector>
+
 
 // Private statics methods
 
@@ -108,6 +117,7 @@ void InteractiveScene::keyCallback(GLFWwindow *window, int key, int, int action,
         case GLFW_KEY_I:
             if (pressed) {
                 scene->showing_gui = !scene->showing_gui;
+                scene->requestRedraw();
             }
             return;
 
@@ -118,6 +128,126 @@ void InteractiveScene::keyCallback(GLFWwindow *window, int key, int, int action,
             }
             return;
 
+        // Cycle the rendering technique
+        case GLFW_KEY_R:
+            if (pressed) {
+                scene->volume->setTechnique(static_cast<Volume::Technique>((scene->volume->getTechnique() + 1) % (Volume::FOURIER + 1)));
+            }
+            return;
+
+        // Raise or lower the isovalue, faster with shift
+        case GLFW_KEY_PAGE_UP:
+        case GLFW_KEY_PAGE_DOWN:
+            if (pressed) {
+                const float delta = Camera::isBoosted() ? 1.0F / 32.0F : 1.0F / 256.0F;
+                scene->volume->setIsovalue(scene->volume->getIsovalue() + (key == GLFW_KEY_PAGE_UP ? delta : -delta));
+            }
+            return;
+
+        // Cycle the composition mode through the intensity projections
+        case GLFW_KEY_M:
+            if (pressed) {
+                scene->volume->setComposition(static_cast<Volume::Composition>((scene->volume->getComposition() + 1) % (Volume::AVERAGE + 1)));
+            }
+            return;
+
+        // Cycle the sampling filter of the CPU ray caster
+        case GLFW_KEY_F:
+            if (pressed) {
+                scene->volume->setFilter(static_cast<Volume::Filter>((scene->volume->getFilter() + 1) % (Volume::TRICUBIC + 1)));
+            }
+            return;
+
+        // Toggle the shading
+        case GLFW_KEY_L:
+            if (pressed) {
+                scene->volume->setShading(!scene->volume->isShading());
+            }
+            return;
+
+        // Cycle the volume pass resolution between full, half and quarter
+        case GLFW_KEY_V:
+            if (pressed) {
+                scene->setVolumeScale(scene->getVolumeScale() > 0.75F ? 0.5F : (scene->getVolumeScale() > 0.375F ? 0.25F : 1.0F));
+            }
+            return;
+
+        // Toggle the accumulation
+        case GLFW_KEY_J:
+            if (pressed) {
+                scene->setAccumulation(!scene->isAccumulationEnabled());
+            }
+            return;
+
+        // Toggle the adaptive quality
+        case GLFW_KEY_Q:
+            if (pressed) {
+                scene->quality->setEnabled(!scene->quality->isEnabled());
+            }
+            return;
+
+        // Toggle the quality metrics
+        case GLFW_KEY_F3:
+            if (pressed) {
+                scene->showing_metrics = !scene->showing_metrics;
+                glfwSetWindowTitle(window, scene->title.c_str());
+                scene->updateMetrics();
+            }
+            return;
+
+        // Toggle the profiler overlay
+        case GLFW_KEY_F4:
+            if (pressed) {
+                scene->showing_profiler = !scene->showing_profiler;
+                glfwSetWindowTitle(window, scene->title.c_str());
+                scene->updateMetrics();
+                scene->requestRedraw();
+            }
+            return;
+
+        // Dump the trace events
+        case GLFW_KEY_F8:
+            if (pressed) {
+                Tracer::dump();
+            }
+            return;
+
+        // Toggle the session recording
+        case GLFW_KEY_F9:
+            if (pressed) {
+                if (scene->isRecording()) {
+                    scene->stopRecording();
+                }
+                else {
+                    scene->startRecording();
+                }
+            }
+            return;
+
+        // Toggle the frame capture
+        case GLFW_KEY_F10:
+            if (pressed) {
+                if (scene->isCapturing()) {
+                    scene->stopCapture();
+                }
+                else if (!scene->capture_path.empty()) {
+                    scene->startCapture(scene->capture_path);
+                }
+            }
+            return;
+
+        // Add a copy of the dataset beside the last volume, remove the last added volume with shift
+        case GLFW_KEY_O:
+            if (pressed) {
+                if (Camera::isBoosted()) {
+                    scene->removeOverlay();
+                }
+                else {
+                    scene->addOverlay(scene->volume->getPath(), glm::vec3(0.5F, 0.0F, 0.0F));
+                }
+            }
+            return;
+
         // Toggle the camera boost
         case GLFW_KEY_LEFT_SHIFT:
         case GLFW_KEY_RIGHT_SHIFT:
@@ -132,12 +262,15 @@ void InteractiveScene::keyCallback(GLFWwindow *window, int key, int, int action,
             }
             return;
 
-        // Reload program
+        // Reload programs in background
         case GLFW_KEY_F6:
             if (pressed) {
-                scene->program->link();
-                scene->program_gui->link();
-                scene->program_func->link();
+                scene->program->reload();
+                scene->program_upsample->reload();
+                scene->program_accumulate->reload();
+                scene->program_mesh->reload();
+                scene->program_gui->reload();
+                scene->program_func->reload();
             }
     }
 }
@@ -260,6 +393,9 @@ void InteractiveScene::drawGUI() {
         return;
     }
 
+    // Time the phase
+    const ProfilerScope scope("gui");
+
     // Disable the depth test and blend
     glDisable(GL_DEPTH_TEST);
     glDisable(GL_BLEND);
@@ -351,6 +487,61 @@ void InteractiveScene::drawGUI() {
 }
 
 
+// Draw the profiler graphs of the last frames
+void InteractiveScene::drawProfiler() {
+    // Check the showing profiler status
+    if (!showing_profiler) {
+        return;
+    }
+
+    // Time the phase
+    const ProfilerScope scope("overlay");
+
+    // Graphed phases and their colors
+    static const std::string phases[] = {"frame", "scene", "volume", "gui"};
+    static const glm::vec3 colors[] = {glm::vec3(1.0F), glm::vec3(1.0F, 1.0F, 0.0F), glm::vec3(1.0F, 0.5F, 0.0F), glm::vec3(0.0F, 1.0F, 1.0F)};
+
+    // The graph covers the top of the window up to twice the target frame time, the budget is drawn in the middle
+    const GLfloat top = 1.0F;
+    const GLfloat range = 2.0F * height_64;
+    const double scale = 1.0 / (2.0 * quality->getTargetTime());
+    const GLfloat step = 2.0F / static_cast<GLfloat>(Profiler::WINDOW - 1U);
+
+    // Budget line followed by the graphs of the phases, the newest frame on the right
+    std::vector<GLfloat> data = {-1.0F, top - 0.5F * range, 1.0F, top - 0.5F * range};
+    std::vector<GLsizei> sizes = {2};
+    for (const std::string &phase : phases) {
+        const std::vector<double> history = profiler->getHistory(phase);
+        const GLfloat start = 1.0F - step * static_cast<GLfloat>(history.size());
+        for (std::size_t i = 0U; i < history.size(); i++) {
+            data.push_back(start + step * static_cast<GLfloat>(i + 1U));
+            data.push_back(top - range + range * static_cast<GLfloat>(std::min(1.0, history[i] * scale)));
+        }
+        sizes.push_back(static_cast<GLsizei>(history.size()));
+    }
+
+    // Update the graphs data
+    glBindVertexArray(vao_profiler);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_profiler);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(data.size() * sizeof(GLfloat)), data.data(), GL_STREAM_DRAW);
+
+    // Draw the budget and the graphs
+    glDisable(GL_DEPTH_TEST);
+    program_func->use();
+    program_func->setUniform("u_color", glm::vec3(0.5F));
+    glDrawArrays(GL_LINES, 0, sizes[0]);
+    GLint first = sizes[0];
+    for (std::size_t i = 1U; i < sizes.size(); i++) {
+        program_func->setUniform("u_color", colors[i - 1U]);
+        glDrawArrays(GL_LINE_STRIP, first, sizes[i]);
+        first += sizes[i];
+    }
+
+    // Unbind the profiler vertex array object
+    glBindVertexArray(GL_FALSE);
+    glEnable(GL_DEPTH_TEST);
+}
+
 // updateFocus
 void InteractiveScene::updateFocus(const glm::ivec2 &pos) {
     // Variables
@@ -420,13 +611,20 @@ void InteractiveScene::updateFocus(const glm::ivec2 &pos) {
 
 // Process keyboard input
 void InteractiveScene::processKeyboardInput() {
+    // Move by the time since the last movement, the first step of a movement takes the default time
+    const double time = glfwGetTime();
+    const double step = travell_time < 0.0 ? 1.0 / 30.0 : std::min(time - travell_time, 0.1);
+    const unsigned long long int revision = camera->getRevision();
+
     // Camera movement
-    if (glfwGetKey(window, GLFW_KEY_W))                                           camera->travell(Camera::FRONT);
-    if (glfwGetKey(window, GLFW_KEY_S))                                           camera->travell(Camera::BACK);
-    if (glfwGetKey(window, GLFW_KEY_A)     || glfwGetKey(window, GLFW_KEY_LEFT))  camera->travell(Camera::LEFT);
-    if (glfwGetKey(window, GLFW_KEY_D)     || glfwGetKey(window, GLFW_KEY_RIGHT)) camera->travell(Camera::RIGHT);
-    if (glfwGetKey(window, GLFW_KEY_SPACE) || glfwGetKey(window, GLFW_KEY_UP))    camera->travell(Camera::UP);
-    if (glfwGetKey(window, GLFW_KEY_C)     || glfwGetKey(window, GLFW_KEY_DOWN))  camera->travell(Camera::DOWN);
+    if (glfwGetKey(window, GLFW_KEY_W))                                           camera->travell(Camera::FRONT, step);
+    if (glfwGetKey(window, GLFW_KEY_S))                                           camera->travell(Camera::BACK, step);
+    if (glfwGetKey(window, GLFW_KEY_A)     || glfwGetKey(window, GLFW_KEY_LEFT))  camera->travell(Camera::LEFT, step);
+    if (glfwGetKey(window, GLFW_KEY_D)     || glfwGetKey(window, GLFW_KEY_RIGHT)) camera->travell(Camera::RIGHT, step);
+    if (glfwGetKey(window, GLFW_KEY_SPACE) || glfwGetKey(window, GLFW_KEY_UP))    camera->travell(Camera::UP, step);
+    if (glfwGetKey(window, GLFW_KEY_C)     || glfwGetKey(window, GLFW_KEY_DOWN))  camera->travell(Camera::DOWN, step);
+
+    travell_time = camera->getRevision() != revision ? time : -1.0;
 }
 
 // Process mouse input
@@ -490,6 +688,65 @@ void InteractiveScene::GUIInteraction(const float &xpos, const int &button) {
 }
 
 
+// Reload the programs with changed shader sources and swap in the linked ones
+void InteractiveScene::updatePrograms() {
+    // Programs to update
+    GLSLProgram *const programs[] = {program, program_upsample, program_accumulate, program_mesh, program_gui, program_func};
+    static const GLenum types[] = {GL_VERTEX_SHADER, GL_GEOMETRY_SHADER, GL_FRAGMENT_SHADER};
+
+    // Watch the shader sources, the programs could be linked after the scene creation
+    const std::set<std::string> changed = watcher->takeChanged();
+    for (GLSLProgram *const target : programs) {
+        bool reload = false;
+        for (const GLenum &type : types) {
+            const std::string path = target->getShaderPath(type);
+            if (watcher->isValid() && !path.empty() && !watcher->isWatching(path)) {
+                watcher->watch(path);
+            }
+            reload = reload || (changed.count(path) != 0U);
+        }
+
+        // Start the background reload of the changed program
+        if (reload) {
+            std::cout << "info: shader source changed, reloading `" << target->getShaderPath(GL_FRAGMENT_SHADER) << "'" << std::endl;
+            target->reload();
+        }
+    }
+
+    // Swap in the linked programs, the previous ones are used until then
+    bool swapped = false;
+    for (GLSLProgram *const target : programs) {
+        swapped = target->update() || swapped;
+    }
+
+    if (swapped) {
+        printLinkReport("hot reload");
+        requestRedraw();
+    }
+}
+
+
+// Show the quality metrics and the profiler percentiles in the window title
+void InteractiveScene::updateMetrics() const {
+    // Check the showing statuses
+    if (!showing_metrics && !showing_profiler) {
+        return;
+    }
+
+    // Append the enabled metrics
+    std::string metrics = title;
+    if (showing_metrics) {
+        metrics += " - " + quality->getMetrics();
+    }
+
+    if (showing_profiler) {
+        metrics += " - " + profiler->getSummary({"frame", "scene", "gui"});
+    }
+
+    glfwSetWindowTitle(window, metrics.c_str());
+}
+
+
 // Constructor
 
 // Interactive scene constructor
@@ -499,6 +756,8 @@ InteractiveScene::InteractiveScene(const std::string &title, const int &width, c
 
     // Showing GUI status
     showing_gui(true),
+    showing_metrics(false),
+    showing_profiler(false),
     focus(InteractiveScene::VOLUME),
 
     // Buffers
@@ -506,13 +765,22 @@ InteractiveScene::InteractiveScene(const std::string &title, const int &width, c
     vao_func(GL_FALSE),
     vbo_gui(GL_FALSE),
     vbo_func(GL_FALSE),
+    vao_profiler(GL_FALSE),
+    vbo_profiler(GL_FALSE),
 
     // GLSL programs
     program_gui(new GLSLProgram()),
     program_func(new GLSLProgram()),
 
     // Mouse
-    mouse(new Mouse(width, height)) {
+    mouse(new Mouse(width, height)),
+
+    // Shader watcher
+    watcher(new ShaderWatcher()),
+
+    // Session recording
+    recorder(nullptr),
+    travell_time(-1.0) {
     // Set the user pointer to this scene and setup callbacks
     if (window != nullptr) {
         glfwSetWindowUserPointer(window, this);
@@ -523,6 +791,12 @@ InteractiveScene::InteractiveScene(const std::string &title, const int &width, c
         glfwSetKeyCallback(window, InteractiveScene::keyCallback);
     }
 
+    // Wake the main loop when a shader source changes
+    watcher->setWakeCallback(glfwPostEmptyEvent);
+
+    // Keep drawing with the active program variant while a new one links
+    asynchronous_variants = true;
+
     // GUI vertex array object
     glGenVertexArrays(1, &vao_gui);
     glBindVertexArray(vao_gui);
@@ -564,6 +838,22 @@ InteractiveScene::InteractiveScene(const std::string &title, const int &width, c
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, nullptr);
 
 
+    // Profiler graphs vertex array object
+    glGenVertexArrays(1, &vao_profiler);
+    glBindVertexArray(vao_profiler);
+
+    // Profiler graphs vertex buffer object, filled on every draw
+    glGenBuffers(1, &vbo_profiler);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_profiler);
+
+    // Vertex attribute
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, nullptr);
+
+    // Unbind vertex array object
+    glBindVertexArray(GL_FALSE);
+
+
     // Update the gui data
     updateGUI();
 }
@@ -592,17 +882,114 @@ Mouse *InteractiveScene::getMouse() const {
     return mouse;
 }
 
+// Get the session recording status
+bool InteractiveScene::isRecording() const {
+    return recorder != nullptr;
+}
+
 
 // Setters
 
-// Set the showing GUI status
+// Set the showing GUI status, the next frame shows the change without waiting for another event
 void InteractiveScene::showGUI(const bool &status) {
-    showing_gui = status;
+    if (showing_gui != status) {
+        showing_gui = status;
+        requestRedraw();
+    }
+}
+
+// Set the session log path used by the recording toggle
+void InteractiveScene::setRecordingPath(const std::string &path) {
+    recording_path = path;
+}
+
+// Set the image pattern used by the frame capture toggle
+void InteractiveScene::setCapturePath(const std::string &pattern) {
+    capture_path = pattern;
 }
 
 
 // Methods
 
+// Start recording the session
+bool InteractiveScene::startRecording() {
+    // Check the path
+    if (recording_path.empty()) {
+        std::cerr << "error: the session recording path has not been set" << std::endl;
+        return false;
+    }
+
+    // Replace the current log
+    delete recorder;
+    recorder = new SessionRecorder(recording_path);
+    if (!recorder->isOpen()) {
+        delete recorder;
+        recorder = nullptr;
+        return false;
+    }
+
+    // Write the initial state
+    recorder->capture(this);
+    return true;
+}
+
+// Stop recording the session
+void InteractiveScene::stopRecording() {
+    delete recorder;
+    recorder = nullptr;
+}
+
+
+// Add a volume of the dataset beside the last volume
+Volume *InteractiveScene::addOverlay(const std::string &overlay_path, const glm::vec3 &offset) {
+    const glm::vec3 position = volumes.back()->getPosition() + offset;
+    const glm::uvec3 resolution = volume->getResolution();
+
+    // Open the dataset like the first volume
+    Volume *const added = addVolume();
+    added->setPath(overlay_path, volume->getFormat(), resolution.x, resolution.y, resolution.z);
+    if (!added->isOpen()) {
+        std::cerr << "error: cannot open the overlay `" << overlay_path << "'" << std::endl;
+        removeVolume(added);
+        return nullptr;
+    }
+
+    // Place it and copy the classification of the first volume
+    added->setPosition(position);
+    added->setFilter(volume->getFilter());
+    added->getTransferFunction()->setNodes(volume->getTransferFunction()->getNodes());
+    return added;
+}
+
+// Remove the last added volume
+void InteractiveScene::removeOverlay() {
+    if (volumes.size() > 1U) {
+        removeVolume(volumes.back());
+    }
+}
+
+
+// Print the link time report of the programs
+void InteractiveScene::printLinkReport(const std::string &stage) const {
+    // Programs to report
+    const GLSLProgram *const programs[] = {program, program_upsample, program_accumulate, program_mesh, program_gui, program_func};
+
+    // Format the link time and source of every program without changing the console format
+    double total = 0.0;
+    std::ostringstream report_text;
+    report_text << std::fixed << std::setprecision(3);
+    for (const GLSLProgram *const report : programs) {
+        total += report->getLinkTime();
+        report_text << "  " << std::setw(40) << std::left << report->getShaderPath(GL_FRAGMENT_SHADER) << std::right
+                    << std::setw(10) << report->getLinkTime() << " ms"
+                    << (report->isValid() ? (report->isBinaryCached() ? "  (binary cache)" : "  (compiled)") : "  (failed)") << '\n';
+    }
+    report_text << "  " << std::setw(40) << std::left << "total" << std::right << std::setw(10) << total << " ms";
+
+    std::cout << "info: " << stage << " program link report" << std::endl;
+    std::cout << report_text.str() << std::endl;
+}
+
 // Render main loop
 void InteractiveScene::mainLoop() {
     // Check the window status
@@ -618,19 +1005,43 @@ void InteractiveScene::mainLoop() {
 
     // The rendering main loop
     while (glfwWindowShouldClose(window) == GLFW_FALSE) {
-        // Draw the scene and GUI
-        drawScene();
-        drawGUI();
+        // Swap in the reloaded programs
+        updatePrograms();
 
-        // Process the keyboard input
+        // Process the keyboard input, held keys keep the camera moving
+        const unsigned long long int camera_revision = camera->getRevision();
         processKeyboardInput();
-
-        // Poll events and swap buffers
-        glfwPollEvents();
+        const bool moving = camera->getRevision() != camera_revision;
+
+        // Log the states changed by the input
+        if (recorder != nullptr) {
+            recorder->capture(this);
+        }
+
+        // Draw the scene and GUI only if something changed
+        if (isDirty()) {
+            beginFrame();
+            drawScene();
+            drawGUI();
+            drawProfiler();
+            endFrame();
+            updateMetrics();
+        }
+
+        // Present the last drawn frame
+        present();
         glfwSwapBuffers(window);
 
-        // Count frame
-        frames++;
+        // Poll events while animating, otherwise sleep until the next event
+        if (moving || isDirty()) {
+            glfwPollEvents();
+        }
+        else if (quality->isRefining() || isVariantPending() || program->isReloading() || program_upsample->isReloading() || program_accumulate->isReloading() || program_mesh->isReloading() || program_gui->isReloading() || program_func->isReloading()) {
+            glfwWaitEventsTimeout(Scene::PENDING_WAIT_TIMEOUT);
+        }
+        else {
+            glfwWaitEvents();
+        }
     }
 }
 
@@ -642,10 +1053,12 @@ InteractiveScene::~InteractiveScene() {
     // Buffers
     glDeleteBuffers(1, &vbo_gui);
     glDeleteBuffers(1, &vbo_func);
+    glDeleteBuffers(1, &vbo_profiler);
 
     // Bertex arrays
     glDeleteVertexArrays(1, &vao_gui);
     glDeleteVertexArrays(1, &vao_func);
+    glDeleteVertexArrays(1, &vao_profiler);
 
     // Programs
     delete program_gui;
@@ -653,4 +1066,10 @@ InteractiveScene::~InteractiveScene() {
 
     // Delete the mouse
     delete mouse;
+
+    // Stop the shader watcher
+    delete watcher;
+
+    // Close the session log
+    delete recorder;
 }
\ No newline at end of file
@@ -2,8 +2,10 @@
 #define __INTERACTIVE_SCENE_HPP_
 
 #include "../scene.hpp"
+#include "../sessionrecorder.hpp"
 
 #include "mouse.hpp"
+#include "shaderwatcher.hpp"
 
 
 class InteractiveScene : public Scene {
@@ -28,6 +30,12 @@ class InteractiveScene : public Scene {
         /** Showing GUI status */
         bool showing_gui;
 
+        /** Showing metrics status */
+        bool showing_metrics;
+
+        /** Showing profiler overlay status */
+        bool showing_profiler;
+
         /** Focus */
         InteractiveScene::Focus focus;
 
@@ -78,6 +86,12 @@ class InteractiveScene : public Scene {
         /** Vertex buffer object for the transfer function */
         GLuint vbo_func;
 
+        /** Vertex array object for the profiler graphs */
+        GLuint vao_profiler;
+
+        /** Vertex buffer object for the profiler graphs */
+        GLuint vbo_profiler;
+
 
         /** GUI program */
         GLSLProgram *program_gui;
@@ -88,6 +102,22 @@ class InteractiveScene : public Scene {
         /** Mouse */
         Mouse *const mouse;
 
+        /** Shader source files watcher */
+        ShaderWatcher *const watcher;
+
+
+        /** Session recorder, null if not recording */
+        SessionRecorder *recorder;
+
+        /** Session log path used by the recording toggle */
+        std::string recording_path;
+
+        /** Image pattern used by the frame capture toggle */
+        std::string capture_path;
+
+        /** Time of the last camera movement by the keyboard, negative if it was not moving */
+        double travell_time;
+
 
         // Constructors
 
@@ -112,6 +142,9 @@ class InteractiveScene : public Scene {
         /** Draw the GUI */
         void drawGUI();
 
+        /** Draw the profiler graphs of the last frames */
+        void drawProfiler();
+
 
         /** updateFocus */
         void updateFocus(const glm::ivec2 &pos);
@@ -124,6 +157,13 @@ class InteractiveScene : public Scene {
         void GUIInteraction(const float &xpos, const int &button);
 
 
+        /** Reload the programs with changed shader sources and swap in the linked ones */
+        void updatePrograms();
+
+        /** Show the quality metrics and the profiler percentiles in the window title */
+        void updateMetrics() const;
+
+
         // Static methods
 
         /** GLFW framebuffer size callback */
@@ -163,15 +203,41 @@ class InteractiveScene : public Scene {
         /** Get the mouse */
         Mouse *getMouse() const;
 
+        /** Get the session recording status */
+        bool isRecording() const;
+
 
         // Setters
 
-        /** Set the showing GUI status */
+        /** Set the showing GUI status and request a redraw if it changed */
         void showGUI(const bool &status);
 
+        /** Set the session log path used by the recording toggle */
+        void setRecordingPath(const std::string &path);
+
+        /** Set the image pattern used by the frame capture toggle */
+        void setCapturePath(const std::string &pattern);
+
 
         // Methods
 
+        /** Print the link time report of the programs */
+        void printLinkReport(const std::string &stage) const;
+
+        /** Start recording the session to the recording path, replacing the log */
+        bool startRecording();
+
+        /** Stop recording the session */
+        void stopRecording();
+
+
+        /** Add a volume of the dataset beside the last volume shifted by the offset, with the format, resolution, transfer function and filter of the first volume, returns null if it cannot be opened */
+        Volume *addOverlay(const std::string &overlay_path, const glm::vec3 &offset);
+
+        /** Remove the last added volume */
+        void removeOverlay();
+
+
         /** Render main loop */
         void mainLoop();
 
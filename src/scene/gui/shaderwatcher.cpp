@@ -0,0 +1,207 @@
+#include "shaderwatcher.hpp"
+
+#include "../../dirsep.h"
+#include "../../profiler/profilerscope.hpp"
+#include "../../profiler/tracer.hpp"
+
+#include <iostream>
+
+#if defined(__linux__)
+    #include <sys/inotify.h>
+    #include <poll.h>
+    #include <unistd.h>
+    #include <limits.h>
+#endif
+
+
+// Private methods
+
+// Read the notifications until the watcher is stopped
+void ShaderWatcher::run() {
+    Tracer::setThreadName("shader watcher");
+
+#if defined(__linux__)
+    // Notification and stop descriptors
+    struct pollfd fds[2];
+    fds[0].fd = notify_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = stop_fd[0];
+    fds[1].events = POLLIN;
+
+    // Events buffer aligned for the event structure
+    alignas(struct inotify_event) char buffer[4096 + sizeof(struct inotify_event) + NAME_MAX + 1];
+
+    for (;;) {
+        // Wait for notifications or the stop signal
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        if (poll(fds, 2, -1) < 0) {
+            continue;
+        }
+
+        // Stop requested
+        if (fds[1].revents != 0) {
+            return;
+        }
+
+        // Read the events
+        const ssize_t length = read(notify_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            continue;
+        }
+
+        // Collect the watched paths that have been written
+        bool modified = false;
+        void (*callback)() = nullptr;
+        {
+            const ProfilerScope scope("shader_notify");
+            std::lock_guard<std::mutex> lock(mutex);
+            callback = wake;
+            for (ssize_t offset = 0; offset < length;) {
+                const struct inotify_event *const event = reinterpret_cast<const struct inotify_event *>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+
+                // Build the full path from the directory
+                const std::map<int, std::string>::const_iterator directory = directories.find(event->wd);
+                if ((event->len == 0U) || (directory == directories.end())) {
+                    continue;
+                }
+
+                const std::string path = directory->second + event->name;
+                if (paths.count(path) != 0U) {
+                    changed.insert(path);
+                    modified = true;
+                }
+            }
+        }
+
+        // Wake the render loop
+        if (modified && (callback != nullptr)) {
+            callback();
+        }
+    }
+#endif
+}
+
+
+// Constructors
+
+// Shader watcher constructor
+ShaderWatcher::ShaderWatcher() :
+    // File descriptors
+    notify_fd(-1),
+    stop_fd{-1, -1},
+
+    // Callback
+    wake(nullptr) {
+#if defined(__linux__)
+    // Create the notification instance
+    notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notify_fd < 0) {
+        std::cerr << "warning: could not create the shader file watcher, automatic reload disabled" << std::endl;
+        return;
+    }
+
+    // Create the stop pipe
+    if (pipe(stop_fd) != 0) {
+        std::cerr << "warning: could not create the shader file watcher stop pipe, automatic reload disabled" << std::endl;
+        close(notify_fd);
+        notify_fd = -1;
+        return;
+    }
+
+    // Start the watcher thread
+    worker = std::thread(&ShaderWatcher::run, this);
+#else
+    std::cerr << "warning: shader file watching is not available on this platform, automatic reload disabled" << std::endl;
+#endif
+}
+
+
+// Getters
+
+// Get the valid status
+bool ShaderWatcher::isValid() const {
+    return notify_fd >= 0;
+}
+
+// Get the watched status of the given path
+bool ShaderWatcher::isWatching(const std::string &path) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return paths.count(path) != 0U;
+}
+
+
+// Setters
+
+// Set the wake callback called from the watcher thread after a change
+void ShaderWatcher::setWakeCallback(void (*callback)()) {
+    std::lock_guard<std::mutex> lock(mutex);
+    wake = callback;
+}
+
+
+// Methods
+
+// Watch the given file path
+bool ShaderWatcher::watch(const std::string &path) {
+    // Check the watcher status
+    if (!isValid() || path.empty()) {
+        return false;
+    }
+
+#if defined(__linux__)
+    // Watch the directory, editors usually replace the file instead of writing it
+    const std::string::size_type separator = path.find_last_of(DIR_SEP);
+    const std::string directory = separator == std::string::npos ? std::string(".") + DIR_SEP : path.substr(0U, separator + 1U);
+    const std::string file = separator == std::string::npos ? path : path.substr(separator + 1U);
+    const int wd = inotify_add_watch(notify_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0) {
+        std::cerr << "warning: could not watch the shader directory `" << directory << "'" << std::endl;
+        return false;
+    }
+
+    // Register the path, the same directory shares the watch descriptor
+    std::lock_guard<std::mutex> lock(mutex);
+    directories[wd] = directory;
+    paths.insert(directory + file);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Take the changed file paths since the last call
+std::set<std::string> ShaderWatcher::takeChanged() {
+    std::set<std::string> result;
+    std::lock_guard<std::mutex> lock(mutex);
+    result.swap(changed);
+    return result;
+}
+
+
+// Destructor
+
+// Shader watcher destructor
+ShaderWatcher::~ShaderWatcher() {
+#if defined(__linux__)
+    // Stop and join the watcher thread
+    if (worker.joinable()) {
+        const char stop = 0;
+        if (write(stop_fd[1], &stop, 1) != 1) {
+            std::cerr << "warning: could not stop the shader file watcher" << std::endl;
+        }
+        worker.join();
+    }
+
+    // Close the descriptors
+    if (stop_fd[0] >= 0) {
+        close(stop_fd[0]);
+        close(stop_fd[1]);
+    }
+
+    if (notify_fd >= 0) {
+        close(notify_fd);
+    }
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef __SHADER_WATCHER_HPP_
+#define __SHADER_WATCHER_HPP_
+
+#include <string>
+
+#include <map>
+#include <set>
+
+#include <mutex>
+#include <thread>
+
+
+/** Background watcher of shader source files */
+class ShaderWatcher {
+    private:
+        // Attributes
+
+        /** Notification file descriptor */
+        int notify_fd;
+
+        /** Stop pipe file descriptors */
+        int stop_fd[2];
+
+
+        /** Watched directories by watch descriptor */
+        std::map<int, std::string> directories;
+
+        /** Watched file paths */
+        std::set<std::string> paths;
+
+        /** Changed file paths not taken yet */
+        std::set<std::string> changed;
+
+
+        /** Wake callback called from the watcher thread after a change */
+        void (*wake)();
+
+
+        /** Mutex of the paths and changes */
+        mutable std::mutex mutex;
+
+        /** Watcher thread */
+        std::thread worker;
+
+
+        // Constructors
+
+        /** Disable the default copy constructor */
+        ShaderWatcher(const ShaderWatcher &) = delete;
+
+        /** Disable the assignation operator */
+        ShaderWatcher &operator=(const ShaderWatcher &) = delete;
+
+
+        // Methods
+
+        /** Read the notifications until the watcher is stopped */
+        void run();
+
+
+    public:
+        // Constructors
+
+        /** Shader watcher constructor */
+        ShaderWatcher();
+
+
+        // Getters
+
+        /** Get the valid status */
+        bool isValid() const;
+
+        /** Get the watched status of the given path */
+        bool isWatching(const std::string &path) const;
+
+
+        // Setters
+
+        /** Set the wake callback called from the watcher thread after a change */
+        void setWakeCallback(void (*callback)());
+
+
+        // Methods
+
+        /** Watch the given file path */
+        bool watch(const std::string &path);
+
+        /** Take the changed file paths since the last call */
+        std::set<std::string> takeChanged();
+
+
+        // Destructor
+
+        /** Shader watcher destructor */
+        virtual ~ShaderWatcher();
+};
+
+#endif // __SHADER_WATCHER_HPP_
\ No newline at end of file
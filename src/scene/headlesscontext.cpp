@@ -0,0 +1,180 @@
+#include "headlesscontext.hpp"
+
+#include <iostream>
+
+#include <cstring>
+
+#if defined(__linux__)
+    #include <EGL/egl.h>
+    #include <EGL/eglext.h>
+#endif
+
+
+// Private methods
+
+// Get the display, the surfaceless platform first, then the first device and the default display
+void *HeadlessContext::getDisplay() const {
+#if defined(__linux__)
+    // Platform displays need the client extensions
+    const char *const extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    const PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if ((extensions != nullptr) && (eglGetPlatformDisplayEXT != nullptr)) {
+        // Surfaceless platform of Mesa, hardware drivers or the llvmpipe software rasterizer
+        if (std::strstr(extensions, "EGL_MESA_platform_surfaceless") != nullptr) {
+            const EGLDisplay surfaceless = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (surfaceless != EGL_NO_DISPLAY) {
+                return surfaceless;
+            }
+        }
+
+        // First device, mainly for the proprietary drivers
+        const PFNEGLQUERYDEVICESEXTPROC eglQueryDevicesEXT = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+        if ((std::strstr(extensions, "EGL_EXT_platform_device") != nullptr) && (eglQueryDevicesEXT != nullptr)) {
+            EGLDeviceEXT device = nullptr;
+            EGLint devices = 0;
+            if ((eglQueryDevicesEXT(1, &device, &devices) == EGL_TRUE) && (devices > 0)) {
+                const EGLDisplay device_display = eglGetPlatformDisplayEXT(EGL_PLATFORM_DEVICE_EXT, device, nullptr);
+                if (device_display != EGL_NO_DISPLAY) {
+                    return device_display;
+                }
+            }
+        }
+    }
+
+    // Default display
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+#else
+    return nullptr;
+#endif
+}
+
+
+// Constructors
+
+// Headless context constructor with the given core profile version, it becomes the current context
+HeadlessContext::HeadlessContext(const int &context_ver_maj, const int &context_ver_min) :
+    // EGL objects
+    display(nullptr),
+    context(nullptr),
+    surface(nullptr) {
+#if defined(__linux__)
+    // Get and initialize the display
+    display = getDisplay();
+    if ((display == EGL_NO_DISPLAY) || (eglInitialize(display, nullptr, nullptr) == EGL_FALSE)) {
+        std::cerr << "error: cannot initialize the EGL display" << std::endl;
+        display = nullptr;
+        return;
+    }
+
+    // Choose a desktop OpenGL configuration
+    const EGLint config_attributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config = nullptr;
+    EGLint configs = 0;
+    if ((eglBindAPI(EGL_OPENGL_API) == EGL_FALSE) || (eglChooseConfig(display, config_attributes, &config, 1, &configs) == EGL_FALSE) || (configs == 0)) {
+        std::cerr << "error: there is no EGL configuration for desktop OpenGL" << std::endl;
+        return;
+    }
+
+    // Create the core profile context
+    const EGLint context_attributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, context_ver_maj,
+        EGL_CONTEXT_MINOR_VERSION, context_ver_min,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attributes);
+    if (context == EGL_NO_CONTEXT) {
+        std::cerr << "error: cannot create the EGL context " << context_ver_maj << "." << context_ver_min << std::endl;
+        context = nullptr;
+        return;
+    }
+
+    // Rendering goes to framebuffer objects, a tiny pixel buffer is only needed without surfaceless support
+    const char *const extensions = eglQueryString(display, EGL_EXTENSIONS);
+    if ((extensions == nullptr) || (std::strstr(extensions, "EGL_KHR_surfaceless_context") == nullptr)) {
+        const EGLint surface_attributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+        surface = eglCreatePbufferSurface(display, config, surface_attributes);
+        if (surface == EGL_NO_SURFACE) {
+            std::cerr << "error: cannot create the EGL pixel buffer surface" << std::endl;
+            surface = nullptr;
+        }
+    }
+
+    // Make it current
+    if (!makeCurrent()) {
+        std::cerr << "error: cannot make the EGL context current" << std::endl;
+        eglDestroyContext(display, context);
+        context = nullptr;
+    }
+#else
+    static_cast<void>(context_ver_maj);
+    static_cast<void>(context_ver_min);
+    std::cerr << "error: headless rendering is only supported on Linux" << std::endl;
+#endif
+}
+
+
+// Getters
+
+// Get the valid status
+bool HeadlessContext::isValid() const {
+    return context != nullptr;
+}
+
+
+// Methods
+
+// Make the context current on the calling thread
+bool HeadlessContext::makeCurrent() const {
+#if defined(__linux__)
+    const EGLSurface target = surface == nullptr ? EGL_NO_SURFACE : surface;
+    return (context != nullptr) && (eglMakeCurrent(display, target, target, context) == EGL_TRUE);
+#else
+    return false;
+#endif
+}
+
+
+// Destructor
+
+// Headless context destructor
+HeadlessContext::~HeadlessContext() {
+#if defined(__linux__)
+    // Check the display
+    if (display == nullptr) {
+        return;
+    }
+
+    // Release and destroy the objects
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (surface != nullptr) {
+        eglDestroySurface(display, surface);
+    }
+
+    // The display is not terminated since it is shared by all the contexts of the process
+    if (context != nullptr) {
+        eglDestroyContext(display, context);
+    }
+#endif
+}
+
+
+// Static methods
+
+// Get the address of an OpenGL function for the loader
+void *HeadlessContext::getProcAddress(const char *name) {
+#if defined(__linux__)
+    return reinterpret_cast<void *>(eglGetProcAddress(name));
+#else
+    static_cast<void>(name);
+    return nullptr;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef __HEADLESS_CONTEXT_HPP_
+#define __HEADLESS_CONTEXT_HPP_
+
+
+/** Offscreen OpenGL context without window nor display server, through EGL */
+class HeadlessContext {
+    private:
+        // Attributes
+
+        /** EGL display */
+        void *display;
+
+        /** EGL context */
+        void *context;
+
+        /** EGL pixel buffer surface, used only without surfaceless context support */
+        void *surface;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        HeadlessContext() = delete;
+
+        /** Disable the default copy constructor */
+        HeadlessContext(const HeadlessContext &) = delete;
+
+        /** Disable the assignation operator */
+        HeadlessContext &operator=(const HeadlessContext &) = delete;
+
+
+        // Methods
+
+        /** Get the display, the surfaceless platform first, then the first device and the default display */
+        void *getDisplay() const;
+
+
+    public:
+        // Constructors
+
+        /** Headless context constructor with the given core profile version, it becomes the current context */
+        HeadlessContext(const int &context_ver_maj, const int &context_ver_min);
+
+
+        // Getters
+
+        /** Get the valid status */
+        bool isValid() const;
+
+
+        // Methods
+
+        /** Make the context current on the calling thread */
+        bool makeCurrent() const;
+
+
+        // Destructor
+
+        /** Headless context destructor */
+        virtual ~HeadlessContext();
+
+
+        // Static methods
+
+        /** Get the address of an OpenGL function for the loader */
+        static void *getProcAddress(const char *name);
+};
+
+#endif // __HEADLESS_CONTEXT_HPP_
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include "qualitycontroller.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <iomanip>
+
+
+// Static const attributes
+
+// Size of the timer queries ring
+const unsigned int QualityController::QUERIES;
+
+// Maximum sample distance scale
+const float QualityController::MAX_STEP_SCALE = 4.0F;
+
+// Minimum render resolution scale
+const float QualityController::MIN_RESOLUTION_SCALE = 0.25F;
+
+
+// Private methods
+
+// Read the available timer query results without blocking
+void QualityController::collect() {
+    while (query_pending > 0U) {
+        // Oldest query of the ring
+        const GLuint oldest = query[(query_head + QualityController::QUERIES - query_pending) % QualityController::QUERIES];
+
+        // Stop at the first result not available yet
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(oldest, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE) {
+            return;
+        }
+
+        // Nanoseconds to milliseconds
+        GLuint64 elapsed = 0U;
+        glGetQueryObjectui64v(oldest, GL_QUERY_RESULT, &elapsed);
+        frame_time = static_cast<double>(elapsed) / 1000000.0;
+        query_pending--;
+    }
+}
+
+// Derive the step and resolution scales from the workload
+void QualityController::apply() {
+    // Split the reduction between the samples and the pixels
+    const float new_step_scale = std::min(QualityController::MAX_STEP_SCALE, 1.0F / std::sqrt(workload));
+    const float new_resolution_scale = std::max(QualityController::MIN_RESOLUTION_SCALE, std::min(1.0F, std::sqrt(workload * new_step_scale)));
+
+    // Count the changes
+    if ((new_step_scale != step_scale) || (new_resolution_scale != resolution_scale)) {
+        step_scale = new_step_scale;
+        resolution_scale = new_resolution_scale;
+        revision++;
+    }
+}
+
+
+// Private static methods
+
+// Get the steady time in seconds
+double QualityController::now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+// Constructors
+
+// Quality controller constructor, needs a current OpenGL context
+QualityController::QualityController(const double &target_time) :
+    // Enabled status
+    enabled(true),
+
+    // Times
+    target_time(target_time),
+    frame_time(0.0),
+    refine_delay(0.15),
+    last_interaction(0.0),
+
+    // Full quality
+    workload(1.0F),
+    step_scale(1.0F),
+    resolution_scale(1.0F),
+
+    // Timer
+    gpu_timer(GLAD_GL_VERSION_3_3 != 0 || GLAD_GL_ARB_timer_query != 0),
+    query{GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE},
+    query_head(0U),
+    query_pending(0U),
+    measuring(false),
+    measuring_cpu(false),
+    cpu_start(0.0),
+
+    // Revision
+    revision(0U) {
+    // Create the timer queries
+    if (gpu_timer) {
+        glGenQueries(QualityController::QUERIES, query);
+    }
+}
+
+
+// Getters
+
+// Get the enabled status
+bool QualityController::isEnabled() const {
+    return enabled;
+}
+
+// Get the GPU timer status
+bool QualityController::isGPUTimer() const {
+    return gpu_timer;
+}
+
+
+// Get the target frame time in milliseconds
+double QualityController::getTargetTime() const {
+    return target_time;
+}
+
+// Get the last measured frame time in milliseconds
+double QualityController::getFrameTime() const {
+    return frame_time;
+}
+
+// Get the refine delay in seconds
+double QualityController::getRefineDelay() const {
+    return refine_delay;
+}
+
+
+// Get the fraction of the full quality work
+float QualityController::getWorkload() const {
+    return workload;
+}
+
+// Get the sample distance scale
+float QualityController::getStepScale() const {
+    return step_scale;
+}
+
+// Get the render resolution scale
+float QualityController::getResolutionScale() const {
+    return resolution_scale;
+}
+
+
+// Get the refining status, true while under the full quality
+bool QualityController::isRefining() const {
+    return workload < 1.0F;
+}
+
+// Get the refinement due status, true if the next frame should refine
+bool QualityController::isRefinementDue() const {
+    return (workload < 1.0F) && ((QualityController::now() - last_interaction) >= refine_delay);
+}
+
+
+// Get the revision counter
+unsigned long long int QualityController::getRevision() const {
+    return revision;
+}
+
+// Get the metrics of the last decision
+std::string QualityController::getMetrics() const {
+    std::ostringstream metrics;
+    metrics << std::fixed << std::setprecision(2)
+            << "frame " << frame_time << " ms (" << (gpu_timer ? "gpu" : "cpu") << "), target " << target_time << " ms, "
+            << "workload " << std::setprecision(0) << 100.0F * workload << "%, "
+            << "step x" << std::setprecision(2) << step_scale << ", "
+            << "resolution " << std::setprecision(0) << 100.0F * resolution_scale << "%"
+            << (enabled ? (isRefining() ? ", refining" : "") : ", disabled");
+    return metrics.str();
+}
+
+
+// Setters
+
+// Set the enabled status
+void QualityController::setEnabled(const bool &status) {
+    enabled = status;
+
+    // Back to the full quality
+    if (!enabled) {
+        workload = 1.0F;
+        apply();
+    }
+
+    revision++;
+}
+
+// Set the target frame time in milliseconds
+void QualityController::setTargetTime(const double &time) {
+    target_time = time;
+}
+
+// Set the refine delay in seconds
+void QualityController::setRefineDelay(const double &delay) {
+    refine_delay = delay;
+}
+
+
+// Methods
+
+// Start measuring the frame
+void QualityController::begin(const bool &cpu) {
+    // GPU timer, skip the frame if the ring is full
+    measuring_cpu = cpu || !gpu_timer;
+    if (!measuring_cpu) {
+        measuring = query_pending < QualityController::QUERIES;
+        if (measuring) {
+            glBeginQuery(GL_TIME_ELAPSED, query[query_head]);
+        }
+    }
+
+    // CPU time
+    else {
+        measuring = true;
+        cpu_start = QualityController::now();
+    }
+}
+
+// Stop measuring the frame
+void QualityController::end() {
+    // Check the measuring status
+    if (!measuring) {
+        return;
+    }
+    measuring = false;
+
+    // GPU timer, the result is read on later frames
+    if (!measuring_cpu) {
+        glEndQuery(GL_TIME_ELAPSED);
+        query_head = (query_head + 1U) % QualityController::QUERIES;
+        query_pending++;
+    }
+
+    // CPU time waiting for the GPU to finish
+    else {
+        glFinish();
+        frame_time = 1000.0 * (QualityController::now() - cpu_start);
+    }
+}
+
+// Decide the quality of the next frame
+void QualityController::update(const bool &interacting) {
+    // Read the finished measures
+    collect();
+
+    // Keep the full quality while disabled
+    if (!enabled) {
+        return;
+    }
+
+    // Fit the workload to the budget while interacting, damped to avoid oscillations
+    if (interacting) {
+        last_interaction = QualityController::now();
+        if (frame_time > 0.0) {
+            const float ratio = static_cast<float>(std::sqrt(target_time / frame_time));
+            workload = std::max(QualityController::MIN_RESOLUTION_SCALE * QualityController::MIN_RESOLUTION_SCALE / QualityController::MAX_STEP_SCALE, std::min(1.0F, workload * ratio));
+        }
+    }
+
+    // Progressive refinement once the input stops
+    else if (isRefinementDue()) {
+        workload = std::min(1.0F, 2.0F * workload);
+    }
+
+    // Update the scales
+    apply();
+}
+
+
+// Destructor
+
+// Quality controller destructor
+QualityController::~QualityController() {
+    if (gpu_timer) {
+        glDeleteQueries(QualityController::QUERIES, query);
+    }
+}
\ No newline at end of file
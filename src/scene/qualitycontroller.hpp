@@ -0,0 +1,186 @@
+#ifndef __QUALITY_CONTROLLER_HPP_
+#define __QUALITY_CONTROLLER_HPP_
+
+#include "../glad/glad.h"
+
+#include <string>
+
+
+/** Adaptive quality controller keeping the volume pass within a frame time budget */
+class QualityController {
+    private:
+        // Static const attributes
+
+        /** Size of the timer queries ring */
+        static const unsigned int QUERIES = 4U;
+
+
+        // Attributes
+
+        /** Enabled status */
+        bool enabled;
+
+
+        /** Target frame time in milliseconds */
+        double target_time;
+
+        /** Last measured frame time in milliseconds */
+        double frame_time;
+
+        /** Delay in seconds after the last interaction before refining */
+        double refine_delay;
+
+        /** Time of the last interaction in seconds */
+        double last_interaction;
+
+
+        /** Fraction of the full quality work */
+        float workload;
+
+        /** Sample distance scale */
+        float step_scale;
+
+        /** Render resolution scale */
+        float resolution_scale;
+
+
+        /** GPU timer status, otherwise the CPU time is measured */
+        bool gpu_timer;
+
+        /** Timer queries ring */
+        GLuint query[QualityController::QUERIES];
+
+        /** Next query in the ring */
+        unsigned int query_head;
+
+        /** Queries waiting for the result */
+        unsigned int query_pending;
+
+        /** Measuring status of the current frame */
+        bool measuring;
+
+        /** CPU time measuring status of the current frame, even with the GPU timer */
+        bool measuring_cpu;
+
+        /** CPU start time of the current frame in seconds */
+        double cpu_start;
+
+
+        /** Revision counter increased on every decision change */
+        unsigned long long int revision;
+
+
+        // Constructors
+
+        /** Disable the default copy constructor */
+        QualityController(const QualityController &) = delete;
+
+        /** Disable the assignation operator */
+        QualityController &operator=(const QualityController &) = delete;
+
+
+        // Methods
+
+        /** Read the available timer query results without blocking */
+        void collect();
+
+        /** Derive the step and resolution scales from the workload */
+        void apply();
+
+
+        // Static methods
+
+        /** Get the steady time in seconds */
+        static double now();
+
+
+    public:
+        // Static const attributes
+
+        /** Maximum sample distance scale */
+        static const float MAX_STEP_SCALE;
+
+        /** Minimum render resolution scale */
+        static const float MIN_RESOLUTION_SCALE;
+
+
+        // Constructors
+
+        /** Quality controller constructor, needs a current OpenGL context */
+        QualityController(const double &target_time = 16.0);
+
+
+        // Getters
+
+        /** Get the enabled status */
+        bool isEnabled() const;
+
+        /** Get the GPU timer status */
+        bool isGPUTimer() const;
+
+
+        /** Get the target frame time in milliseconds */
+        double getTargetTime() const;
+
+        /** Get the last measured frame time in milliseconds */
+        double getFrameTime() const;
+
+        /** Get the refine delay in seconds */
+        double getRefineDelay() const;
+
+
+        /** Get the fraction of the full quality work */
+        float getWorkload() const;
+
+        /** Get the sample distance scale */
+        float getStepScale() const;
+
+        /** Get the render resolution scale */
+        float getResolutionScale() const;
+
+
+        /** Get the refining status, true while under the full quality */
+        bool isRefining() const;
+
+        /** Get the refinement due status, true if the next frame should refine */
+        bool isRefinementDue() const;
+
+
+        /** Get the revision counter */
+        unsigned long long int getRevision() const;
+
+        /** Get the metrics of the last decision */
+        std::string getMetrics() const;
+
+
+        // Setters
+
+        /** Set the enabled status */
+        void setEnabled(const bool &status);
+
+        /** Set the target frame time in milliseconds */
+        void setTargetTime(const double &time);
+
+        /** Set the refine delay in seconds */
+        void setRefineDelay(const double &delay);
+
+
+        // Methods
+
+        /** Start measuring the frame, the CPU time is measured for the passes rendered on the CPU */
+        void begin(const bool &cpu = false);
+
+        /** Stop measuring the frame */
+        void end();
+
+        /** Decide the quality of the next frame */
+        void update(const bool &interacting);
+
+
+        // Destructor
+
+        /** Quality controller destructor */
+        virtual ~QualityController();
+};
+
+#endif // __QUALITY_CONTROLLER_HPP_
\ No newline at end of file
@@ -1,17 +1,41 @@
 #include "scene.hpp"
 
+#include "../profiler/profilerscope.hpp"
+#include "../volume/volumecache.hpp"
+
+#include <glm/matrix.hpp>
+
 #include <iostream>
 
+#include <algorithm>
+#include <cmath>
+
 
 // Private static attributes
 
 // Instances counter
 std::size_t Scene::instances = 0U;
 
+// GLFW initialized flag
+bool Scene::initialized_glfw = false;
+
 // Glad loaded flag
 bool Scene::initialized_glad = false;
 
 
+// Event wait timeout in seconds while something is pending
+const double Scene::PENDING_WAIT_TIMEOUT = 1.0 / 60.0;
+
+// Opacity range of the upsampling filter
+const float Scene::UPSAMPLE_SIGMA = 0.05F;
+
+// Accumulated samples per pixel of a converged frame
+const unsigned int Scene::MAX_SAMPLES = 32U;
+
+// Blend weight of the current frame while reprojecting
+const float Scene::MOTION_WEIGHT = 0.25F;
+
+
 // Screen width
 GLsizei Scene::screen_width = 0U;
 
@@ -41,23 +65,34 @@ void Scene::errorCallback(int error, const char *description) {
 
 // GLFW framebuffer size callback
 void Scene::framebufferSizeCallback(GLFWwindow *window, int width, int height) {
+    static_cast<Scene *>(glfwGetWindowUserPointer(window))->resize(width, height);
+}
+
+
+// Private methods
+
+// Update the frame resolution
+void Scene::resize(const int &new_width, const int &new_height) {
     // Resize viewport
-    glViewport(0, 0, width, height);
+    glViewport(0, 0, new_width, new_height);
 
-    // Get the scene and update the window resolution
-    Scene *const scene = static_cast<Scene *>(glfwGetWindowUserPointer(window));
-    scene->width = width;
-    scene->height = height;
+    // Update the resolution
+    width = new_width;
+    height = new_height;
+
+    // Resize the offscreen framebuffer and draw again
+    framebuffer->resize(width, height);
+    revision++;
 
     // Update the camera resolution
-    scene->camera->setResolution(glm::uvec2(static_cast<unsigned int>(width), static_cast<unsigned int>(height)));
+    camera->setResolution(glm::uvec2(static_cast<unsigned int>(width), static_cast<unsigned int>(height)));
 }
 
-
-// Private methods
-
 // Draw the scene
 void Scene::drawScene() {
+    // Time the phase
+    const ProfilerScope scope("scene");
+
     // Clear color and depth buffers
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -66,19 +101,383 @@ void Scene::drawScene() {
     glEnable(GL_BLEND);
 
     // Check the volume
-    if (volume->isOpen()) {
+    if (!volume->isOpen()) {
+        return;
+    }
+
+    // The isosurface is drawn as an opaque mesh at the full resolution
+    if (volume->getTechnique() == Volume::ISOSURFACE) {
+        isosurface->update(volume);
+        profiler->begin("volume");
+        camera->bind(program_mesh);
+        isosurface->draw(program_mesh, volume, camera->getViewMatrix());
+        profiler->end();
+        return;
+    }
+
+    // Apply the quality decided for this frame to all the volumes, and jitter the samples only if they are accumulated
+    const bool accumulating = isAccumulationActive();
+    for (Volume *const drawn : volumes) {
+        if (drawn->getStepScale() != quality->getStepScale()) {
+            drawn->setStepScale(quality->getStepScale());
+        }
+
+        if (drawn->isJittering() != accumulating) {
+            drawn->setJittering(accumulating);
+        }
+    }
+
+    // Volumes sampled together by the rays
+    const std::vector<const Volume *> layers = getLayers();
+
+    // The CPU passes are uploaded to the volume framebuffer, they need the upsampling program
+    const bool upsampling = (program_upsample != nullptr) && program_upsample->isValid();
+    const bool cpu = ((volume->getTechnique() == Volume::CPU_RAY_CASTING) || (volume->getTechnique() == Volume::SHEAR_WARP) || (volume->getTechnique() == Volume::FOURIER)) && upsampling;
+
+    // Render the volume offscreen at a fraction of the resolution or to accumulate it, it needs the upsampling program
+    const float scale = volume_scale * quality->getResolutionScale();
+    const bool offscreen = cpu || accumulating || ((scale < 1.0F) && upsampling);
+    GLint target = GL_FALSE;
+    if (offscreen) {
+        // Bind the volume framebuffer
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &target);
+        const GLsizei pass_width = scale < 1.0F ? std::max(1, static_cast<GLsizei>(static_cast<float>(width) * scale)) : width;
+        const GLsizei pass_height = scale < 1.0F ? std::max(1, static_cast<GLsizei>(static_cast<float>(height) * scale)) : height;
+        volume_framebuffer->resize(pass_width, pass_height);
+
+        // Decide the accumulation of this pass, before binding since resizing unbinds the framebuffers
+        if (accumulating) {
+            prepareAccumulation(volume_framebuffer->getResolution());
+        }
+
+        volume_framebuffer->bind();
+        glViewport(0, 0, pass_width, pass_height);
+
+        // Clear to transparent
+        glClearColor(0.0F, 0.0F, 0.0F, 0.0F);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glClearColor(background_color.r, background_color.g, background_color.b, 1.0F);
+
+        // Accumulate premultiplied colors and the coverage in the alpha channel
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    // Draw the volume measuring the time spent
+    profiler->begin("volume");
+    if (cpu) {
+        // Render the pass on the CPU threads and upload it to the volume framebuffer, the shear-warp only composites the emission absorption model
+        const glm::uvec2 resolution = volume_framebuffer->getResolution();
+        CPURenderer *renderer = cpu_ray_caster;
+        if (volume->getTechnique() == Volume::FOURIER) {
+            renderer = fourier_renderer;
+        }
+        else if ((volume->getTechnique() == Volume::SHEAR_WARP) && (volume->getComposition() == Volume::DVR)) {
+            renderer = shear_warp;
+        }
+        quality->begin(true);
+        if (!layers.empty()) {
+            cpu_ray_caster->render(layers, camera, static_cast<GLsizei>(resolution.x), static_cast<GLsizei>(resolution.y), cpu_image);
+        }
+        else {
+            renderer->render(volume, camera, static_cast<GLsizei>(resolution.x), static_cast<GLsizei>(resolution.y), cpu_image);
+        }
+        quality->end();
+
+        glBindTexture(GL_TEXTURE_2D, volume_framebuffer->getColorTexture());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, static_cast<GLsizei>(resolution.x), static_cast<GLsizei>(resolution.y), GL_RGBA, GL_UNSIGNED_BYTE, cpu_image.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_2D, GL_FALSE);
+    }
+    else if (!layers.empty()) {
+        // The multi-volume rays neither shade nor need the data format
+        std::set<std::string> defines = volume->getDefines();
+        defines.erase("SHADING");
+        defines.erase("DATA_16BIT");
+        defines.insert("MULTI_VOLUME");
+
+        quality->begin();
+        selectVariant(defines);
+        camera->bind(program);
+        Volume::drawLayers(layers, program);
+        quality->end();
+    }
+    else {
+        quality->begin();
+        selectVariant(volume->getDefines());
+        prewarmVariants(volume->getDefines());
         camera->bind(program);
         volume->draw(program);
+        quality->end();
+    }
+    profiler->end();
+
+    // Composite the volume over the background at the window resolution
+    if (offscreen) {
+        const GLuint texture = accumulating ? accumulateVolume() : volume_framebuffer->getColorTexture();
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(target));
+        glViewport(0, 0, width, height);
+        upsampleVolume(texture);
+    }
+}
+
+// Get the open volumes of the multi-volume pass
+std::vector<const Volume *> Scene::getLayers() const {
+    std::vector<const Volume *> layers;
+    const Volume::Technique technique = volume->getTechnique();
+    if (((technique != Volume::RAY_CASTING) && (technique != Volume::CPU_RAY_CASTING)) || (volume->getComposition() != Volume::DVR)) {
+        return layers;
+    }
+
+    for (const Volume *const layer : volumes) {
+        if (layer->isEnabled() && layer->isOpen()) {
+            layers.push_back(layer);
+        }
+    }
+
+    // A single volume is drawn alone
+    if (layers.size() < 2U) {
+        layers.clear();
+    }
+    return layers;
+}
+
+// Get the accumulation active status of the GPU techniques, it needs the accumulation and upsampling programs
+bool Scene::isAccumulationActive() const {
+    const bool gpu = (volume->getTechnique() == Volume::SLICING) || (volume->getTechnique() == Volume::RAY_CASTING);
+    return accumulation && gpu && (program_accumulate != nullptr) && program_accumulate->isValid() && (program_upsample != nullptr) && program_upsample->isValid();
+}
+
+// Decide how the next volume pass is accumulated and set its jitter
+void Scene::prepareAccumulation(const glm::uvec2 &resolution) {
+    // Matrices of the frame
+    const glm::mat4 mvp = camera->getProjectionMatrix() * camera->getViewMatrix() * volume->getModelMatrix();
+    const glm::mat4 volume_mat = volume->getVolumeMatrix();
+
+    // Anything but the view that changes the volume pass restarts the accumulation, the clipping box too, the other volumes are not reprojected so any change of them too
+    unsigned long long int revision = volume->getTransferFunction()->getRevision() + quality->getRevision();
+    for (std::size_t i = 1U; i < volumes.size(); i++) {
+        revision += volumes[i]->getRevision();
+    }
+    const std::set<std::string> defines = volume->getDefines();
+    const glm::vec3 clip_min = volume->getClipMin();
+    const glm::vec3 clip_max = volume->getClipMax();
+    const bool clipping = (clip_min != accumulated_clip_min) || (clip_max != accumulated_clip_max);
+    const bool restart = (accumulated_samples == 0U) || (revision != accumulated_revision) || (defines != accumulated_defines) || clipping || (resolution != accumulation_framebuffer[0]->getResolution());
+
+    // View changes reproject the history
+    reprojecting = !restart && ((mvp != accumulated_mvp) || (volume_mat != accumulated_volume_mat));
+    ray_mat = volume_mat * glm::inverse(mvp);
+    previous_mat = accumulated_mvp * glm::inverse(accumulated_volume_mat);
+
+    // Blend weight of the current frame, the static frames are averaged
+    if (restart) {
+        accumulation_weight = 1.0F;
+        accumulated_samples = 1U;
+    }
+    else if (reprojecting) {
+        accumulation_weight = Scene::MOTION_WEIGHT;
+        accumulated_samples = static_cast<unsigned int>(1.0F / Scene::MOTION_WEIGHT);
+    }
+    else {
+        accumulated_samples++;
+        accumulation_weight = 1.0F / static_cast<float>(accumulated_samples);
+    }
+
+    // Store the accumulated state
+    accumulated_revision = revision;
+    accumulated_defines = defines;
+    accumulated_mvp = mvp;
+    accumulated_volume_mat = volume_mat;
+    accumulated_clip_min = clip_min;
+    accumulated_clip_max = clip_max;
+
+    // Resize the accumulation framebuffers
+    accumulation_framebuffer[0]->resize(static_cast<GLsizei>(resolution.x), static_cast<GLsizei>(resolution.y));
+    accumulation_framebuffer[1]->resize(static_cast<GLsizei>(resolution.x), static_cast<GLsizei>(resolution.y));
+
+    // Low discrepancy jitter offset of the frame
+    const double golden = 0.61803398874989484820 * static_cast<double>(frames);
+    volume->setJitter(static_cast<float>(golden - std::floor(golden)));
+}
+
+// Blend the volume pass with the history, returns the accumulated texture
+GLuint Scene::accumulateVolume() {
+    // Time the phase
+    const ProfilerScope scope("accumulate");
+
+    // Render into the framebuffer that is not holding the history
+    const unsigned int next = 1U - accumulation_index;
+    accumulation_framebuffer[next]->bind();
+    glDisable(GL_BLEND);
+    glDisable(GL_DEPTH_TEST);
+
+    // Set the accumulation uniforms
+    program_accumulate->use();
+    program_accumulate->setUniform("u_current", 0);
+    program_accumulate->setUniform("u_history", 1);
+    program_accumulate->setUniform("u_ray_mat", ray_mat);
+    program_accumulate->setUniform("u_previous_mat", previous_mat);
+    program_accumulate->setUniform("u_weight", accumulation_weight);
+    program_accumulate->setUniform("u_reproject", reprojecting ? 1 : 0);
+    program_accumulate->setUniform("u_clip_min", accumulated_clip_min);
+    program_accumulate->setUniform("u_clip_max", accumulated_clip_max);
+
+    // Bind the current pass and the history
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, accumulation_framebuffer[accumulation_index]->getColorTexture());
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, volume_framebuffer->getColorTexture());
+
+    // Draw the screen covering triangle
+    glBindVertexArray(vao_screen);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(GL_FALSE);
+
+    // Restore the state
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, GL_FALSE);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, GL_FALSE);
+    glEnable(GL_BLEND);
+    glEnable(GL_DEPTH_TEST);
+
+    // The target becomes the history
+    accumulation_index = next;
+    return accumulation_framebuffer[next]->getColorTexture();
+}
+
+// Composite the volume pass texture with edge aware upsampling
+void Scene::upsampleVolume(const GLuint &texture) const {
+    // Time the phase
+    const ProfilerScope scope("upsample");
+
+    // Premultiplied over operator without depth, the slices maximum keeps the maximum operator
+    const bool maximum = (volume->getTechnique() == Volume::SLICING) && (volume->getComposition() == Volume::MIP);
+    glDisable(GL_DEPTH_TEST);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    if (maximum) {
+        glBlendEquation(GL_MAX);
+    }
+
+    // Bind the volume pass image
+    program_upsample->use();
+    program_upsample->setUniform("u_image", 0);
+    program_upsample->setUniform("u_sigma", Scene::UPSAMPLE_SIGMA);
+
+    // The entry depth into the clipped volume box guides the filter at full resolution
+    const glm::mat4 mvp = camera->getProjectionMatrix() * camera->getViewMatrix() * volume->getModelMatrix();
+    program_upsample->setUniform("u_ray_mat", volume->getVolumeMatrix() * glm::inverse(mvp));
+    program_upsample->setUniform("u_clip_min", volume->getClipMin());
+    program_upsample->setUniform("u_clip_max", volume->getClipMax());
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    // Draw the screen covering triangle
+    glBindVertexArray(vao_screen);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(GL_FALSE);
+
+    // Restore the state
+    glBindTexture(GL_TEXTURE_2D, GL_FALSE);
+    glBlendEquation(GL_FUNC_ADD);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_DEPTH_TEST);
+}
+
+// Activate the program variant of the defines, with asynchronous variants the active one keeps drawing until it is linked
+void Scene::selectVariant(const std::set<std::string> &defines) {
+    // Without an active variant, or without asynchronous variants, wait for the link
+    if (!asynchronous_variants || !program->isValid()) {
+        program->setVariant(defines);
+        variant_pending = false;
+        return;
+    }
+
+    // Start the link and keep the active variant, the history of its frames is discarded once the new one is ready
+    program->prepareVariant(defines);
+    variant_pending = !program->isVariantReady(defines);
+    if (variant_pending) {
+        pending_defines = defines;
+        accumulated_samples = 0U;
+        return;
+    }
+    program->setVariant(defines);
+}
+
+// Start linking in background the variants one composition or shading change away from the defines
+void Scene::prewarmVariants(const std::set<std::string> &defines) {
+    // Without parallel compile every build would stall the frame
+    if (!asynchronous_variants || (defines == prewarmed_defines) || !GLSLProgram::isParallelCompileSupported()) {
+        return;
+    }
+    prewarmed_defines = defines;
+
+    // Emission absorption model with and without shading, and every intensity projection
+    std::set<std::string> base = defines;
+    for (const char *const name : {"MIP", "MINIP", "AVERAGE", "SHADING"}) {
+        base.erase(name);
+    }
+    for (const char *const name : {"", "SHADING", "MIP", "MINIP", "AVERAGE"}) {
+        std::set<std::string> likely = base;
+        if (*name != '\0') {
+            likely.insert(name);
+        }
+        program->prepareVariant(likely);
+    }
+}
+
+
+// Bind the offscreen framebuffer as the render target
+void Scene::beginFrame() {
+    // Decide the quality, any change besides the quality itself is an interaction
+    const unsigned long long int content_revision = getRevision() - quality->getRevision();
+    quality->update(content_revision != drawn_content_revision);
+    drawn_content_revision = content_revision;
+
+    // Time the whole frame
+    profiler->begin("frame");
+
+    // Bind the offscreen framebuffer
+    framebuffer->bind();
+}
+
+// Mark the current state as drawn
+void Scene::endFrame() {
+    // Read back the frame for the capture
+    if (frame_capture != nullptr) {
+        profiler->begin("capture");
+        frame_capture->capture(framebuffer->getFramebufferObject(), width, height);
+        profiler->end();
+    }
+
+    // Seal the profiler record of the frame
+    profiler->end();
+    profiler->endFrame(frames);
+
+    drawn_revision = getRevision();
+    frames++;
+}
+
+// Copy the last drawn frame to the window
+void Scene::present() const {
+    // Check the window, headless frames are only read back
+    if (window == nullptr) {
+        return;
     }
+
+    const ProfilerScope scope("present");
+    framebuffer->blit(GL_FALSE, width, height);
 }
 
 
 // Constructor
 
 // Scene constructor
-Scene::Scene(const std::string &title, const int &width, const int &height, const int &context_ver_maj, const int &context_ver_min) :
+Scene::Scene(const std::string &title, const int &width, const int &height, const int &context_ver_maj, const int &context_ver_min, const bool &headless) :
     // Defaults for window
     window(nullptr),
+    context(nullptr),
     title(title),
     width(width),
     height(height),
@@ -92,52 +491,113 @@ Scene::Scene(const std::string &title, const int &width, const int &height, cons
     // Volume
     volume(nullptr),
 
-    // Program
-    program(nullptr) {
-    // Create window flag
-    bool create_window = true;
-
-    // Initialize GLFW if there are no instances
-    if (Scene::instances == 0U) {
-        // Setup error callback
-        glfwSetErrorCallback(Scene::errorCallback);
-
-        // Initialize the library
-        if (glfwInit() != GLFW_TRUE) {
-            std::cerr << "error: cannot initialize GLFW" << std::endl;
-            create_window = false;
+    // Programs
+    program(nullptr),
+    program_upsample(nullptr),
+    program_accumulate(nullptr),
+    program_mesh(nullptr),
+    isosurface(nullptr),
+    cpu_ray_caster(nullptr),
+    shear_warp(nullptr),
+    fourier_renderer(nullptr),
+    vao_screen(GL_FALSE),
+
+    // Frames
+    frames(0U),
+    profiler(nullptr),
+    frame_capture(nullptr),
+
+    // Dirty state
+    framebuffer(nullptr),
+    volume_framebuffer(nullptr),
+    volume_scale(0.5F),
+    layer_framebuffer(nullptr),
+
+    // Accumulation
+    accumulation(true),
+    accumulation_framebuffer{nullptr, nullptr},
+    accumulation_index(0U),
+    accumulated_samples(0U),
+    accumulation_weight(1.0F),
+    reprojecting(false),
+    accumulated_revision(0U),
+    accumulated_mvp(1.0F),
+    accumulated_volume_mat(1.0F),
+    accumulated_clip_min(0.0F),
+    accumulated_clip_max(1.0F),
+    ray_mat(1.0F),
+    previous_mat(1.0F),
+    quality(nullptr),
+    revision(1U),
+    drawn_revision(0U),
+    drawn_content_revision(0U),
+    continuous(false),
+    asynchronous_variants(false),
+    variant_pending(false) {
+    // Create the offscreen context
+    if (headless) {
+        context = new HeadlessContext(context_ver_maj, context_ver_min);
+        if (!context->isValid()) {
+            std::cerr << "error: cannot create the headless context" << std::endl;
+            delete context;
+            context = nullptr;
         }
     }
 
-    // Create window
-    if (create_window) {
-        // Set the window hints
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, context_ver_maj);
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, context_ver_min);
-        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    // Create the window
+    else {
+        // Initialize GLFW once
+        if (!Scene::initialized_glfw) {
+            // Setup error callback
+            glfwSetErrorCallback(Scene::errorCallback);
+
+            // Initialize the library
+            Scene::initialized_glfw = glfwInit() == GLFW_TRUE;
+            if (!Scene::initialized_glfw) {
+                std::cerr << "error: cannot initialize GLFW" << std::endl;
+            }
+        }
 
-        // Create the scene window
-        window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
-    }
+        // Create window
+        if (Scene::initialized_glfw) {
+            // Set the window hints
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, context_ver_maj);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, context_ver_min);
+            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-    // Check the window creation
-    if (window == nullptr) {
-        std::cerr << "error: cannot create the application window" << std::endl;
-    }
+            // Create the scene window
+            window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+        }
+
+        // Check the window creation
+        if (window == nullptr) {
+            std::cerr << "error: cannot create the application window" << std::endl;
+        }
 
-    // Setup the context
-    else {
         // Set the user pointer to this scene and setup the current context
-        glfwSetWindowUserPointer(window, this);
-        glfwMakeContextCurrent(window);
+        else {
+            glfwSetWindowUserPointer(window, this);
+            glfwMakeContextCurrent(window);
+        }
+    }
 
-        // Initialize Glad and check errors
-        if (!Scene::initialized_glad && (gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)) == 0)) {
+    // Setup the context
+    if ((window != nullptr) || (context != nullptr)) {
+        // Initialize Glad and check errors, the headless functions are loaded from EGL
+        const GLADloadproc loader = headless ? reinterpret_cast<GLADloadproc>(HeadlessContext::getProcAddress) : reinterpret_cast<GLADloadproc>(glfwGetProcAddress);
+        if ((headless || !Scene::initialized_glad) && (gladLoadGLLoader(loader) == 0)) {
             std::cerr << "error: cannot initialize glad" << std::endl;
 
-            // Destroy window
-            glfwDestroyWindow(window);
-            window = nullptr;
+            // Destroy window or context
+            if (window != nullptr) {
+                glfwDestroyWindow(window);
+                window = nullptr;
+            }
+
+            if (context != nullptr) {
+                delete context;
+                context = nullptr;
+            }
         }
 
         // Finalize conext setup
@@ -151,20 +611,56 @@ Scene::Scene(const std::string &title, const int &width, const int &height, cons
             Scene::opengl_version  = glGetString(GL_VERSION);
             Scene::glsl_version    = glGetString(GL_SHADING_LANGUAGE_VERSION);
 
+            // Create the profiler first to receive the scopes of the default objects
+            profiler = new Profiler();
+            Profiler::setActive(profiler);
+
+            // The closed volumes keep their OpenGL objects in the cache until the scene clears it
+            VolumeCache::attach();
+
             // Create the default objects
             camera = new Camera(width, height);
             volume = new Volume();
+            volumes.push_back(volume);
             program = new GLSLProgram();
+            program_upsample = new GLSLProgram();
+            program_accumulate = new GLSLProgram();
+            program_mesh = new GLSLProgram();
+            isosurface = new Isosurface();
+            cpu_ray_caster = new RayCaster();
+            shear_warp = new ShearWarp();
+            fourier_renderer = new FourierRenderer();
+            glGenVertexArrays(1, &vao_screen);
+            framebuffer = new Framebuffer(width, height);
+            volume_framebuffer = new Framebuffer(width, height);
+            accumulation_framebuffer[0] = new Framebuffer(width, height, GL_RGBA32F, false);
+            accumulation_framebuffer[1] = new Framebuffer(width, height, GL_RGBA32F, false);
+            quality = new QualityController();
+
+            // Set the viewport of the offscreen frame
+            glViewport(0, 0, width, height);
+
+            // Without interaction the quality is not degraded
+            if (headless) {
+                quality->setEnabled(false);
+            }
 
             // Set the resize window callback and maximize window
-            glfwSetFramebufferSizeCallback(window, Scene::framebufferSizeCallback);
-            glfwMaximizeWindow(window);
+            else {
+                glfwSetFramebufferSizeCallback(window, Scene::framebufferSizeCallback);
+                glfwMaximizeWindow(window);
 
-            // Setup the swap interval
-            glfwSwapInterval(1);
+                // Setup the swap interval
+                glfwSwapInterval(1);
+            }
 
             // Set the blend function
             glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+            // Let the driver compile the shaders in parallel threads
+            if (GLAD_GL_KHR_parallel_shader_compile != 0) {
+                glMaxShaderCompilerThreadsKHR(0xFFFFFFFFU);
+            }
         }
     }
 
@@ -177,7 +673,12 @@ Scene::Scene(const std::string &title, const int &width, const int &height, cons
 
 // Get the valid status
 bool Scene::isValid() {
-    return window != nullptr;
+    return (window != nullptr) || (context != nullptr);
+}
+
+// Get the headless status
+bool Scene::isHeadless() const {
+    return context != nullptr;
 }
 
 
@@ -207,35 +708,294 @@ Volume *Scene::getVolume() const {
     return volume;
 }
 
+// Get the volumes
+std::vector<Volume *> Scene::getVolumes() const {
+    return volumes;
+}
+
 // Get program by ID
 GLSLProgram *Scene::getProgram() const {
     return program;
 }
 
+// Get the volume upsampling program
+GLSLProgram *Scene::getUpsampleProgram() const {
+    return program_upsample;
+}
+
+// Get the volume accumulation program
+GLSLProgram *Scene::getAccumulateProgram() const {
+    return program_accumulate;
+}
+
+// Get the isosurface mesh program
+GLSLProgram *Scene::getMeshProgram() const {
+    return program_mesh;
+}
+
+// Get the isosurface of the volume
+Isosurface *Scene::getIsosurface() const {
+    return isosurface;
+}
+
+// Get the ray caster on the CPU threads
+RayCaster *Scene::getCPURayCaster() const {
+    return cpu_ray_caster;
+}
+
+// Get the shear-warp renderer on the CPU threads
+ShearWarp *Scene::getShearWarp() const {
+    return shear_warp;
+}
+
+// Get the Fourier renderer on the CPU threads
+FourierRenderer *Scene::getFourierRenderer() const {
+    return fourier_renderer;
+}
+
+// Get the adaptive quality controller
+QualityController *Scene::getQualityController() const {
+    return quality;
+}
+
+// Get the resolution fraction of the volume pass
+float Scene::getVolumeScale() const {
+    return volume_scale;
+}
+
+// Get the accumulation enabled status
+bool Scene::isAccumulationEnabled() const {
+    return accumulation;
+}
+
+// Get the accumulated samples per pixel
+unsigned int Scene::getAccumulatedSamples() const {
+    return accumulated_samples;
+}
+
 
 // Get frames
 unsigned long long int Scene::getFrames() const {
     return frames;
 }
 
+// Get the frame phases profiler
+Profiler *Scene::getProfiler() const {
+    return profiler;
+}
+
+
+// Get the revision counter of everything that affects the frame
+unsigned long long int Scene::getRevision() const {
+    unsigned long long int volume_revision = 0U;
+    for (const Volume *const counted : volumes) {
+        volume_revision += counted->getRevision();
+    }
+    return revision + camera->getRevision() + volume_revision + quality->getRevision();
+}
+
+// Get the continuous rendering status
+bool Scene::isContinuous() const {
+    return continuous;
+}
+
+// Get the dirty status, true if something changed since the last drawn frame
+bool Scene::isDirty() const {
+    return continuous || (getRevision() != drawn_revision) || quality->isRefinementDue() || (volume->isOpen() && isAccumulationActive() && (accumulated_samples < Scene::MAX_SAMPLES)) || (variant_pending && program->isVariantReady(pending_defines));
+}
+
+// Get the pending status of a program variant linking in background
+bool Scene::isVariantPending() const {
+    return variant_pending;
+}
+
+// Get the frame capture status
+bool Scene::isCapturing() const {
+    return frame_capture != nullptr;
+}
+
 
 // Setters
 
 // Set title
 void Scene::setTitle(const std::string &new_title) {
     title = new_title;
-    glfwSetWindowTitle(window, title.c_str());
+    if (window != nullptr) {
+        glfwSetWindowTitle(window, title.c_str());
+    }
+}
+
+// Set the frame resolution, the window is resized if there is one
+void Scene::setResolution(const int &new_width, const int &new_height) {
+    // Check the resolution
+    if ((new_width <= 0) || (new_height <= 0)) {
+        return;
+    }
+
+    // The framebuffer size callback updates the resolution
+    if (window != nullptr) {
+        glfwSetWindowSize(window, new_width, new_height);
+    }
+    else {
+        resize(new_width, new_height);
+    }
 }
 
 // Set the background color
 void Scene::setBackgroundColor(const glm::vec3 &color) {
     background_color = color;
     glClearColor(background_color.r, background_color.g, background_color.b, 1.0F);
+    revision++;
+}
+
+// Set the continuous rendering status
+void Scene::setContinuous(const bool &status) {
+    continuous = status;
+}
+
+// Set the resolution fraction of the volume pass, clamped to [0.125, 1]
+void Scene::setVolumeScale(const float &scale) {
+    volume_scale = std::max(0.125F, std::min(1.0F, scale));
+    revision++;
+}
+
+// Set the accumulation enabled status
+void Scene::setAccumulation(const bool &status) {
+    accumulation = status;
+    accumulated_samples = 0U;
+    revision++;
 }
 
 
 // Methods
 
+// Force the next frame to be drawn
+void Scene::requestRedraw() {
+    revision++;
+}
+
+// Add an empty volume drawn with the others
+Volume *Scene::addVolume() {
+    Volume *const added = new Volume();
+    volumes.push_back(added);
+    accumulated_samples = 0U;
+    revision++;
+    return added;
+}
+
+// Remove and delete a volume added to the scene
+void Scene::removeVolume(Volume *const removed) {
+    // Check the volume, the first one is never removed
+    if (volumes.size() < 2U) {
+        return;
+    }
+
+    std::vector<Volume *>::iterator found = std::find(volumes.begin() + 1, volumes.end(), removed);
+    if (found == volumes.end()) {
+        return;
+    }
+
+    // Keep the scene revision increasing without the revisions of the removed volume
+    revision += removed->getRevision() + 1U;
+    volumes.erase(found);
+    delete removed;
+    accumulated_samples = 0U;
+}
+
+// Draw a frame into the offscreen framebuffer even if nothing changed
+void Scene::renderFrame() {
+    beginFrame();
+    drawScene();
+    endFrame();
+}
+
+// Read the last drawn frame as RGBA rows from top to bottom
+std::vector<GLubyte> Scene::readFrame() const {
+    // Read the offscreen framebuffer
+    const std::size_t row = 4U * static_cast<std::size_t>(width);
+    std::vector<GLubyte> pixels(row * static_cast<std::size_t>(height));
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer->getFramebufferObject());
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, GL_FALSE);
+
+    // Flip the rows
+    for (std::size_t top = 0U, bottom = static_cast<std::size_t>(height) - 1U; top < bottom; top++, bottom--) {
+        std::swap_ranges(pixels.begin() + static_cast<std::ptrdiff_t>(top * row), pixels.begin() + static_cast<std::ptrdiff_t>((top + 1U) * row), pixels.begin() + static_cast<std::ptrdiff_t>(bottom * row));
+    }
+
+    return pixels;
+}
+
+// Draw the volume alone and read its premultiplied layer
+std::vector<GLfloat> Scene::renderLayer() {
+    // Time the whole frame
+    profiler->begin("frame");
+
+    // Bind the layer framebuffer
+    if (layer_framebuffer == nullptr) {
+        layer_framebuffer = new Framebuffer(width, height, GL_RGBA32F, false);
+    }
+    layer_framebuffer->resize(width, height);
+    layer_framebuffer->bind();
+    glViewport(0, 0, width, height);
+
+    // Clear to transparent
+    glClearColor(0.0F, 0.0F, 0.0F, 0.0F);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glClearColor(background_color.r, background_color.g, background_color.b, 1.0F);
+
+    // Accumulate premultiplied colors and the coverage in the alpha channel, without jitter to match the other layers
+    std::vector<GLfloat> pixels(4U * static_cast<std::size_t>(width) * static_cast<std::size_t>(height));
+    if (volume->isOpen()) {
+        if (volume->isJittering()) {
+            volume->setJittering(false);
+        }
+
+        glDisable(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+        profiler->begin("volume");
+        program->setVariant(volume->getDefines());
+        camera->bind(program);
+        volume->draw(program);
+        profiler->end();
+
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    // Read the layer
+    {
+        const ProfilerScope scope("layer");
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, layer_framebuffer->getFramebufferObject());
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_FLOAT, pixels.data());
+    }
+
+    // Restore the offscreen frame as the render target
+    framebuffer->bind();
+
+    // Seal the profiler record of the frame
+    profiler->end();
+    profiler->endFrame(frames);
+    frames++;
+    return pixels;
+}
+
+// Capture every drawn frame asynchronously
+void Scene::startCapture(const std::string &pattern) {
+    delete frame_capture;
+    frame_capture = new FrameCapture(pattern);
+}
+
+// Stop capturing
+void Scene::stopCapture() {
+    delete frame_capture;
+    frame_capture = nullptr;
+}
+
 // Render main loop
 void Scene::mainLoop() {
     // Check the window status
@@ -251,15 +1011,27 @@ void Scene::mainLoop() {
 
     // The rendering main loop
     while (glfwWindowShouldClose(window) == GLFW_FALSE) {
-        // Draw the scene
-        drawScene();
+        // Draw the scene only if something changed
+        if (isDirty()) {
+            beginFrame();
+            drawScene();
+            endFrame();
+        }
 
-        // Poll events and swap buffers
-        glfwPollEvents();
+        // Present the last drawn frame
+        present();
         glfwSwapBuffers(window);
 
-        // Count frame
-        frames++;
+        // Poll events while drawing continuously, otherwise sleep until the next event
+        if (isDirty()) {
+            glfwPollEvents();
+        }
+        else if (quality->isRefining()) {
+            glfwWaitEventsTimeout(Scene::PENDING_WAIT_TIMEOUT);
+        }
+        else {
+            glfwWaitEvents();
+        }
     }
 }
 
@@ -268,32 +1040,110 @@ void Scene::mainLoop() {
 
 // Scene destructor
 Scene::~Scene() {
+    // Finish the capture
+    if (frame_capture != nullptr) {
+        delete frame_capture;
+    }
+
     // Delete the camera
     if (camera != nullptr) {
         delete camera;
     }
 
-    // Delete the volume
-    if (volume != nullptr) {
-        delete volume;
+    // Delete the isosurface, the CPU renderers and the volumes
+    if (isosurface != nullptr) {
+        delete isosurface;
+    }
+
+    if (cpu_ray_caster != nullptr) {
+        delete cpu_ray_caster;
+    }
+
+    if (shear_warp != nullptr) {
+        delete shear_warp;
+    }
+
+    if (fourier_renderer != nullptr) {
+        delete fourier_renderer;
+    }
+
+    for (Volume *const deleted : volumes) {
+        delete deleted;
     }
 
-    // Delete the program
+    // Delete the cached volumes while the context is current, the deleted volumes were kept there
+    VolumeCache::clear();
+
+    // Delete the programs
     if (program != nullptr) {
         delete program;
     }
 
+    if (program_upsample != nullptr) {
+        delete program_upsample;
+    }
+
+    if (program_accumulate != nullptr) {
+        delete program_accumulate;
+    }
+
+    if (program_mesh != nullptr) {
+        delete program_mesh;
+    }
+
+    // Delete the screen vertex array object
+    if (vao_screen != GL_FALSE) {
+        glDeleteVertexArrays(1, &vao_screen);
+    }
+
+    // Delete the offscreen framebuffers
+    if (framebuffer != nullptr) {
+        delete framebuffer;
+    }
+
+    if (volume_framebuffer != nullptr) {
+        delete volume_framebuffer;
+    }
+
+    if (layer_framebuffer != nullptr) {
+        delete layer_framebuffer;
+    }
+
+    for (Framebuffer *const accumulation_target : accumulation_framebuffer) {
+        if (accumulation_target != nullptr) {
+            delete accumulation_target;
+        }
+    }
+
+    // Delete the quality controller
+    if (quality != nullptr) {
+        delete quality;
+    }
+
+    // Delete the profiler, flushing the export file
+    if (profiler != nullptr) {
+        delete profiler;
+    }
+
 
     // Destroy window
     if (window != nullptr) {
         glfwDestroyWindow(window);
     }
 
-    // If is the last instance
-    if ((Scene::instances == 1U) && Scene::initialized_glad) {
-        // Terminate GLFW
+    // Destroy the offscreen context
+    if (context != nullptr) {
+        delete context;
+    }
+
+    // Terminate GLFW if is the last instance
+    if ((Scene::instances == 1U) && Scene::initialized_glfw) {
         glfwTerminate();
+        Scene::initialized_glfw = false;
+    }
 
+    // If is the last instance
+    if ((Scene::instances == 1U) && Scene::initialized_glad) {
         // Reset initialized Glad flag
         Scene::initialized_glad = false;
 
@@ -2,9 +2,18 @@
 #define __SCENE_HPP_
 
 #include "../volume/volume.hpp"
+#include "../volume/isosurface.hpp"
+#include "../cpu/raycaster.hpp"
+#include "../cpu/shearwarp.hpp"
+#include "../cpu/fourierrenderer.hpp"
+#include "../profiler/profiler.hpp"
 
 #include "camera.hpp"
+#include "framebuffer.hpp"
+#include "framecapture.hpp"
 #include "glslprogram.hpp"
+#include "headlesscontext.hpp"
+#include "qualitycontroller.hpp"
 
 #include "../glad/glad.h"
 #include <GLFW/glfw3.h>
@@ -14,6 +23,8 @@
 #include <string>
 
 #include <map>
+#include <set>
+#include <vector>
 
 
 class Scene {
@@ -23,6 +34,9 @@ class Scene {
         /** Window */
         GLFWwindow *window;
 
+        /** Offscreen context of a headless scene */
+        HeadlessContext *context;
+
         /** Window title */
         std::string title;
 
@@ -40,16 +54,135 @@ class Scene {
         /** Camera */
         Camera *camera;
 
-        /** Volume */
+        /** Volume, the first of the volumes and the only one drawn by the techniques without multi-volume pass */
         Volume *volume;
 
+        /** Volumes with their own transforms and transfer functions, drawn together by the ray casting techniques */
+        std::vector<Volume *> volumes;
+
         /** Program */
         GLSLProgram *program;
 
+        /** Volume upsampling program */
+        GLSLProgram *program_upsample;
+
+        /** Volume accumulation program */
+        GLSLProgram *program_accumulate;
+
+        /** Isosurface mesh program */
+        GLSLProgram *program_mesh;
+
+        /** Isosurface of the volume */
+        Isosurface *isosurface;
+
+        /** Ray caster on the CPU threads */
+        RayCaster *cpu_ray_caster;
+
+        /** Shear-warp renderer on the CPU threads */
+        ShearWarp *shear_warp;
+
+        /** Fourier renderer on the CPU threads */
+        FourierRenderer *fourier_renderer;
+
+        /** Image of the last CPU volume pass */
+        std::vector<GLubyte> cpu_image;
+
+        /** Empty vertex array object for screen passes */
+        GLuint vao_screen;
+
 
         /** Frames */
         unsigned long long int frames;
 
+        /** Frame phases profiler */
+        Profiler *profiler;
+
+        /** Frame capture, null if not capturing */
+        FrameCapture *frame_capture;
+
+
+        /** Offscreen framebuffer holding the last drawn frame */
+        Framebuffer *framebuffer;
+
+        /** Offscreen framebuffer for the reduced resolution volume pass */
+        Framebuffer *volume_framebuffer;
+
+        /** Resolution fraction of the volume pass */
+        float volume_scale;
+
+        /** Floating point framebuffer of the volume layer, created on the first use */
+        Framebuffer *layer_framebuffer;
+
+
+        /** Accumulation enabled status */
+        bool accumulation;
+
+        /** Accumulation framebuffers, the history and the target are swapped every frame */
+        Framebuffer *accumulation_framebuffer[2];
+
+        /** Accumulation framebuffer holding the history */
+        unsigned int accumulation_index;
+
+        /** Accumulated samples per pixel */
+        unsigned int accumulated_samples;
+
+        /** Blend weight of the current frame */
+        float accumulation_weight;
+
+        /** Reprojection of the history status */
+        bool reprojecting;
+
+        /** Accumulated transfer function and quality revision */
+        unsigned long long int accumulated_revision;
+
+        /** Accumulated program variant defines */
+        std::set<std::string> accumulated_defines;
+
+        /** Accumulated projection, view and model matrix */
+        glm::mat4 accumulated_mvp;
+
+        /** Accumulated volume matrix */
+        glm::mat4 accumulated_volume_mat;
+
+        /** Accumulated clipping box minimum corner */
+        glm::vec3 accumulated_clip_min;
+
+        /** Accumulated clipping box maximum corner */
+        glm::vec3 accumulated_clip_max;
+
+        /** Matrix from the normalized device coordinates to the texture space */
+        glm::mat4 ray_mat;
+
+        /** Matrix from the texture space to the previous clip space */
+        glm::mat4 previous_mat;
+
+        /** Adaptive quality controller */
+        QualityController *quality;
+
+        /** Revision counter of the scene own changes */
+        unsigned long long int revision;
+
+        /** Revision of the last drawn frame */
+        unsigned long long int drawn_revision;
+
+        /** Revision of the last drawn frame without the quality changes */
+        unsigned long long int drawn_content_revision;
+
+        /** Continuous rendering status, otherwise it only draws on changes */
+        bool continuous;
+
+        /** Asynchronous variants status, the active program variant keeps drawing while a new one links */
+        bool asynchronous_variants;
+
+        /** Pending variant status, a requested program variant is still linking */
+        bool variant_pending;
+
+        /** Defines of the pending program variant */
+        std::set<std::string> pending_defines;
+
+        /** Defines of the last variant whose likely neighbours were prewarmed */
+        std::set<std::string> prewarmed_defines;
+
 
         // Constructors
 
@@ -65,19 +198,69 @@ class Scene {
 
         // Methods
 
+        /** Update the frame resolution */
+        void resize(const int &new_width, const int &new_height);
+
         /** Draw the scene */
         void drawScene();
 
+        /** Get the open volumes of the multi-volume pass, empty if the first volume is drawn alone, the pass needs a ray casting technique with the emission absorption model and more than one open volume */
+        std::vector<const Volume *> getLayers() const;
+
+        /** Get the accumulation active status of the GPU techniques, it needs the accumulation and upsampling programs */
+        bool isAccumulationActive() const;
+
+        /** Decide how the next volume pass is accumulated and set its jitter */
+        void prepareAccumulation(const glm::uvec2 &resolution);
+
+        /** Blend the volume pass with the history, returns the accumulated texture */
+        GLuint accumulateVolume();
+
+        /** Composite the volume pass texture with edge aware upsampling */
+        void upsampleVolume(const GLuint &texture) const;
+
+        /** Activate the program variant of the defines, with asynchronous variants the active one keeps drawing until it is linked */
+        void selectVariant(const std::set<std::string> &defines);
+
+        /** Start linking in background the variants one composition or shading change away from the defines */
+        void prewarmVariants(const std::set<std::string> &defines);
+
+
+        /** Bind the offscreen framebuffer as the render target */
+        void beginFrame();
+
+        /** Mark the current state as drawn */
+        void endFrame();
+
+        /** Copy the last drawn frame to the window */
+        void present() const;
+
 
         // Static attributes
 
         /** Instances counter */
         static std::size_t instances;
 
+        /** GLFW initialized flag */
+        static bool initialized_glfw;
+
         /** Glad loaded flag */
         static bool initialized_glad;
 
 
+        /** Event wait timeout in seconds while something is pending */
+        static const double PENDING_WAIT_TIMEOUT;
+
+        /** Entry depth range of the upsampling filter in texture units */
+        static const float UPSAMPLE_SIGMA;
+
+        /** Accumulated samples per pixel of a converged frame */
+        static const unsigned int MAX_SAMPLES;
+
+        /** Blend weight of the current frame while reprojecting */
+        static const float MOTION_WEIGHT;
+
+
         /** Screen width */
         static GLsizei screen_width;
 
@@ -110,8 +293,8 @@ class Scene {
     public:
         // Constructor
 
-        /** Scene constructor */
-        Scene(const std::string &title, const int &width = 800, const int &height = 600, const int &context_ver_maj = 3, const int &context_ver_min = 3);
+        /** Scene constructor, a headless scene renders offscreen through EGL without window nor display */
+        Scene(const std::string &title, const int &width = 800, const int &height = 600, const int &context_ver_maj = 3, const int &context_ver_min = 3, const bool &headless = false);
 
 
         // Getters
@@ -119,6 +302,9 @@ class Scene {
         /** Get the valid status */
         bool isValid();
 
+        /** Get the headless status */
+        bool isHeadless() const;
+
 
         /** Get resolution */
         std::string getTitle() const;
@@ -133,16 +319,71 @@ class Scene {
         /** Get the camera */
         Camera *getCamera() const;
 
-        /** Get the volume */
+        /** Get the volume, the first of the volumes */
         Volume *getVolume() const;
 
+        /** Get the volumes, the first one is the volume */
+        std::vector<Volume *> getVolumes() const;
+
         /** Get the program */
         GLSLProgram *getProgram() const;
 
+        /** Get the volume upsampling program */
+        GLSLProgram *getUpsampleProgram() const;
+
+        /** Get the volume accumulation program */
+        GLSLProgram *getAccumulateProgram() const;
+
+        /** Get the isosurface mesh program */
+        GLSLProgram *getMeshProgram() const;
+
+        /** Get the isosurface of the volume */
+        Isosurface *getIsosurface() const;
+
+        /** Get the ray caster on the CPU threads */
+        RayCaster *getCPURayCaster() const;
+
+        /** Get the shear-warp renderer on the CPU threads */
+        ShearWarp *getShearWarp() const;
+
+        /** Get the Fourier renderer on the CPU threads */
+        FourierRenderer *getFourierRenderer() const;
+
+        /** Get the adaptive quality controller */
+        QualityController *getQualityController() const;
+
+        /** Get the resolution fraction of the volume pass */
+        float getVolumeScale() const;
+
+        /** Get the accumulation enabled status */
+        bool isAccumulationEnabled() const;
+
+        /** Get the accumulated samples per pixel */
+        unsigned int getAccumulatedSamples() const;
+
 
         /** Get frames */
         unsigned long long int getFrames() const;
 
+        /** Get the frame phases profiler */
+        Profiler *getProfiler() const;
+
+
+        /** Get the revision counter of everything that affects the frame */
+        unsigned long long int getRevision() const;
+
+        /** Get the continuous rendering status */
+        bool isContinuous() const;
+
+        /** Get the dirty status, true if something changed since the last drawn frame */
+        bool isDirty() const;
+
+        /** Get the pending status of a program variant linking in background */
+        bool isVariantPending() const;
+
+        /** Get the frame capture status */
+        bool isCapturing() const;
+
 
         // Setters
 
@@ -152,9 +393,45 @@ class Scene {
         /** Set the background color */
         void setBackgroundColor(const glm::vec3 &color);
 
+        /** Set the frame resolution, the window is resized if there is one */
+        void setResolution(const int &new_width, const int &new_height);
+
+        /** Set the continuous rendering status */
+        void setContinuous(const bool &status);
+
+        /** Set the resolution fraction of the volume pass, clamped to [0.125, 1] */
+        void setVolumeScale(const float &scale);
+
+        /** Set the accumulation enabled status */
+        void setAccumulation(const bool &status);
+
 
         // Methods
 
+        /** Force the next frame to be drawn */
+        void requestRedraw();
+
+        /** Add an empty volume drawn with the others, the scene owns it */
+        Volume *addVolume();
+
+        /** Remove and delete a volume added to the scene, the first volume is never removed */
+        void removeVolume(Volume *const removed);
+
+        /** Draw a frame into the offscreen framebuffer even if nothing changed */
+        void renderFrame();
+
+        /** Read the last drawn frame as RGBA rows from top to bottom */
+        std::vector<GLubyte> readFrame() const;
+
+        /** Draw the volume alone over a transparent background at the full resolution and read its premultiplied RGBA rows from the bottom, for sort-last compositing */
+        std::vector<GLfloat> renderLayer();
+
+        /** Capture every drawn frame asynchronously, numbered after the pattern as PNG or PPM images */
+        void startCapture(const std::string &pattern);
+
+        /** Stop capturing, waiting for the pending images */
+        void stopCapture();
+
         /** Render main loop */
         virtual void mainLoop();
 
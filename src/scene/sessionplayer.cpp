@@ -0,0 +1,362 @@
+#include "sessionplayer.hpp"
+#include "sessionrecorder.hpp"
+
+#include <iostream>
+#include <fstream>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+
+// Private methods
+
+// Read and decode the log file
+bool SessionPlayer::read() {
+    // Open the file
+    std::ifstream file(path, std::ifstream::in | std::ifstream::binary);
+    if (!file.is_open()) {
+        std::cerr << "error: cannot open the session log `" << path << "'" << std::endl;
+        return false;
+    }
+
+    // Check the header
+    char magic[4];
+    std::uint32_t version = 0U;
+    if (!file.read(magic, 4) || (std::memcmp(magic, SessionRecorder::MAGIC, 4) != 0) || !SessionPlayer::extract(file, version)) {
+        std::cerr << "error: `" << path << "' is not a session log" << std::endl;
+        return false;
+    }
+
+    if ((version == 0U) || (version > SessionRecorder::VERSION)) {
+        std::cerr << "error: unsupported session log version " << version << " in `" << path << "'" << std::endl;
+        return false;
+    }
+
+    // Decode the records, a truncated last record of a crashed session is dropped
+    SessionPlayer::Record record;
+    while (SessionPlayer::extract(file, record, version)) {
+        records.push_back(record);
+    }
+
+    if (!file.eof()) {
+        std::cerr << "warning: the session log `" << path << "' is truncated after " << records.size() << " records" << std::endl;
+    }
+
+    return true;
+}
+
+// Set the recorded parts on the scene
+void SessionPlayer::apply(Scene *const scene, const SessionPlayer::Record &record) const {
+    Volume *const volume = scene->getVolume();
+
+    // Load the dataset only if it changed
+    if ((record.parts & SessionRecorder::DATASET) != 0U) {
+        if ((record.dataset != volume->getPath()) || (record.format != volume->getFormat()) || (record.dataset_resolution != volume->getResolution())) {
+            volume->setPath(record.dataset, record.format, record.dataset_resolution.x, record.dataset_resolution.y, record.dataset_resolution.z);
+        }
+    }
+
+    // Added volumes, the ones of the same dataset are kept
+    if ((record.parts & SessionRecorder::OVERLAYS) != 0U) {
+        std::vector<Volume *> volumes = scene->getVolumes();
+        while (volumes.size() > record.overlays.size() + 1U) {
+            scene->removeVolume(volumes.back());
+            volumes.pop_back();
+        }
+
+        for (std::size_t i = 0U; i < record.overlays.size(); i++) {
+            const SessionPlayer::Overlay &overlay = record.overlays[i];
+            Volume *const added = i + 1U < volumes.size() ? volumes[i + 1U] : scene->addVolume();
+            if ((overlay.dataset != added->getPath()) || (overlay.format != added->getFormat()) || (overlay.dataset_resolution != added->getResolution())) {
+                added->setPath(overlay.dataset, overlay.format, overlay.dataset_resolution.x, overlay.dataset_resolution.y, overlay.dataset_resolution.z);
+            }
+            added->setPosition(overlay.position);
+            added->getTransferFunction()->setNodes(overlay.nodes);
+        }
+    }
+
+    // Frame resolution
+    if ((record.parts & SessionRecorder::RESOLUTION) != 0U) {
+        scene->setResolution(static_cast<int>(record.resolution.x), static_cast<int>(record.resolution.y));
+    }
+
+    // Camera, the up vector goes first since the direction keeps it
+    if ((record.parts & SessionRecorder::CAMERA) != 0U) {
+        Camera *const camera = scene->getCamera();
+        camera->setOrthogonal(record.orthogonal);
+        camera->setPosition(record.camera_position);
+        camera->setUp(record.camera_up);
+        camera->setDirection(record.camera_direction);
+        camera->setFOV(record.fov);
+    }
+
+    // Volume transform and render options
+    if ((record.parts & SessionRecorder::VOLUME) != 0U) {
+        volume->setPosition(record.volume_position);
+        volume->setRotation(record.volume_rotation);
+        volume->setScale(record.volume_scale);
+        volume->setTechnique(record.technique);
+        volume->setComposition(record.composition);
+        volume->setShading(record.shading);
+        volume->setIsovalue(record.isovalue);
+        volume->setFilter(record.filter);
+    }
+
+    // Transfer function
+    if ((record.parts & SessionRecorder::TRANSFER_FUNCTION) != 0U) {
+        volume->getTransferFunction()->setNodes(record.nodes);
+    }
+}
+
+
+// Private static methods
+
+// Get the steady time in seconds
+double SessionPlayer::now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Read the path, format and resolution of a volume
+bool SessionPlayer::extractDataset(std::istream &stream, std::string &dataset, VolumeData::Format &format, glm::uvec3 &resolution) {
+    std::uint32_t length = 0U;
+    std::uint8_t code = 0U;
+    std::uint32_t size[3] = {0U, 0U, 0U};
+    if (!SessionPlayer::extract(stream, length) || (length > 4096U)) {
+        return false;
+    }
+
+    dataset.resize(length);
+    if ((length > 0U) && !stream.read(&dataset[0], length)) {
+        return false;
+    }
+
+    if (!SessionPlayer::extract(stream, code) || !SessionPlayer::extract(stream, size[0]) || !SessionPlayer::extract(stream, size[1]) || !SessionPlayer::extract(stream, size[2]) || (code > VolumeData::UNKOWN)) {
+        return false;
+    }
+
+    format = static_cast<VolumeData::Format>(code);
+    resolution = glm::uvec3(size[0], size[1], size[2]);
+    return true;
+}
+
+// Read the transfer function nodes of a volume
+bool SessionPlayer::extractNodes(std::istream &stream, std::vector<std::pair<GLubyte, glm::uvec4> > &nodes) {
+    std::uint16_t count = 0U;
+    if (!SessionPlayer::extract(stream, count) || (count > 256U)) {
+        return false;
+    }
+
+    nodes.clear();
+    for (std::uint16_t i = 0U; i < count; i++) {
+        std::uint8_t node[5];
+        if (!stream.read(reinterpret_cast<char *>(node), 5)) {
+            return false;
+        }
+        nodes.push_back(std::make_pair(static_cast<GLubyte>(node[0]), glm::uvec4(node[1], node[2], node[3], node[4])));
+    }
+    return true;
+}
+
+// Read a record
+bool SessionPlayer::extract(std::istream &stream, SessionPlayer::Record &record, const std::uint32_t &version) {
+    // Time and parts mask
+    std::uint8_t parts = 0U;
+    if (!SessionPlayer::extract(stream, record.time) || !SessionPlayer::extract(stream, parts)) {
+        return false;
+    }
+    record.parts = parts;
+
+    // Volume path, format and resolution
+    if (((parts & SessionRecorder::DATASET) != 0U) && !SessionPlayer::extractDataset(stream, record.dataset, record.format, record.dataset_resolution)) {
+        return false;
+    }
+
+    // Added volumes count followed by the dataset, position and transfer function of each
+    if ((parts & SessionRecorder::OVERLAYS) != 0U) {
+        std::uint16_t count = 0U;
+        if (!SessionPlayer::extract(stream, count) || (count > 256U)) {
+            return false;
+        }
+
+        record.overlays.resize(count);
+        for (SessionPlayer::Overlay &overlay : record.overlays) {
+            if (!SessionPlayer::extractDataset(stream, overlay.dataset, overlay.format, overlay.dataset_resolution) || !SessionPlayer::extract(stream, overlay.position.x) || !SessionPlayer::extract(stream, overlay.position.y) || !SessionPlayer::extract(stream, overlay.position.z) || !SessionPlayer::extractNodes(stream, overlay.nodes)) {
+                return false;
+            }
+        }
+    }
+
+    // Frame width and height
+    if ((parts & SessionRecorder::RESOLUTION) != 0U) {
+        std::uint32_t size[2] = {0U, 0U};
+        if (!SessionPlayer::extract(stream, size[0]) || !SessionPlayer::extract(stream, size[1])) {
+            return false;
+        }
+        record.resolution = glm::uvec2(size[0], size[1]);
+    }
+
+    // Camera position, direction, up vector, field of view and projection
+    if ((parts & SessionRecorder::CAMERA) != 0U) {
+        float value[10];
+        std::uint8_t orthogonal = 0U;
+        for (float &component : value) {
+            if (!SessionPlayer::extract(stream, component)) {
+                return false;
+            }
+        }
+
+        if (!SessionPlayer::extract(stream, orthogonal)) {
+            return false;
+        }
+
+        record.camera_position = glm::vec3(value[0], value[1], value[2]);
+        record.camera_direction = glm::vec3(value[3], value[4], value[5]);
+        record.camera_up = glm::vec3(value[6], value[7], value[8]);
+        record.fov = value[9];
+        record.orthogonal = orthogonal != 0U;
+    }
+
+    // Volume position, rotation, scale, technique, composition, shading, isovalue and sampling filter
+    if ((parts & SessionRecorder::VOLUME) != 0U) {
+        float value[10];
+        std::uint8_t option[3] = {0U, 0U, 0U};
+        float isovalue = 0.5F;
+        std::uint8_t filter = static_cast<std::uint8_t>(Volume::TRILINEAR);
+        for (float &component : value) {
+            if (!SessionPlayer::extract(stream, component)) {
+                return false;
+            }
+        }
+
+        for (std::uint8_t &flag : option) {
+            if (!SessionPlayer::extract(stream, flag)) {
+                return false;
+            }
+        }
+
+        if ((version > 1U) && !SessionPlayer::extract(stream, isovalue)) {
+            return false;
+        }
+
+        if ((version > 2U) && !SessionPlayer::extract(stream, filter)) {
+            return false;
+        }
+
+        record.volume_position = glm::vec3(value[0], value[1], value[2]);
+        record.volume_rotation = glm::quat(value[3], value[4], value[5], value[6]);
+        record.volume_scale = glm::vec3(value[7], value[8], value[9]);
+        record.technique = option[0] <= Volume::FOURIER ? static_cast<Volume::Technique>(option[0]) : Volume::SLICING;
+        record.composition = option[1] <= Volume::AVERAGE ? static_cast<Volume::Composition>(option[1]) : Volume::DVR;
+        record.shading = option[2] != 0U;
+        record.isovalue = isovalue;
+        record.filter = filter <= Volume::TRICUBIC ? static_cast<Volume::Filter>(filter) : Volume::TRILINEAR;
+    }
+
+    // Transfer function node count, indices and colors
+    if (((parts & SessionRecorder::TRANSFER_FUNCTION) != 0U) && !SessionPlayer::extractNodes(stream, record.nodes)) {
+        return false;
+    }
+
+    return true;
+}
+
+
+// Constructors
+
+// Session player constructor
+SessionPlayer::SessionPlayer(const std::string &log_path) :
+    path(log_path),
+    next(0U),
+    valid(false) {
+    valid = read();
+}
+
+
+// Getters
+
+// Get the valid status
+bool SessionPlayer::isValid() const {
+    return valid;
+}
+
+// Get the finished status
+bool SessionPlayer::isFinished() const {
+    return next >= records.size();
+}
+
+// Get the number of records
+std::size_t SessionPlayer::getRecords() const {
+    return records.size();
+}
+
+// Get the recorded duration in seconds
+double SessionPlayer::getDuration() const {
+    return records.empty() ? 0.0 : records.back().time;
+}
+
+// Get the time of the next record
+double SessionPlayer::getNextTime() const {
+    return isFinished() ? getDuration() : records[next].time;
+}
+
+
+// Methods
+
+// Apply the records up to the given time
+std::size_t SessionPlayer::advance(Scene *const scene, const double &time) {
+    const std::size_t first = next;
+    while ((next < records.size()) && (records[next].time <= time)) {
+        apply(scene, records[next]);
+        next++;
+    }
+    return next - first;
+}
+
+// Rewind to the first record
+void SessionPlayer::rewind() {
+    next = 0U;
+}
+
+// Render the whole session
+unsigned long long int SessionPlayer::play(Scene *const scene, const bool &realtime) {
+    unsigned long long int frames = 0U;
+
+    // As fast as possible, exactly a frame per record to be deterministic
+    if (!realtime) {
+        while (!isFinished()) {
+            advance(scene, getNextTime());
+            scene->renderFrame();
+            frames++;
+        }
+        return frames;
+    }
+
+    // At real time, drawing only while something changes
+    const double start = SessionPlayer::now();
+    while (!isFinished() || scene->isDirty()) {
+        advance(scene, SessionPlayer::now() - start);
+
+        if (scene->isDirty()) {
+            scene->renderFrame();
+            frames++;
+        }
+
+        // Sleep until the next record
+        else if (!isFinished()) {
+            const double wait = getNextTime() - (SessionPlayer::now() - start);
+            if (wait > 0.0) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+            }
+        }
+    }
+
+    return frames;
+}
+
+
+// Destructor
+
+// Session player destructor
+SessionPlayer::~SessionPlayer() {}
\ No newline at end of file
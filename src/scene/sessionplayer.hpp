@@ -0,0 +1,215 @@
+#ifndef __SESSION_PLAYER_HPP_
+#define __SESSION_PLAYER_HPP_
+
+#include "scene.hpp"
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <string>
+#include <istream>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+/** Replays a session log written by the session recorder on a scene */
+class SessionPlayer {
+    private:
+        // Structures
+
+        /** Decoded added volume */
+        struct Overlay {
+            /** Volume path */
+            std::string dataset;
+
+            /** Volume format */
+            VolumeData::Format format;
+
+            /** Volume resolution */
+            glm::uvec3 dataset_resolution;
+
+            /** Volume position */
+            glm::vec3 position;
+
+            /** Transfer function nodes */
+            std::vector<std::pair<GLubyte, glm::uvec4> > nodes;
+        };
+
+        /** Decoded record, only the parts in the mask are set */
+        struct Record {
+            /** Time since the recording start in seconds */
+            double time;
+
+            /** Recorded parts mask */
+            unsigned int parts;
+
+
+            /** Camera position */
+            glm::vec3 camera_position;
+
+            /** Camera look direction */
+            glm::vec3 camera_direction;
+
+            /** Camera up vector */
+            glm::vec3 camera_up;
+
+            /** Camera field of view in degrees */
+            float fov;
+
+            /** Camera orthogonal projection status */
+            bool orthogonal;
+
+
+            /** Volume position */
+            glm::vec3 volume_position;
+
+            /** Volume rotation */
+            glm::quat volume_rotation;
+
+            /** Volume scale */
+            glm::vec3 volume_scale;
+
+            /** Volume rendering technique */
+            Volume::Technique technique;
+
+            /** Volume composition mode */
+            Volume::Composition composition;
+
+            /** Volume shading status */
+            bool shading;
+
+            /** Volume isovalue */
+            float isovalue;
+
+            /** Volume sampling filter */
+            Volume::Filter filter;
+
+
+            /** Transfer function nodes */
+            std::vector<std::pair<GLubyte, glm::uvec4> > nodes;
+
+
+            /** Volume path */
+            std::string dataset;
+
+            /** Volume format */
+            VolumeData::Format format;
+
+            /** Volume resolution */
+            glm::uvec3 dataset_resolution;
+
+
+            /** Added volumes */
+            std::vector<SessionPlayer::Overlay> overlays;
+
+
+            /** Frame resolution */
+            glm::uvec2 resolution;
+        };
+
+
+        // Attributes
+
+        /** Log file path */
+        std::string path;
+
+        /** Decoded records, in time order */
+        std::vector<SessionPlayer::Record> records;
+
+        /** Next record to apply */
+        std::size_t next;
+
+        /** Valid status */
+        bool valid;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        SessionPlayer() = delete;
+
+        /** Disable the default copy constructor */
+        SessionPlayer(const SessionPlayer &) = delete;
+
+        /** Disable the assignation operator */
+        SessionPlayer &operator=(const SessionPlayer &) = delete;
+
+
+        // Methods
+
+        /** Read and decode the log file */
+        bool read();
+
+        /** Set the recorded parts on the scene */
+        void apply(Scene *const scene, const SessionPlayer::Record &record) const;
+
+
+        // Static methods
+
+        /** Get the steady time in seconds */
+        static double now();
+
+        /** Read the raw bytes of the value, returns false at the end of the stream */
+        template <class T>
+        static bool extract(std::istream &stream, T &value) {
+            return static_cast<bool>(stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+        }
+
+        /** Read the path, format and resolution of a volume, returns false if it is truncated */
+        static bool extractDataset(std::istream &stream, std::string &dataset, VolumeData::Format &format, glm::uvec3 &resolution);
+
+        /** Read the transfer function nodes of a volume, returns false if it is truncated */
+        static bool extractNodes(std::istream &stream, std::vector<std::pair<GLubyte, glm::uvec4> > &nodes);
+
+        /** Read a record of the log format version, returns false at the end of the stream or if it is truncated */
+        static bool extract(std::istream &stream, SessionPlayer::Record &record, const std::uint32_t &version);
+
+
+    public:
+        // Constructors
+
+        /** Session player constructor, reads the whole log */
+        SessionPlayer(const std::string &log_path);
+
+
+        // Getters
+
+        /** Get the valid status */
+        bool isValid() const;
+
+        /** Get the finished status, all the records have been applied */
+        bool isFinished() const;
+
+        /** Get the number of records */
+        std::size_t getRecords() const;
+
+        /** Get the recorded duration in seconds */
+        double getDuration() const;
+
+        /** Get the time of the next record, the duration if finished */
+        double getNextTime() const;
+
+
+        // Methods
+
+        /** Apply the records up to the given time since the recording start, returns the number of applied records */
+        std::size_t advance(Scene *const scene, const double &time);
+
+        /** Rewind to the first record */
+        void rewind();
+
+        /** Render the whole session, a frame per record or at real time, returns the number of rendered frames */
+        unsigned long long int play(Scene *const scene, const bool &realtime);
+
+
+        // Destructor
+
+        /** Session player destructor */
+        virtual ~SessionPlayer();
+};
+
+#endif // __SESSION_PLAYER_HPP_
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "sessionrecorder.hpp"
+
+#include <iostream>
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+
+// Static const attributes
+
+// File signature
+const char SessionRecorder::MAGIC[4] = {'V', 'R', 'S', 'L'};
+
+// Format version
+const std::uint32_t SessionRecorder::VERSION;
+
+
+// Private static methods
+
+// Get the steady time in seconds
+double SessionRecorder::now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Append the path length and characters, format and resolution of the volume
+void SessionRecorder::appendDataset(std::string &buffer, const Volume *const volume) {
+    const std::string volume_path = volume->getPath();
+    const glm::uvec3 resolution = volume->getResolution();
+    SessionRecorder::append(buffer, static_cast<std::uint32_t>(volume_path.size()));
+    buffer.append(volume_path);
+    SessionRecorder::append(buffer, static_cast<std::uint8_t>(volume->getFormat()));
+    SessionRecorder::append(buffer, static_cast<std::uint32_t>(resolution.x));
+    SessionRecorder::append(buffer, static_cast<std::uint32_t>(resolution.y));
+    SessionRecorder::append(buffer, static_cast<std::uint32_t>(resolution.z));
+}
+
+// Append the node count followed by the index and color of every node of the volume transfer function
+void SessionRecorder::appendNodes(std::string &buffer, const Volume *const volume) {
+    const std::vector<std::pair<GLubyte, glm::uvec4> > nodes = volume->getTransferFunction()->getNodes();
+    SessionRecorder::append(buffer, static_cast<std::uint16_t>(nodes.size()));
+    for (const std::pair<GLubyte, glm::uvec4> &node : nodes) {
+        SessionRecorder::append(buffer, static_cast<std::uint8_t>(node.first));
+        SessionRecorder::append(buffer, static_cast<std::uint8_t>(node.second.r));
+        SessionRecorder::append(buffer, static_cast<std::uint8_t>(node.second.g));
+        SessionRecorder::append(buffer, static_cast<std::uint8_t>(node.second.b));
+        SessionRecorder::append(buffer, static_cast<std::uint8_t>(node.second.a));
+    }
+}
+
+// Serialize a state part of the scene
+std::string SessionRecorder::serialize(const Scene *const scene, const SessionRecorder::Part &part) {
+    std::string buffer;
+
+    switch (part) {
+        // Camera pose and projection
+        case SessionRecorder::CAMERA: {
+            const Camera *const camera = scene->getCamera();
+            const glm::vec3 vectors[3] = {camera->getPosition(), camera->getDirection(), camera->getUp()};
+            for (const glm::vec3 &vector : vectors) {
+                SessionRecorder::append(buffer, vector.x);
+                SessionRecorder::append(buffer, vector.y);
+                SessionRecorder::append(buffer, vector.z);
+            }
+            SessionRecorder::append(buffer, camera->getFOV());
+            SessionRecorder::append(buffer, static_cast<std::uint8_t>(camera->isOrthogonal()));
+            break;
+        }
+
+        // Volume transform and render options
+        case SessionRecorder::VOLUME: {
+            const Volume *const volume = scene->getVolume();
+            const glm::vec3 position = volume->getPosition();
+            const glm::quat rotation = volume->getRotation();
+            const glm::vec3 scale = volume->getScale();
+            const float values[10] = {position.x, position.y, position.z, rotation.w, rotation.x, rotation.y, rotation.z, scale.x, scale.y, scale.z};
+            for (const float &value : values) {
+                SessionRecorder::append(buffer, value);
+            }
+            SessionRecorder::append(buffer, static_cast<std::uint8_t>(volume->getTechnique()));
+            SessionRecorder::append(buffer, static_cast<std::uint8_t>(volume->getComposition()));
+            SessionRecorder::append(buffer, static_cast<std::uint8_t>(volume->isShading()));
+            SessionRecorder::append(buffer, volume->getIsovalue());
+            SessionRecorder::append(buffer, static_cast<std::uint8_t>(volume->getFilter()));
+            break;
+        }
+
+        // Node count followed by the index and color of every node
+        case SessionRecorder::TRANSFER_FUNCTION:
+            SessionRecorder::appendNodes(buffer, scene->getVolume());
+            break;
+
+        // Path length and characters, format and resolution
+        case SessionRecorder::DATASET:
+            SessionRecorder::appendDataset(buffer, scene->getVolume());
+            break;
+
+        // Count of the added volumes followed by the dataset, position and transfer function of each
+        case SessionRecorder::OVERLAYS: {
+            const std::vector<Volume *> volumes = scene->getVolumes();
+            SessionRecorder::append(buffer, static_cast<std::uint16_t>(volumes.size() - 1U));
+            for (std::size_t i = 1U; i < volumes.size(); i++) {
+                const glm::vec3 position = volumes[i]->getPosition();
+                SessionRecorder::appendDataset(buffer, volumes[i]);
+                SessionRecorder::append(buffer, position.x);
+                SessionRecorder::append(buffer, position.y);
+                SessionRecorder::append(buffer, position.z);
+                SessionRecorder::appendNodes(buffer, volumes[i]);
+            }
+            break;
+        }
+
+        // Frame width and height
+        case SessionRecorder::RESOLUTION: {
+            const glm::vec2 resolution = scene->getResolution();
+            SessionRecorder::append(buffer, static_cast<std::uint32_t>(resolution.x));
+            SessionRecorder::append(buffer, static_cast<std::uint32_t>(resolution.y));
+            break;
+        }
+    }
+
+    return buffer;
+}
+
+
+// Constructors
+
+// Session recorder constructor
+SessionRecorder::SessionRecorder(const std::string &log_path) :
+    path(log_path),
+    file(log_path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc),
+    origin(SessionRecorder::now()),
+    flushed(origin),
+    records(0U) {
+    // Check the file
+    if (!file.is_open()) {
+        std::cerr << "error: cannot open the session log `" << path << "'" << std::endl;
+        return;
+    }
+
+    // Write the header
+    file.write(SessionRecorder::MAGIC, 4);
+    const std::uint32_t version = SessionRecorder::VERSION;
+    file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+
+    std::cout << "info: recording the session to `" << path << "'" << std::endl;
+}
+
+
+// Getters
+
+// Get the open status
+bool SessionRecorder::isOpen() const {
+    return file.is_open();
+}
+
+// Get the log file path
+std::string SessionRecorder::getPath() const {
+    return path;
+}
+
+// Get the number of written records
+unsigned long long int SessionRecorder::getRecords() const {
+    return records;
+}
+
+
+// Methods
+
+// Write a record with the changed parts
+void SessionRecorder::capture(const Scene *const scene) {
+    // Check the file
+    if (!file.is_open()) {
+        return;
+    }
+
+    // Collect the changed parts, the dataset goes before the states that depend on it
+    static const SessionRecorder::Part order[6] = {SessionRecorder::DATASET, SessionRecorder::OVERLAYS, SessionRecorder::RESOLUTION, SessionRecorder::CAMERA, SessionRecorder::VOLUME, SessionRecorder::TRANSFER_FUNCTION};
+    std::uint8_t parts = 0U;
+    std::string payload;
+    for (std::size_t i = 0U; i < 6U; i++) {
+        std::string state = SessionRecorder::serialize(scene, order[i]);
+        if (state != last[i]) {
+            parts |= static_cast<std::uint8_t>(order[i]);
+            payload.append(state);
+            last[i].swap(state);
+        }
+    }
+
+    // Nothing changed
+    if (parts == 0U) {
+        return;
+    }
+
+    // Write the time, the parts mask and the parts
+    const double time = SessionRecorder::now();
+    const double offset = time - origin;
+    file.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
+    file.write(reinterpret_cast<const char *>(&parts), sizeof(parts));
+    file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    records++;
+
+    // Flush every second to keep the log of a crashed session
+    if (time - flushed > 1.0) {
+        file.flush();
+        flushed = time;
+    }
+}
+
+
+// Destructor
+
+// Session recorder destructor
+SessionRecorder::~SessionRecorder() {
+    if (file.is_open()) {
+        file.close();
+        std::cout << "info: " << records << " session records written to `" << path << "'" << std::endl;
+    }
+}
\ No newline at end of file
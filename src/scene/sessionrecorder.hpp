@@ -0,0 +1,135 @@
+#ifndef __SESSION_RECORDER_HPP_
+#define __SESSION_RECORDER_HPP_
+
+#include "scene.hpp"
+
+#include <string>
+#include <fstream>
+
+#include <cstdint>
+
+
+/** Records the timestamped camera, volume and transfer function states of a scene to a compact binary log */
+class SessionRecorder {
+    public:
+        // Enumerations
+
+        /** State parts of a record, only the changed parts are written */
+        enum Part {
+            /** Camera position, direction, up vector, field of view and projection */
+            CAMERA = 1,
+
+            /** Volume position, rotation, scale, technique, composition, shading, isovalue and sampling filter */
+            VOLUME = 2,
+
+            /** Transfer function nodes */
+            TRANSFER_FUNCTION = 4,
+
+            /** Volume path, format and resolution */
+            DATASET = 8,
+
+            /** Frame resolution */
+            RESOLUTION = 16,
+
+            /** Added volumes, their count followed by the path, format, resolution, position and transfer function nodes of each */
+            OVERLAYS = 32
+        };
+
+
+        // Static const attributes
+
+        /** File signature */
+        static const char MAGIC[4];
+
+        /** Format version, the version 1 logs have no isovalue, the version 2 logs no sampling filter and the version 3 logs no added volumes */
+        static const std::uint32_t VERSION = 4U;
+
+
+    private:
+        // Attributes
+
+        /** Log file path */
+        std::string path;
+
+        /** Log file */
+        std::ofstream file;
+
+        /** Recording start time in seconds */
+        double origin;
+
+        /** Last flush time in seconds */
+        double flushed;
+
+        /** Written records */
+        unsigned long long int records;
+
+
+        /** Last written parts, serialized */
+        std::string last[6];
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        SessionRecorder() = delete;
+
+        /** Disable the default copy constructor */
+        SessionRecorder(const SessionRecorder &) = delete;
+
+        /** Disable the assignation operator */
+        SessionRecorder &operator=(const SessionRecorder &) = delete;
+
+
+        // Static methods
+
+        /** Get the steady time in seconds */
+        static double now();
+
+        /** Append the raw bytes of the value */
+        template <class T>
+        static void append(std::string &buffer, const T &value) {
+            buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        /** Append the path length and characters, format and resolution of the volume */
+        static void appendDataset(std::string &buffer, const Volume *const volume);
+
+        /** Append the node count followed by the index and color of every node of the volume transfer function */
+        static void appendNodes(std::string &buffer, const Volume *const volume);
+
+        /** Serialize a state part of the scene */
+        static std::string serialize(const Scene *const scene, const SessionRecorder::Part &part);
+
+
+    public:
+        // Constructors
+
+        /** Session recorder constructor, truncates the log file */
+        SessionRecorder(const std::string &log_path);
+
+
+        // Getters
+
+        /** Get the open status */
+        bool isOpen() const;
+
+        /** Get the log file path */
+        std::string getPath() const;
+
+        /** Get the number of written records */
+        unsigned long long int getRecords() const;
+
+
+        // Methods
+
+        /** Write a record with the parts changed since the last one, if any */
+        void capture(const Scene *const scene);
+
+
+        // Destructor
+
+        /** Session recorder destructor, closes the log file */
+        virtual ~SessionRecorder();
+};
+
+#endif // __SESSION_RECORDER_HPP_
\ No newline at end of file
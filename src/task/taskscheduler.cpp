@@ -0,0 +1,409 @@
+#include "taskscheduler.hpp"
+
+#include "../profiler/tracer.hpp"
+
+#include <iostream>
+
+#include <algorithm>
+
+
+// Private static const attributes
+
+// Number of priorities
+const std::size_t TaskScheduler::PRIORITIES;
+
+
+// Private static attributes
+
+// Scheduler of the application
+std::atomic<TaskScheduler *> TaskScheduler::active(nullptr);
+
+// Scheduler of the calling worker thread, null for the other threads
+thread_local TaskScheduler *TaskScheduler::owner = nullptr;
+
+// Index of the calling worker thread
+thread_local std::size_t TaskScheduler::worker_index = 0U;
+
+// Task running on the calling thread
+thread_local TaskScheduler::Task *TaskScheduler::current = nullptr;
+
+
+// Private getters
+
+// Get the status of a task the sleeping workers can take
+bool TaskScheduler::isRunnable() const {
+    return (queued[TaskScheduler::INTERACTIVE].load() > 0U) || (queued[TaskScheduler::NORMAL].load() > 0U) || ((queued[TaskScheduler::BACKGROUND].load() > 0U) && (running_background.load() < background_limit));
+}
+
+
+// Private methods
+
+// Queue the task in the deque of the calling worker or in the shared deque
+void TaskScheduler::push(const TaskScheduler::Handle &task) {
+    // The workers keep their own tasks for locality, the others are stolen from the front
+    TaskScheduler::Worker *const target = TaskScheduler::owner == this ? workers[TaskScheduler::worker_index] : &shared;
+    {
+        std::lock_guard<std::mutex> lock(target->mutex);
+        target->tasks[task->priority].push_back(task);
+    }
+    queued[task->priority]++;
+
+    // Wake a sleeping worker, the lock orders the count before its check
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+    }
+    wake.notify_one();
+}
+
+// Claim the next queued task of the priority in the deque
+TaskScheduler::Handle TaskScheduler::pop(TaskScheduler::Worker *const worker, const std::size_t &priority, const bool &back) {
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    std::deque<TaskScheduler::Handle> &tasks = worker->tasks[priority];
+    while (!tasks.empty()) {
+        const TaskScheduler::Handle task = back ? tasks.back() : tasks.front();
+        if (back) {
+            tasks.pop_back();
+        }
+        else {
+            tasks.pop_front();
+        }
+        queued[priority]--;
+
+        // The tasks already claimed by a waiter or cancelled are dropped
+        int expected = TaskScheduler::QUEUED;
+        if (task->state.compare_exchange_strong(expected, TaskScheduler::RUNNING)) {
+            return task;
+        }
+    }
+
+    return TaskScheduler::Handle();
+}
+
+// Claim the next task for the worker
+TaskScheduler::Handle TaskScheduler::take(const std::size_t &index, bool &background) {
+    background = false;
+    for (std::size_t priority = 0U; priority < TaskScheduler::PRIORITIES; priority++) {
+        if (queued[priority].load() == 0U) {
+            continue;
+        }
+
+        // The background tasks leave workers free for the interactive ones
+        if (priority == TaskScheduler::BACKGROUND) {
+            unsigned int running = running_background.load();
+            do {
+                if (running >= background_limit) {
+                    return TaskScheduler::Handle();
+                }
+            } while (!running_background.compare_exchange_weak(running, running + 1U));
+        }
+
+        // Own deque from the back, then the shared deque and the other workers from the front
+        TaskScheduler::Handle task = pop(workers[index], priority, true);
+        if (!task) {
+            task = pop(&shared, priority, false);
+        }
+        for (std::size_t i = 1U; !task && (i < workers.size()); i++) {
+            task = pop(workers[(index + i) % workers.size()], priority, false);
+        }
+
+        if (task) {
+            background = priority == TaskScheduler::BACKGROUND;
+            return task;
+        }
+        if (priority == TaskScheduler::BACKGROUND) {
+            running_background--;
+        }
+    }
+
+    return TaskScheduler::Handle();
+}
+
+// Run the claimed task on the calling thread and record its statistics
+void TaskScheduler::run(const TaskScheduler::Handle &task, const bool &background) {
+    // Run the work unless it was cancelled before, as the current task of the thread
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    TaskScheduler::Task *const previous = TaskScheduler::current;
+    TaskScheduler::current = task.get();
+    bool cancelled = true;
+    if (!TaskScheduler::isCancelled()) {
+        task->work();
+        cancelled = false;
+    }
+    TaskScheduler::current = previous;
+    const std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+    // Signal the waiters
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->state = TaskScheduler::DONE;
+        task->finished.notify_all();
+    }
+    record(task->name, TaskScheduler::getMilliseconds(task->queued, start), TaskScheduler::getMilliseconds(start, stop), cancelled);
+
+    // Release the background slot for the sleeping workers
+    if (background) {
+        running_background--;
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+        }
+        wake.notify_one();
+    }
+}
+
+// Add a task to the statistics of its name
+void TaskScheduler::record(const std::string &name, const double &wait_ms, const double &run_ms, const bool &cancelled) {
+    std::lock_guard<std::mutex> lock(statistics_mutex);
+    std::map<std::string, TaskScheduler::Statistics>::iterator found = statistics.find(name);
+    if (found == statistics.end()) {
+        found = statistics.insert(std::make_pair(name, TaskScheduler::Statistics{0U, 0U, 0.0, 0.0, 0.0})).first;
+    }
+
+    TaskScheduler::Statistics &target = found->second;
+    if (cancelled) {
+        target.cancelled++;
+        return;
+    }
+    target.tasks++;
+    target.run_ms += run_ms;
+    target.wait_ms += wait_ms;
+    target.max_wait_ms = std::max(target.max_wait_ms, wait_ms);
+}
+
+// Run the worker thread until stopped
+void TaskScheduler::loop(const std::size_t &index) {
+    Tracer::setThreadName("worker " + std::to_string(index));
+    TaskScheduler::owner = this;
+    TaskScheduler::worker_index = index;
+
+    while (true) {
+        // Run the next task
+        bool background = false;
+        const TaskScheduler::Handle task = take(index, background);
+        if (task) {
+            run(task, background);
+            continue;
+        }
+
+        // Sleep until a task can be taken or the stop
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this] { return stopping || isRunnable(); });
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+
+// Private static methods
+
+// Get the time in milliseconds between the steady time points
+double TaskScheduler::getMilliseconds(const std::chrono::steady_clock::time_point &start, const std::chrono::steady_clock::time_point &stop) {
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+
+// Constructors
+
+// Task scheduler constructor
+TaskScheduler::TaskScheduler(const unsigned int &threads) :
+    threads(std::max(1U, threads > 0U ? threads : std::thread::hardware_concurrency())),
+    running_background(0U),
+    background_limit(1U),
+    stopping(false) {
+    // The caller helps its parallel loops, so it counts as one of the threads
+    const unsigned int count = std::max(1U, this->threads - 1U);
+    background_limit = std::max(1U, count - 1U);
+    for (std::size_t priority = 0U; priority < TaskScheduler::PRIORITIES; priority++) {
+        queued[priority] = 0U;
+    }
+
+    // Start the workers once all the deques exist
+    for (unsigned int i = 0U; i < count; i++) {
+        workers.push_back(new TaskScheduler::Worker());
+    }
+    for (std::size_t i = 0U; i < workers.size(); i++) {
+        workers[i]->thread = std::thread(&TaskScheduler::loop, this, i);
+    }
+
+    std::cout << "info: task scheduler with " << count << " workers for " << this->threads << " threads, at most " << background_limit << " running background tasks" << std::endl;
+}
+
+
+// Getters
+
+// Get the number of threads running the tasks
+unsigned int TaskScheduler::getThreads() const {
+    return threads;
+}
+
+// Get the statistics by task name
+std::map<std::string, TaskScheduler::Statistics> TaskScheduler::getStatistics() const {
+    std::lock_guard<std::mutex> lock(statistics_mutex);
+    return statistics;
+}
+
+// Get the finished status of the task
+bool TaskScheduler::isDone(const TaskScheduler::Handle &task) const {
+    return task->state.load() == TaskScheduler::DONE;
+}
+
+
+// Methods
+
+// Queue the work
+TaskScheduler::Handle TaskScheduler::submit(const std::function<void()> &work, const TaskScheduler::Priority &priority, const std::string &name) {
+    const TaskScheduler::Handle task = std::make_shared<TaskScheduler::Task>();
+    task->work = work;
+    task->priority = priority;
+    task->name = name;
+    task->queued = std::chrono::steady_clock::now();
+    task->state = TaskScheduler::QUEUED;
+    task->cancelled = false;
+
+    // Keep the running task alive for the cancellation of its children
+    if (TaskScheduler::current != nullptr) {
+        task->parent = TaskScheduler::current->shared_from_this();
+    }
+
+    push(task);
+    return task;
+}
+
+// Wait for the task
+void TaskScheduler::wait(const TaskScheduler::Handle &task) {
+    // Run it here if it is still queued
+    int expected = TaskScheduler::QUEUED;
+    if (task->state.compare_exchange_strong(expected, TaskScheduler::RUNNING)) {
+        run(task, false);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(task->mutex);
+    task->finished.wait(lock, [&task] { return task->state.load() == TaskScheduler::DONE; });
+}
+
+// Cancel the task
+void TaskScheduler::cancel(const TaskScheduler::Handle &task) {
+    task->cancelled = true;
+
+    // A queued task is finished without running
+    int expected = TaskScheduler::QUEUED;
+    if (task->state.compare_exchange_strong(expected, TaskScheduler::DONE)) {
+        {
+            std::lock_guard<std::mutex> lock(task->mutex);
+            task->finished.notify_all();
+        }
+        record(task->name, 0.0, 0.0, true);
+    }
+}
+
+// Run the task over the range in chunks of the grain size on at most the given threads
+bool TaskScheduler::parallel(const std::size_t &count, const std::size_t &grain, const std::function<void(const std::size_t &, const std::size_t &)> &task, const TaskScheduler::Priority &priority, const std::string &name, const unsigned int &threads) {
+    // Every participant takes the next chunk until all of them are taken or the loop is cancelled
+    const std::size_t size = std::max(static_cast<std::size_t>(1U), grain);
+    const std::size_t chunks = (count + size - 1U) / size;
+    std::atomic<std::size_t> next(0U);
+    std::atomic<bool> complete(true);
+    const auto worker = [&task, &next, &complete, count, size, chunks] {
+        for (std::size_t chunk = next++; chunk < chunks; chunk = next++) {
+            if (TaskScheduler::isCancelled()) {
+                complete = false;
+                next = chunks;
+                return;
+            }
+            task(chunk * size, std::min(count, (chunk + 1U) * size));
+        }
+    };
+
+    // Queue the helpers, the idle workers steal them
+    const std::size_t participants = std::min(static_cast<std::size_t>(threads > 0U ? std::min(threads, getThreads()) : getThreads()), chunks);
+    std::vector<TaskScheduler::Handle> helpers;
+    for (std::size_t i = 0U; i + 1U < participants; i++) {
+        helpers.push_back(submit(worker, priority, name));
+    }
+
+    // The caller takes chunks too
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    worker();
+    record(name, 0.0, TaskScheduler::getMilliseconds(start, std::chrono::steady_clock::now()), false);
+
+    // The helpers nobody took have nothing left, only the running ones are waited for
+    for (const TaskScheduler::Handle &helper : helpers) {
+        int expected = TaskScheduler::QUEUED;
+        if (!helper->state.compare_exchange_strong(expected, TaskScheduler::DONE)) {
+            wait(helper);
+        }
+    }
+
+    return complete;
+}
+
+
+// Destructor
+
+// Task scheduler destructor
+TaskScheduler::~TaskScheduler() {
+    // Stop the workers after their running task
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (TaskScheduler::Worker *const worker : workers) {
+        worker->thread.join();
+    }
+
+    // Cancel the tasks left in the deques
+    std::vector<TaskScheduler::Worker *> deques = workers;
+    deques.push_back(&shared);
+    for (TaskScheduler::Worker *const worker : deques) {
+        for (const std::deque<TaskScheduler::Handle> &tasks : worker->tasks) {
+            for (const TaskScheduler::Handle &task : tasks) {
+                cancel(task);
+            }
+        }
+    }
+    for (TaskScheduler::Worker *const worker : workers) {
+        delete worker;
+    }
+
+    if (TaskScheduler::active == this) {
+        TaskScheduler::active = nullptr;
+    }
+
+    // Report the statistics by task name
+    for (const std::pair<const std::string, TaskScheduler::Statistics> &entry : statistics) {
+        const TaskScheduler::Statistics &target = entry.second;
+        std::cout << "info: " << target.tasks << " `" << entry.first << "' tasks ran " << target.run_ms << " ms, waited " << (target.tasks > 0U ? target.wait_ms / static_cast<double>(target.tasks) : 0.0) << " ms on average and " << target.max_wait_ms << " ms at most";
+        if (target.cancelled > 0U) {
+            std::cout << ", " << target.cancelled << " cancelled";
+        }
+        std::cout << std::endl;
+    }
+}
+
+
+// Static getters
+
+// Get the scheduler of the application
+TaskScheduler *TaskScheduler::getActive() {
+    return TaskScheduler::active;
+}
+
+// Get the cancelled status of the task running on the calling thread or of its parents
+bool TaskScheduler::isCancelled() {
+    for (const TaskScheduler::Task *task = TaskScheduler::current; task != nullptr; task = task->parent.get()) {
+        if (task->cancelled.load()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// Static setters
+
+// Set the scheduler of the application
+void TaskScheduler::setActive(TaskScheduler *const scheduler) {
+    TaskScheduler::active = scheduler;
+}
\ No newline at end of file
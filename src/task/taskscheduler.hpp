@@ -0,0 +1,277 @@
+#ifndef __TASK_SCHEDULER_HPP_
+#define __TASK_SCHEDULER_HPP_
+
+#include <string>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/** Work-stealing task scheduler shared by the CPU subsystems, every worker pops its own deque from the back and steals the others from the front, the higher priorities first */
+class TaskScheduler {
+    public:
+        // Enumerations
+
+        /** Task priority, the interactive tasks are taken first */
+        enum Priority {
+            /** Work a frame waits for, like the render rows */
+            INTERACTIVE,
+
+            /** Work the caller waits for outside of the frames */
+            NORMAL,
+
+            /** Preprocessing and encoding nobody waits for, it never takes all the workers */
+            BACKGROUND
+        };
+
+
+        // Structures
+
+        /** Accumulated statistics of the tasks of a name */
+        struct Statistics {
+            /** Finished tasks */
+            unsigned long long int tasks;
+
+            /** Tasks cancelled before they ran */
+            unsigned long long int cancelled;
+
+            /** Total running time in milliseconds */
+            double run_ms;
+
+            /** Total time in the queues in milliseconds */
+            double wait_ms;
+
+            /** Longest time in the queues in milliseconds */
+            double max_wait_ms;
+        };
+
+
+    private:
+        // Enumerations
+
+        /** Task state, a queued task is claimed by the first worker or waiter that swaps its state */
+        enum State {
+            QUEUED,
+            RUNNING,
+            DONE
+        };
+
+
+        // Structures
+
+        /** Submitted task, shared by the deques, the handles and its children */
+        struct Task : public std::enable_shared_from_this<TaskScheduler::Task> {
+            /** Work of the task */
+            std::function<void()> work;
+
+            /** Priority of the task */
+            TaskScheduler::Priority priority;
+
+            /** Name of the statistics */
+            std::string name;
+
+            /** Submission time */
+            std::chrono::steady_clock::time_point queued;
+
+            /** Task state */
+            std::atomic<int> state;
+
+            /** Cancelled status, polled by the running work */
+            std::atomic<bool> cancelled;
+
+            /** Task that submitted this one, its cancellation is inherited */
+            std::shared_ptr<TaskScheduler::Task> parent;
+
+            /** Finished state lock */
+            std::mutex mutex;
+
+            /** Signals the finished state to the waiters */
+            std::condition_variable finished;
+        };
+
+        /** Deques of a worker thread by priority, the shared deques have no thread */
+        struct Worker {
+            /** Queued tasks by priority */
+            std::deque<std::shared_ptr<TaskScheduler::Task> > tasks[TaskScheduler::BACKGROUND + 1];
+
+            /** Deques lock */
+            std::mutex mutex;
+
+            /** Worker thread */
+            std::thread thread;
+        };
+
+
+    public:
+        // Types
+
+        /** Handle of a submitted task */
+        typedef std::shared_ptr<TaskScheduler::Task> Handle;
+
+
+    private:
+        // Static const attributes
+
+        /** Number of priorities */
+        static const std::size_t PRIORITIES = TaskScheduler::BACKGROUND + 1U;
+
+
+        // Attributes
+
+        /** Number of threads of the parallel loops, the workers and the caller */
+        unsigned int threads;
+
+        /** Worker threads */
+        std::vector<TaskScheduler::Worker *> workers;
+
+        /** Deques of the tasks submitted by the other threads */
+        TaskScheduler::Worker shared;
+
+        /** Queued tasks by priority, including the claimed ones not popped yet */
+        std::atomic<std::size_t> queued[TaskScheduler::PRIORITIES];
+
+        /** Running background tasks */
+        std::atomic<unsigned int> running_background;
+
+        /** Maximum number of running background tasks */
+        unsigned int background_limit;
+
+
+        /** Sleeping workers lock */
+        std::mutex sleep_mutex;
+
+        /** Signals a queued task or the stop to the sleeping workers */
+        std::condition_variable wake;
+
+        /** Stop status of the workers */
+        bool stopping;
+
+
+        /** Statistics by task name */
+        std::map<std::string, TaskScheduler::Statistics> statistics;
+
+        /** Statistics lock */
+        mutable std::mutex statistics_mutex;
+
+
+        // Constructors
+
+        /** Disable the default copy constructor */
+        TaskScheduler(const TaskScheduler &) = delete;
+
+        /** Disable the assignation operator */
+        TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+
+        // Getters
+
+        /** Get the status of a task the sleeping workers can take */
+        bool isRunnable() const;
+
+
+        // Methods
+
+        /** Queue the task in the deque of the calling worker or in the shared deque */
+        void push(const TaskScheduler::Handle &task);
+
+        /** Claim the next queued task of the priority in the deque, from the back or the front */
+        TaskScheduler::Handle pop(TaskScheduler::Worker *const worker, const std::size_t &priority, const bool &back);
+
+        /** Claim the next task for the worker, its own deque first, then the shared deque, then the other workers */
+        TaskScheduler::Handle take(const std::size_t &index, bool &background);
+
+        /** Run the claimed task on the calling thread and record its statistics */
+        void run(const TaskScheduler::Handle &task, const bool &background);
+
+        /** Add a task to the statistics of its name */
+        void record(const std::string &name, const double &wait_ms, const double &run_ms, const bool &cancelled);
+
+        /** Run the worker thread until stopped */
+        void loop(const std::size_t &index);
+
+
+        // Static attributes
+
+        /** Scheduler of the application */
+        static std::atomic<TaskScheduler *> active;
+
+        /** Scheduler of the calling worker thread, null for the other threads */
+        static thread_local TaskScheduler *owner;
+
+        /** Index of the calling worker thread */
+        static thread_local std::size_t worker_index;
+
+        /** Task running on the calling thread */
+        static thread_local TaskScheduler::Task *current;
+
+
+        // Static methods
+
+        /** Get the time in milliseconds between the steady time points */
+        static double getMilliseconds(const std::chrono::steady_clock::time_point &start, const std::chrono::steady_clock::time_point &stop);
+
+
+    public:
+        // Constructors
+
+        /** Task scheduler constructor, the threads including the caller default to the number of cores, there is at least one worker for the background tasks */
+        TaskScheduler(const unsigned int &threads = 0U);
+
+
+        // Getters
+
+        /** Get the number of threads running the tasks, the workers and the caller */
+        unsigned int getThreads() const;
+
+        /** Get the statistics by task name */
+        std::map<std::string, TaskScheduler::Statistics> getStatistics() const;
+
+        /** Get the finished status of the task */
+        bool isDone(const TaskScheduler::Handle &task) const;
+
+
+        // Methods
+
+        /** Queue the work, it inherits the cancellation of the task running on the calling thread */
+        TaskScheduler::Handle submit(const std::function<void()> &work, const TaskScheduler::Priority &priority, const std::string &name);
+
+        /** Wait for the task, running it on this thread if nobody took it yet */
+        void wait(const TaskScheduler::Handle &task);
+
+        /** Cancel the task, it does not run if it is still queued and the running work sees it in isCancelled() */
+        void cancel(const TaskScheduler::Handle &task);
+
+        /** Run the task over the range in chunks of the grain size on at most the given threads, all of them by default, the caller takes chunks too and never waits for a queued helper, returns false if cancelled before all the chunks ran */
+        bool parallel(const std::size_t &count, const std::size_t &grain, const std::function<void(const std::size_t &, const std::size_t &)> &task, const TaskScheduler::Priority &priority, const std::string &name, const unsigned int &threads = 0U);
+
+
+        // Destructor
+
+        /** Task scheduler destructor, cancels the queued tasks and joins the workers */
+        virtual ~TaskScheduler();
+
+
+        // Static getters
+
+        /** Get the scheduler of the application */
+        static TaskScheduler *getActive();
+
+        /** Get the cancelled status of the task running on the calling thread or of its parents */
+        static bool isCancelled();
+
+
+        // Static setters
+
+        /** Set the scheduler of the application */
+        static void setActive(TaskScheduler *const scheduler);
+};
+
+#endif // __TASK_SCHEDULER_HPP_
\ No newline at end of file
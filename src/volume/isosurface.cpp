@@ -0,0 +1,178 @@
+#include "isosurface.hpp"
+
+#include "../profiler/profilerscope.hpp"
+
+#include <glm/mat3x3.hpp>
+
+#include <iostream>
+
+#include <chrono>
+#include <vector>
+
+
+// Extraction
+
+// Extraction constructor
+Isosurface::Extraction::Extraction(const GLushort *voxel, const VolumeData::Format &format, const glm::uvec3 &resolution) :
+    marching_cubes(new MarchingCubes(voxel, format, resolution)),
+    extracted(false),
+    isovalue(0.0F) {}
+
+// Get the size of the min max grid and the mesh in bytes
+std::size_t Isosurface::Extraction::getBytes() const {
+    return marching_cubes->getBytes() + sizeof(GLfloat) * vertex_data.size() + sizeof(GLuint) * index_data.size();
+}
+
+// Extraction destructor
+Isosurface::Extraction::~Extraction() {
+    delete marching_cubes;
+}
+
+
+// Constructors
+
+// Isosurface constructor
+Isosurface::Isosurface() :
+    // Buffers
+    vao(GL_FALSE),
+    vbo(GL_FALSE),
+    ebo(GL_FALSE),
+    count(0),
+
+    // Extraction
+    data_revision(0U),
+    uploaded(false),
+    isovalue(0.0F),
+
+    // Statistics
+    vertices(0U),
+    extraction_time(0.0) {
+    // Vertex array object
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+
+    // Vertex and element buffers, the element array binding is kept by the vertex array object
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+
+    // Position and normal attributes
+    const GLsizei stride = static_cast<GLsizei>(6U * sizeof(GLfloat));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, nullptr);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void *>(3U * sizeof(GLfloat)));
+
+    // Unbind vertex array object
+    glBindVertexArray(GL_FALSE);
+}
+
+
+// Getters
+
+// Get the number of triangles
+std::size_t Isosurface::getTriangles() const {
+    return static_cast<std::size_t>(count) / 3U;
+}
+
+// Get the number of vertices
+std::size_t Isosurface::getVertices() const {
+    return vertices;
+}
+
+// Get the time of the last extraction in milliseconds
+double Isosurface::getExtractionTime() const {
+    return extraction_time;
+}
+
+
+// Methods
+
+// Upload the mesh again if the voxels or the isovalue of the volume changed
+void Isosurface::update(const Volume *const volume) {
+    // Nothing to draw without voxels
+    if (!volume->isOpen() || (volume->getVoxels() == nullptr)) {
+        uploaded = false;
+        count = 0;
+        vertices = 0U;
+        return;
+    }
+
+    // Nothing to upload
+    if (uploaded && (data_revision == volume->getDataRevision()) && (isovalue == volume->getIsovalue())) {
+        return;
+    }
+
+    // The volume keeps the extractor and its last mesh with its voxels
+    const ProfilerScope scope("isosurface");
+    Isosurface::Extraction *extraction = static_cast<Isosurface::Extraction *>(volume->getDerived("isosurface"));
+    if (extraction == nullptr) {
+        extraction = new Isosurface::Extraction(volume->getVoxels(), volume->getFormat(), volume->getResolution());
+        volume->setDerived("isosurface", extraction);
+    }
+
+    // Extract the isovalue in raw units if it is not the kept mesh, the data range was stretched by the value scale
+    isovalue = volume->getIsovalue();
+    if (!extraction->extracted || (extraction->isovalue != isovalue)) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const float maximum = volume->getFormat() == VolumeData::RAW8 ? 255.0F : 65535.0F;
+        const float value = isovalue * maximum / volume->getValueScale();
+        extraction->marching_cubes->extract(value, extraction->vertex_data, extraction->index_data);
+        extraction->extracted = true;
+        extraction->isovalue = isovalue;
+        extraction_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "info: isosurface " << isovalue << " extracted in " << extraction_time << " ms with " << extraction->index_data.size() / 3U << " triangles, " << extraction->vertex_data.size() / 6U << " vertices and " << extraction->marching_cubes->getActiveBricks(value) << " active bricks" << std::endl;
+    }
+
+    // Upload the mesh
+    const std::vector<GLfloat> &vertex_data = extraction->vertex_data;
+    const std::vector<GLuint> &index_data = extraction->index_data;
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertex_data.size() * sizeof(GLfloat)), vertex_data.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, GL_FALSE);
+    glBindVertexArray(vao);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(index_data.size() * sizeof(GLuint)), index_data.data(), GL_STATIC_DRAW);
+    glBindVertexArray(GL_FALSE);
+
+    count = static_cast<GLsizei>(index_data.size());
+    vertices = vertex_data.size() / 6U;
+    data_revision = volume->getDataRevision();
+    uploaded = true;
+}
+
+// Draw the mesh with the transfer function color of the isovalue
+void Isosurface::draw(GLSLProgram *const program, const Volume *const volume, const glm::mat4 &view_mat) const {
+    // Check the mesh and program status
+    if ((count == 0) || !volume->isEnabled() || (program == nullptr) || (!program->isValid())) {
+        return;
+    }
+
+    // Bind the transfer function
+    volume->getTransferFunction()->bind(program);
+
+    // Use the program
+    program->use();
+
+    // Set the mesh uniforms, the normals are lit in view space
+    const glm::mat4 model_mat = volume->getModelMatrix() * volume->getVoxelMatrix();
+    program->setUniform("u_model_mat", model_mat);
+    program->setUniform("u_normal_mat", glm::transpose(glm::inverse(glm::mat3(view_mat * model_mat))));
+    program->setUniform("u_isovalue", isovalue);
+
+    // Draw the triangles
+    glBindVertexArray(vao);
+    glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+    glBindVertexArray(GL_FALSE);
+}
+
+
+// Destructor
+
+// Isosurface destructor
+Isosurface::~Isosurface() {
+    glDeleteBuffers(1, &ebo);
+    glDeleteBuffers(1, &vbo);
+    glDeleteVertexArrays(1, &vao);
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#ifndef __ISOSURFACE_HPP_
+#define __ISOSURFACE_HPP_
+
+#include "volume.hpp"
+#include "marchingcubes.hpp"
+#include "../scene/glslprogram.hpp"
+
+#include "../glad/glad.h"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <vector>
+
+
+/** Opaque isosurface of the volume extracted with marching cubes and drawn as an indexed triangle mesh */
+class Isosurface {
+    private:
+        // Structures
+
+        /** Extractor of the voxels and its last mesh, the volume keeps them with its voxels */
+        class Extraction : public VolumeData::Derived {
+            private:
+                // Constructors
+
+                /** Disable the default constructor */
+                Extraction() = delete;
+
+                /** Disable the default copy constructor */
+                Extraction(const Extraction &) = delete;
+
+                /** Disable the assignation operator */
+                Extraction &operator=(const Extraction &) = delete;
+
+
+            public:
+                // Attributes
+
+                /** Extractor of the voxels */
+                MarchingCubes *marching_cubes;
+
+                /** Extracted status */
+                bool extracted;
+
+                /** Extracted data value */
+                float isovalue;
+
+                /** Interleaved positions and normals of the mesh */
+                std::vector<GLfloat> vertex_data;
+
+                /** Triangle vertex indices of the mesh */
+                std::vector<GLuint> index_data;
+
+
+                // Constructors
+
+                /** Extraction constructor, the min max grid of the extractor is built from the voxels that must outlive it */
+                Extraction(const GLushort *voxel, const VolumeData::Format &format, const glm::uvec3 &resolution);
+
+
+                // Getters
+
+                /** Get the size of the min max grid and the mesh in bytes */
+                std::size_t getBytes() const;
+
+
+                // Destructor
+
+                /** Extraction destructor */
+                virtual ~Extraction();
+        };
+
+
+        // Attributes
+
+        /** Vertex array object */
+        GLuint vao;
+
+        /** Vertex buffer object with interleaved positions and normals */
+        GLuint vbo;
+
+        /** Element buffer object */
+        GLuint ebo;
+
+        /** Number of indices */
+        GLsizei count;
+
+
+        /** Data revision of the volume the mesh was uploaded for */
+        unsigned long long int data_revision;
+
+        /** Uploaded status */
+        bool uploaded;
+
+        /** Data value of the uploaded mesh */
+        float isovalue;
+
+
+        /** Number of vertices */
+        std::size_t vertices;
+
+        /** Time of the last extraction in milliseconds */
+        double extraction_time;
+
+
+        // Constructors
+
+        /** Disable the default copy constructor */
+        Isosurface(const Isosurface &) = delete;
+
+        /** Disable the assignation operator */
+        Isosurface &operator=(const Isosurface &) = delete;
+
+
+    public:
+        // Constructors
+
+        /** Isosurface constructor, needs a current OpenGL context */
+        Isosurface();
+
+
+        // Getters
+
+        /** Get the number of triangles */
+        std::size_t getTriangles() const;
+
+        /** Get the number of vertices */
+        std::size_t getVertices() const;
+
+        /** Get the time of the last extraction in milliseconds */
+        double getExtractionTime() const;
+
+
+        // Methods
+
+        /** Upload the mesh again if the voxels or the isovalue of the volume changed, it is extracted only if the volume does not keep the mesh of the isovalue with its voxels */
+        void update(const Volume *const volume);
+
+        /** Draw the mesh with the transfer function color of the isovalue */
+        void draw(GLSLProgram *const program, const Volume *const volume, const glm::mat4 &view_mat) const;
+
+
+        // Destructor
+
+        /** Isosurface destructor */
+        virtual ~Isosurface();
+};
+
+#endif // __ISOSURFACE_HPP_
\ No newline at end of file
@@ -1,15 +1,32 @@
 #include "rawloader.hpp"
 
+#include "../../profiler/profilerscope.hpp"
+#include "../../task/taskscheduler.hpp"
+
+#include <glm/common.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <iostream>
 #include <fstream>
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 
 // Private methods
 
 // Read data from file
 bool RAWLoader::read(const unsigned int &width, const unsigned int &height, const unsigned int &depth) {
+    // Time the phase
+    const ProfilerScope scope("read");
+
     // Open the model file and check it
     std::ifstream file(volume_data->path);
     if (!file.is_open()) {
@@ -20,15 +37,52 @@ bool RAWLoader::read(const unsigned int &width, const unsigned int &height, cons
     // Voxel size
     const std::size_t bytes = volume_data->format == VolumeData::RAW8 ? sizeof(GLubyte) : sizeof(GLushort);
 
-    // Read the resolution
-    volume_data->resolution.x = width;
-    volume_data->resolution.y = height;
-    volume_data->resolution.z = depth;
+    // Grid resolution
+    volume_data->grid.x = width;
+    volume_data->grid.y = height;
+    volume_data->grid.z = depth;
+
+    // Read the whole grid if the region is empty
+    const bool whole = (region_size.x == 0U) || (region_size.y == 0U) || (region_size.z == 0U);
+    const glm::uvec3 end = region_offset + region_size;
+    if (!whole && ((end.x > width) || (end.y > height) || (end.z > depth))) {
+        std::cerr << "error: the region is outside the grid of the volume `" << volume_data->path << "'" << std::endl;
+        return false;
+    }
+
+    // Read the resolution, a stride over the extent reads a single voxel along the axis
+    const glm::uvec3 origin = whole ? glm::uvec3(0U) : region_offset;
+    const glm::uvec3 extent = whole ? volume_data->grid : region_size;
+    region_stride = glm::min(region_stride, glm::max(extent, glm::uvec3(1U)));
+    volume_data->resolution = (extent + region_stride - glm::uvec3(1U)) / region_stride;
+    volume_data->offset = origin;
+    volume_data->stride = region_stride;
 
     // Read the voxel data
-    size = static_cast<std::size_t>(volume_data->resolution.x * volume_data->resolution.y * volume_data->resolution.z);
+    size = static_cast<std::size_t>(volume_data->resolution.x) * static_cast<std::size_t>(volume_data->resolution.y) * static_cast<std::size_t>(volume_data->resolution.z);
     voxel = new GLushort[size];
-    file.read(reinterpret_cast<char *>(voxel), bytes * size);
+    if (region_stride != glm::uvec3(1U)) {
+        file.close();
+        return readStrided(origin, extent);
+    }
+
+    if (whole) {
+        file.read(reinterpret_cast<char *>(voxel), bytes * size);
+    }
+
+    // Read the rows of the region seeking over the rest of the grid
+    else {
+        char *target = reinterpret_cast<char *>(voxel);
+        const std::size_t row = bytes * static_cast<std::size_t>(region_size.x);
+        for (unsigned int z = region_offset.z; z < end.z; z++) {
+            for (unsigned int y = region_offset.y; y < end.y; y++) {
+                const std::size_t first = (static_cast<std::size_t>(z) * height + y) * width + region_offset.x;
+                file.seekg(static_cast<std::streamoff>(bytes * first));
+                file.read(target, static_cast<std::streamsize>(row));
+                target += row;
+            }
+        }
+    }
 
     // Close the file and set the volume open
     file.close();
@@ -36,6 +90,170 @@ bool RAWLoader::read(const unsigned int &width, const unsigned int &height, cons
     return true;
 }
 
+// Read the region downsampled by the stride
+bool RAWLoader::readStrided(const glm::uvec3 &origin, const glm::uvec3 &extent) {
+    if (size == 0U) {
+        return true;
+    }
+
+    // Voxel size and first voxel of the region in the file
+    const std::size_t bytes = volume_data->format == VolumeData::RAW8 ? sizeof(GLubyte) : sizeof(GLushort);
+    const std::size_t width = volume_data->grid.x;
+    const std::size_t height = volume_data->grid.y;
+    const std::size_t first = (static_cast<std::size_t>(origin.z) * height + origin.y) * width + origin.x;
+    const glm::uvec3 &resolution = volume_data->resolution;
+    const std::size_t slab = static_cast<std::size_t>(resolution.x) * resolution.y;
+
+    // Region of the mapped file, null without a mapping
+    const char *source = nullptr;
+
+#if defined(__unix__) || defined(__APPLE__)
+    // Map the file, the pages of the rows skipped by the stride are never read and the read ahead is off without the filter
+    void *mapping = MAP_FAILED;
+    std::size_t length = 0U;
+    const int descriptor = open(volume_data->path.c_str(), O_RDONLY);
+    struct stat status;
+    if ((descriptor >= 0) && (fstat(descriptor, &status) == 0)) {
+        length = static_cast<std::size_t>(status.st_size);
+        if (length < bytes * width * height * volume_data->grid.z) {
+            std::cerr << "error: the volume `" << volume_data->path << "' is smaller than its grid" << std::endl;
+            close(descriptor);
+            return false;
+        }
+
+        mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if ((mapping != MAP_FAILED) && !region_filter) {
+            posix_madvise(mapping, length, POSIX_MADV_RANDOM);
+        }
+    }
+
+    if (descriptor >= 0) {
+        close(descriptor);
+    }
+
+    if (mapping != MAP_FAILED) {
+        source = static_cast<const char *>(mapping) + bytes * first;
+    }
+#endif
+
+    // Downsample the slabs in parallel, from the mapping or from the rows of their stride boxes read by every task into its own buffer
+    TaskScheduler::getActive()->parallel(resolution.z, 1U, [this, source, bytes, width, height, first, slab, &extent](const std::size_t &first_slab, const std::size_t &last_slab) {
+        std::ifstream file;
+        std::vector<char> buffer;
+        if (source == nullptr) {
+            file.open(volume_data->path, std::ifstream::in | std::ifstream::binary);
+        }
+
+        for (unsigned int k = static_cast<unsigned int>(first_slab); k < static_cast<unsigned int>(last_slab); k++) {
+            unsigned int begin = 0U;
+            unsigned int end = 0U;
+            RAWLoader::getBox(k, region_stride.z, extent.z, region_filter, begin, end);
+            const char *rows = nullptr;
+            std::size_t slice = width * height;
+            glm::uvec2 plane(extent.x, extent.y);
+            glm::uvec2 stride(region_stride.x, region_stride.y);
+            if (source != nullptr) {
+                rows = source + bytes * static_cast<std::size_t>(begin) * slice;
+            }
+
+            // Read the rows of the boxes of the slab, all of them with the filter or the middle ones, which are then the rows of the plane
+            else {
+                if (!region_filter) {
+                    plane.y = volume_data->resolution.y;
+                    stride.y = 1U;
+                }
+                slice = static_cast<std::size_t>(plane.x) * plane.y;
+                buffer.resize(bytes * slice * (end - begin));
+                for (unsigned int z = begin; z < end; z++) {
+                    for (unsigned int y = 0U; y < plane.y; y++) {
+                        unsigned int line = y;
+                        if (!region_filter) {
+                            unsigned int line_end = 0U;
+                            RAWLoader::getBox(y, region_stride.y, extent.y, false, line, line_end);
+                        }
+                        file.seekg(static_cast<std::streamoff>(bytes * (first + (static_cast<std::size_t>(z) * height + line) * width)));
+                        file.read(&buffer[bytes * ((z - begin) * slice + static_cast<std::size_t>(y) * plane.x)], static_cast<std::streamsize>(bytes * plane.x));
+                    }
+                }
+                rows = buffer.data();
+            }
+
+            const std::size_t row = source != nullptr ? width : plane.x;
+            if (volume_data->format == VolumeData::RAW8) {
+                reduce(reinterpret_cast<const GLubyte *>(rows), row, slice, end - begin, plane, stride, reinterpret_cast<GLubyte *>(voxel) + k * slab);
+            }
+            else {
+                reduce(reinterpret_cast<const GLushort *>(rows), row, slice, end - begin, plane, stride, voxel + k * slab);
+            }
+        }
+    }, TaskScheduler::NORMAL, "downsample");
+
+#if defined(__unix__) || defined(__APPLE__)
+    if (mapping != MAP_FAILED) {
+        munmap(mapping, length);
+    }
+#endif
+
+    return true;
+}
+
+// Downsample a slab from the rows of its stride boxes
+template <typename T>
+void RAWLoader::reduce(const T *source, const std::size_t &row, const std::size_t &slice, const unsigned int &depth, const glm::uvec2 &plane, const glm::uvec2 &stride, T *const target) {
+    const glm::uvec3 &resolution = volume_data->resolution;
+    std::vector<unsigned long long int> sum(resolution.x);
+
+    // Boxes along the rows, the same for all of them
+    std::vector<unsigned int> row_begin(resolution.x);
+    std::vector<unsigned int> row_end(resolution.x);
+    for (unsigned int i = 0U; i < resolution.x; i++) {
+        RAWLoader::getBox(i, stride.x, plane.x, region_filter, row_begin[i], row_end[i]);
+    }
+
+    for (unsigned int j = 0U; j < resolution.y; j++) {
+        unsigned int begin = 0U;
+        unsigned int end = 0U;
+        RAWLoader::getBox(j, stride.y, plane.y, region_filter, begin, end);
+
+        // Sum the boxes of the row over their rows
+        std::fill(sum.begin(), sum.end(), 0ULL);
+        for (unsigned int z = 0U; z < depth; z++) {
+            for (unsigned int y = begin; y < end; y++) {
+                const T *const line = source + static_cast<std::size_t>(z) * slice + static_cast<std::size_t>(y) * row;
+                for (unsigned int i = 0U; i < resolution.x; i++) {
+                    unsigned long long int box = 0ULL;
+                    for (unsigned int x = row_begin[i]; x < row_end[i]; x++) {
+                        box += line[x];
+                    }
+                    sum[i] += box;
+                }
+            }
+        }
+
+        // Average the boxes rounding to the nearest, the boxes at the upper end of the region may be cut
+        const unsigned long long int rows = static_cast<unsigned long long int>(depth) * (end - begin);
+        T *const output = target + static_cast<std::size_t>(j) * resolution.x;
+        for (unsigned int i = 0U; i < resolution.x; i++) {
+            const unsigned long long int count = rows * (row_end[i] - row_begin[i]);
+            output[i] = static_cast<T>((sum[i] + (count >> 1U)) / count);
+        }
+    }
+}
+
+// Static methods
+
+// Get the range of the region coordinates along an axis averaged by the read voxel of the index
+void RAWLoader::getBox(const unsigned int &index, const unsigned int &stride, const unsigned int &extent, const bool &filter, unsigned int &begin, unsigned int &end) {
+    if (filter) {
+        begin = index * stride;
+        end = std::min(begin + stride, extent);
+    }
+    else {
+        begin = std::min(index * stride + (stride >> 1U), extent - 1U);
+        end = begin + 1U;
+    }
+}
+
 
 // Constructor
 
@@ -3,6 +3,8 @@
 
 #include "volumeloader.hpp"
 
+#include <glm/vec2.hpp>
+
 
 /** Raw volume loader class */
 class RAWLoader : public VolumeLoader {
@@ -12,6 +14,18 @@ class RAWLoader : public VolumeLoader {
         /** Read file */
         virtual bool read(const unsigned int &width = 0U, const unsigned int &height = 0U, const unsigned int &depth = 0U);
 
+        /** Read the region of the given origin and extent downsampled by the stride, from a mapping of the file touching only the rows it needs or by seeking to the rows of the stride boxes of every slab */
+        bool readStrided(const glm::uvec3 &origin, const glm::uvec3 &extent);
+
+        /** Downsample a slab to the target from the rows of its stride boxes, depth slices of a plane of rows separated by the given numbers of voxels, with the stride along the rows and across them */
+        template <typename T>
+        void reduce(const T *source, const std::size_t &row, const std::size_t &slice, const unsigned int &depth, const glm::uvec2 &plane, const glm::uvec2 &stride, T *const target);
+
+        // Static methods
+
+        /** Get the range of the region coordinates along an axis averaged by the read voxel of the index, only the middle one without the filter */
+        static void getBox(const unsigned int &index, const unsigned int &stride, const unsigned int &extent, const bool &filter, unsigned int &begin, unsigned int &end);
+
 
     public:
         // Constructors
@@ -14,19 +14,39 @@ VolumeData::VolumeData(const std::string &path, const VolumeData::Format &format
     
     // Resolution
     resolution(0U),
+    grid(0U),
+    offset(0U),
+    stride(1U),
+    value_scale(1.0F),
 
     // Buffers
     vao(GL_FALSE),
     vbo(GL_FALSE),
 
     // Textures array
-    texture(GL_FALSE) {}
+    texture(GL_FALSE),
+
+    // Host voxels
+    voxel(nullptr),
+    voxels(0U),
+
+    // Derived structures
+    derived() {}
 
 
 // Destructor
 
+// Derived structure destructor
+VolumeData::Derived::~Derived() {}
+
 // Volume data destructor
 VolumeData::~VolumeData() {
+    // Derived structures
+    for (const std::pair<const std::string, VolumeData::Derived *> &structure : derived) {
+        delete structure.second;
+    }
+    derived.clear();
+
     // Vertex buffer object
     if (vbo != GL_FALSE) {
         glDeleteBuffers(1, &vbo);
@@ -44,4 +64,8 @@ VolumeData::~VolumeData() {
         glDeleteTextures(1, &texture);
         texture = GL_FALSE;
     }
+
+    // Host voxels
+    delete[] voxel;
+    voxel = nullptr;
 }
\ No newline at end of file
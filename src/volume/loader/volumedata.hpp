@@ -4,6 +4,7 @@
 #include "../../glad/glad.h"
 #include <glm/vec3.hpp>
 
+#include <map>
 #include <string>
 
 
@@ -41,6 +42,24 @@ class VolumeData {
         };
 
 
+        // Structures
+
+        /** Structure computed from the voxels by a renderer, kept and cached with the voxels so switching back to them does not compute it again */
+        class Derived {
+            public:
+                // Getters
+
+                /** Get the size in bytes */
+                virtual std::size_t getBytes() const = 0;
+
+
+                // Destructor
+
+                /** Derived structure destructor */
+                virtual ~Derived();
+        };
+
+
         // Attributes
 
         /** Open status */
@@ -57,6 +76,18 @@ class VolumeData {
         /** Resolution */
         glm::uvec3 resolution;
 
+        /** Resolution of the whole grid in the file, larger than the resolution if a region was read */
+        glm::uvec3 grid;
+
+        /** Offset of the read region in the grid */
+        glm::uvec3 offset;
+
+        /** Voxels of the grid per read voxel along every axis, larger than one if the region was downsampled */
+        glm::uvec3 stride;
+
+        /** Scale to stretch the used range of the data to the unit range */
+        float value_scale;
+
 
         /** Vertex array object */
         GLuint vao;
@@ -69,6 +100,17 @@ class VolumeData {
         GLuint texture;
 
 
+        /** Host copy of the voxels, x fastest, bytes for RAW8 and shorts for RAW16 */
+        GLushort *voxel;
+
+        /** Number of voxels */
+        std::size_t voxels;
+
+
+        /** Structures computed from the voxels by the renderers by name, owned with the voxels, they are not part of the volume state */
+        mutable std::map<std::string, VolumeData::Derived *> derived;
+
+
         // Constructor
 
         /** Volume data constructor */
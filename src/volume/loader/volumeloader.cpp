@@ -3,8 +3,14 @@
 #include "rawloader.hpp"
 #include "pvmloader.hpp"
 
+#include "../../profiler/profilerscope.hpp"
+
+#include <glm/common.hpp>
+
 #include <iostream>
 
+#include <algorithm>
+
 
 // Private constructors
 
@@ -15,35 +21,30 @@ VolumeLoader::VolumeLoader(const std::string &path, const VolumeData::Format &fo
 
     // Voxel data
     voxel(nullptr),
-    size(0U) {}
+    size(0U),
+
+    // Region
+    region_offset(0U),
+    region_size(0U),
+    region_stride(1U),
+    region_filter(true) {}
 
 
 // Private methods
 
 // Load data to GPU
 void VolumeLoader::load() {
-    // Generate and load textures
-    const GLenum bytes = volume_data->format == VolumeData::RAW8 ? GL_UNSIGNED_BYTE : GL_UNSIGNED_SHORT;
-    glGenTextures(1, &volume_data->texture);
+    // Time the phase
+    const ProfilerScope scope("upload");
 
-    // Bind texture
-    glBindTexture(GL_TEXTURE_3D, volume_data->texture);
-
-    // Texture parameters
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-
-    // Load texture
-    const unsigned int x = volume_data->resolution.x;
-    const unsigned int y = volume_data->resolution.y;
-    const unsigned int z = volume_data->resolution.z;
-    glTexImage3D(GL_TEXTURE_3D, 0, GL_RED, x, y, z, 0, GL_RED, bytes, voxel);
+    // Stretch the used range of the 16 bits data, usually 12 bits
+    if ((volume_data->format == VolumeData::RAW16) && (size > 0U)) {
+        const GLushort maximum = *std::max_element(voxel, voxel + size);
+        volume_data->value_scale = maximum == 0U ? 1.0F : 65535.0F / static_cast<float>(maximum);
+    }
 
-    // Unbind texture
-    glBindTexture(GL_TEXTURE_3D, GL_FALSE);
+    // Load the texture
+    VolumeLoader::upload(volume_data, voxel);
 
 
     // Vertex array object
@@ -80,7 +81,10 @@ VolumeLoader::~VolumeLoader() {
 // Public static methods
 
 // Read and load data
-VolumeData *VolumeLoader::load(const std::string &path, const VolumeData::Format &format, const unsigned int &width, const unsigned int &height, const unsigned int &depth) {
+VolumeData *VolumeLoader::load(const std::string &path, const VolumeData::Format &format, const unsigned int &width, const unsigned int &height, const unsigned int &depth, const glm::uvec3 &offset, const glm::uvec3 &size, const glm::uvec3 &stride, const bool &filter) {
+    // Time the phase
+    const ProfilerScope scope("load");
+
     // Create a null volume loader
     VolumeLoader *loader = nullptr;
 
@@ -99,10 +103,19 @@ VolumeData *VolumeLoader::load(const std::string &path, const VolumeData::Format
             return new VolumeData(path);
     }
 
-    // Read and load data
+    // Set the region to read and its stride, at least one voxel
+    loader->region_offset = offset;
+    loader->region_size = size;
+    loader->region_stride = glm::max(stride, glm::uvec3(1U));
+    loader->region_filter = filter;
+
+    // Read and load data, the voxels are kept on the host
     if (loader->read(width, height, depth)) {
         loader->volume_data->open = true;
         loader->load();
+        loader->volume_data->voxel = loader->voxel;
+        loader->volume_data->voxels = loader->size;
+        loader->voxel = nullptr;
     }
 
     // Get the volume data and delete loader
@@ -111,4 +124,32 @@ VolumeData *VolumeLoader::load(const std::string &path, const VolumeData::Format
 
     // Return the volume data
     return volume_data;
+}
+
+// Upload the voxels to a new texture of the volume data
+void VolumeLoader::upload(VolumeData *const volume_data, const GLushort *const voxel) {
+    // Generate and load textures
+    const GLenum bytes = volume_data->format == VolumeData::RAW8 ? GL_UNSIGNED_BYTE : GL_UNSIGNED_SHORT;
+    glGenTextures(1, &volume_data->texture);
+
+    // Bind texture
+    glBindTexture(GL_TEXTURE_3D, volume_data->texture);
+
+    // Texture parameters
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+    // Load texture
+    const unsigned int x = volume_data->resolution.x;
+    const unsigned int y = volume_data->resolution.y;
+    const unsigned int z = volume_data->resolution.z;
+    const GLint internal_format = volume_data->format == VolumeData::RAW8 ? GL_R8 : GL_R16;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage3D(GL_TEXTURE_3D, 0, internal_format, x, y, z, 0, GL_RED, bytes, voxel);
+
+    // Unbind texture
+    glBindTexture(GL_TEXTURE_3D, GL_FALSE);
 }
\ No newline at end of file
@@ -42,6 +42,19 @@ class VolumeLoader {
         std::size_t size;
 
 
+        /** Offset of the region to read */
+        glm::uvec3 region_offset;
+
+        /** Size of the region to read, zero for the whole grid */
+        glm::uvec3 region_size;
+
+        /** Voxels of the region per read voxel along every axis */
+        glm::uvec3 region_stride;
+
+        /** Average the voxels of every stride box instead of taking the middle one */
+        bool region_filter;
+
+
         // Methods
 
         /** Read file */
@@ -60,8 +73,11 @@ class VolumeLoader {
 
         // Static methods
 
-        /** Read volume */
-        static VolumeData *load(const std::string &path, const VolumeData::Format &format = VolumeData::UNKOWN, const unsigned int &width = 0U, const unsigned int &height = 0U, const unsigned int &depth = 0U);
+        /** Read volume, only the region of the grid with the given offset and size if the size is not zero, downsampled by the stride with a box filter or by taking the middle voxel of every stride box */
+        static VolumeData *load(const std::string &path, const VolumeData::Format &format = VolumeData::UNKOWN, const unsigned int &width = 0U, const unsigned int &height = 0U, const unsigned int &depth = 0U, const glm::uvec3 &offset = glm::uvec3(0U), const glm::uvec3 &size = glm::uvec3(0U), const glm::uvec3 &stride = glm::uvec3(1U), const bool &filter = true);
+
+        /** Upload the voxels of the resolution and format of the volume data to a new texture of it */
+        static void upload(VolumeData *const volume_data, const GLushort *const voxel);
 };
 
 #endif // __VOLUME_LOADER_HPP_
\ No newline at end of file
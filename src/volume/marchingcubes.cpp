@@ -0,0 +1,356 @@
+#include "marchingcubes.hpp"
+
+#include "../task/taskscheduler.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/vec2.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <atomic>
+
+
+// Cell geometry
+
+/** Corner offsets of a cell */
+static const unsigned int CORNERS[8][3] = {{0U, 0U, 0U}, {1U, 0U, 0U}, {1U, 1U, 0U}, {0U, 1U, 0U}, {0U, 0U, 1U}, {1U, 0U, 1U}, {1U, 1U, 1U}, {0U, 1U, 1U}};
+
+/** Corners joined by every edge */
+static const unsigned int EDGES[12][2] = {{0U, 1U}, {1U, 2U}, {2U, 3U}, {3U, 0U}, {4U, 5U}, {5U, 6U}, {6U, 7U}, {7U, 4U}, {0U, 4U}, {1U, 5U}, {2U, 6U}, {3U, 7U}};
+
+/** Corners of every face, counterclockwise seen from outside the cell */
+static const unsigned int FACES[6][4] = {{0U, 3U, 2U, 1U}, {4U, 5U, 6U, 7U}, {0U, 1U, 5U, 4U}, {3U, 7U, 6U, 2U}, {0U, 4U, 7U, 3U}, {1U, 2U, 6U, 5U}};
+
+
+/** Get whether the edge lies on the face */
+static bool isOnFace(const unsigned int &edge, const unsigned int (&face)[4]) {
+    return (std::count(face, face + 4, EDGES[edge][0]) != 0) && (std::count(face, face + 4, EDGES[edge][1]) != 0);
+}
+
+/** Get whether both edges lie on a common face */
+static bool isCoplanar(const unsigned int &a, const unsigned int &b) {
+    for (const unsigned int (&face)[4] : FACES) {
+        if (isOnFace(a, face) && isOnFace(b, face)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// Private methods
+
+// March the active bricks of the z slab
+template <typename T>
+void MarchingCubes::march(const T *data, const float &value, const unsigned int &slab, MarchingCubes::EdgeCache &cache, MarchingCubes::Slab &output) const {
+    // Active bricks of the slab
+    const glm::uvec3 bricks = min_max_grid->getBricks();
+    std::vector<glm::uvec2> active;
+    for (unsigned int by = 0U; by < bricks.y; by++) {
+        for (unsigned int bx = 0U; bx < bricks.x; bx++) {
+            if (min_max_grid->isActive(glm::uvec3(bx, by, slab), value)) {
+                active.push_back(glm::uvec2(bx, by));
+            }
+        }
+    }
+
+    if (active.empty()) {
+        return;
+    }
+
+    // Voxel strides
+    const std::size_t width = resolution.x;
+    const std::size_t plane = width * resolution.y;
+    const std::size_t offset[8] = {0U, 1U, width + 1U, width, plane, plane + 1U, plane + width + 1U, plane + width};
+
+    // Stamps are unique to every plane of every slab
+    const unsigned int base = slab * (resolution.z + 1U) + 1U;
+
+    // Clamped voxel value
+    const auto sample = [&](const unsigned int &x, const unsigned int &y, const unsigned int &z) {
+        return static_cast<float>(data[z * plane + y * width + x]);
+    };
+
+    // Central differences gradient
+    const auto gradient = [&](const unsigned int &x, const unsigned int &y, const unsigned int &z) {
+        return glm::vec3(
+            sample(std::min(x + 1U, resolution.x - 1U), y, z) - sample(x > 0U ? x - 1U : 0U, y, z),
+            sample(x, std::min(y + 1U, resolution.y - 1U), z) - sample(x, y > 0U ? y - 1U : 0U, z),
+            sample(x, y, std::min(z + 1U, resolution.z - 1U)) - sample(x, y, z > 0U ? z - 1U : 0U));
+    };
+
+    // Vertex on the edge from the voxel along the axis, shared through the cache
+    const auto vertex = [&](const unsigned int &x, const unsigned int &y, const unsigned int &z, const unsigned int &axis) {
+        // Look up the cache, the z edges belong to the layer of cells and the others to the voxel plane
+        const std::size_t slot = axis == 2U ? 4U : ((z & 1U) << 1) + axis;
+        const std::size_t entry = slot * plane + y * width + x;
+        const unsigned int stamp = base + z;
+        if (cache.stamp[entry] == stamp) {
+            return cache.index[entry];
+        }
+
+        // Interpolate the crossing
+        const unsigned int end[3] = {x + (axis == 0U ? 1U : 0U), y + (axis == 1U ? 1U : 0U), z + (axis == 2U ? 1U : 0U)};
+        const float a = sample(x, y, z);
+        const float b = sample(end[0], end[1], end[2]);
+        const float t = b != a ? (value - a) / (b - a) : 0.5F;
+        glm::vec3 position(x, y, z);
+        position[static_cast<int>(axis)] += t;
+
+        // The normal points to the lower values
+        const glm::vec3 slope = glm::mix(gradient(x, y, z), gradient(end[0], end[1], end[2]), t);
+        const float length = glm::length(slope);
+        const glm::vec3 normal = length > 0.0F ? -slope / length : glm::vec3(0.0F);
+
+        // Store the vertex
+        const GLuint index = static_cast<GLuint>(output.vertices.size() / 6U);
+        const GLfloat attributes[6] = {position.x, position.y, position.z, normal.x, normal.y, normal.z};
+        output.vertices.insert(output.vertices.end(), attributes, attributes + 6);
+        cache.index[entry] = index;
+        cache.stamp[entry] = stamp;
+        return index;
+    };
+
+    // Smallest raw value on the inside
+    const unsigned int threshold = static_cast<unsigned int>(std::ceil(std::max(value, 0.0F)));
+
+    // March the layers of cells in order so the planes of the cache are reused
+    const unsigned int z0 = slab * MinMaxGrid::BRICK;
+    const unsigned int z1 = std::min(z0 + MinMaxGrid::BRICK, resolution.z - 1U);
+    for (unsigned int z = z0; z < z1; z++) {
+        for (const glm::uvec2 &brick : active) {
+            const unsigned int x0 = brick.x * MinMaxGrid::BRICK;
+            const unsigned int y0 = brick.y * MinMaxGrid::BRICK;
+            const unsigned int x1 = std::min(x0 + MinMaxGrid::BRICK, resolution.x - 1U);
+            const unsigned int y1 = std::min(y0 + MinMaxGrid::BRICK, resolution.y - 1U);
+            for (unsigned int y = y0; y < y1; y++) {
+                for (unsigned int x = x0; x < x1; x++) {
+                    // Classify the corners, the integer threshold avoids converting them
+                    const T *const corner = data + z * plane + y * width + x;
+                    unsigned int index = 0U;
+                    for (unsigned int i = 0U; i < 8U; i++) {
+                        index |= (corner[offset[i]] >= threshold ? 1U : 0U) << i;
+                    }
+
+                    // Most cells of an active brick are not crossed
+                    if ((index == 0U) || (index == 255U)) {
+                        continue;
+                    }
+
+                    // Emit the triangles of the case
+                    for (const GLubyte &edge : MarchingCubes::TRIANGLES[index]) {
+                        const unsigned int *const first = CORNERS[EDGES[edge][0]];
+                        const unsigned int *const second = CORNERS[EDGES[edge][1]];
+                        const unsigned int axis = first[0] != second[0] ? 0U : (first[1] != second[1] ? 1U : 2U);
+                        output.indices.push_back(vertex(x + std::min(first[0], second[0]), y + std::min(first[1], second[1]), z + std::min(first[2], second[2]), axis));
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+// Static attributes
+
+// Triangle edges of every corner case
+const std::vector<std::vector<GLubyte> > MarchingCubes::TRIANGLES = MarchingCubes::buildTriangles();
+
+
+// Static methods
+
+// Clip the ears of the loop without cutting across a face
+bool MarchingCubes::triangulate(const std::vector<GLubyte> &loop, std::vector<GLubyte> &triangles) {
+    // Last triangle
+    const std::size_t size = loop.size();
+    if (size == 3U) {
+        triangles.insert(triangles.end(), loop.begin(), loop.end());
+        return true;
+    }
+
+    // Try every ear whose diagonal leaves the faces, backtracking on failure
+    for (std::size_t i = 0U; i < size; i++) {
+        const GLubyte previous = loop[(i + size - 1U) % size];
+        const GLubyte following = loop[(i + 1U) % size];
+        if (isCoplanar(previous, following)) {
+            continue;
+        }
+
+        const std::size_t emitted = triangles.size();
+        triangles.push_back(previous);
+        triangles.push_back(loop[i]);
+        triangles.push_back(following);
+
+        std::vector<GLubyte> rest(loop);
+        rest.erase(rest.begin() + static_cast<std::ptrdiff_t>(i));
+        if (MarchingCubes::triangulate(rest, triangles)) {
+            return true;
+        }
+        triangles.resize(emitted);
+    }
+
+    return false;
+}
+
+// Build the triangle edges of every corner case
+std::vector<std::vector<GLubyte> > MarchingCubes::buildTriangles() {
+    // Edge joining two corners
+    const auto edge = [](const unsigned int &a, const unsigned int &b) {
+        for (unsigned int i = 0U; i < 12U; i++) {
+            if (((EDGES[i][0] == a) && (EDGES[i][1] == b)) || ((EDGES[i][0] == b) && (EDGES[i][1] == a))) {
+                return i;
+            }
+        }
+        return 12U;
+    };
+
+    std::vector<std::vector<GLubyte> > table(256U);
+    for (unsigned int index = 1U; index < 255U; index++) {
+        // Every run of inside corners of a face cuts it from the edge entering the run to the edge leaving it
+        int next[12];
+        std::fill(next, next + 12, -1);
+        for (const unsigned int (&face)[4] : FACES) {
+            for (unsigned int k = 0U; k < 4U; k++) {
+                const bool inside = ((index >> face[k]) & 1U) != 0U;
+                const bool entering = ((index >> face[(k + 1U) & 3U]) & 1U) != 0U;
+                if (inside || !entering) {
+                    continue;
+                }
+
+                for (unsigned int m = k + 1U; m < k + 4U; m++) {
+                    const bool current = ((index >> face[m & 3U]) & 1U) != 0U;
+                    const bool following = ((index >> face[(m + 1U) & 3U]) & 1U) != 0U;
+                    if (current && !following) {
+                        next[edge(face[k], face[(k + 1U) & 3U])] = static_cast<int>(edge(face[m & 3U], face[(m + 1U) & 3U]));
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Every crossed edge enters one face and leaves the neighbour one, the cuts close into loops
+        bool visited[12] = {false, false, false, false, false, false, false, false, false, false, false, false};
+        for (unsigned int start = 0U; start < 12U; start++) {
+            if ((next[start] < 0) || visited[start]) {
+                continue;
+            }
+
+            std::vector<GLubyte> loop;
+            for (int i = static_cast<int>(start); !visited[i]; i = next[i]) {
+                visited[i] = true;
+                loop.push_back(static_cast<GLubyte>(i));
+            }
+
+            // Fan the loop if every triangulation has a diagonal on a face, that neighbour cells would also draw
+            if (!MarchingCubes::triangulate(loop, table[index])) {
+                for (std::size_t i = 1U; i + 1U < loop.size(); i++) {
+                    table[index].push_back(loop[0]);
+                    table[index].push_back(loop[i]);
+                    table[index].push_back(loop[i + 1U]);
+                }
+            }
+        }
+    }
+
+    return table;
+}
+
+
+// Constructors
+
+// Marching cubes constructor
+MarchingCubes::MarchingCubes(const GLushort *voxel, const VolumeData::Format &format, const glm::uvec3 &resolution, const unsigned int &threads) :
+    voxel(voxel),
+    format(format),
+    resolution(resolution),
+    threads(threads > 0U ? threads : TaskScheduler::getActive()->getThreads()),
+    min_max_grid(new MinMaxGrid(voxel, format, resolution, this->threads)) {}
+
+
+// Getters
+
+// Get the number of active bricks of the raw value
+std::size_t MarchingCubes::getActiveBricks(const float &value) const {
+    const glm::uvec3 bricks = min_max_grid->getBricks();
+    std::size_t count = 0U;
+    for (unsigned int z = 0U; z < bricks.z; z++) {
+        for (unsigned int y = 0U; y < bricks.y; y++) {
+            for (unsigned int x = 0U; x < bricks.x; x++) {
+                if (min_max_grid->isActive(glm::uvec3(x, y, z), value)) {
+                    count++;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// Get the size of the min max grid in bytes
+std::size_t MarchingCubes::getBytes() const {
+    const glm::uvec3 bricks = min_max_grid->getBricks();
+    return 2U * sizeof(GLushort) * static_cast<std::size_t>(bricks.x) * static_cast<std::size_t>(bricks.y) * static_cast<std::size_t>(bricks.z);
+}
+
+
+// Methods
+
+// Extract the isosurface of the raw value
+void MarchingCubes::extract(const float &value, std::vector<GLfloat> &vertices, std::vector<GLuint> &indices) const {
+    vertices.clear();
+    indices.clear();
+
+    // Check the grid
+    const unsigned int slabs = min_max_grid->getBricks().z;
+    if (slabs == 0U) {
+        return;
+    }
+
+    // The threads take the next slab until all of them are marched, every thread with its edge cache
+    std::vector<MarchingCubes::Slab> output(slabs);
+    std::atomic<unsigned int> next(0U);
+    const auto worker = [this, &value, &output, &next, slabs] {
+        MarchingCubes::EdgeCache cache;
+        const std::size_t plane = static_cast<std::size_t>(resolution.x) * resolution.y;
+        cache.index.resize(5U * plane);
+        cache.stamp.assign(5U * plane, 0U);
+        for (unsigned int slab = next++; slab < slabs; slab = next++) {
+            if (format == VolumeData::RAW8) {
+                march(reinterpret_cast<const GLubyte *>(voxel), value, slab, cache, output[slab]);
+            }
+            else {
+                march(voxel, value, slab, cache, output[slab]);
+            }
+        }
+    };
+
+    const unsigned int count = std::min(threads, slabs);
+    TaskScheduler::getActive()->parallel(count, 1U, [&worker](const std::size_t &, const std::size_t &) {
+        worker();
+    }, TaskScheduler::INTERACTIVE, "isosurface", count);
+
+    // Concatenate the slabs in order, the vertices of the slab boundaries are not shared
+    std::size_t vertices_size = 0U;
+    std::size_t indices_size = 0U;
+    for (const MarchingCubes::Slab &slab : output) {
+        vertices_size += slab.vertices.size();
+        indices_size += slab.indices.size();
+    }
+    vertices.reserve(vertices_size);
+    indices.reserve(indices_size);
+    for (const MarchingCubes::Slab &slab : output) {
+        const GLuint first = static_cast<GLuint>(vertices.size() / 6U);
+        vertices.insert(vertices.end(), slab.vertices.begin(), slab.vertices.end());
+        for (const GLuint &index : slab.indices) {
+            indices.push_back(first + index);
+        }
+    }
+}
+
+
+// Destructor
+
+// Marching cubes destructor
+MarchingCubes::~MarchingCubes() {
+    delete min_max_grid;
+}
\ No newline at end of file
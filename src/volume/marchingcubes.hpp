@@ -0,0 +1,118 @@
+#ifndef __MARCHING_CUBES_HPP_
+#define __MARCHING_CUBES_HPP_
+
+#include "minmaxgrid.hpp"
+#include "loader/volumedata.hpp"
+
+#include "../glad/glad.h"
+
+#include <glm/vec3.hpp>
+
+#include <vector>
+
+
+/** Marching cubes isosurface extraction on parallel threads, the z slabs of the min max grid are marched skipping its inactive bricks and the vertices of a slab are shared through edge caches */
+class MarchingCubes {
+    private:
+        // Structures
+
+        /** Triangles of a slab */
+        struct Slab {
+            /** Interleaved positions and normals in voxels */
+            std::vector<GLfloat> vertices;
+
+            /** Triangle vertex indices within the slab */
+            std::vector<GLuint> indices;
+        };
+
+        /** Vertex indices of the cell edges of a thread, stamped to reuse them without clearing */
+        struct EdgeCache {
+            /** X and y edges of two voxel planes followed by the z edges of a layer of cells */
+            std::vector<GLuint> index;
+
+            /** Stamps of the plane or layer the indices belong to */
+            std::vector<unsigned int> stamp;
+        };
+
+
+        // Attributes
+
+        /** Host voxels, bytes for RAW8 and shorts for RAW16 */
+        const GLushort *voxel;
+
+        /** Voxel format */
+        VolumeData::Format format;
+
+        /** Resolution */
+        glm::uvec3 resolution;
+
+        /** Number of parallel threads */
+        unsigned int threads;
+
+        /** Minimum and maximum values of the bricks */
+        MinMaxGrid *min_max_grid;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        MarchingCubes() = delete;
+
+        /** Disable the default copy constructor */
+        MarchingCubes(const MarchingCubes &) = delete;
+
+        /** Disable the assignation operator */
+        MarchingCubes &operator=(const MarchingCubes &) = delete;
+
+
+        // Methods
+
+        /** March the active bricks of the z slab */
+        template <typename T>
+        void march(const T *data, const float &value, const unsigned int &slab, MarchingCubes::EdgeCache &cache, MarchingCubes::Slab &output) const;
+
+
+        // Static attributes
+
+        /** Triangle edges of every corner case */
+        static const std::vector<std::vector<GLubyte> > TRIANGLES;
+
+
+        // Static methods
+
+        /** Triangulate the loop of crossed edges clipping ears without a diagonal on a face of the cell, returns false if it is not possible */
+        static bool triangulate(const std::vector<GLubyte> &loop, std::vector<GLubyte> &triangles);
+
+        /** Build the triangle edges of every corner case, the inside corners of the ambiguous faces are kept apart so neighbour cells agree */
+        static std::vector<std::vector<GLubyte> > buildTriangles();
+
+
+    public:
+        // Constructors
+
+        /** Marching cubes constructor, the min max grid is built from the voxels that must outlive the extractor, the threads default to all the threads of the task scheduler */
+        MarchingCubes(const GLushort *voxel, const VolumeData::Format &format, const glm::uvec3 &resolution, const unsigned int &threads = 0U);
+
+
+        // Getters
+
+        /** Get the number of active bricks of the raw value */
+        std::size_t getActiveBricks(const float &value) const;
+
+        /** Get the size of the min max grid in bytes */
+        std::size_t getBytes() const;
+
+
+        // Methods
+
+        /** Extract the isosurface of the raw value as interleaved positions and normals in voxels, and counterclockwise triangles seen from the lower values */
+        void extract(const float &value, std::vector<GLfloat> &vertices, std::vector<GLuint> &indices) const;
+
+
+        // Destructor
+
+        /** Marching cubes destructor */
+        virtual ~MarchingCubes();
+};
+
+#endif // __MARCHING_CUBES_HPP_
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "minmaxgrid.hpp"
+
+#include "../task/taskscheduler.hpp"
+
+#include <algorithm>
+
+
+// Static const attributes
+
+// Cells along every side of a brick
+const unsigned int MinMaxGrid::BRICK;
+
+
+// Private methods
+
+// Compute the bricks of the slabs in the range
+template <typename T>
+void MinMaxGrid::build(const T *voxel, const glm::uvec3 &resolution, const unsigned int &first, const unsigned int &last) {
+    const std::size_t width = resolution.x;
+    const std::size_t slice = width * resolution.y;
+    for (unsigned int bz = first; bz < last; bz++) {
+        for (unsigned int by = 0U; by < bricks.y; by++) {
+            for (unsigned int bx = 0U; bx < bricks.x; bx++) {
+                // Voxels of the brick cells including the upper corners
+                const unsigned int x0 = bx * MinMaxGrid::BRICK;
+                const unsigned int y0 = by * MinMaxGrid::BRICK;
+                const unsigned int z0 = bz * MinMaxGrid::BRICK;
+                const unsigned int x1 = std::min(x0 + MinMaxGrid::BRICK, resolution.x - 1U);
+                const unsigned int y1 = std::min(y0 + MinMaxGrid::BRICK, resolution.y - 1U);
+                const unsigned int z1 = std::min(z0 + MinMaxGrid::BRICK, resolution.z - 1U);
+
+                // Scan the rows
+                T low = voxel[z0 * slice + y0 * width + x0];
+                T high = low;
+                for (unsigned int z = z0; z <= z1; z++) {
+                    for (unsigned int y = y0; y <= y1; y++) {
+                        const T *const row = voxel + z * slice + y * width;
+                        const std::pair<const T *, const T *> range = std::minmax_element(row + x0, row + x1 + 1U);
+                        low = std::min(low, *range.first);
+                        high = std::max(high, *range.second);
+                    }
+                }
+
+                const std::size_t index = (static_cast<std::size_t>(bz) * bricks.y + by) * bricks.x + bx;
+                minimum[index] = static_cast<GLushort>(low);
+                maximum[index] = static_cast<GLushort>(high);
+            }
+        }
+    }
+}
+
+
+// Constructors
+
+// Min max grid constructor
+MinMaxGrid::MinMaxGrid(const GLushort *voxel, const VolumeData::Format &format, const glm::uvec3 &resolution, const unsigned int &threads) :
+    bricks(0U) {
+    // A grid needs at least one cell
+    if ((voxel == nullptr) || (resolution.x < 2U) || (resolution.y < 2U) || (resolution.z < 2U)) {
+        return;
+    }
+
+    // Bricks covering the cells
+    bricks = (resolution - glm::uvec3(2U)) / MinMaxGrid::BRICK + glm::uvec3(1U);
+    const std::size_t count = static_cast<std::size_t>(bricks.x) * bricks.y * bricks.z;
+    minimum.resize(count);
+    maximum.resize(count);
+
+    // Build the slabs in parallel
+    TaskScheduler::getActive()->parallel(bricks.z, 1U, [this, voxel, format, resolution](const std::size_t &first, const std::size_t &last) {
+        if (format == VolumeData::RAW8) {
+            build(reinterpret_cast<const GLubyte *>(voxel), resolution, static_cast<unsigned int>(first), static_cast<unsigned int>(last));
+        }
+        else {
+            build(voxel, resolution, static_cast<unsigned int>(first), static_cast<unsigned int>(last));
+        }
+    }, TaskScheduler::NORMAL, "min max grid", threads);
+}
+
+
+// Getters
+
+// Get the number of bricks along every axis
+glm::uvec3 MinMaxGrid::getBricks() const {
+    return bricks;
+}
+
+// Get the active status of the brick
+bool MinMaxGrid::isActive(const glm::uvec3 &brick, const float &value) const {
+    const std::size_t index = (static_cast<std::size_t>(brick.z) * bricks.y + brick.y) * bricks.x + brick.x;
+    return (static_cast<float>(minimum[index]) < value) && (value <= static_cast<float>(maximum[index]));
+}
+
+
+// Destructor
+
+// Min max grid destructor
+MinMaxGrid::~MinMaxGrid() {}
\ No newline at end of file
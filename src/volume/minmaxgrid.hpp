@@ -0,0 +1,75 @@
+#ifndef __MIN_MAX_GRID_HPP_
+#define __MIN_MAX_GRID_HPP_
+
+#include "loader/volumedata.hpp"
+
+#include "../glad/glad.h"
+
+#include <glm/vec3.hpp>
+
+#include <vector>
+
+
+/** Minimum and maximum raw values of the bricks of cells of a voxel grid, to skip the cells that cannot contain an isosurface */
+class MinMaxGrid {
+    private:
+        // Attributes
+
+        /** Number of bricks along every axis */
+        glm::uvec3 bricks;
+
+        /** Minimum raw value of every brick, x fastest */
+        std::vector<GLushort> minimum;
+
+        /** Maximum raw value of every brick, x fastest */
+        std::vector<GLushort> maximum;
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        MinMaxGrid() = delete;
+
+        /** Disable the default copy constructor */
+        MinMaxGrid(const MinMaxGrid &) = delete;
+
+        /** Disable the assignation operator */
+        MinMaxGrid &operator=(const MinMaxGrid &) = delete;
+
+
+        // Methods
+
+        /** Compute the bricks of the slabs in the range */
+        template <typename T>
+        void build(const T *voxel, const glm::uvec3 &resolution, const unsigned int &first, const unsigned int &last);
+
+
+    public:
+        // Static const attributes
+
+        /** Cells along every side of a brick, a brick covers one more voxel to include the shared corners */
+        static const unsigned int BRICK = 8U;
+
+
+        // Constructors
+
+        /** Min max grid constructor, the z slabs of bricks are built by the tasks of the scheduler on at most the threads, all of them by default */
+        MinMaxGrid(const GLushort *voxel, const VolumeData::Format &format, const glm::uvec3 &resolution, const unsigned int &threads = 0U);
+
+
+        // Getters
+
+        /** Get the number of bricks along every axis */
+        glm::uvec3 getBricks() const;
+
+        /** Get the active status of the brick, true if it has corners on both sides of the raw value */
+        bool isActive(const glm::uvec3 &brick, const float &value) const;
+
+
+        // Destructor
+
+        /** Min max grid destructor */
+        virtual ~MinMaxGrid();
+};
+
+#endif // __MIN_MAX_GRID_HPP_
\ No newline at end of file
@@ -1,10 +1,18 @@
 #include "transferfunction.hpp"
 
+#include "../profiler/profilerscope.hpp"
+
 
 // Private methods
 
 // Update the function
 void TransferFunction::update() {
+    // Time the phase
+    const ProfilerScope scope("transfer_function");
+
+    // Count the change
+    revision++;
+
     // Get the first node
     unsigned int a = static_cast<unsigned int>(*node.begin()) << 2U;
     glm::vec4 color_a(data[a], data[a + 1U], data[a + 2U], data[a + 3U]);
@@ -63,7 +71,10 @@ void TransferFunction::update() {
 /** Transfer function constructor */
 TransferFunction::TransferFunction() :
     // Texture attributes
-    texture(GL_FALSE) {
+    texture(GL_FALSE),
+
+    // Revision
+    revision(0U) {
     // Generate the texture
     glGenTextures(1, &texture);
 
@@ -107,6 +118,21 @@ const GLubyte *TransferFunction::getData() const {
     return data;
 }
 
+// Get the nodes as index and color pairs
+std::vector<std::pair<GLubyte, glm::uvec4> > TransferFunction::getNodes() const {
+    std::vector<std::pair<GLubyte, glm::uvec4> > nodes;
+    for (const GLubyte &index : node) {
+        nodes.push_back(std::make_pair(index, getNode(index)));
+    }
+    return nodes;
+}
+
+
+// Get the revision counter
+unsigned long long int TransferFunction::getRevision() const {
+    return revision;
+}
+
 
 // Setters
 
@@ -134,13 +160,42 @@ void TransferFunction::setCurrentNode(const glm::uvec4 &color){
 // Set the current node index
 void TransferFunction::setCurrentNodeIndex(const GLubyte &index){
     current_node = index;
+    revision++;
+}
+
+// Replace all the nodes
+bool TransferFunction::setNodes(const std::vector<std::pair<GLubyte, glm::uvec4> > &nodes) {
+    // The function needs at least the two ends
+    std::set<GLubyte> new_node;
+    for (const std::pair<GLubyte, glm::uvec4> &entry : nodes) {
+        new_node.insert(entry.first);
+    }
+
+    if (new_node.size() < 2U) {
+        return false;
+    }
+
+    // Set the colors
+    for (const std::pair<GLubyte, glm::uvec4> &entry : nodes) {
+        const unsigned int i = static_cast<unsigned int>(entry.first) << 2;
+        data[i]     = glm::clamp(entry.second.r, 0U, 255U);
+        data[i + 1] = glm::clamp(entry.second.g, 0U, 255U);
+        data[i + 2] = glm::clamp(entry.second.b, 0U, 255U);
+        data[i + 3] = glm::clamp(entry.second.a, 0U, 255U);
+    }
+
+    // Select the first node and update the function once
+    node = new_node;
+    current_node = *node.begin();
+    update();
+    return true;
 }
 
 
 // Methods
 
 // Bind the transfer function
-void TransferFunction::bind(GLSLProgram *const program, const GLint &index) {
+void TransferFunction::bind(GLSLProgram *const program, const GLint &index, const GLchar *const uniform) {
     // Check the program status
     if ((program == nullptr) || (!program->isValid())) {
         return;
@@ -150,7 +205,7 @@ void TransferFunction::bind(GLSLProgram *const program, const GLint &index) {
     program->use();
 
     // Set uniform
-    program->setUniform("u_trans_func", index);
+    program->setUniform(uniform, index);
 
     // Bind texture
     glActiveTexture(GL_TEXTURE0 + index);
@@ -182,6 +237,37 @@ void TransferFunction::reset() {
 }
 
 
+// Load a named preset
+bool TransferFunction::loadPreset(const std::string &name) {
+    // The linear ramp is the default function
+    if (name == "linear") {
+        reset();
+        return true;
+    }
+
+    // Nodes of the preset as index and color
+    std::vector<std::pair<GLubyte, glm::uvec4> > nodes;
+    if (name == "bone") {
+        nodes.push_back(std::make_pair(  0U, glm::uvec4(  0U,   0U,   0U,   0U)));
+        nodes.push_back(std::make_pair( 90U, glm::uvec4(  0U,   0U,   0U,   0U)));
+        nodes.push_back(std::make_pair(140U, glm::uvec4(230U, 200U, 160U,  48U)));
+        nodes.push_back(std::make_pair(255U, glm::uvec4(255U, 255U, 240U, 255U)));
+    }
+    else if (name == "tissue") {
+        nodes.push_back(std::make_pair(  0U, glm::uvec4(  0U,   0U,   0U,   0U)));
+        nodes.push_back(std::make_pair( 40U, glm::uvec4(  0U,   0U,   0U,   0U)));
+        nodes.push_back(std::make_pair( 70U, glm::uvec4(200U,  90U,  60U,  24U)));
+        nodes.push_back(std::make_pair(140U, glm::uvec4(240U, 200U, 180U,  96U)));
+        nodes.push_back(std::make_pair(255U, glm::uvec4(255U, 255U, 255U, 200U)));
+    }
+    else {
+        return false;
+    }
+
+    return setNodes(nodes);
+}
+
+
 // Select the previous node as current
 GLubyte TransferFunction::selectPreviousNode() {
     // Get the current node
@@ -198,6 +284,7 @@ GLubyte TransferFunction::selectPreviousNode() {
     }
 
     // Update the current node and return
+    revision++;
     return current_node = *prev;
 }
 
@@ -209,6 +296,7 @@ GLubyte TransferFunction::selectNextNode() {
     // Update the current node if is not the last
     if (next != node.end()) {
         current_node = *next;
+        revision++;
     }
 
     // Return the new current node
@@ -5,7 +5,11 @@
 
 #include "../glad/glad.h"
 
+#include <string>
+
 #include <set>
+#include <utility>
+#include <vector>
 
 
 /** The transfer function class */
@@ -27,6 +31,10 @@ class TransferFunction {
         GLubyte current_node;
 
 
+        /** Revision counter increased on every change */
+        unsigned long long int revision;
+
+
         // Constructors
 
         /** Disable the default copy constructor */
@@ -64,6 +72,13 @@ class TransferFunction {
         /** Get the function data */
         const GLubyte *getData() const;
 
+        /** Get the nodes as index and color pairs */
+        std::vector<std::pair<GLubyte, glm::uvec4> > getNodes() const;
+
+
+        /** Get the revision counter */
+        unsigned long long int getRevision() const;
+
 
         // Setters
 
@@ -76,15 +91,21 @@ class TransferFunction {
         /** Set the current node index */
         void setCurrentNodeIndex(const GLubyte &index);
 
+        /** Replace all the nodes and select the first one, returns false if there are less than two */
+        bool setNodes(const std::vector<std::pair<GLubyte, glm::uvec4> > &nodes);
+
 
         // Methods
 
-        /** Bind the transfer function */
-        void bind(GLSLProgram *const program, const GLint &index = 0);
+        /** Bind the transfer function to the texture unit and the sampler uniform */
+        void bind(GLSLProgram *const program, const GLint &index = 0, const GLchar *const uniform = "u_trans_func");
 
         /** Reset */
         void reset();
 
+        /** Load a named preset, `linear', `bone' or `tissue', returns false if it is unknown */
+        bool loadPreset(const std::string &name);
+
 
         /** Select the previous node as current */
         GLubyte selectPreviousNode();
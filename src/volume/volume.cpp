@@ -1,20 +1,53 @@
 #include "volume.hpp"
+#include "volumecache.hpp"
 
 #include "../dirsep.h"
 
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string>
+
+
+// Static const attributes
+
+// Maximum number of volumes of a multi-volume pass on the GPU
+const std::size_t Volume::MAX_LAYERS = 4U;
+
 
 // Private methods
 
 // Load the volume from the volume path
 void Volume::load() {
-    // Load the volume
-    VolumeData *volume_data = VolumeLoader::load(path, format, resolution.x, resolution.y, resolution.z);
+    // Read only the brick and the ghost voxels around it, as many read voxels as the ghost distance
+    glm::uvec3 read_offset(0U);
+    glm::uvec3 read_size(0U);
+    const bool whole = (brick_size.x == 0U) || (brick_size.y == 0U) || (brick_size.z == 0U);
+    if (!whole) {
+        for (int i = 0; i < 3; i++) {
+            const unsigned int margin = ghost * read_stride[i];
+            read_offset[i] = brick_offset[i] > margin ? brick_offset[i] - margin : 0U;
+            read_size[i] = std::min(brick_offset[i] + brick_size[i] + margin, grid[i]) - read_offset[i];
+        }
+    }
+
+    // Take the volume from the cache or load it
+    cache_key = VolumeCache::getKey(path, format, grid, read_offset, read_size, read_stride, read_filter);
+    VolumeData *volume_data = VolumeCache::take(cache_key);
+    if (volume_data == nullptr) {
+        volume_data = VolumeLoader::load(path, format, grid.x, grid.y, grid.z, read_offset, read_size, read_stride, read_filter);
+    }
 
     // Set the open statuses
     open = volume_data->open;
 
     // Set the resolution
     resolution = volume_data->resolution;
+    grid = volume_data->grid;
+    offset = volume_data->offset;
+    stride = volume_data->stride;
 
     // Set the buffers
     vao = volume_data->vao;
@@ -22,22 +55,76 @@ void Volume::load() {
 
     // Set the texture
     texture = volume_data->texture;
-    diagonal = glm::length(glm::vec3(resolution));
+    value_scale = volume_data->value_scale;
+    diagonal = glm::length(glm::vec3(grid));
     step = 1.0F / diagonal;
-    tex_dim = glm::vec3(resolution) / diagonal;
+    tex_dim = glm::vec3(grid) / diagonal;
+
+    // Map the grid texture coordinates to the read region, the t axis is swapped and a downsampled region covers its read voxels times the stride
+    if (open && (!whole || (stride != glm::uvec3(1U)))) {
+        const glm::vec3 covered(resolution * stride);
+        const glm::vec3 factor = glm::vec3(grid) / covered;
+        const glm::vec3 shift = glm::vec3(offset) / covered;
+        const glm::uvec3 lower = whole ? glm::uvec3(0U) : brick_offset;
+        const glm::uvec3 upper = whole ? grid : brick_offset + brick_size;
+        region_mat = glm::scale(glm::translate(glm::mat4(1.0F), glm::vec3(-shift.x, 1.0F - factor.y + shift.y, -shift.z)), factor);
+        region_scale = factor;
+        clip_min = glm::vec3(lower - offset) / covered;
+        clip_max = glm::vec3(upper - offset) / covered;
+    }
+    else {
+        region_mat = glm::mat4(1.0F);
+        region_scale = glm::vec3(1.0F);
+        clip_min = glm::vec3(0.0F);
+        clip_max = glm::vec3(1.0F);
+    }
+
+    // Take the host voxels
+    delete[] voxel;
+    voxel = volume_data->voxel;
+    voxels = volume_data->voxels;
+
+    // Take the structures computed from them, the previous ones are deleted with the loader data
+    derived.swap(volume_data->derived);
 
     // Clean up the loader data
     volume_data->vao = GL_FALSE;
     volume_data->vbo = GL_FALSE;
     volume_data->texture = GL_FALSE;
+    volume_data->voxel = nullptr;
     delete volume_data;
 
     // Reset the transfer function
     transfer_function->reset();
+    revision++;
+    data_revision++;
 }
 
 // Makes the volume empty
 void Volume::clear() {
+    // Keep the open volume in the cache, it owns the voxels and the OpenGL objects from now on
+    if (open) {
+        VolumeData *const volume_data = new VolumeData(path, format);
+        volume_data->open = true;
+        volume_data->resolution = resolution;
+        volume_data->grid = grid;
+        volume_data->offset = offset;
+        volume_data->stride = stride;
+        volume_data->value_scale = value_scale;
+        volume_data->vao = vao;
+        volume_data->vbo = vbo;
+        volume_data->texture = texture;
+        volume_data->voxel = voxel;
+        volume_data->voxels = voxels;
+        volume_data->derived.swap(derived);
+        VolumeCache::store(cache_key, volume_data);
+
+        vao = GL_FALSE;
+        vbo = GL_FALSE;
+        texture = GL_FALSE;
+        voxel = nullptr;
+    }
+
     // Set not open
     open = false;
 
@@ -61,10 +148,22 @@ void Volume::clear() {
     glDeleteTextures(1, &texture);
     texture = GL_FALSE;
 
+    // Host voxels and the structures computed from them
+    delete[] voxel;
+    voxel = nullptr;
+    voxels = 0U;
+    for (const std::pair<const std::string, VolumeData::Derived *> &structure : derived) {
+        delete structure.second;
+    }
+    derived.clear();
+
     // Texture attributes
+    value_scale = 1.0F;
     step = 1.0F;
     diagonal = 0.0F;
     tex_dim = glm::vec3(0.0F);
+    revision++;
+    data_revision++;
 }
 
 // Update the matrices
@@ -74,7 +173,15 @@ void Volume::updateMatrices() {
 
     // Update the matrices
     model_mat = glm::scale(glm::translate(identity, position), dimension);
-    volume_mat = glm::inverse(glm::mat4_cast(rotation) * glm::translate(glm::scale(identity, tex_dim), glm::vec3(-0.5F)));
+    volume_mat = region_mat * glm::inverse(glm::mat4_cast(rotation) * glm::translate(glm::scale(identity, tex_dim), glm::vec3(-0.5F)));
+
+    // Count the change
+    revision++;
+}
+
+// Get whether the GPU draws rays instead of slices
+bool Volume::isRayCast() const {
+    return (technique == Volume::RAY_CASTING) || (composition == Volume::MINIP) || (composition == Volume::AVERAGE);
 }
 
 // Constructor
@@ -86,6 +193,13 @@ Volume::Volume() :
     // Enabled
     enabled(true),
 
+    // Render options
+    technique(Volume::SLICING),
+    composition(Volume::DVR),
+    filter(Volume::TRILINEAR),
+    shading(false),
+    isovalue(0.5F),
+
     // Geometry
     position(0.0F),
     rotation(glm::quat(1.0F, 0.0F, 0.0F, 0.0F)),
@@ -94,14 +208,32 @@ Volume::Volume() :
     // Texture
     diagonal(0.0F),
     step(1.0F),
+    step_scale(1.0F),
+    jittering(false),
+    jitter(0.0F),
     tex_dim(0.0F),
 
+    // Brick
+    brick_offset(0U),
+    brick_size(0U),
+    ghost(0U),
+    read_stride(1U),
+    read_filter(true),
+    clip_min(0.0F),
+    clip_max(1.0F),
+    region_mat(1.0F),
+    region_scale(1.0F),
+
     // Transfer function
     transfer_function(new TransferFunction()),
 
     // Matrices
     model_mat(1.0F),
-    volume_mat(1.0F) {}
+    volume_mat(1.0F),
+
+    // Revisions
+    revision(0U),
+    data_revision(0U) {}
 
 // Volume constructor
 Volume::Volume(const std::string &path, const VolumeData::Format &format) :
@@ -110,6 +242,13 @@ Volume::Volume(const std::string &path, const VolumeData::Format &format) :
     // Enabled
     enabled(true),
 
+    // Render options
+    technique(Volume::SLICING),
+    composition(Volume::DVR),
+    filter(Volume::TRILINEAR),
+    shading(false),
+    isovalue(0.5F),
+
     // Geometry
     position(0.0F),
     rotation(1.0F, 0.0F, 0.0F, 0.0F),
@@ -118,14 +257,32 @@ Volume::Volume(const std::string &path, const VolumeData::Format &format) :
     // Texture
     diagonal(0.0F),
     step(1.0F),
+    step_scale(1.0F),
+    jittering(false),
+    jitter(0.0F),
     tex_dim(0.0F),
 
+    // Brick
+    brick_offset(0U),
+    brick_size(0U),
+    ghost(0U),
+    read_stride(1U),
+    read_filter(true),
+    clip_min(0.0F),
+    clip_max(1.0F),
+    region_mat(1.0F),
+    region_scale(1.0F),
+
     // Transfer function
     transfer_function(new TransferFunction()),
 
     // Matrices
     model_mat(1.0F),
-    volume_mat(1.0F) {
+    volume_mat(1.0F),
+
+    // Revisions
+    revision(0U),
+    data_revision(0U) {
     // Load the volume
     load();
 }
@@ -144,6 +301,88 @@ bool Volume::isOpen() const {
 }
 
 
+// Get the rendering technique
+Volume::Technique Volume::getTechnique() const {
+    return technique;
+}
+
+// Get the composition mode
+Volume::Composition Volume::getComposition() const {
+    return composition;
+}
+
+// Get the sampling filter of the CPU ray caster
+Volume::Filter Volume::getFilter() const {
+    return filter;
+}
+
+// Get the shading status
+bool Volume::isShading() const {
+    return shading;
+}
+
+// Get the data value of the isosurface
+float Volume::getIsovalue() const {
+    return isovalue;
+}
+
+// Get the step scale
+float Volume::getStepScale() const {
+    return step_scale;
+}
+
+// Get the distance between samples in model space
+float Volume::getSampleDistance() const {
+    return step * step_scale;
+}
+
+// Get the sample position jittering status
+bool Volume::isJittering() const {
+    return jittering;
+}
+
+// Get the jitter offset of the current frame in steps
+float Volume::getJitter() const {
+    return jitter;
+}
+
+// Get the program variant defines for the current render options
+std::set<std::string> Volume::getDefines() const {
+    std::set<std::string> defines;
+
+    // Rendering technique
+    if (isRayCast()) {
+        defines.insert("RAY_CASTING");
+    }
+
+    // Composition mode, shading only applies to the emission absorption model
+    if (composition == Volume::MIP) {
+        defines.insert("MIP");
+    }
+    else if (composition == Volume::MINIP) {
+        defines.insert("MINIP");
+    }
+    else if (composition == Volume::AVERAGE) {
+        defines.insert("AVERAGE");
+    }
+    else if (shading) {
+        defines.insert("SHADING");
+    }
+
+    // Per pixel ray offsets
+    if (jittering) {
+        defines.insert("JITTER");
+    }
+
+    // Data format
+    if (format == VolumeData::RAW16) {
+        defines.insert("DATA_16BIT");
+    }
+
+    return defines;
+}
+
+
 // Get the volume file path
 std::string Volume::getPath() const {
     return path;
@@ -154,6 +393,11 @@ std::string Volume::getName() const {
     return path.substr(path.find_last_of(DIR_SEP) + 1U);
 }
 
+// Get the volume format
+VolumeData::Format Volume::getFormat() const {
+    return format;
+}
+
 
 // Get the resolution
 glm::uvec3 Volume::getResolution() const {
@@ -161,6 +405,70 @@ glm::uvec3 Volume::getResolution() const {
 }
 
 
+// Get the resolution of the whole grid
+glm::uvec3 Volume::getGrid() const {
+    return grid;
+}
+
+// Get the offset of the read region in the grid
+glm::uvec3 Volume::getOffset() const {
+    return offset;
+}
+
+// Get the voxels of the grid per read voxel along every axis
+glm::uvec3 Volume::getStride() const {
+    return stride;
+}
+
+// Get the offset of the drawn brick
+glm::uvec3 Volume::getBrickOffset() const {
+    return brick_offset;
+}
+
+// Get the size of the drawn brick
+glm::uvec3 Volume::getBrickSize() const {
+    return brick_size;
+}
+
+// Get the position of a world space point in voxels of the grid
+glm::vec3 Volume::getGridPosition(const glm::vec3 &point) const {
+    // Texture coordinates of the grid with the t axis swapped as sampled
+    glm::vec3 tex = glm::vec3(glm::inverse(region_mat) * volume_mat * glm::inverse(model_mat) * glm::vec4(point, 1.0F));
+    tex.t = 1.0F - tex.t;
+    return tex * glm::vec3(grid);
+}
+
+// Get the lower corner of the drawn brick in texture coordinates of the read region
+glm::vec3 Volume::getClipMin() const {
+    return clip_min;
+}
+
+// Get the upper corner of the drawn brick in texture coordinates of the read region
+glm::vec3 Volume::getClipMax() const {
+    return clip_max;
+}
+
+
+// Get the host copy of the read voxels
+const GLushort *Volume::getVoxels() const {
+    return voxel;
+}
+
+// Get the scale that stretches the used range of the data to one
+float Volume::getValueScale() const {
+    return value_scale;
+}
+
+// Get the matrix from the voxel indices of the read region to the model space
+glm::mat4 Volume::getVoxelMatrix() const {
+    // Voxel centers to the grid texture coordinates with the t axis swapped as sampled, every read voxel spans the stride
+    const glm::vec3 size(grid);
+    const glm::mat4 texture_mat = glm::scale(glm::translate(glm::mat4(1.0F), glm::vec3(0.0F, 1.0F, 0.0F)), glm::vec3(1.0F, -1.0F, 1.0F) / size);
+    const glm::mat4 voxel_mat = glm::scale(glm::translate(texture_mat, glm::vec3(offset) + glm::vec3(stride) * 0.5F), glm::vec3(stride));
+    return glm::inverse(volume_mat) * region_mat * voxel_mat;
+}
+
+
 // Get the position
 glm::vec3 Volume::getPosition() const {
     return position;
@@ -199,11 +507,76 @@ glm::mat4 Volume::getVolumeMatrix() const {
 }
 
 
+// Get the revision counter, including the transfer function changes
+unsigned long long int Volume::getRevision() const {
+    return revision + transfer_function->getRevision();
+}
+
+// Get the revision counter of the voxels
+unsigned long long int Volume::getDataRevision() const {
+    return data_revision;
+}
+
+// Get the structure computed from the voxels by a renderer under the name
+VolumeData::Derived *Volume::getDerived(const std::string &name) const {
+    const std::map<std::string, VolumeData::Derived *>::const_iterator structure = derived.find(name);
+    return structure != derived.end() ? structure->second : nullptr;
+}
+
+
 // Setters
 
 // Set the enabled status
 void Volume::setEnabled(const bool &status) {
     enabled = status;
+    revision++;
+}
+
+
+// Set the rendering technique
+void Volume::setTechnique(const Volume::Technique &new_technique) {
+    technique = new_technique;
+    revision++;
+}
+
+// Set the composition mode
+void Volume::setComposition(const Volume::Composition &new_composition) {
+    composition = new_composition;
+    revision++;
+}
+
+// Set the sampling filter of the CPU ray caster
+void Volume::setFilter(const Volume::Filter &new_filter) {
+    filter = new_filter;
+    revision++;
+}
+
+// Set the shading status
+void Volume::setShading(const bool &status) {
+    shading = status;
+    revision++;
+}
+
+// Set the data value of the isosurface
+void Volume::setIsovalue(const float &new_isovalue) {
+    isovalue = std::min(std::max(new_isovalue, 0.0F), 1.0F);
+    revision++;
+}
+
+// Set the step scale, the opacity is corrected for the new sample distance
+void Volume::setStepScale(const float &scale) {
+    step_scale = scale;
+}
+
+// Set the sample position jittering status
+void Volume::setJittering(const bool &status) {
+    jittering = status;
+    revision++;
+}
+
+// Set the jitter offset of the current frame in steps, the revision is not changed
+void Volume::setJitter(const float &offset) {
+    jitter = offset;
 }
 
 
@@ -218,6 +591,7 @@ void Volume::setPath(const std::string &new_path, const VolumeData::Format &new_
     resolution.x = width;
     resolution.y = height;
     resolution.z = depth;
+    grid = resolution;
 
     // Load if the path is not empty
     if (!path.empty()) {
@@ -227,6 +601,20 @@ void Volume::setPath(const std::string &new_path, const VolumeData::Format &new_
 }
 
 
+// Set the brick of the grid to read and draw on the next load
+void Volume::setBrick(const glm::uvec3 &new_offset, const glm::uvec3 &new_size, const unsigned int &ghost_voxels) {
+    brick_offset = new_offset;
+    brick_size = new_size;
+    ghost = ghost_voxels;
+}
+
+// Set the voxels of the grid per read voxel along every axis on the next load
+void Volume::setStride(const glm::uvec3 &new_stride, const bool &new_filter) {
+    read_stride = glm::max(new_stride, glm::uvec3(1U));
+    read_filter = new_filter;
+}
+
+
 // Set the new position
 void Volume::setPosition(const glm::vec3 &new_position) {
     position = new_position;
@@ -252,6 +640,16 @@ void Volume::setScale(const glm::vec3 &new_scale) {
 }
 
 
+// Keep the structure computed from the voxels by a renderer under the name
+void Volume::setDerived(const std::string &name, VolumeData::Derived *const structure) const {
+    VolumeData::Derived *&target = derived[name];
+    if (target != structure) {
+        delete target;
+        target = structure;
+    }
+}
+
+
 // Methods
 
 // Reload volume
@@ -292,6 +690,14 @@ void Volume::draw(GLSLProgram *const program) const {
     program->setUniform("u_model_mat", model_mat);
     program->setUniform("u_volume_mat", volume_mat);
     program->setUniform("u_tex", 1);
+    program->setUniform("u_voxel", 1.0F / glm::vec3(resolution));
+    program->setUniform("u_value_scale", value_scale);
+    program->setUniform("u_step", step * step_scale);
+    program->setUniform("u_step_scale", step_scale);
+    program->setUniform("u_jitter", jitter);
+    program->setUniform("u_clip_min", clip_min);
+    program->setUniform("u_clip_max", clip_max);
+    program->setUniform("u_region_scale", region_scale);
 
     // Bind the texture
     glActiveTexture(GL_TEXTURE1);
@@ -300,15 +706,32 @@ void Volume::draw(GLSLProgram *const program) const {
     // Bind the vertex array object
     glBindVertexArray(vao);
 
-    // Draw the volume slices
-    for (float i = -0.5F; i < 0.5F; i += step) {
-        // Set the slice position
-        program->setUniform("u_slice", i);
-
-        // Draw square
+    // Ray casting draws a single screen filling quad
+    if (isRayCast()) {
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     }
 
+    // Draw the volume slices
+    else {
+        // The maximum intensity is taken by the blend equation
+        if (composition == Volume::MIP) {
+            glBlendEquation(GL_MAX);
+        }
+
+        // Jittering offsets all the slices of the frame
+        const float distance = step * step_scale;
+        for (float i = -0.5F + (jittering ? jitter * distance : 0.0F); i < 0.5F; i += distance) {
+            // Set the slice position
+            program->setUniform("u_slice", i);
+
+            // Draw square
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        }
+
+        // Restore the blend equation
+        glBlendEquation(GL_FUNC_ADD);
+    }
+
     // Unbind the vertex array object and texture
     glBindTexture(GL_TEXTURE_3D, GL_FALSE);
     glBindVertexArray(GL_FALSE);
@@ -357,4 +780,70 @@ Volume::~Volume() {
 
     // Delete the transfer function
     delete transfer_function;
+}
+
+
+// Static methods
+
+// Get the distance between samples in world space shared by the volumes
+float Volume::getSampleDistance(const std::vector<const Volume *> &volumes) {
+    // The model space of every volume is the world space scaled by its dimension, its shortest axis bounds the world distance of its samples
+    float distance = std::numeric_limits<float>::max();
+    for (const Volume *const volume : volumes) {
+        const glm::vec3 scale = glm::abs(volume->dimension);
+        distance = std::min(distance, volume->getSampleDistance() * std::min(scale.x, std::min(scale.y, scale.z)));
+    }
+    return distance;
+}
+
+// Draw the volumes in one ray casting pass of the multi-volume program variant
+void Volume::drawLayers(const std::vector<const Volume *> &volumes, GLSLProgram *const program) {
+    // Check the volumes and the program status
+    if (volumes.empty() || (program == nullptr) || (!program->isValid())) {
+        return;
+    }
+
+    // The rays are cast in world space with the jitter of the first volume
+    const std::size_t layers = std::min(volumes.size(), Volume::MAX_LAYERS);
+    const Volume *const first = volumes.front();
+    program->use();
+    program->setUniform("u_model_mat", glm::mat4(1.0F));
+    program->setUniform("u_step", Volume::getSampleDistance(std::vector<const Volume *>(volumes.begin(), volumes.begin() + static_cast<std::ptrdiff_t>(layers))));
+    program->setUniform("u_jitter", first->jitter);
+    program->setUniform("u_layers", static_cast<GLint>(layers));
+
+    // Every volume binds its transfer function and its texture to its own pair of texture units, the unused samplers get theirs too since samplers of different types cannot share a unit
+    for (std::size_t i = 0U; i < Volume::MAX_LAYERS; i++) {
+        const std::string index = "[" + std::to_string(i) + "]";
+        const GLint unit = static_cast<GLint>(2U * i);
+        program->setUniform(("u_layer_trans_func" + index).c_str(), unit);
+        program->setUniform(("u_layer_tex" + index).c_str(), unit + 1);
+        if (i >= layers) {
+            continue;
+        }
+
+        const Volume *const volume = volumes[i];
+        volume->transfer_function->bind(program, unit, ("u_layer_trans_func" + index).c_str());
+        program->setUniform(("u_layer_mat" + index).c_str(), volume->volume_mat * glm::inverse(volume->model_mat));
+        program->setUniform(("u_layer_inverse_scale" + index).c_str(), 1.0F / volume->dimension);
+        program->setUniform(("u_layer_clip_min" + index).c_str(), volume->clip_min);
+        program->setUniform(("u_layer_clip_max" + index).c_str(), volume->clip_max);
+        program->setUniform(("u_layer_value_scale" + index).c_str(), volume->format == VolumeData::RAW16 ? volume->value_scale : 1.0F);
+        program->setUniform(("u_layer_step" + index).c_str(), volume->step);
+
+        glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(unit) + 1U);
+        glBindTexture(GL_TEXTURE_3D, volume->texture);
+    }
+
+    // Draw the screen filling quad of the first volume
+    glBindVertexArray(first->vao);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    // Unbind the vertex array object and the textures
+    for (std::size_t i = 0U; i < layers; i++) {
+        glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(2U * i + 1U));
+        glBindTexture(GL_TEXTURE_3D, GL_FALSE);
+    }
+    glActiveTexture(GL_TEXTURE0);
+    glBindVertexArray(GL_FALSE);
 }
\ No newline at end of file
@@ -15,9 +15,70 @@
 
 #include <string>
 
+#include <set>
+#include <vector>
+
 
 /** Volume class */
 class Volume : private VolumeData {
+    public:
+        // Enumerations
+
+        /** Rendering techniques */
+        enum Technique {
+            /** Texture based viewport aligned slices */
+            SLICING,
+
+            /** GPU ray casting */
+            RAY_CASTING,
+
+            /** Opaque triangle mesh of the isosurface extracted on the CPU */
+            ISOSURFACE,
+
+            /** Ray casting on the CPU threads */
+            CPU_RAY_CASTING,
+
+            /** Shear-warp factorization on the CPU threads, the intensity projections are ray cast */
+            SHEAR_WARP,
+
+            /** Line integrals on the CPU threads by the Fourier slice theorem, the composition is ignored */
+            FOURIER
+        };
+
+        /** Composition modes */
+        enum Composition {
+            /** Direct volume rendering with emission and absorption */
+            DVR,
+
+            /** Maximum intensity projection */
+            MIP,
+
+            /** Minimum intensity projection */
+            MINIP,
+
+            /** Average intensity projection */
+            AVERAGE
+        };
+
+        /** Sampling filters of the CPU ray caster */
+        enum Filter {
+            /** Nearest voxel */
+            NEAREST,
+
+            /** Trilinear interpolation of the eight neighbour voxels */
+            TRILINEAR,
+
+            /** Catmull-Rom interpolation of the sixty-four neighbour voxels */
+            TRICUBIC
+        };
+
+
+        // Static const attributes
+
+        /** Maximum number of volumes of a multi-volume pass on the GPU, as MAX_LAYERS of the ray casting shader */
+        static const std::size_t MAX_LAYERS;
+
+
     private:
         // Attributes
 
@@ -25,6 +86,22 @@ class Volume : private VolumeData {
         bool enabled;
 
 
+        /** Rendering technique */
+        Volume::Technique technique;
+
+        /** Composition mode */
+        Volume::Composition composition;
+
+        /** Sampling filter of the CPU ray caster */
+        Volume::Filter filter;
+
+        /** Shading status */
+        bool shading;
+
+        /** Data value of the isosurface, from zero to one after the value scale */
+        float isovalue;
+
+
         /** Position */
         glm::vec3 position;
 
@@ -41,10 +118,50 @@ class Volume : private VolumeData {
         /** Step */
         float step;
 
+        /** Step scale for reduced quality */
+        float step_scale;
+
+        /** Sample position jittering status */
+        bool jittering;
+
+        /** Jitter offset of the current frame in steps */
+        float jitter;
+
         /** Texture dimensions */
         glm::vec3 tex_dim;
 
 
+        /** Offset of the drawn brick in the grid */
+        glm::uvec3 brick_offset;
+
+        /** Size of the drawn brick, zero for the whole grid */
+        glm::uvec3 brick_size;
+
+        /** Voxels read around the brick for the interpolation and the gradients */
+        unsigned int ghost;
+
+        /** Voxels of the grid per read voxel along every axis on the next load */
+        glm::uvec3 read_stride;
+
+        /** Average the voxels of every stride box on the next load instead of taking the middle one */
+        bool read_filter;
+
+        /** Lower corner of the brick in texture coordinates */
+        glm::vec3 clip_min;
+
+        /** Upper corner of the brick in texture coordinates */
+        glm::vec3 clip_max;
+
+        /** Matrix from the grid texture coordinates to the read region texture coordinates */
+        glm::mat4 region_mat;
+
+        /** Scale from the grid texture coordinates to the read region texture coordinates */
+        glm::vec3 region_scale;
+
+        /** Key of the read region in the volume cache */
+        std::string cache_key;
+
+
         /** Transfer function */
         TransferFunction *transfer_function;
 
@@ -56,6 +173,13 @@ class Volume : private VolumeData {
         glm::mat4 volume_mat;
 
 
+        /** Revision counter increased on every change */
+        unsigned long long int revision;
+
+        /** Revision counter increased when the voxels change */
+        unsigned long long int data_revision;
+
+
         // Constructors
 
         /** Disable the default copy constructor */
@@ -67,15 +191,18 @@ class Volume : private VolumeData {
 
         // Methods
 
-        /** Load the volume from the volume pah */
+        /** Load the volume from the volume pah, taking it from the volume cache if it is there */
         void load();
 
-        /** Makes the volume empty */
+        /** Makes the volume empty, the open voxels and texture are kept in the volume cache */
         void clear();
 
         /** Update volume and normal matrices */
         void updateMatrices();
 
+        /** Get whether the GPU draws rays instead of slices, the projections besides the maximum need whole rays */
+        bool isRayCast() const;
+
 
     public:
         // Constructor
@@ -96,16 +223,84 @@ class Volume : private VolumeData {
         bool isOpen() const;
 
 
+        /** Get the rendering technique */
+        Volume::Technique getTechnique() const;
+
+        /** Get the composition mode */
+        Volume::Composition getComposition() const;
+
+        /** Get the sampling filter of the CPU ray caster */
+        Volume::Filter getFilter() const;
+
+        /** Get the shading status */
+        bool isShading() const;
+
+        /** Get the data value of the isosurface */
+        float getIsovalue() const;
+
+        /** Get the step scale */
+        float getStepScale() const;
+
+        /** Get the distance between samples in model space, including the step scale */
+        float getSampleDistance() const;
+
+        /** Get the sample position jittering status */
+        bool isJittering() const;
+
+        /** Get the jitter offset of the current frame in steps */
+        float getJitter() const;
+
+        /** Get the program variant defines for the current render options */
+        std::set<std::string> getDefines() const;
+
+
         /** Get the volume path*/
         std::string getPath() const;
 
         /** Get the volume name */
         std::string getName() const;
 
+        /** Get the volume format */
+        VolumeData::Format getFormat() const;
+
 
         /** Get the resolution */
         glm::uvec3 getResolution() const;
 
+        /** Get the resolution of the whole grid, larger than the resolution if only a brick was read or it was downsampled */
+        glm::uvec3 getGrid() const;
+
+        /** Get the offset of the read region in the grid */
+        glm::uvec3 getOffset() const;
+
+        /** Get the voxels of the grid per read voxel along every axis, larger than one if the region was downsampled */
+        glm::uvec3 getStride() const;
+
+        /** Get the offset of the drawn brick in the grid */
+        glm::uvec3 getBrickOffset() const;
+
+        /** Get the size of the drawn brick, zero for the whole grid */
+        glm::uvec3 getBrickSize() const;
+
+        /** Get the position of a world space point in voxels of the grid */
+        glm::vec3 getGridPosition(const glm::vec3 &point) const;
+
+        /** Get the lower corner of the drawn brick in texture coordinates of the read region */
+        glm::vec3 getClipMin() const;
+
+        /** Get the upper corner of the drawn brick in texture coordinates of the read region */
+        glm::vec3 getClipMax() const;
+
+
+        /** Get the host copy of the read voxels, x fastest, bytes for RAW8 and shorts for RAW16 */
+        const GLushort *getVoxels() const;
+
+        /** Get the scale that stretches the used range of the data to one */
+        float getValueScale() const;
+
+        /** Get the matrix from the voxel indices of the read region to the model space */
+        glm::mat4 getVoxelMatrix() const;
+
 
         /** Get the position */
         glm::vec3 getPosition() const;
@@ -131,16 +326,57 @@ class Volume : private VolumeData {
         glm::mat4 getVolumeMatrix() const;
 
 
+        /** Get the revision counter, including the transfer function changes */
+        unsigned long long int getRevision() const;
+
+        /** Get the revision counter of the voxels */
+        unsigned long long int getDataRevision() const;
+
+        /** Get the structure computed from the voxels by a renderer under the name, null if there is none */
+        VolumeData::Derived *getDerived(const std::string &name) const;
+
+
         // Setters
 
         /** Set the enabled status */
         void setEnabled(const bool &status);
 
 
+        /** Set the rendering technique */
+        void setTechnique(const Volume::Technique &new_technique);
+
+        /** Set the composition mode */
+        void setComposition(const Volume::Composition &new_composition);
+
+        /** Set the sampling filter of the CPU ray caster */
+        void setFilter(const Volume::Filter &new_filter);
+
+        /** Set the shading status */
+        void setShading(const bool &status);
+
+        /** Set the data value of the isosurface, clamped to [0, 1] */
+        void setIsovalue(const float &new_isovalue);
+
+        /** Set the step scale, the opacity is corrected for the new sample distance and the revision is not changed */
+        void setStepScale(const float &scale);
+
+        /** Set the sample position jittering status */
+        void setJittering(const bool &status);
+
+        /** Set the jitter offset of the current frame in steps, the revision is not changed */
+        void setJitter(const float &offset);
+
+
         /** Set the new path */
         void setPath(const std::string &new_path, const VolumeData::Format &new_format = VolumeData::UNKOWN, const unsigned int &width = 0U, const unsigned int &height = 0U, const unsigned int &depth = 0U);
 
 
+        /** Set the brick of the grid to read and draw on the next load, the voxels around it up to the ghost distance are also read */
+        void setBrick(const glm::uvec3 &new_offset, const glm::uvec3 &new_size, const unsigned int &ghost_voxels = 2U);
+
+        /** Set the voxels of the grid per read voxel along every axis on the next load, averaged by a box filter or the middle one of every box, the ghost voxels are read voxels */
+        void setStride(const glm::uvec3 &new_stride, const bool &new_filter = true);
+
         /** Set the new position */
         void setPosition(const glm::vec3 &new_position);
 
@@ -154,6 +390,10 @@ class Volume : private VolumeData {
         void setScale(const glm::vec3 &new_scale);
 
 
+        /** Keep the structure computed from the voxels by a renderer under the name replacing the previous one, the volume owns it and keeps it in the volume cache with the voxels */
+        void setDerived(const std::string &name, VolumeData::Derived *const structure) const;
+
+
         // Methods
 
         /** Reload the volume */
@@ -182,8 +422,17 @@ class Volume : private VolumeData {
 
         // Destructor
 
-        /** Volume destructor */
+        /** Volume destructor, the open voxels and OpenGL objects are kept in the volume cache, which must be cleared before the OpenGL context is destroyed */
         virtual ~Volume();
+
+
+        // Static methods
+
+        /** Get the distance between samples in world space shared by the volumes, every volume is sampled at least as densely as alone */
+        static float getSampleDistance(const std::vector<const Volume *> &volumes);
+
+        /** Draw the volumes in one ray casting pass of the MULTI_VOLUME program variant, the samples of the overlapping volumes are mixed by their opacities, the volumes past MAX_LAYERS are left out */
+        static void drawLayers(const std::vector<const Volume *> &volumes, GLSLProgram *const program);
 };
 
 #endif // __VOLUME_HPP_
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include "volumecache.hpp"
+
+#include "loader/volumeloader.hpp"
+#include "../profiler/profilerscope.hpp"
+
+#include <iostream>
+#include <sstream>
+
+
+// Private static attributes
+
+// Cached volumes, the most recently used first
+std::list<VolumeCache::Entry> VolumeCache::entries;
+
+// Budget of the host voxels in bytes
+std::size_t VolumeCache::budget = static_cast<std::size_t>(1024U) << 20U;
+
+// Budget of the resident textures in bytes, zero to delete them
+std::size_t VolumeCache::texture_budget = static_cast<std::size_t>(256U) << 20U;
+
+// Size of the cached host voxels in bytes
+std::size_t VolumeCache::bytes = 0U;
+
+// Size of the resident textures in bytes
+std::size_t VolumeCache::texture_bytes = 0U;
+
+// Volumes taken from the cache
+unsigned long long int VolumeCache::hits = 0U;
+
+// Volumes not found in the cache
+unsigned long long int VolumeCache::misses = 0U;
+
+// Attached status
+bool VolumeCache::attached = false;
+
+
+// Private static methods
+
+// Evict the least recently used volumes and textures until they fit in the budgets
+void VolumeCache::evict() {
+    // Whole volumes over the host budget
+    while (!VolumeCache::entries.empty() && (VolumeCache::bytes > VolumeCache::budget)) {
+        const VolumeCache::Entry &entry = VolumeCache::entries.back();
+        std::cout << "info: volume cache evicted `" << entry.data->path << "'" << std::endl;
+        VolumeCache::bytes -= entry.bytes;
+        VolumeCache::texture_bytes -= entry.texture_bytes;
+        delete entry.data;
+        VolumeCache::entries.pop_back();
+    }
+
+    // Textures over their budget, the host voxels upload them again when taken
+    for (std::list<VolumeCache::Entry>::reverse_iterator entry = VolumeCache::entries.rbegin(); (entry != VolumeCache::entries.rend()) && (VolumeCache::texture_bytes > VolumeCache::texture_budget); ++entry) {
+        if (entry->texture_bytes > 0U) {
+            glDeleteTextures(1, &entry->data->texture);
+            entry->data->texture = GL_FALSE;
+            VolumeCache::texture_bytes -= entry->texture_bytes;
+            entry->texture_bytes = 0U;
+        }
+    }
+}
+
+
+// Static getters
+
+// Get the budget of the host voxels in bytes
+std::size_t VolumeCache::getBudget() {
+    return VolumeCache::budget;
+}
+
+// Get the budget of the resident textures in bytes
+std::size_t VolumeCache::getTextureBudget() {
+    return VolumeCache::texture_budget;
+}
+
+// Get the size of the cached host voxels in bytes
+std::size_t VolumeCache::getBytes() {
+    return VolumeCache::bytes;
+}
+
+// Get the size of the resident textures in bytes
+std::size_t VolumeCache::getTextureBytes() {
+    return VolumeCache::texture_bytes;
+}
+
+// Get the number of cached volumes
+std::size_t VolumeCache::getEntries() {
+    return VolumeCache::entries.size();
+}
+
+// Get the number of volumes taken from the cache
+unsigned long long int VolumeCache::getHits() {
+    return VolumeCache::hits;
+}
+
+// Get the number of volumes not found in the cache
+unsigned long long int VolumeCache::getMisses() {
+    return VolumeCache::misses;
+}
+
+
+// Static setters
+
+// Set the budget of the host voxels in bytes
+void VolumeCache::setBudget(const std::size_t &new_budget) {
+    VolumeCache::budget = new_budget;
+    VolumeCache::evict();
+}
+
+// Set the budget of the resident textures in bytes
+void VolumeCache::setTextureBudget(const std::size_t &new_budget) {
+    VolumeCache::texture_budget = new_budget;
+    VolumeCache::evict();
+}
+
+
+// Static methods
+
+// Get the key of the region of the grid read from the path
+std::string VolumeCache::getKey(const std::string &path, const VolumeData::Format &format, const glm::uvec3 &grid, const glm::uvec3 &offset, const glm::uvec3 &size, const glm::uvec3 &stride, const bool &filter) {
+    std::ostringstream key;
+    key << path << '|' << format << '|' << grid.x << 'x' << grid.y << 'x' << grid.z << '|' << offset.x << ',' << offset.y << ',' << offset.z << '|' << size.x << 'x' << size.y << 'x' << size.z;
+    if (stride != glm::uvec3(1U)) {
+        key << '/' << stride.x << ',' << stride.y << ',' << stride.z << (filter ? "" : "n");
+    }
+    return key.str();
+}
+
+// Attach the cache to the current OpenGL context
+void VolumeCache::attach() {
+    VolumeCache::attached = true;
+}
+
+// Keep the open volume data under the key
+void VolumeCache::store(const std::string &key, VolumeData *const data) {
+    // A detached cache would outlive the OpenGL objects, the volumes must be deleted before it is cleared
+    if (!VolumeCache::attached) {
+        std::cerr << "error: volume `" << data->path << "' closed while the volume cache is not attached to the OpenGL context" << std::endl;
+        delete data;
+        return;
+    }
+
+    // Replace a stale copy of the same region
+    for (std::list<VolumeCache::Entry>::iterator entry = VolumeCache::entries.begin(); entry != VolumeCache::entries.end(); ++entry) {
+        if (entry->key == key) {
+            VolumeCache::bytes -= entry->bytes;
+            VolumeCache::texture_bytes -= entry->texture_bytes;
+            delete entry->data;
+            VolumeCache::entries.erase(entry);
+            break;
+        }
+    }
+
+    // The newest volume goes first, the budgets evict the oldest
+    VolumeCache::Entry entry;
+    entry.key = key;
+    entry.data = data;
+    entry.bytes = sizeof(GLushort) * data->voxels;
+    for (const std::pair<const std::string, VolumeData::Derived *> &structure : data->derived) {
+        entry.bytes += structure.second->getBytes();
+    }
+    entry.texture_bytes = data->texture != GL_FALSE ? (data->format == VolumeData::RAW8 ? sizeof(GLubyte) : sizeof(GLushort)) * data->voxels : 0U;
+    VolumeCache::entries.push_front(entry);
+    VolumeCache::bytes += entry.bytes;
+    VolumeCache::texture_bytes += entry.texture_bytes;
+    VolumeCache::evict();
+}
+
+// Take the volume data of the key out of the cache
+VolumeData *VolumeCache::take(const std::string &key) {
+    for (std::list<VolumeCache::Entry>::iterator entry = VolumeCache::entries.begin(); entry != VolumeCache::entries.end(); ++entry) {
+        if (entry->key != key) {
+            continue;
+        }
+
+        VolumeData *const data = entry->data;
+        VolumeCache::bytes -= entry->bytes;
+        VolumeCache::texture_bytes -= entry->texture_bytes;
+        VolumeCache::entries.erase(entry);
+        VolumeCache::hits++;
+
+        // Upload the texture again if it was evicted
+        const bool resident = data->texture != GL_FALSE;
+        if (!resident) {
+            const ProfilerScope scope("upload");
+            VolumeLoader::upload(data, data->voxel);
+        }
+
+        std::cout << "info: volume `" << data->path << "' taken from the cache" << (resident ? " with its resident texture" : ", texture uploaded again") << std::endl;
+        return data;
+    }
+
+    VolumeCache::misses++;
+    return nullptr;
+}
+
+// Delete all the cached volumes
+void VolumeCache::clear() {
+    for (const VolumeCache::Entry &entry : VolumeCache::entries) {
+        delete entry.data;
+    }
+    VolumeCache::entries.clear();
+    VolumeCache::bytes = 0U;
+    VolumeCache::texture_bytes = 0U;
+    VolumeCache::attached = false;
+}
\ No newline at end of file
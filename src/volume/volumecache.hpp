@@ -0,0 +1,130 @@
+#ifndef __VOLUME_CACHE_HPP_
+#define __VOLUME_CACHE_HPP_
+
+#include "loader/volumedata.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <string>
+
+#include <list>
+
+
+/** Process-wide cache of the closed volumes, their host voxels, value scale, buffers and the structures the renderers computed from the voxels are kept within a memory budget evicting the least recently used, and their textures optionally stay resident within a budget of their own, it must be used from the OpenGL context thread while it is attached to the context */
+class VolumeCache {
+    private:
+        // Structures
+
+        /** Cached volume */
+        struct Entry {
+            /** Path, format, grid, read region and stride of the volume */
+            std::string key;
+
+            /** Volume data owning the voxels and the OpenGL objects */
+            VolumeData *data;
+
+            /** Size of the host voxels and the derived structures in bytes */
+            std::size_t bytes;
+
+            /** Size of the texture in bytes, zero if it was deleted */
+            std::size_t texture_bytes;
+        };
+
+
+        // Constructors
+
+        /** Disable the default constructor */
+        VolumeCache() = delete;
+
+        /** Disable the default copy constructor */
+        VolumeCache(const VolumeCache &) = delete;
+
+        /** Disable the assignation operator */
+        VolumeCache &operator=(const VolumeCache &) = delete;
+
+
+        // Static attributes
+
+        /** Cached volumes, the most recently used first */
+        static std::list<VolumeCache::Entry> entries;
+
+        /** Budget of the host voxels in bytes */
+        static std::size_t budget;
+
+        /** Budget of the resident textures in bytes, zero to delete them */
+        static std::size_t texture_budget;
+
+        /** Size of the cached host voxels in bytes */
+        static std::size_t bytes;
+
+        /** Size of the resident textures in bytes */
+        static std::size_t texture_bytes;
+
+        /** Volumes taken from the cache */
+        static unsigned long long int hits;
+
+        /** Volumes not found in the cache */
+        static unsigned long long int misses;
+
+        /** Attached status, the cache owns OpenGL objects only while the context is current */
+        static bool attached;
+
+
+        // Static methods
+
+        /** Evict the least recently used volumes and textures until they fit in the budgets */
+        static void evict();
+
+
+    public:
+        // Static getters
+
+        /** Get the budget of the host voxels in bytes */
+        static std::size_t getBudget();
+
+        /** Get the budget of the resident textures in bytes */
+        static std::size_t getTextureBudget();
+
+        /** Get the size of the cached host voxels in bytes */
+        static std::size_t getBytes();
+
+        /** Get the size of the resident textures in bytes */
+        static std::size_t getTextureBytes();
+
+        /** Get the number of cached volumes */
+        static std::size_t getEntries();
+
+        /** Get the number of volumes taken from the cache */
+        static unsigned long long int getHits();
+
+        /** Get the number of volumes not found in the cache */
+        static unsigned long long int getMisses();
+
+        // Static setters
+
+        /** Set the budget of the host voxels in bytes, evicting the volumes over it */
+        static void setBudget(const std::size_t &new_budget);
+
+        /** Set the budget of the resident textures in bytes, zero deletes the textures of the cached volumes */
+        static void setTextureBudget(const std::size_t &new_budget);
+
+
+        // Static methods
+
+        /** Get the key of the region of the grid read from the path, the whole grid if the size is zero, downsampled by the stride with or without the filter */
+        static std::string getKey(const std::string &path, const VolumeData::Format &format, const glm::uvec3 &grid, const glm::uvec3 &offset, const glm::uvec3 &size, const glm::uvec3 &stride = glm::uvec3(1U), const bool &filter = true);
+
+        /** Attach the cache to the current OpenGL context, the closed volumes are kept until it is cleared */
+        static void attach();
+
+        /** Keep the open volume data under the key, the cache owns it, it is deleted at once if the cache is not attached */
+        static void store(const std::string &key, VolumeData *const data);
+
+        /** Take the volume data of the key out of the cache with its texture uploaded again if it was deleted, null if it is not cached */
+        static VolumeData *take(const std::string &key);
+
+        /** Delete all the cached volumes and detach the cache, before the OpenGL context is destroyed */
+        static void clear();
+};
+
+#endif // __VOLUME_CACHE_HPP_
\ No newline at end of file